@@ -0,0 +1,546 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGBatchRunner.cpp
+ Date started: 10/16/26
+ Purpose:      Runs a script many times with dispersed properties.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+This class runs a number of independent simulations of the same script, each
+one with its own FGFDMExec instance, on a pool of worker threads.
+
+HISTORY
+--------------------------------------------------------------------------------
+10/16/26         Created
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGBatchRunner.h"
+#include "FGFDMExec.h"
+#include "input_output/FGPropertyManager.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <sys/time.h>
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <deque>
+#include <cmath>
+
+using namespace std;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGBatchRunner.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_BATCHRUNNER;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LOCAL DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// A mutex on top of the platform threads.
+
+class BatchMutex {
+public:
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  BatchMutex(void) {InitializeCriticalSection(&cs);}
+  ~BatchMutex() {DeleteCriticalSection(&cs);}
+  void Lock(void) {EnterCriticalSection(&cs);}
+  void Unlock(void) {LeaveCriticalSection(&cs);}
+private:
+  CRITICAL_SECTION cs;
+#else
+  BatchMutex(void) {pthread_mutex_init(&mutex, 0);}
+  ~BatchMutex() {pthread_mutex_destroy(&mutex);}
+  void Lock(void) {pthread_mutex_lock(&mutex);}
+  void Unlock(void) {pthread_mutex_unlock(&mutex);}
+private:
+  pthread_mutex_t mutex;
+#endif
+};
+
+// The random numbers of a run: a xorshift64* generator whose state is derived
+// from the batch seed and the run number.
+
+class BatchRandom {
+public:
+  BatchRandom(unsigned long seed, unsigned int run) {
+    state = Mix((unsigned long long)seed * 0x9E3779B97F4A7C15ULL + run + 1);
+    if (state == 0) state = 0x9E3779B97F4A7C15ULL;
+  }
+
+  /// Returns a uniformly distributed number in (0, 1].
+  double Uniform(void) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    unsigned long long r = state * 0x2545F4914F6CDD1DULL;
+    return ((r >> 11) + 1) * (1.0/9007199254740992.0);
+  }
+
+  /// Returns a normally distributed number (Box-Muller).
+  double Gaussian(void) {
+    double u1 = Uniform(), u2 = Uniform();
+    return sqrt(-2.0*log(u1))*cos(2.0*M_PI*u2);
+  }
+
+private:
+  unsigned long long state;
+
+  static unsigned long long Mix(unsigned long long z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+};
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+static double getcurrentseconds(void)
+{
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+#else
+static double getcurrentseconds(void)
+{
+  struct timeval tval;
+  gettimeofday(&tval, 0);
+  return (tval.tv_sec + tval.tv_usec*1e-6);
+}
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A worker of the pool. Each worker owns a queue of runs; it takes runs from
+// the front of its own queue and, once that is empty, from the back of the
+// queues of the other workers. No runs are added once the pool is started, so
+// a worker is done when all the queues are empty.
+
+class FGBatchRunner::Worker {
+public:
+  Worker(FGBatchRunner* runner, vector <Worker*>& crew)
+    : Runner(runner), Crew(crew) {}
+
+  deque <unsigned int> Queue;
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  static DWORD WINAPI Entry(LPVOID worker) {
+    ((Worker*)worker)->Work();
+    return 0;
+  }
+#else
+  static void* Entry(void* worker) {
+    ((Worker*)worker)->Work();
+    return 0;
+  }
+#endif
+
+  void Work(void) {
+    unsigned int run;
+    while (Pop(run) || Steal(run)) {
+      FGFDMExec* fdm = new FGFDMExec();
+      Runner->RunOne(run, fdm);
+      delete fdm;
+    }
+  }
+
+private:
+  FGBatchRunner* Runner;
+  vector <Worker*>& Crew;
+  BatchMutex Lock;
+
+  bool Pop(unsigned int& run) {
+    Lock.Lock();
+    bool found = !Queue.empty();
+    if (found) {
+      run = Queue.front();
+      Queue.pop_front();
+    }
+    Lock.Unlock();
+    return found;
+  }
+
+  bool Steal(unsigned int& run) {
+    unsigned int self = 0;
+    while (Crew[self] != this) self++;
+
+    for (unsigned int i=1; i<Crew.size(); i++) {
+      Worker* victim = Crew[(self + i) % Crew.size()];
+      victim->Lock.Lock();
+      bool found = !victim->Queue.empty();
+      if (found) {
+        run = victim->Queue.back();
+        victim->Queue.pop_back();
+      }
+      victim->Lock.Unlock();
+      if (found) return true;
+    }
+    return false;
+  }
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGBatchRunner::FGBatchRunner(void)
+{
+  RootDir     = "";
+  nRuns       = 1;
+  nThreads    = 1;
+  Seed        = 1;
+  OutputRate  = 0.0;
+  nFailed     = 0;
+  ElapsedTime = 0.0;
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGBatchRunner::~FGBatchRunner()
+{
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBatchRunner::AddDispersion(const string& property, eDispersionType type,
+                                  double a, double b)
+{
+  Dispersion dispersion;
+  dispersion.Property = property;
+  dispersion.Type = type;
+  dispersion.A = a;
+  dispersion.B = b;
+  Dispersions.push_back(dispersion);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGBatchRunner::LoadDispersions(const string& filename)
+{
+  Element* document = LoadXMLDocument(RootDir + filename);
+
+  if (!document) {
+    cerr << "File: " << filename << " could not be loaded." << endl;
+    return false;
+  }
+
+  if (document->GetName() != string("dispersions")) {
+    cerr << "File: " << filename << " is not a dispersions file" << endl;
+    return false;
+  }
+
+  Element* dispersion_element = document->FindElement("dispersion");
+  while (dispersion_element) {
+    string property = dispersion_element->GetAttributeValue("name");
+    string type = dispersion_element->GetAttributeValue("type");
+
+    if (property.empty()) {
+      cerr << "A dispersion must name the dispersed property" << endl;
+      return false;
+    }
+
+    if (type == "gaussian") {
+      double mean = 0.0;
+      if (!dispersion_element->GetAttributeValue("mean").empty())
+        mean = dispersion_element->GetAttributeValueAsNumber("mean");
+      double sigma = dispersion_element->GetAttributeValueAsNumber("sigma");
+      if (sigma == HUGE_VAL) {
+        cerr << "The gaussian dispersion of " << property << " has no sigma" << endl;
+        return false;
+      }
+      AddDispersion(property, dtGaussian, mean, sigma);
+    } else if (type == "uniform") {
+      double lower = dispersion_element->GetAttributeValueAsNumber("lower");
+      double upper = dispersion_element->GetAttributeValueAsNumber("upper");
+      if (lower == HUGE_VAL || upper == HUGE_VAL) {
+        cerr << "The uniform dispersion of " << property << " needs a lower and an"
+                " upper bound" << endl;
+        return false;
+      }
+      AddDispersion(property, dtUniform, lower, upper);
+    } else {
+      cerr << "Unknown dispersion type \"" << type << "\" for " << property << endl;
+      return false;
+    }
+
+    dispersion_element = document->FindNextElement("dispersion");
+  }
+
+  Element* output_element = document->FindElement("output");
+  if (output_element) {
+    if (!output_element->GetAttributeValue("rate").empty())
+      OutputRate = output_element->GetAttributeValueAsNumber("rate");
+
+    Element* property_element = output_element->FindElement("property");
+    while (property_element) {
+      AddOutputProperty(property_element->GetDataLine());
+      property_element = output_element->FindNextElement("property");
+    }
+  }
+
+  ResetParser();
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGBatchRunner::Run(void)
+{
+  if (ScriptName.empty()) {
+    cerr << "No script given for the batch" << endl;
+    return false;
+  }
+
+  Results.clear();
+  Results.resize(nRuns);
+
+  // The debug level is shared by all the executives. Messages from the runs
+  // would be interleaved, so they are silenced for the duration of the batch.
+  // The executives do not write it while it is 0, so it is only written here,
+  // before and after the workers run.
+  short saved_debug_lvl = debug_lvl;
+  debug_lvl = 0;
+
+  unsigned int threads = nThreads < nRuns ? nThreads : nRuns;
+  if (threads == 0) threads = 1;
+
+  vector <Worker*> crew;
+  for (unsigned int i=0; i<threads; i++) crew.push_back(new Worker(this, crew));
+
+  // Every worker starts with a contiguous share of the runs.
+  for (unsigned int run=0; run<nRuns; run++)
+    crew[(unsigned long)run*threads/nRuns]->Queue.push_back(run);
+
+  double start = getcurrentseconds();
+
+  // The calling thread is the first worker.
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  vector <HANDLE> handles;
+  for (unsigned int i=1; i<threads; i++)
+    handles.push_back(CreateThread(0, 0, Worker::Entry, crew[i], 0, 0));
+  crew[0]->Work();
+  for (unsigned int i=0; i<handles.size(); i++) {
+    WaitForSingleObject(handles[i], INFINITE);
+    CloseHandle(handles[i]);
+  }
+#else
+  vector <pthread_t> handles(threads);
+  for (unsigned int i=1; i<threads; i++)
+    pthread_create(&handles[i], 0, Worker::Entry, crew[i]);
+  crew[0]->Work();
+  for (unsigned int i=1; i<threads; i++) pthread_join(handles[i], 0);
+#endif
+
+  ElapsedTime = getcurrentseconds() - start;
+
+  for (unsigned int i=0; i<crew.size(); i++) delete crew[i];
+  debug_lvl = saved_debug_lvl;
+
+  nFailed = 0;
+  for (unsigned int run=0; run<nRuns; run++) {
+    if (!Results[run].Success) nFailed++;
+  }
+
+  return nFailed == 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs one simulation. This is called from the worker threads: it touches
+// nothing but the given executive and the result of the run.
+
+void FGBatchRunner::RunOne(unsigned int run, FGFDMExec* fdm)
+{
+  Result& result = Results[run];
+  BatchRandom random(Seed, run);
+
+  fdm->SetRootDir(RootDir);
+  fdm->SetAircraftPath("aircraft");
+  fdm->SetEnginePath("engine");
+  fdm->SetSystemsPath("systems");
+
+  if (!fdm->LoadScript(ScriptName, 0.0)) {
+    cerr << "Run " << run << ": script file " << ScriptName
+         << " was not successfully loaded" << endl;
+    return;
+  }
+
+  // The runs must not write the outputs of the aircraft and the script.
+  fdm->DisableOutput();
+  fdm->SetRandomSeed(Seed, run);
+
+  FGPropertyManager* pm = fdm->GetPropertyManager();
+
+  for (unsigned int i=0; i<Dispersions.size(); i++) {
+    const Dispersion& dispersion = Dispersions[i];
+    FGPropertyManager* node = pm->GetNode(dispersion.Property);
+    if (!node) {
+      cerr << "Run " << run << ": no property by the name " << dispersion.Property << endl;
+      return;
+    }
+
+    double offset;
+    if (dispersion.Type == dtGaussian)
+      offset = dispersion.A + dispersion.B*random.Gaussian();
+    else
+      offset = dispersion.A + (dispersion.B - dispersion.A)*random.Uniform();
+
+    double value = node->getDoubleValue() + offset;
+    node->setDoubleValue(value);
+    result.Dispersed.push_back(value);
+  }
+
+  vector <FGPropertyManager*> outputs;
+  for (unsigned int i=0; i<OutputProperties.size(); i++) {
+    FGPropertyManager* node = pm->GetNode(OutputProperties[i]);
+    if (!node) {
+      cerr << "Run " << run << ": no property by the name " << OutputProperties[i] << endl;
+      return;
+    }
+    outputs.push_back(node);
+  }
+
+  fdm->RunIC();
+
+  unsigned int every = 1;
+  if (OutputRate > 0.0 && fdm->GetDeltaT() > 0.0) {
+    every = (unsigned int)(1.0/(OutputRate*fdm->GetDeltaT()) + 0.5);
+    if (every == 0) every = 1;
+  }
+
+  unsigned int frame = 0;
+  bool running = true;
+  while (running) {
+    if (frame % every == 0) {
+      result.Samples.push_back(fdm->GetSimTime());
+      for (unsigned int i=0; i<outputs.size(); i++)
+        result.Samples.push_back(outputs[i]->getDoubleValue());
+    }
+    running = fdm->Run();
+    frame++;
+  }
+
+  result.Success = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned long FGBatchRunner::GetNumSamples(void) const
+{
+  unsigned long samples = 0;
+  unsigned int columns = 1 + OutputProperties.size();
+
+  for (unsigned int run=0; run<Results.size(); run++)
+    samples += Results[run].Samples.size()/columns;
+
+  return samples;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGBatchRunner::WriteCSV(const string& filename) const
+{
+  ofstream out(filename.c_str());
+
+  if (!out.is_open()) {
+    cerr << "Could not open file: " << filename << endl;
+    return false;
+  }
+
+  WriteCSV(out);
+
+  return out.good();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBatchRunner::WriteCSV(ostream& out) const
+{
+  unsigned int columns = 1 + OutputProperties.size();
+
+  out << "Run, Time";
+  for (unsigned int i=0; i<Dispersions.size(); i++) out << ", " << Dispersions[i].Property;
+  for (unsigned int i=0; i<OutputProperties.size(); i++) out << ", " << OutputProperties[i];
+  out << endl;
+
+  out.precision(10);
+
+  for (unsigned int run=0; run<Results.size(); run++) {
+    const Result& result = Results[run];
+    if (!result.Success) continue;
+
+    for (unsigned int s=0; s<result.Samples.size(); s+=columns) {
+      out << run << ", " << result.Samples[s];
+      for (unsigned int i=0; i<result.Dispersed.size(); i++) out << ", " << result.Dispersed[i];
+      for (unsigned int i=1; i<columns; i++) out << ", " << result.Samples[s+i];
+      out << "\n";
+    }
+  }
+
+  out.flush();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGBatchRunner::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGBatchRunner" << endl;
+    if (from == 1) cout << "Destroyed:    FGBatchRunner" << endl;
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
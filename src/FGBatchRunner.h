@@ -0,0 +1,200 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+ Header:       FGBatchRunner.h
+ Date started: 10/16/26
+ file The header file for the batch (Monte Carlo) runner.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+HISTORY
+--------------------------------------------------------------------------------
+10/16/26         Created
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGBATCHRUNNER_H
+#define FGBATCHRUNNER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGJSBBase.h"
+#include "input_output/FGXMLFileRead.h"
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_BATCHRUNNER "$Id: FGBatchRunner.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGFDMExec;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Runs a script many times with dispersed properties (Monte Carlo).
+    Each run is an independent FGFDMExec instance with its own property tree.
+    The runs are distributed over a pool of worker threads: every worker starts
+    with a contiguous share of the runs and, when it has finished its own share,
+    steals runs from the back of the other workers' queues, so that runs of
+    differing length keep all the threads busy.
+
+    Before the simulation of a run is started, a random offset is added to
+    each dispersed property. The random numbers are drawn from a generator that
+    is seeded from the batch seed and the run number only, so the results of a
+    batch do not depend on the number of threads nor on the order in which
+    the runs are executed. For the same reason, the random numbers drawn
+    during a run (sensor noise, turbulence, random functions) come from the
+    stream of the batch seed numbered after the run (see
+    FGFDMExec::SetRandomSeed()).
+
+    During each run the output properties are sampled at the given rate. The
+    samples of all the runs are kept in memory and are written in run order,
+    as one table with a column per property, by WriteCSV().
+
+    The dispersions and the output properties may be read from a file:
+
+    @code
+<?xml version="1.0"?>
+<dispersions name="C172 cruise">
+  <dispersion name="ic/h-sl-ft" type="gaussian" sigma="100"/>
+  <dispersion name="ic/vc-kts" type="uniform" lower="-5" upper="5"/>
+  <output rate="10">
+    <property> position/h-sl-ft </property>
+    <property> velocities/vc-kts </property>
+  </output>
+</dispersions>
+    @endcode
+
+    A gaussian dispersion adds a normally distributed offset with the given
+    mean (0 by default) and standard deviation; a uniform dispersion adds an
+    offset between the lower and upper bounds. The rate of the output is given
+    in Hz; when it is absent (or 0), every frame is sampled.
+
+    The standalone program JSBSimBatch is a command line front end for this
+    class.
+    @version "$Id: FGBatchRunner.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGBatchRunner : public FGJSBBase, public FGXMLFileRead
+{
+public:
+  enum eDispersionType {dtGaussian, dtUniform};
+
+  /// Constructor
+  FGBatchRunner(void);
+  /// Destructor
+  ~FGBatchRunner();
+
+  /// Sets the directory the script, aircraft, engine and systems paths are relative to.
+  void SetRootDir(const std::string& rootdir) {RootDir = rootdir;}
+  /// Sets the script that is run by each simulation.
+  void SetScript(const std::string& script) {ScriptName = script;}
+  /// Sets the number of simulations.
+  void SetRuns(unsigned int runs) {nRuns = runs;}
+  /// Sets the number of worker threads.
+  void SetThreads(unsigned int threads) {nThreads = threads > 0 ? threads : 1;}
+  /// Sets the seed from which the random numbers of each run are derived.
+  void SetSeed(unsigned long seed) {Seed = seed;}
+  /** Sets the rate at which the output properties are sampled.
+      @param rate the rate in Hz, 0 to sample every frame */
+  void SetOutputRate(double rate) {OutputRate = rate;}
+
+  /** Adds a dispersion.
+      @param property the name of the dispersed property
+      @param type the distribution of the offset added to the property
+      @param a the mean of a gaussian or the lower bound of a uniform offset
+      @param b the standard deviation of a gaussian or the upper bound of a
+               uniform offset */
+  void AddDispersion(const std::string& property, eDispersionType type, double a, double b);
+  /// Adds a property that is sampled during the runs.
+  void AddOutputProperty(const std::string& property) {OutputProperties.push_back(property);}
+  /** Reads the dispersions and output properties from a file.
+      @return true if the file could be read */
+  bool LoadDispersions(const std::string& filename);
+
+  /** Runs the batch. Blocks until all the runs are complete.
+      @return true if all the runs were successful */
+  bool Run(void);
+
+  /** Writes the samples of all the runs as comma separated values. The
+      columns are the run number, the simulation time, the dispersed values of
+      the run and the output properties.
+      @return true if the file could be written */
+  bool WriteCSV(const std::string& filename) const;
+  void WriteCSV(std::ostream& out) const;
+
+  /// Returns the number of runs that failed to load or to initialize.
+  unsigned int GetNumFailed(void) const {return nFailed;}
+  /// Returns the number of samples taken over all runs.
+  unsigned long GetNumSamples(void) const;
+  /// Returns the time taken by the last call to Run(), in seconds.
+  double GetElapsedTime(void) const {return ElapsedTime;}
+
+private:
+  struct Dispersion {
+    std::string Property;
+    eDispersionType Type;
+    double A, B;
+  };
+
+  struct Result {
+    bool Success;
+    std::vector <double> Dispersed;
+    std::vector <double> Samples;
+    Result(void) : Success(false) {}
+  };
+
+  std::string RootDir;
+  std::string ScriptName;
+  unsigned int nRuns;
+  unsigned int nThreads;
+  unsigned long Seed;
+  double OutputRate;
+  unsigned int nFailed;
+  double ElapsedTime;
+  std::vector <Dispersion> Dispersions;
+  std::vector <std::string> OutputProperties;
+  std::vector <Result> Results;
+
+  class Worker;
+  friend class Worker;
+  void RunOne(unsigned int run, FGFDMExec* fdm);
+
+  void Debug(int from);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
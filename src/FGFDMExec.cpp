@@ -58,15 +58,21 @@ INCLUDES
 #include "models/FGAuxiliary.h"
 #include "models/FGInput.h"
 #include "models/FGOutput.h"
+#include "math/FGFunction.h"
 #include "initialization/FGInitialCondition.h"
 //#include "initialization/FGTrimAnalysis.h" // Remove until later
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGScript.h"
+#include "input_output/FGOutputRecord.h"
+#include "input_output/FGfdmSocket.h"
 #include "initialization/FGSimplexTrim.h"
 
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <iterator>
 #include <cstdlib>
+#include <cctype>
 
 using namespace std;
 
@@ -79,8 +85,17 @@ static const char *IdHdr = ID_FDMEXEC;
 GLOBAL DECLARATIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
-unsigned int FGFDMExec::FDMctr = 0;
-FGPropertyManager* FGFDMExec::master=0;
+// Makes the random numbers of the calling thread come from a generator while
+// in scope. The previous generator is restored, for the case of an instance
+// run from within another (a child FDM).
+class RandomScope
+{
+public:
+  RandomScope(FGRandom* generator) {previous = FGJSBBase::SetRandomGenerator(generator);}
+  ~RandomScope() {FGJSBBase::SetRandomGenerator(previous);}
+private:
+  FGRandom* previous;
+};
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
@@ -111,6 +126,7 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root) : Root(root)
   Frame           = 0;
   Error           = 0;
   GroundCallback  = 0;
+  SocketBatch     = 0;
   Atmosphere      = 0;
   FCS             = 0;
   Propulsion      = 0;
@@ -139,23 +155,19 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root) : Root(root)
   dT = 1.0/120.0; // a default timestep size. This is needed for when JSBSim is
                   // run in standalone mode with no initialization file.
 
-  IdFDM = FDMctr; // The main (parent) JSBSim instance is always the "zeroth"
-  FDMctr++;       // instance. "child" instances are loaded last.
+  messageId = 0;
 
-  try {
-    char* num = getenv("JSBSIM_DEBUG");
-    if (num) debug_lvl = atoi(num); // set debug level
-  } catch (...) {               // if error set to 1
-    debug_lvl = 1;
-  }
+  StandAlone = (Root == 0);
+  if (StandAlone) Root = new FGPropertyManager;
 
-  if (Root == 0) {
-    if (master == 0)
-      master = new FGPropertyManager;
-    Root = master;
-  }
+  // The instance ID is local to the property tree: the main (parent) JSBSim
+  // instance of a tree is the "zeroth" instance, "child" instances are loaded
+  // last and take the next free slots.
+  IdFDM = 0;
+  while (Root->GetNode("/fdm/jsbsim", IdFDM, false) != 0) IdFDM++;
 
   instance = Root->GetNode("/fdm/jsbsim",IdFDM,true);
+  Random.Seed(0, IdFDM);
   Debug(0);
   // this is to catch errors in binding member functions to the property tree.
   try {
@@ -168,6 +180,13 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root) : Root(root)
   trim_status = false;
   ta_mode     = 99;
 
+  FunctionDirtyTracking   = 0;
+  FunctionsEvaluated      = 0;
+  FunctionsSkipped        = 0;
+  TotalFunctionsEvaluated = 0;
+  TotalFunctionsSkipped   = 0;
+  ScheduleFrame           = 0;
+
   Constructing = true;
   typedef int (FGFDMExec::*iPMF)(void) const;
 //  instance->Tie("simulation/do_trim_analysis", this, (iPMF)0, &FGFDMExec::DoTrimAnalysis);
@@ -177,6 +196,18 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root) : Root(root)
   instance->Tie("simulation/terminate", (int *)&Terminate);
   instance->Tie("simulation/sim-time-sec", this, &FGFDMExec::GetSimTime);
   instance->Tie("simulation/jsbsim-debug", this, &FGFDMExec::GetDebugLevel, &FGFDMExec::SetDebugLevel);
+  instance->Tie("simulation/functions/dirty-tracking", this, &FGFDMExec::GetFunctionDirtyTracking,
+                                                       &FGFDMExec::SetFunctionDirtyTracking);
+  instance->Tie("simulation/functions/evaluated", this, &FGFDMExec::GetFunctionsEvaluated);
+  instance->Tie("simulation/functions/skipped", this, &FGFDMExec::GetFunctionsSkipped);
+  instance->Tie("simulation/schedule/worst-frame-time-sec", this, &FGFDMExec::GetWorstFrameTime);
+  instance->Tie("simulation/schedule/balance", this, (iPMF)0, &FGFDMExec::BalanceSchedule);
+  instance->Tie("simulation/perf/reset", this, (iPMF)0, &FGFDMExec::ResetPerformanceStats);
+  FrameStats.Bind(instance, "simulation/perf/frame");
+  instance->Tie("simulation/random-seed", this, &FGFDMExec::GetSeedProperty,
+                                                &FGFDMExec::SetSeedProperty);
+  instance->Tie("simulation/random-stream", this, &FGFDMExec::GetStreamProperty,
+                                                  &FGFDMExec::SetStreamProperty);
 
   Constructing = false;
 }
@@ -188,7 +219,6 @@ FGFDMExec::~FGFDMExec()
   try {
     checkTied( instance );
     DeAllocate();
-    if (Root == 0)  delete master;
   } catch ( string msg ) {
     cout << "Caught error: " << msg << endl;
   }
@@ -198,7 +228,10 @@ FGFDMExec::~FGFDMExec()
 
   PropertyCatalog.clear();
 
-  FDMctr--;
+  // Free the properties of this instance (and its slot) in a shared tree; a
+  // tree of our own is freed as a whole.
+  if (StandAlone) delete Root;
+  else Root->GetNode("/fdm")->removeChild("jsbsim", IdFDM, false);
 
   Debug(1);
 }
@@ -216,7 +249,8 @@ bool FGFDMExec::Allocate(void)
   Aerodynamics    = new FGAerodynamics (this);
   Inertial        = new FGInertial(this);
 
-  GroundCallback  = new FGGroundCallback(Inertial->GetRefRadius());
+  GroundCallback  = new FGDefaultGroundCallback(Inertial->GetRefRadius());
+  SocketBatch     = new FGfdmSocketBatch;
 
   GroundReactions = new FGGroundReactions(this);
   ExternalReactions = new FGExternalReactions(this);
@@ -259,6 +293,8 @@ bool FGFDMExec::Allocate(void)
 
 bool FGFDMExec::DeAllocate(void)
 {
+  UnbindSchedule();
+
   delete Input;
   delete Atmosphere;
   delete FCS;
@@ -281,10 +317,12 @@ bool FGFDMExec::DeAllocate(void)
   delete Trim;
 
   delete GroundCallback;
+  delete SocketBatch;
 
   Error       = 0;
 
   Input           = 0;
+  SocketBatch     = 0;
   Atmosphere      = 0;
   FCS             = 0;
   Propulsion      = 0;
@@ -300,6 +338,7 @@ bool FGFDMExec::DeAllocate(void)
   Script          = 0;
 
   Models.clear();
+  Functions.clear();
 
   modelLoaded = false;
   return modelLoaded;
@@ -307,10 +346,237 @@ bool FGFDMExec::DeAllocate(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGFDMExec::Schedule(FGModel* model, int rate)
+void FGFDMExec::Schedule(FGModel* model, int rate, int phase)
 {
   model->SetRate(rate);
+  model->SetPhase(phase);
   Models.push_back(model);
+  BindSchedule(model);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The scheduling and timing properties of a model are named after its class:
+// FGAtmosphere is found under simulation/schedule/atmosphere and
+// simulation/perf/atmosphere, the first FGOutput under .../output and the next
+// ones under output[1], output[2], ...
+
+void FGFDMExec::BindSchedule(FGModel* model)
+{
+  string name = model->Name;
+  if (name.compare(0, 2, "FG") == 0) name.erase(0, 2);
+  for (unsigned int i=0; i<name.size(); i++) name[i] = tolower(name[i]);
+
+  string key = name;
+  for (int idx=1; instance->HasNode("simulation/schedule/" + key + "/rate"); idx++)
+    key = CreateIndexedPropertyName(name, idx);
+
+  string base = "simulation/schedule/" + key;
+  instance->Tie(base + "/rate", model, &FGModel::GetRate, &FGModel::SetRate);
+  instance->Tie(base + "/phase", model, &FGModel::GetPhase, &FGModel::SetPhase);
+  model->BindExecStats("simulation/perf/" + key);
+  ModelKeys.push_back(key);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The properties are tied to the models, so they must be untied before the
+// models are deleted. Everything under simulation/perf/<key> is untied, which
+// also covers the statistics the models bind there by themselves (FCS
+// components, output queues).
+
+void FGFDMExec::UnbindSchedule(void)
+{
+  const char* leaves[] = {"/rate", "/phase"};
+
+  for (unsigned int i=0; i<ModelKeys.size(); i++) {
+    for (unsigned int j=0; j<sizeof(leaves)/sizeof(leaves[0]); j++) {
+      string name = "simulation/schedule/" + ModelKeys[i] + leaves[j];
+      if (instance->HasNode(name) && instance->GetNode(name)->isTied())
+        instance->Untie(name);
+    }
+    string base = "simulation/perf/" + ModelKeys[i];
+    if (instance->HasNode(base)) checkTied(instance->GetNode(base));
+  }
+  ModelKeys.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::ResetPerformanceStats(void)
+{
+  for (unsigned int i=0; i<Models.size(); i++) Models[i]->ResetExecStats();
+  FrameStats.Reset();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGFDMExec::GetPerformanceStrings(const string& delimiter) const
+{
+  ostringstream buf;
+
+  buf << "Frame mean (us)" << delimiter << "Frame max (us)" << delimiter << "Frame p99 (us)";
+  for (unsigned int i=0; i<ModelKeys.size(); i++) {
+    buf << delimiter << ModelKeys[i] << " mean (us)"
+        << delimiter << ModelKeys[i] << " max (us)"
+        << delimiter << ModelKeys[i] << " p99 (us)";
+  }
+
+  return buf.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGFDMExec::GetPerformanceValues(const string& delimiter) const
+{
+  FGOutputRecord record;
+
+  GetPerformanceValues(record);
+
+  return record.Print(delimiter);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::GetPerformanceValues(FGOutputRecord& record) const
+{
+  record.Push(1e6*FrameStats.GetMean());
+  record.Push(1e6*FrameStats.GetMax());
+  record.Push(1e6*FrameStats.GetP99());
+  for (unsigned int i=0; i<Models.size(); i++) {
+    const FGTimingStats& stats = Models[i]->GetExecStats();
+    record.Push(1e6*stats.GetMean());
+    record.Push(1e6*stats.GetMax());
+    record.Push(1e6*stats.GetP99());
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGFDMExec::GetPerformanceReport(void) const
+{
+  ostringstream buf;
+
+  buf << "  Model                Rate Phase    Runs    Min (us)   Mean (us)    p99 (us)    Max (us)" << endl;
+  buf << fixed << setprecision(2);
+  for (unsigned int i=0; i<Models.size(); i++) {
+    const FGTimingStats& stats = Models[i]->GetExecStats();
+    buf << "  " << left << setw(18) << ModelKeys[i] << right
+        << setw(7) << Models[i]->GetRate() << setw(6) << Models[i]->GetPhase()
+        << setw(8) << stats.GetCount()
+        << setw(12) << 1e6*stats.GetMin() << setw(12) << 1e6*stats.GetMean()
+        << setw(12) << 1e6*stats.GetP99() << setw(12) << 1e6*stats.GetMax() << endl;
+  }
+  buf << "  " << left << setw(31) << "Frame" << right << setw(8) << FrameStats.GetCount()
+      << setw(12) << 1e6*FrameStats.GetMin() << setw(12) << 1e6*FrameStats.GetMean()
+      << setw(12) << 1e6*FrameStats.GetP99() << setw(12) << 1e6*FrameStats.GetMax() << endl;
+  buf << "  Worst case frame (us): " << 1e6*GetWorstFrameTime() << endl;
+
+  return buf.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The schedule repeats itself every least common multiple of the model rates.
+// The period is bounded so that the worst case search stays cheap for unusual
+// combinations of rates (the frames beyond the bound are then not examined).
+
+static unsigned int GreatestCommonDivisor(unsigned int a, unsigned int b)
+{
+  while (b != 0) {
+    unsigned int r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+unsigned int FGFDMExec::GetSchedulePeriod(void) const
+{
+  const unsigned int MaxPeriod = 10000;
+  unsigned int period = 1;
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    unsigned int rate = Models[i]->GetRate();
+    period = period / GreatestCommonDivisor(period, rate) * rate;
+    if (period > MaxPeriod) return MaxPeriod;
+  }
+
+  return period;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGFDMExec::GetWorstFrameTime(void) const
+{
+  unsigned int period = GetSchedulePeriod();
+  vector <double> load(period, 0.0);
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    unsigned int rate = Models[i]->GetRate();
+    double cost = Models[i]->GetExecStats().GetMax();
+    for (unsigned int f=Models[i]->GetPhase(); f<period; f+=rate) load[f] += cost;
+  }
+
+  double worst = 0.0;
+  for (unsigned int f=0; f<period; f++)
+    if (load[f] > worst) worst = load[f];
+
+  return worst;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::BalanceSchedule(void)
+{
+  unsigned int period = GetSchedulePeriod();
+  vector <double> load(period, 0.0);
+  vector <FGModel*> multirate;
+
+  // Models that have not run yet all count for the same (small) cost, so that
+  // they are at least spread evenly.
+  const double DefaultCost = 1e-9;
+
+  vector <double> costs;
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    const FGTimingStats& stats = Models[i]->GetExecStats();
+    if (Models[i]->GetRate() == 1) {
+      for (unsigned int f=0; f<period; f++) load[f] += stats.GetMean();
+    } else {
+      // Insertion by decreasing cost
+      double cost = stats.GetCount() > 0 ? stats.GetMean() : DefaultCost;
+      unsigned int pos = 0;
+      while (pos < costs.size() && costs[pos] >= cost) pos++;
+      multirate.insert(multirate.begin() + pos, Models[i]);
+      costs.insert(costs.begin() + pos, cost);
+    }
+  }
+
+  for (unsigned int i=0; i<multirate.size(); i++) {
+    FGModel* model = multirate[i];
+    unsigned int rate = model->GetRate();
+    double cost = costs[i];
+    unsigned int best = 0;
+    double best_peak = 0.0;
+
+    for (unsigned int phase=0; phase<rate; phase++) {
+      double peak = 0.0;
+      for (unsigned int f=phase; f<period; f+=rate)
+        if (load[f] > peak) peak = load[f];
+      if (phase == 0 || peak < best_peak) {
+        best = phase;
+        best_peak = peak;
+      }
+    }
+
+    model->SetPhase(best);
+    for (unsigned int f=best; f<period; f+=rate) load[f] += cost;
+  }
+
+  if (debug_lvl > 0) {
+    cout << endl << "  Model schedule (rate/phase):" << endl;
+    for (unsigned int i=0; i<Models.size(); i++)
+      cout << "    " << Models[i]->Name << ": " << Models[i]->GetRate()
+           << "/" << Models[i]->GetPhase() << endl;
+  }
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -318,6 +584,7 @@ void FGFDMExec::Schedule(FGModel* model, int rate)
 bool FGFDMExec::Run(void)
 {
   bool success=true;
+  RandomScope random(&Random);
 
   Debug(2);
 
@@ -329,8 +596,31 @@ bool FGFDMExec::Run(void)
   // returns true if success, false if complete
   if (Script != 0 && !IntegrationSuspended()) success = Script->RunScript();
 
-  vector <FGModel*>::iterator it;
-  for (it = Models.begin(); it != Models.end(); ++it) (*it)->Run();
+  // The frames where the time does not advance (initialization, trim, hold)
+  // run every model and are neither counted in the schedule nor timed. In the
+  // other frames, each model that is run is timed from the end of the previous
+  // one, so that a single clock reading is taken per model.
+  if (IntegrationSuspended() || holding) {
+    for (unsigned int i=0; i<Models.size(); i++) Models[i]->Run();
+  } else {
+    double start = GetMonotonicSeconds();
+    double now = start;
+    for (unsigned int i=0; i<Models.size(); i++) {
+      FGModel* model = Models[i];
+      if (!model->IsDue(ScheduleFrame)) continue;
+      model->Run();
+      double end = GetMonotonicSeconds();
+      model->AddExecTime(end - now);
+      now = end;
+    }
+    FrameStats.Add(now - start);
+    ScheduleFrame++;
+  }
+
+  // The packets the outputs queued during the frame
+  SocketBatch->Send();
+
+  CountFunctionEvaluations();
 
   Frame++;
   if (!Holding()) IncrTime();
@@ -344,6 +634,8 @@ bool FGFDMExec::Run(void)
 
 bool FGFDMExec::RunIC(void)
 {
+  RandomScope random(&Random);
+
   SuspendIntegration(); // saves the integration rate, dt, then sets it to 0.0.
   Initialize(IC);
   Run();
@@ -411,6 +703,7 @@ void FGFDMExec::ResetToInitialConditions(void)
 
   vector <FGModel*>::iterator it;
   for (it = Models.begin(); it != Models.end(); ++it) (*it)->InitModel();
+  ScheduleFrame = 0;
 
   RunIC();
   if (Script) Script->ResetEvents();
@@ -489,15 +782,18 @@ bool FGFDMExec::LoadModel(string model, bool addModelToPath)
     Allocate();
   }
 
-  int saved_debug_lvl = debug_lvl;
+  // A child is loaded quietly. The level is only written when it is not quiet
+  // already, so that the instances of a batch (run at level 0) never write it.
+  short saved_debug_lvl = debug_lvl;
+  bool quiet = IsChild && debug_lvl != 0;
 
   document = LoadXMLDocument(aircraftCfgFileName); // "document" is a class member
   if (document) {
-    if (IsChild) debug_lvl = 0;
+    if (quiet) debug_lvl = 0;
 
     ReadPrologue(document);
 
-    if (IsChild) debug_lvl = saved_debug_lvl;
+    if (quiet) debug_lvl = saved_debug_lvl;
 
     // Process the fileheader element in the aircraft config file. This element is OPTIONAL.
     element = document->FindElement("fileheader");
@@ -509,7 +805,7 @@ bool FGFDMExec::LoadModel(string model, bool addModelToPath)
       }
     }
 
-    if (IsChild) debug_lvl = 0;
+    if (quiet) debug_lvl = 0;
 
     // Process the metrics element. This element is REQUIRED.
     element = document->FindElement("metrics");
@@ -649,7 +945,7 @@ bool FGFDMExec::LoadModel(string model, bool addModelToPath)
       } else {
         Outputs.push_back(Output);
         string outputProp = CreateIndexedPropertyName("simulation/output",idx);
-        instance->Tie(outputProp+"/log_rate_hz", Output, (iOPMF)0, &FGOutput::SetRate);
+        instance->Tie(outputProp+"/log_rate_hz", Output, (iOPMF)0, &FGOutput::SetRateHz);
         idx++;
       }
       element = document->FindNextElement("output");
@@ -677,7 +973,7 @@ bool FGFDMExec::LoadModel(string model, bool addModelToPath)
            << reset << endl;
     }
     
-    if (IsChild) debug_lvl = saved_debug_lvl;
+    if (quiet) debug_lvl = saved_debug_lvl;
 
   } else {
     cerr << fgred
@@ -694,6 +990,17 @@ bool FGFDMExec::LoadModel(string model, bool addModelToPath)
     result = false;
   }
 
+  // Compile the functions of the models now that all properties are bound.
+  if (result) {
+    Functions.clear();
+    for (unsigned int i=0; i<Models.size(); i++) Models[i]->GetFunctions(Functions);
+    for (unsigned int i=0; i<Functions.size(); i++) {
+      Functions[i]->Compile();
+      Functions[i]->SetDirtyTracking(FunctionDirtyTracking != 0);
+    }
+    TotalFunctionsEvaluated = TotalFunctionsSkipped = 0;
+  }
+
   if (result) {
     struct PropertyCatalogStructure masterPCS;
     masterPCS.base_string = "";
@@ -706,6 +1013,34 @@ bool FGFDMExec::LoadModel(string model, bool addModelToPath)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFDMExec::SetFunctionDirtyTracking(int track)
+{
+  FunctionDirtyTracking = track ? 1 : 0;
+  for (unsigned int i=0; i<Functions.size(); i++)
+    Functions[i]->SetDirtyTracking(FunctionDirtyTracking != 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Updates the number of function evaluations computed and skipped since the
+// previous frame.
+
+void FGFDMExec::CountFunctionEvaluations(void)
+{
+  unsigned long evaluated = 0, skipped = 0;
+
+  for (unsigned int i=0; i<Functions.size(); i++) {
+    evaluated += Functions[i]->GetNumEvaluations();
+    skipped += Functions[i]->GetNumSkipped();
+  }
+
+  FunctionsEvaluated = (int)(evaluated - TotalFunctionsEvaluated);
+  FunctionsSkipped = (int)(skipped - TotalFunctionsSkipped);
+  TotalFunctionsEvaluated = evaluated;
+  TotalFunctionsSkipped = skipped;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGFDMExec::BuildPropertyCatalog(struct PropertyCatalogStructure* pcs)
 {
   struct PropertyCatalogStructure* pcsNew = new struct PropertyCatalogStructure;
@@ -854,7 +1189,7 @@ bool FGFDMExec::ReadChild(Element* el)
 
   struct childData* child = new childData;
 
-  child->exec = new FGFDMExec();
+  child->exec = new FGFDMExec(Root);
   child->exec->SetChild(true);
 
   string childAircraft = el->GetAttributeValue("name");
@@ -924,6 +1259,27 @@ void FGFDMExec::EnableOutput(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFDMExec::SuspendOutput(void)
+{
+  SuspendedOutputs.resize(Outputs.size());
+  for (unsigned i=0; i<Outputs.size(); i++) {
+    SuspendedOutputs[i] = Outputs[i]->IsEnabled();
+    Outputs[i]->Disable();
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::ResumeOutput(void)
+{
+  for (unsigned i=0; i<Outputs.size() && i<SuspendedOutputs.size(); i++) {
+    if (SuspendedOutputs[i]) Outputs[i]->Enable();
+  }
+  SuspendedOutputs.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 bool FGFDMExec::SetOutputDirectives(string fname)
 {
   bool result;
@@ -938,7 +1294,7 @@ bool FGFDMExec::SetOutputDirectives(string fname)
     Outputs.push_back(Output);
     typedef int (FGOutput::*iOPMF)(void) const;
     string outputProp = CreateIndexedPropertyName("simulation/output",Outputs.size()-1);
-    instance->Tie(outputProp+"/log_rate_hz", Output, (iOPMF)0, &FGOutput::SetRate);
+    instance->Tie(outputProp+"/log_rate_hz", Output, (iOPMF)0, &FGOutput::SetRateHz);
   }
 
   return result;
@@ -959,7 +1315,7 @@ void FGFDMExec::DoTrim(int mode)
   saved_time = sim_time;
   FGTrim trim(this, (JSBSim::TrimMode)mode);
   if ( !trim.DoTrim() ) cerr << endl << "Trim Failed" << endl << endl;
-  trim.Report();
+  if (debug_lvl > 0) trim.Report();
   sim_time = saved_time;
 }
 
@@ -1058,6 +1414,118 @@ void FGFDMExec::UseAtmosphereMars(void)
 */
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const Message& msg)
+{
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eText;
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text, bool bVal)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eBool;
+  msg.bVal = bVal;
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text, int iVal)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eInteger;
+  msg.bVal = (iVal != 0);
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text, double dVal)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eDouble;
+  msg.bVal = (dVal != 0.0);
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int FGFDMExec::SomeMessages(void)
+{
+  return !Messages.empty();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::ProcessMessage(void)
+{
+  if (Messages.empty()) return;
+  localMsg = Messages.front();
+
+  while (Messages.size() > 0) {
+      switch (localMsg.type) {
+      case JSBSim::FGJSBBase::Message::eText:
+        cout << localMsg.messageId << ": " << localMsg.text << endl;
+        break;
+      case JSBSim::FGJSBBase::Message::eBool:
+        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.bVal << endl;
+        break;
+      case JSBSim::FGJSBBase::Message::eInteger:
+        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.iVal << endl;
+        break;
+      case JSBSim::FGJSBBase::Message::eDouble:
+        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.dVal << endl;
+        break;
+      default:
+        cerr << "Unrecognized message type." << endl;
+        break;
+      }
+      Messages.pop();
+      if (Messages.size() > 0) localMsg = Messages.front();
+      else break;
+  }
+
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGJSBBase::Message* FGFDMExec::ProcessNextMessage(void)
+{
+  if (Messages.empty()) return NULL;
+  localMsg = Messages.front();
+
+  Messages.pop();
+  return &localMsg;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -52,8 +52,10 @@ INCLUDES
 #include "input_output/FGXMLFileRead.h"
 #include "models/FGPropagate.h"
 #include "math/FGColumnVector3.h"
+#include "math/FGRandom.h"
 
 #include <vector>
+#include <queue>
 #include <string>
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -70,6 +72,9 @@ namespace JSBSim {
 
 class FGScript;
 class FGTrim;
+class FGFunction;
+class FGOutputRecord;
+class FGfdmSocketBatch;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -142,7 +147,9 @@ CLASS DOCUMENTATION
     <h3>JSBSim Debugging Directives</h3>
 
     This describes to any interested entity the debug level
-    requested by setting the JSBSIM_DEBUG environment variable.
+    requested by setting the JSBSIM_DEBUG environment variable. The variable
+    is read once, when the program starts; SetDebugLevel() changes the level
+    afterwards, for all the instances.
     The bitmasked value choices are as follows:
     - <b>unset</b>: In this case (the default) JSBSim would only print
        out the normally expected messages, essentially echoing
@@ -161,12 +168,48 @@ CLASS DOCUMENTATION
     - <b>16</b>: When set various parameters are sanity checked and
        a message is printed out when they go out of bounds
 
+    <h3>Scheduling</h3>
+
+    Each model is run at its own rate and phase (see Schedule() and FGModel):
+    a model of rate N and phase P runs at the frames whose number modulo N is
+    P, and the outputs of the models that do not run at a frame are held. The
+    frames are counted from the initial conditions (the frames where the time
+    does not advance, such as those of RunIC() and of the trim, run all the
+    models and are neither counted nor timed). By
+    default every model runs at each frame. Lowering the rate of the expensive
+    models whose outputs vary slowly (the atmosphere, the mass balance, the
+    outputs, ...) and giving them different phases spreads their cost over the
+    frames instead of having them all run at the same frame.
+
+    The wall clock time spent in each model is measured at each run. From the
+    maximum time of each model, the executive computes the worst case frame
+    time: the largest total time of the models that run at a same frame, over
+    all the frames of the schedule period (the least common multiple of the
+    rates). BalanceSchedule() chooses the phases of the models of rate greater
+    than one so as to reduce it.
+
     <h3>Properties</h3>
     @property simulator/do_trim (write only) Can be set to the integer equivalent to one of
                                 tLongitudinal (0), tFull (1), tGround (2), tPullup (3),
                                 tCustom (4), tTurn (5). Setting this to a legal value
                                 (such as by a script) causes a trim to be performed. This
                                 property actually maps toa function call of DoTrim().
+    @property simulation/schedule/<model>/rate The rate of the model, in frames.
+                                <model> is the name of the model class, in lower case
+                                and without the FG prefix (atmosphere, fcs, output, ...).
+    @property simulation/schedule/<model>/phase The phase of the model, in frames.
+    @property simulation/schedule/worst-frame-time-sec (read only) The worst case frame
+                                time, computed from the maximum times of the models.
+    @property simulation/schedule/balance (write only) Setting this to a non zero value
+                                calls BalanceSchedule().
+    @property simulation/perf/<model>/last-sec, min-sec, mean-sec, max-sec, p99-sec
+                                (read only) The statistics of the wall clock times of
+                                the scheduled runs of the model (see FGTimingStats).
+    @property simulation/perf/frame/last-sec, ... The same statistics for the time
+                                spent in the models during a frame.
+    @property simulation/perf/reset (write only) Setting this to a non zero value
+                                clears the statistics (for instance once the
+                                simulation is warmed up).
 
     @author Jon S. Berndt
     @version $Revision: 1.52 $
@@ -206,7 +249,16 @@ class FGFDMExec : public FGJSBBase, public FGXMLFileRead
 
 public:
 
-  /// Default constructor
+  /** Default constructor.
+      An instance created without a property tree owns an isolated tree of its
+      own, so that any number of instances can be run side by side, also in
+      separate threads, and property lookups do not slow down as instances are
+      added. An instance given a tree (as FlightGear does, and as child FDMs
+      do with the tree of their parent) shares it with the other instances
+      attached to it. In both cases the instance is rooted at the first free
+      /fdm/jsbsim[n] node of the tree, and that node, with all the properties
+      beneath it, is removed from the tree when the instance is destroyed.
+      @param root the property tree to attach to, or 0 to create a new one */
   FGFDMExec(FGPropertyManager* root = 0);
 
   /// Default destructor
@@ -217,12 +269,50 @@ public:
       FGFDMExec::Run() method must be made before the model is executed. A
       value of 1 means that the model will be executed for each call to the
       exec's Run() method. A value of 5 means that the model will only be
-      executed every 5th call to the exec's Run() method. Use of a rate other than
-      one is at this time not recommended.
+      executed every 5th call to the exec's Run() method. The phase tells at
+      which of these calls: a model of rate 5 and phase 2 is executed at the
+      frames 2, 7, 12, ... The rate and phase can be changed later on through
+      the model, or its simulation/schedule properties.
       @param model A pointer to the model being scheduled.
       @param rate The rate at which to execute the model as described above.
-      @return Currently returns 0 always. */
-  void Schedule(FGModel* model, int rate);
+      @param phase The phase of the model, between 0 and rate-1. */
+  void Schedule(FGModel* model, int rate, int phase = 0);
+
+  /** Chooses the phases of the models of rate greater than one, so that the
+      models that run at the same frame take as little time as possible. The
+      models are placed in turn, the most expensive one first (as per their
+      mean execution time so far), at the phase that least increases the
+      largest frame time. The models of rate 1 are left untouched. */
+  void BalanceSchedule(void);
+
+  /** Returns the worst case frame time: the largest sum of the maximum
+      execution times of the models that are run at a same frame, over a period
+      of the schedule.
+      @return the time in seconds. */
+  double GetWorstFrameTime(void) const;
+
+  /// Returns the wall clock time (seconds) spent in the models during the last frame.
+  double GetFrameTime(void) const {return FrameStats.GetLast();}
+  /// Returns the statistics of the wall clock time spent in the models per frame.
+  const FGTimingStats& GetFrameStats(void) const {return FrameStats;}
+
+  /// Clears the timing statistics of the frames and of the models.
+  void ResetPerformanceStats(void);
+  /** Returns the labels of the timing statistics of the frames and of the
+      models, as written by FGOutput (performance subsystem).
+      @param delimiter the separator of the labels */
+  string GetPerformanceStrings(const string& delimiter) const;
+  /** Returns the timing statistics of the frames and of the models (mean,
+      maximum and 99th percentile, in microseconds), in the order of
+      GetPerformanceStrings().
+      @param delimiter the separator of the values */
+  string GetPerformanceValues(const string& delimiter) const;
+  /** Appends the timing statistics of the frames and of the models to an
+      output record, in the order of GetPerformanceStrings().
+      @param record the output record */
+  void GetPerformanceValues(FGOutputRecord& record) const;
+  /// Returns a table of the schedule and timing statistics of the models.
+  string GetPerformanceReport(void) const;
 
   /** This function executes each scheduled model in succession.
       @return true if successful, false if sim should be ended  */
@@ -318,6 +408,8 @@ public:
   inline FGInput* GetInput(void)              {return Input;}
   /// Returns the FGGroundCallback pointer.
   inline FGGroundCallback* GetGroundCallback(void) {return GroundCallback;}
+  /// Returns the batch the output sockets queue their packets in.
+  inline FGfdmSocketBatch* GetSocketBatch(void) {return SocketBatch;}
   /// Retrieves the script object
   inline FGScript* GetScript(void) {return Script;}
   // Returns a pointer to the FGInitialCondition object
@@ -418,6 +510,12 @@ public:
   void DisableOutput(void);
   /// Enables data logging to all outputs.
   void EnableOutput(void);
+  /** Disables data logging to all outputs until ResumeOutput() is called.
+      Unlike EnableOutput(), ResumeOutput() only re-enables the outputs that
+      were enabled when the output was suspended. */
+  void SuspendOutput(void);
+  /// Restores the outputs to the state they were in when SuspendOutput() was called.
+  void ResumeOutput(void);
   /// Pauses execution by preventing time from incrementing.
   void Hold(void) {holding = true;}
   /// Resumes execution from a "Hold".
@@ -426,7 +524,8 @@ public:
   bool Holding(void) {return holding;}
   /// Resets the initial conditions object and prepares the simulation to run again.
   void ResetToInitialConditions(void);
-  /// Sets the debug level.
+  /** Sets the debug level. The level is shared by all the instances: it must
+      not be changed while instances run in other threads. */
   void SetDebugLevel(int level) {debug_lvl = level;}
   /// Wait for some user input
   void WaitInput(void) {Input->Wait(); }
@@ -435,6 +534,43 @@ public:
   /// return stepping mode
   bool Stepping(void) {return stepping;}
 
+  ///@name JSBSim Messaging functions
+  //@{
+  /** Places a Message structure on the Message queue.
+      @param msg pointer to a Message structure
+      @return pointer to a Message structure */
+  void PutMessage(const Message& msg);
+  /** Creates a message with the given text and places it on the queue.
+      @param text message text
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text);
+  /** Creates a message with the given text and boolean value and places it on the queue.
+      @param text message text
+      @param bVal boolean value associated with the message
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text, bool bVal);
+  /** Creates a message with the given text and integer value and places it on the queue.
+      @param text message text
+      @param iVal integer value associated with the message
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text, int iVal);
+  /** Creates a message with the given text and double value and places it on the queue.
+      @param text message text
+      @param dVal double value associated with the message
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text, double dVal);
+  /** Reads the message on the queue (but does not delete it).
+      @return 1 if some messages */
+  int SomeMessages(void);
+  /** Reads the message on the queue and removes it from the queue.
+      This function also prints out the message.*/
+  void ProcessMessage(void);
+  /** Reads the next message on the queue and removes it from the queue.
+      This function also prints out the message.
+      @return a pointer to the message, or NULL if there are no messages.*/
+  Message* ProcessNextMessage(void);
+  //@}
+
   struct PropertyCatalogStructure {
     /// Name of the property.
     string base_string;
@@ -518,8 +654,39 @@ public:
   /** Retrieves the current debug level setting. */
   int GetDebugLevel(void) const {return debug_lvl;};
 
+  /** Enables or disables dirty tracking for the functions of the loaded model.
+      When enabled, a function is only re-evaluated when one of its input
+      properties has changed since its previous evaluation.
+      @param track non-zero to enable dirty tracking. */
+  void SetFunctionDirtyTracking(int track);
+  /// Returns 1 if function dirty tracking is enabled, 0 otherwise.
+  int GetFunctionDirtyTracking(void) const {return FunctionDirtyTracking;}
+  /// Returns the number of function evaluations computed during the last frame.
+  int GetFunctionsEvaluated(void) const {return FunctionsEvaluated;}
+  /// Returns the number of function evaluations skipped during the last frame.
+  int GetFunctionsSkipped(void) const {return FunctionsSkipped;}
+  /// Returns the functions owned by the models (and engines) of the loaded aircraft.
+  const vector <FGFunction*>& GetFunctions(void) const {return Functions;}
+
+  /** Restarts the random numbers of this instance (sensor noise, turbulence,
+      random functions) at the beginning of a stream. The numbers only depend
+      on the seed and the stream, so a run can be reproduced from them; the
+      runs of a batch use the same seed and their number as the stream. The
+      default is a seed of 0 and the instance ID (see GetFDMInstance()) as the
+      stream. The seed and the stream are also the properties
+      simulation/random-seed and simulation/random-stream.
+      @param seed the seed
+      @param stream the stream */
+  void SetRandomSeed(unsigned long seed, unsigned int stream) {Random.Seed(seed, stream);}
+  /// Returns the seed of the random numbers.
+  unsigned long GetRandomSeed(void) const {return Random.GetSeed();}
+  /// Returns the stream of the random numbers.
+  unsigned int GetRandomStream(void) const {return Random.GetStream();}
+  /// Returns the generator of the random numbers of this instance.
+  FGRandom& GetRandom(void) {return Random;}
+
 private:
-  static unsigned int FDMctr;
+  bool StandAlone;
   int Error;
   unsigned int Frame;
   unsigned int IdFDM;
@@ -543,10 +710,17 @@ private:
 
   bool trim_status;
   int ta_mode;
-
-  static FGPropertyManager *master;
+  int FunctionDirtyTracking;
+  int FunctionsEvaluated;
+  int FunctionsSkipped;
+  unsigned long TotalFunctionsEvaluated;
+  unsigned long TotalFunctionsSkipped;
+  FGTimingStats FrameStats;
+  unsigned int ScheduleFrame;
+  FGRandom Random;
 
   FGGroundCallback*   GroundCallback;
+  FGfdmSocketBatch*   SocketBatch;
   FGAtmosphere*       Atmosphere;
   FGFCS*              FCS;
   FGPropulsion*       Propulsion;
@@ -569,8 +743,15 @@ private:
 
   vector <string> PropertyCatalog;
   vector <FGOutput*> Outputs;
+  vector <bool> SuspendedOutputs;
   vector <childData*> ChildFDMList;
   vector <FGModel*> Models;
+  vector <string> ModelKeys;
+  vector <FGFunction*> Functions;
+
+  std::queue <Message> Messages;
+  Message localMsg;
+  unsigned int messageId;
 
   bool ReadFileHeader(Element*);
   bool ReadChild(Element*);
@@ -579,6 +760,16 @@ private:
   bool Allocate(void);
   bool DeAllocate(void);
   void Initialize(FGInitialCondition *FGIC);
+  void CountFunctionEvaluations(void);
+  void BindSchedule(FGModel* model);
+  void UnbindSchedule(void);
+  unsigned int GetSchedulePeriod(void) const;
+  void BalanceSchedule(int mode) {if (mode) BalanceSchedule();}
+  void ResetPerformanceStats(int mode) {if (mode) ResetPerformanceStats();}
+  int GetSeedProperty(void) const {return (int)Random.GetSeed();}
+  void SetSeedProperty(int seed) {Random.Seed((unsigned long)seed, Random.GetStream());}
+  int GetStreamProperty(void) const {return (int)Random.GetStream();}
+  void SetStreamProperty(int stream) {Random.Seed(Random.GetSeed(), (unsigned int)stream);}
 
   void Debug(int from);
 };
@@ -38,10 +38,19 @@ INCLUDES
 #define BASE
 
 #include "FGJSBBase.h"
+#include "math/FGRandom.h"
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
 
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
 namespace JSBSim {
 
 static const char *IdSrc = "$Id: FGJSBBase.cpp,v 1.29 2010/03/18 13:19:21 jberndt Exp $";
@@ -106,11 +115,15 @@ const double FGJSBBase::kgtoslug = 0.06852168;
 const string FGJSBBase::needed_cfg_version = "2.0";
 const string FGJSBBase::JSBSim_version = "1.0 "__DATE__" "__TIME__" (ArduPilot)";
 
-std::queue <FGJSBBase::Message> FGJSBBase::Messages;
-FGJSBBase::Message FGJSBBase::localMsg;
-unsigned int FGJSBBase::messageId = 0;
+// The debug level is read from the environment once, before any instance is
+// created: the instances of a batch run in parallel and must not write it.
+static short InitialDebugLevel(void)
+{
+  char* num = std::getenv("JSBSIM_DEBUG");
+  return num ? (short)std::atoi(num) : 1;
+}
 
-short FGJSBBase::debug_lvl  = 1;
+short FGJSBBase::debug_lvl  = InitialDebugLevel();
 
 using std::cerr;
 using std::cout;
@@ -118,114 +131,6 @@ using std::endl;
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGJSBBase::PutMessage(const Message& msg)
-{
-  Messages.push(msg);
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-void FGJSBBase::PutMessage(const string& text)
-{
-  Message msg;
-  msg.text = text;
-  msg.messageId = messageId++;
-  msg.subsystem = "FDM";
-  msg.type = Message::eText;
-  Messages.push(msg);
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-void FGJSBBase::PutMessage(const string& text, bool bVal)
-{
-  Message msg;
-  msg.text = text;
-  msg.messageId = messageId++;
-  msg.subsystem = "FDM";
-  msg.type = Message::eBool;
-  msg.bVal = bVal;
-  Messages.push(msg);
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-void FGJSBBase::PutMessage(const string& text, int iVal)
-{
-  Message msg;
-  msg.text = text;
-  msg.messageId = messageId++;
-  msg.subsystem = "FDM";
-  msg.type = Message::eInteger;
-  msg.bVal = (iVal != 0);
-  Messages.push(msg);
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-void FGJSBBase::PutMessage(const string& text, double dVal)
-{
-  Message msg;
-  msg.text = text;
-  msg.messageId = messageId++;
-  msg.subsystem = "FDM";
-  msg.type = Message::eDouble;
-  msg.bVal = (dVal != 0.0);
-  Messages.push(msg);
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-int FGJSBBase::SomeMessages(void)
-{
-  return !Messages.empty();
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-void FGJSBBase::ProcessMessage(void)
-{
-  if (Messages.empty()) return;
-  localMsg = Messages.front();
-
-  while (Messages.size() > 0) {
-      switch (localMsg.type) {
-      case JSBSim::FGJSBBase::Message::eText:
-        cout << localMsg.messageId << ": " << localMsg.text << endl;
-        break;
-      case JSBSim::FGJSBBase::Message::eBool:
-        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.bVal << endl;
-        break;
-      case JSBSim::FGJSBBase::Message::eInteger:
-        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.iVal << endl;
-        break;
-      case JSBSim::FGJSBBase::Message::eDouble:
-        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.dVal << endl;
-        break;
-      default:
-        cerr << "Unrecognized message type." << endl;
-        break;
-      }
-      Messages.pop();
-      if (Messages.size() > 0) localMsg = Messages.front();
-      else break;
-  }
-
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
-FGJSBBase::Message* FGJSBBase::ProcessNextMessage(void)
-{
-  if (Messages.empty()) return NULL;
-  localMsg = Messages.front();
-
-  Messages.pop();
-  return &localMsg;
-}
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
 void FGJSBBase::disableHighLighting(void) {
   highint[0]='\0';
   halfint[0]='\0';
@@ -251,31 +156,65 @@ string FGJSBBase::CreateIndexedPropertyName(const string& Property, int index)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double FGJSBBase::GaussianRandomNumber(void)
+#if defined(_MSC_VER) || defined(__MINGW32__)
+double FGJSBBase::GetMonotonicSeconds(void)
 {
-  static double V1, V2, S;
-  static int phase = 0;
-  double X;
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+#else
+double FGJSBBase::GetMonotonicSeconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+#endif
 
-  if (phase == 0) {
-    V1 = V2 = S = X = 0.0;
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-    do {
-      double U1 = (double)rand() / RAND_MAX;
-      double U2 = (double)rand() / RAND_MAX;
+// The generator is set per thread, so that FDM instances run on different
+// threads (see FGBatchRunner) each draw from their own.
+#if defined(_MSC_VER)
+#  define JSBSIM_THREAD_LOCAL __declspec(thread)
+#else
+#  define JSBSIM_THREAD_LOCAL __thread
+#endif
 
-      V1 = 2 * U1 - 1;
-      V2 = 2 * U2 - 1;
-      S = V1 * V1 + V2 * V2;
-    } while(S >= 1 || S == 0);
+static JSBSIM_THREAD_LOCAL FGRandom* CurrentRandom = 0;
 
-    X = V1 * sqrt(-2 * log(S) / S);
-  } else
-    X = V2 * sqrt(-2 * log(S) / S);
+// The generator of a thread when no FDM instance has set one. It is created on
+// first use, and lives as long as the program.
+static FGRandom* DefaultRandom(void)
+{
+  static JSBSIM_THREAD_LOCAL FGRandom* generator = 0;
+  if (generator == 0) generator = new FGRandom;
+  return generator;
+}
 
-  phase = 1 - phase;
+FGRandom* FGJSBBase::SetRandomGenerator(FGRandom* generator)
+{
+  FGRandom* previous = CurrentRandom;
+  CurrentRandom = generator;
+  return previous;
+}
 
-  return X;
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGJSBBase::GaussianRandomNumber(void)
+{
+  FGRandom* generator = CurrentRandom ? CurrentRandom : DefaultRandom();
+  return generator->GetGaussian();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGJSBBase::UniformRandomNumber(void)
+{
+  FGRandom* generator = CurrentRandom ? CurrentRandom : DefaultRandom();
+  return generator->GetUniform();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
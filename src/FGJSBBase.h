@@ -39,7 +39,6 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <float.h>
-#include <queue>
 #include <string>
 #include <cmath>
 
@@ -71,6 +70,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGRandom;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -116,6 +117,10 @@ public:
     public: Filter(void) {}
     public: Filter(double coeff, double dt) {
       prev_in = prev_out = 0.0;
+      SetCoefficients(coeff, dt);
+    }
+    /// Changes the coefficients (e.g. for a new time step), keeping the state.
+    public: void SetCoefficients(double coeff, double dt) {
       double denom = 2.0 + coeff*dt;
       ca = coeff*dt/denom;
       cb = (2.0 - coeff*dt)/denom;
@@ -154,43 +159,6 @@ public:
   static char fgdef[6];
   //@}
 
-  ///@name JSBSim Messaging functions
-  //@{
-  /** Places a Message structure on the Message queue.
-      @param msg pointer to a Message structure
-      @return pointer to a Message structure */
-  void PutMessage(const Message& msg);
-  /** Creates a message with the given text and places it on the queue.
-      @param text message text
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text);
-  /** Creates a message with the given text and boolean value and places it on the queue.
-      @param text message text
-      @param bVal boolean value associated with the message
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text, bool bVal);
-  /** Creates a message with the given text and integer value and places it on the queue.
-      @param text message text
-      @param iVal integer value associated with the message
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text, int iVal);
-  /** Creates a message with the given text and double value and places it on the queue.
-      @param text message text
-      @param dVal double value associated with the message
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text, double dVal);
-  /** Reads the message on the queue (but does not delete it).
-      @return 1 if some messages */
-  int SomeMessages(void);
-  /** Reads the message on the queue and removes it from the queue.
-      This function also prints out the message.*/
-  void ProcessMessage(void);
-  /** Reads the next message on the queue and removes it from the queue.
-      This function also prints out the message.
-      @return a pointer to the message, or NULL if there are no messages.*/
-  Message* ProcessNextMessage(void);
-  //@}
-
   /** Returns the version number of JSBSim.
   *   @return The version number of JSBSim. */
   std::string GetVersion(void) {return JSBSim_version;}
@@ -305,15 +273,21 @@ public:
   
   static double sign(double num) {return num>=0.0?1.0:-1.0;}
 
-protected:
-  static Message localMsg;
+  /** Returns the time in seconds of a monotonic clock, to measure the wall
+      clock time spent in the code (for instance by the models). The origin is
+      arbitrary: only differences between two values are meaningful. */
+  static double GetMonotonicSeconds(void);
 
-  static std::queue <Message> Messages;
+  /** Sets the generator the random numbers of the calling thread are drawn
+      from (see GaussianRandomNumber()). FGFDMExec sets its own while it runs,
+      so that each instance has its own, reproducible, random numbers.
+      @param generator the generator, or 0 for the default one of the thread
+      @return the generator that was set before */
+  static FGRandom* SetRandomGenerator(FGRandom* generator);
 
+protected:
   void Debug(int) {};
 
-  static unsigned int messageId;
-
   static const double radtodeg;
   static const double degtorad;
   static const double hptoftlbssec;
@@ -337,7 +311,10 @@ protected:
 
   static std::string CreateIndexedPropertyName(const std::string& Property, int index);
 
+  /// Returns a normally distributed random number (mean 0, variance 1).
   static double GaussianRandomNumber(void);
+  /// Returns a uniformly distributed random number in [0, 1).
+  static double UniformRandomNumber(void);
 
 public:
 /// Moments L, M, N
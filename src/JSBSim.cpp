@@ -40,6 +40,8 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include "FGFDMExec.h"
+#include "models/FGInertial.h"
+#include "input_output/FGDEMGroundCallback.h"
 //#include <initialization/FGTrimAnalysis.h>
 
 #if !defined(__GNUC__) && !defined(sgi) && !defined(_MSC_VER)
@@ -81,6 +83,7 @@ string ScriptName;
 string AircraftName;
 string ResetName;
 string LogOutputName;
+string TerrainDir;
 vector <string> LogDirectiveName;
 vector <string> CommandLineProperties;
 vector <double> CommandLinePropertyValues;
@@ -293,6 +296,13 @@ int main(int argc, char* argv[])
 
   if (override_sim_rate) override_sim_rate_value = FDMExec->GetDeltaT();
 
+  if (!TerrainDir.empty()) {
+    JSBSim::FGInertial* Inertial = FDMExec->GetInertial();
+    FDMExec->SetGroundCallback(new JSBSim::FGDEMGroundCallback(TerrainDir,
+                                 Inertial->GetRefRadius(), Inertial->GetSemimajor(),
+                                 Inertial->GetSemiminor()));
+  }
+
   // *** OPTION A: LOAD A SCRIPT, WHICH LOADS EVERYTHING ELSE *** //
   if (!ScriptName.empty()) {
 
@@ -533,6 +543,13 @@ bool options(int count, char **arg)
         gripe;
         exit(1);
       }
+    } else if (keyword == "--terrain") {
+      if (n != string::npos) {
+        TerrainDir = value;
+      } else {
+        gripe;
+        exit(1);
+      }
     } else if (keyword == "--aircraft") {
       if (n != string::npos) {
         AircraftName = value;
@@ -635,6 +652,8 @@ void PrintHelp(void)
     cout << "    --logdirectivefile=<filename>  specifies the name of a data logging directives file" << endl;
     cout << "                                   (can appear multiple times)" << endl;
     cout << "    --root=<path>  specifies the JSBSim root directory (where aircraft/, engine/, etc. reside)" << endl;
+    cout << "    --terrain=<path>  specifies a directory of SRTM terrain tiles (.hgt) for the ground" << endl;
+    cout << "                      (geoid undulations in meters are read from <path>/geoid.txt)" << endl;
     cout << "    --aircraft=<filename>  specifies the name of the aircraft to be modeled" << endl;
     cout << "    --script=<filename>  specifies a script to run" << endl;
     cout << "    --realtime  specifies to run in actual real world time" << endl;
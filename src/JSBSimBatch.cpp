@@ -0,0 +1,235 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       JSBSimBatch.cpp
+ Date started: 10/16/26
+ Purpose:      Runs a script many times with dispersed properties.
+ Called by:    The USER.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+JSBSimBatch is the command line front end of FGBatchRunner: it runs a script a
+number of times, with the properties listed in a dispersions file perturbed,
+on a number of threads, and writes the sampled output properties of all the
+runs to one CSV file. For example (from the JSBSim root directory):
+
+  JSBSimBatch --script=scripts/c172_cruise_8K.xml --dispersions=dispersions.xml
+              --runs=1000 --threads=8 --out=c172_cruise_8K_mc.csv
+
+HISTORY
+--------------------------------------------------------------------------------
+10/16/26         Created
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGBatchRunner.h"
+
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+GLOBAL DATA
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+string RootDir = "";
+string ScriptName = "";
+string DispersionsName = "";
+string OutputName = "batch.csv";
+vector <string> OutputProperties;
+unsigned int runs = 1;
+unsigned int threads = 1;
+unsigned long seed = 1;
+double rate = -1.0;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+bool options(int, char**);
+void PrintHelp(void);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+int main(int argc, char* argv[])
+{
+  if (!options(argc, argv)) {
+    PrintHelp();
+    exit(-1);
+  }
+
+  JSBSim::FGBatchRunner runner;
+  runner.SetRootDir(RootDir);
+  runner.SetScript(ScriptName);
+  runner.SetRuns(runs);
+  runner.SetThreads(threads);
+  runner.SetSeed(seed);
+
+  if (!DispersionsName.empty() && !runner.LoadDispersions(DispersionsName)) {
+    cerr << "Dispersions file " << DispersionsName << " was not successfully loaded" << endl;
+    exit(-1);
+  }
+
+  // Command line settings come on top of those of the dispersions file.
+  for (unsigned int i=0; i<OutputProperties.size(); i++)
+    runner.AddOutputProperty(OutputProperties[i]);
+  if (rate >= 0.0) runner.SetOutputRate(rate);
+
+  cout << "Running " << runs << " simulations of " << ScriptName << " on "
+       << threads << " thread(s)" << endl;
+
+  bool result = runner.Run();
+
+  cout << "Elapsed time: " << runner.GetElapsedTime() << " seconds, "
+       << runner.GetNumSamples() << " samples" << endl;
+  if (!result) cerr << runner.GetNumFailed() << " run(s) failed" << endl;
+
+  if (!runner.WriteCSV(OutputName)) exit(-1);
+
+  return result ? 0 : 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool options(int count, char **arg)
+{
+  bool result = true;
+
+  if (count == 1) {
+    PrintHelp();
+    exit(0);
+  }
+
+#define gripe cerr << "Option '" << keyword 	\
+	<< "' requires a value, as in '"	\
+	<< keyword << "=something'" << endl << endl;/**/
+
+  for (int i=1; i<count; i++) {
+    string argument = string(arg[i]);
+    string keyword(argument);
+    string value("");
+    string::size_type n=argument.find("=");
+    if (n != string::npos && n > 0) {
+      keyword = argument.substr(0, n);
+      value = argument.substr(n+1);
+    }
+
+    if (keyword == "--help") {
+      PrintHelp();
+      exit(0);
+    } else if (keyword == "--root") {
+      if (n != string::npos) {
+        RootDir = value;
+        if (RootDir[RootDir.length()-1] != '/') {
+          RootDir += '/';
+        }
+      } else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--script") {
+      if (n != string::npos) ScriptName = value;
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--dispersions") {
+      if (n != string::npos) DispersionsName = value;
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--out") {
+      if (n != string::npos) OutputName = value;
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--property") {
+      if (n != string::npos) OutputProperties.push_back(value);
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--runs") {
+      if (n != string::npos) runs = atoi(value.c_str());
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--threads") {
+      if (n != string::npos) threads = atoi(value.c_str());
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--seed") {
+      if (n != string::npos) seed = strtoul(value.c_str(), 0, 10);
+      else {
+        gripe;
+        result = false;
+      }
+    } else if (keyword == "--rate") {
+      if (n != string::npos) rate = atof(value.c_str());
+      else {
+        gripe;
+        result = false;
+      }
+    } else {
+      cerr << endl << "  Parameter: " << argument << " not understood" << endl;
+      result = false;
+    }
+  }
+
+  if (ScriptName.empty()) {
+    cerr << "  A script must be given" << endl;
+    result = false;
+  }
+
+  if (threads < 1) threads = 1;
+
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PrintHelp(void)
+{
+  cout << endl << "  Usage: JSBSimBatch <options>" << endl << endl;
+  cout << "  options:" << endl;
+    cout << "    --help  returns this message" << endl;
+    cout << "    --root=<path>  specifies the JSBSim root directory (where aircraft/, engine/, etc. reside)" << endl;
+    cout << "    --script=<filename>  specifies the script that is run" << endl;
+    cout << "    --dispersions=<filename>  specifies the dispersions (and output properties) file" << endl;
+    cout << "    --runs=<count>  specifies the number of simulations" << endl;
+    cout << "    --threads=<count>  specifies the number of simulations run at the same time" << endl;
+    cout << "    --seed=<number>  specifies the seed of the random dispersions" << endl;
+    cout << "    --property=<name>  adds a property to the output (can appear multiple times)" << endl;
+    cout << "    --rate=<rate (double)>  specifies the output rate in Hz (0 for every frame)" << endl;
+    cout << "    --out=<filename>  specifies the CSV file the results are written to" << endl << endl;
+
+  cout << "  NOTE: There can be no spaces around the = sign when" << endl;
+  cout << "        an option is followed by a filename" << endl << endl;
+}
@@ -241,7 +241,7 @@ bool FGTrim::DoTrim(void) {
     fdmex->GetGroundReactions()->GetGearUnit(i)->SetReport(false);
   }
 
-  fdmex->DisableOutput();
+  fdmex->SuspendOutput();
 
   setEngineTrimMode(true);
 
@@ -361,7 +361,7 @@ bool FGTrim::DoTrim(void) {
     fdmex->GetGroundReactions()->GetGearUnit(i)->SetReport(true);
   }
   setEngineTrimMode(false);
-  fdmex->EnableOutput();
+  fdmex->ResumeOutput();
 
   time_trimDone = std::clock();
   std::cout << "\ntrim computation time: " << 
@@ -0,0 +1,537 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGDEMGroundCallback.cpp
+ Date started: October 16 2026
+ Purpose:      Ground callback for a digital elevation model
+ Called by:    FGLGear, FGPropagate, FGGroundReactions
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+This class answers the ground queries from a directory of SRTM tiles, which it
+maps in memory and keeps in a cache of the most recently used tiles.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include "FGDEMGroundCallback.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  #include <windows.h>
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #include <sys/types.h>
+  #include <sys/stat.h>
+  #include <sys/mman.h>
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::max;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGDEMGroundCallback.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_DEMGROUNDCALLBACK;
+
+// The elevation of a void sample
+static const int VoidSample = -32768;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGDEMGroundCallback::FGDEMGroundCallback(const string& directory,
+                                         double ReferenceRadius,
+                                         double semimajor, double semiminor,
+                                         unsigned int maxTiles)
+  : FGGroundCallback(ReferenceRadius)
+{
+  Directory = directory;
+  a = semimajor;
+  b = semiminor;
+  e2 = 1.0 - b*b/(a*a);
+  MaxTiles = maxTiles > 0 ? maxTiles : 1;
+  UseCount = 0;
+  TilesLoaded = 0;
+  DefaultUndulation = 0.0;
+
+  LoadGeoid();
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGDEMGroundCallback::~FGDEMGroundCallback()
+{
+  std::map <int, Tile>::iterator it;
+  for (it = Tiles.begin(); it != Tiles.end(); ++it) UnmapTile(it->second);
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGDEMGroundCallback::GetAGLevel(double t, const FGLocation& loc,
+                                       FGLocation& contact, FGColumnVector3& normal,
+                                       FGColumnVector3& vel) const
+{
+  const Tile* tile = 0;
+  int tileLat = 0, tileLon = 0;
+  return Query(t, loc, contact, normal, vel, tile, tileLat, tileLon);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The tile of a query is kept for the next one, which is looked up again only
+// if it is in another tile.
+
+void FGDEMGroundCallback::GetAGLevels(double t, unsigned int count,
+                                      const FGLocation* loc, double* agl,
+                                      FGLocation* contact, FGColumnVector3* normal,
+                                      FGColumnVector3* vel) const
+{
+  const Tile* tile = 0;
+  int tileLat = 0, tileLon = 0;
+  for (unsigned int i=0; i<count; i++)
+    agl[i] = Query(t, loc[i], contact[i], normal[i], vel[i], tile, tileLat, tileLon);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The tiles that are mapped take the new undulation at once.
+
+void FGDEMGroundCallback::SetGeoidUndulation(double undulation)
+{
+  DefaultUndulation = undulation / fttom;
+
+  std::map <int, Tile>::iterator it;
+  for (it = Tiles.begin(); it != Tiles.end(); ++it)
+    if (Undulations.find(it->first) == Undulations.end())
+      SetTileUndulation(it->first, DefaultUndulation);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGDEMGroundCallback::SetGeoidUndulation(int lat, int lon, double undulation)
+{
+  int key = TileKey(lat, lon);
+  Undulations[key] = undulation / fttom;
+  SetTileUndulation(key, Undulations[key]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGDEMGroundCallback::SetTileUndulation(int key, double undulation)
+{
+  std::map <int, Tile>::iterator it = Tiles.find(key);
+  if (it == Tiles.end()) return;
+
+  Tile& tile = it->second;
+  tile.maxElevation += undulation - tile.undulation;
+  tile.undulation = undulation;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGDEMGroundCallback::GetUndulation(int lat, int lon) const
+{
+  std::map <int, double>::const_iterator it = Undulations.find(TileKey(lat, lon));
+  return it != Undulations.end() ? it->second : DefaultUndulation;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Reads geoid.txt from the tile directory, if there is one: "default" or the
+// name of a tile (N37W122), then the undulation in meters, per line.
+
+void FGDEMGroundCallback::LoadGeoid(void)
+{
+  string path = Directory + "/geoid.txt";
+  std::ifstream file(path.c_str());
+  if (!file) {
+    cerr << "No geoid.txt in " << Directory << ": the terrain elevations are"
+         << " taken as heights above the ellipsoid, not the geoid" << endl;
+    return;
+  }
+
+  string line;
+  int number = 0;
+  while (std::getline(file, line)) {
+    number++;
+    string::size_type hash = line.find('#');
+    if (hash != string::npos) line.erase(hash);
+
+    std::istringstream words(line);
+    string name;
+    double undulation;
+    if (!(words >> name)) continue;
+    if (!(words >> undulation)) {
+      cerr << path << ":" << number << ": no undulation for " << name << endl;
+      continue;
+    }
+
+    char ns, ew;
+    int lat, lon;
+    if (name == "default") {
+      SetGeoidUndulation(undulation);
+    } else if (sscanf(name.c_str(), "%c%2d%c%3d", &ns, &lat, &ew, &lon) == 4
+               && (ns == 'N' || ns == 'S') && (ew == 'E' || ew == 'W')) {
+      SetGeoidUndulation(ns == 'S' ? -lat : lat, ew == 'W' ? -lon : lon, undulation);
+    } else {
+      cerr << path << ":" << number << ": unknown tile " << name << endl;
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A point at a height h above the ellipsoid is at most h farther from the
+// center of the earth than the point of the ellipsoid below it, which is the
+// farthest at the latitude nearest to the equator. The radii of curvature of
+// the ellipsoid are at least a(1-e2), which bounds the angles that the
+// distance spans.
+
+double FGDEMGroundCallback::GetMaxTerrainGeoCentRadius(const FGLocation& loc,
+                                                       double distance) const
+{
+  FGLocation geo(loc);
+  geo.SetEllipse(a, b);
+  double lat = geo.GetGeodLatitudeDeg();
+  double lon = geo.GetLongitudeDeg();
+
+  double dlat = 1.01*distance/(a*(1.0 - e2))*radtodeg;
+  double south = lat - dlat, north = lat + dlat;
+  if (south <= -89.0 || north >= 89.0) return HUGE_VAL;
+  double dlon = dlat/cos(max(fabs(south), fabs(north))*degtorad);
+
+  int s = (int)floor(south), n = (int)floor(north);
+  int w = (int)floor(lon - dlon), e = (int)floor(lon + dlon);
+  if (n - s > 1 || e - w > 1) return HUGE_VAL;
+
+  double maxElevation = 0.0;
+  for (int ilat = s; ilat <= n; ilat++) {
+    for (int ilon = w; ilon <= e; ilon++) {
+      const Tile* tile = FindTile(ilat, ilon < -180 ? ilon + 360 : ilon > 179 ? ilon - 360 : ilon);
+      maxElevation = max(maxElevation, tile->maxElevation);
+    }
+  }
+
+  double phi = (south > 0.0 ? south : north < 0.0 ? north : 0.0)*degtorad;
+  double sinPhi = sin(phi), cosPhi = cos(phi);
+  double RN = a/sqrt(1.0 - e2*sinPhi*sinPhi);
+  double radius = sqrt(RN*cosPhi*RN*cosPhi
+                       + (1.0 - e2)*RN*sinPhi*(1.0 - e2)*RN*sinPhi);
+
+  return radius + maxElevation;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The undulation is that of the tile, which need not be mapped for it.
+
+bool FGDEMGroundCallback::GetSeaLevelRadius(const FGLocation& loc,
+                                            double& radius) const
+{
+  FGLocation geo(loc);
+  geo.SetEllipse(a, b);
+  double lat = geo.GetGeodLatitudeDeg();
+  double lon = geo.GetLongitudeDeg();
+
+  int ilat = (int)floor(lat);
+  int ilon = (int)floor(lon);
+  if (ilat > 89) ilat = 89;
+  if (ilon > 179) ilon = 179;
+  double undulation = GetUndulation(ilat, ilon);
+
+  double sinLat = sin(lat*degtorad), cosLat = cos(lat*degtorad);
+  double RN = a/sqrt(1.0 - e2*sinLat*sinLat);
+  double horizontal = (RN + undulation)*cosLat;
+  double vertical = ((1.0 - e2)*RN + undulation)*sinLat;
+  radius = sqrt(horizontal*horizontal + vertical*vertical);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The height above ground is measured along the normal to the ellipsoid, from
+// the point of the ground below the location.
+
+double FGDEMGroundCallback::Query(double /*t*/, const FGLocation& loc,
+                                  FGLocation& contact, FGColumnVector3& normal,
+                                  FGColumnVector3& vel, const Tile*& tile,
+                                  int& tileLat, int& tileLon) const
+{
+  FGLocation geo(loc);
+  geo.SetEllipse(a, b);
+  double lat = geo.GetGeodLatitudeDeg();
+  double lon = geo.GetLongitudeDeg();
+
+  int ilat = (int)floor(lat);
+  int ilon = (int)floor(lon);
+  if (ilat > 89) ilat = 89;
+  if (ilon > 179) ilon = 179;
+
+  if (tile == 0 || ilat != tileLat || ilon != tileLon) {
+    tile = FindTile(ilat, ilon);
+    tileLat = ilat;
+    tileLon = ilon;
+  }
+
+  // Where there is no tile, or no valid sample around the location, the
+  // ground is sea level: the geoid, at the undulation of the tile above the
+  // ellipsoid. SRTM has no tile over the ocean.
+  double elevation = tile->undulation;
+  double dhdEast = 0.0, dhdNorth = 0.0;
+
+  double latRad = lat*degtorad, lonRad = lon*degtorad;
+  double sinLat = sin(latRad), cosLat = cos(latRad);
+  double sinLon = sin(lonRad), cosLon = cos(lonRad);
+  double w = 1.0 - e2*sinLat*sinLat;
+  double RN = a/sqrt(w);             // prime vertical radius of curvature
+
+  if (tile->data != 0) {
+    // The cell of the grid around the location: the rows go south and the
+    // columns east.
+    unsigned int last = tile->samples - 1;
+    double x = (lon - ilon)*last;
+    double y = (ilat + 1 - lat)*last;
+    unsigned int col = x > 0.0 ? (unsigned int)x : 0;
+    unsigned int row = y > 0.0 ? (unsigned int)y : 0;
+    if (col > last - 1) col = last - 1;
+    if (row > last - 1) row = last - 1;
+    double fx = x - col;
+    double fy = y - row;
+
+    // The samples at the north west, north east, south west and south east
+    // corners. A void takes the mean of the others.
+    double h[4];
+    const unsigned char* p[4];
+    p[0] = tile->data + 2*(row*tile->samples + col);
+    p[1] = p[0] + 2;
+    p[2] = p[0] + 2*tile->samples;
+    p[3] = p[2] + 2;
+    bool valid[4];
+    double sum = 0.0;
+    int nvalid = 0;
+    for (int i=0; i<4; i++) {
+      int sample = (short)((p[i][0] << 8) | p[i][1]);
+      valid[i] = sample != VoidSample;
+      h[i] = sample / fttom;
+      if (valid[i]) {
+        sum += h[i];
+        nvalid++;
+      }
+    }
+
+    if (nvalid > 0) {
+      for (int i=0; i<4; i++) if (!valid[i]) h[i] = sum / nvalid;
+
+      // The samples are above the geoid, the ground above the ellipsoid
+      elevation += h[0]*(1.0-fx)*(1.0-fy) + h[1]*fx*(1.0-fy)
+                 + h[2]*(1.0-fx)*fy + h[3]*fx*fy;
+      double dhdx = (h[1]-h[0])*(1.0-fy) + (h[3]-h[2])*fy;
+      double dhdy = (h[2]-h[0])*(1.0-fx) + (h[3]-h[1])*fx;
+
+      // The slopes, from the size of a cell on the ellipsoid
+      double RM = RN*(1.0 - e2)/w;   // meridian radius of curvature
+      double cell = degtorad/last;
+      dhdEast = cosLat > 1e-9 ? dhdx/(cell*RN*cosLat) : 0.0;
+      dhdNorth = -dhdy/(cell*RM);
+    }
+  }
+
+  FGColumnVector3 up(cosLat*cosLon, cosLat*sinLon, sinLat);
+  FGColumnVector3 north(-sinLat*cosLon, -sinLat*sinLon, cosLat);
+  FGColumnVector3 east(-sinLon, cosLon, 0.0);
+  normal = up - dhdNorth*north - dhdEast*east;
+  normal.Normalize();
+
+  contact = FGColumnVector3((RN + elevation)*cosLat*cosLon,
+                            (RN + elevation)*cosLat*sinLon,
+                            ((1.0 - e2)*RN + elevation)*sinLat);
+  vel = FGColumnVector3(0.0, 0.0, 0.0);
+
+  return geo.GetGeodAltitude() - elevation;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const FGDEMGroundCallback::Tile* FGDEMGroundCallback::FindTile(int lat, int lon) const
+{
+  int key = TileKey(lat, lon);
+  std::map <int, Tile>::iterator it = Tiles.find(key);
+
+  if (it == Tiles.end()) {
+    if (Tiles.size() >= MaxTiles) {
+      std::map <int, Tile>::iterator oldest = Tiles.begin();
+      for (std::map <int, Tile>::iterator i = Tiles.begin(); i != Tiles.end(); ++i)
+        if (i->second.lastUsed < oldest->second.lastUsed) oldest = i;
+      UnmapTile(oldest->second);
+      Tiles.erase(oldest);
+    }
+    Tile tile;
+    MapTile(lat, lon, tile);
+    it = Tiles.insert(std::make_pair(key, tile)).first;
+  }
+
+  it->second.lastUsed = ++UseCount;
+  return &it->second;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The tile is left unmapped (data = 0) if it is missing or not valid: its
+// ground is then the geoid, at its undulation.
+
+bool FGDEMGroundCallback::MapTile(int lat, int lon, Tile& tile) const
+{
+  tile.data = 0;
+  tile.size = 0;
+  tile.samples = 0;
+  tile.undulation = GetUndulation(lat, lon);
+  tile.maxElevation = tile.undulation;
+  tile.lastUsed = 0;
+
+  std::ostringstream name;
+  name << Directory << '/' << std::setfill('0')
+       << (lat < 0 ? 'S' : 'N') << std::setw(2) << abs(lat)
+       << (lon < 0 ? 'W' : 'E') << std::setw(3) << abs(lon) << ".hgt";
+  string path = name.str();
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  tile.file = 0;
+  tile.mapping = 0;
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  tile.size = GetFileSize(file, NULL);
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping != NULL) {
+    tile.data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (tile.data == 0) CloseHandle(mapping);
+  }
+  if (tile.data == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  tile.file = file;
+  tile.mapping = mapping;
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    tile.size = st.st_size;
+    void* mapping = mmap(0, tile.size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping != MAP_FAILED) tile.data = (const unsigned char*)mapping;
+  }
+  close(fd);  // The mapping stays valid
+  if (tile.data == 0) return false;
+#endif
+
+  unsigned int samples = (unsigned int)(sqrt(tile.size/2.0) + 0.5);
+  if (samples < 2 || 2*(size_t)samples*samples != tile.size) {
+    cerr << "The terrain tile " << path << " is not a square grid of 16 bit samples" << endl;
+    UnmapTile(tile);
+    return false;
+  }
+  tile.samples = samples;
+  int highest = 0;
+  for (size_t i = 0; i < tile.size; i += 2) {
+    int sample = (short)((tile.data[i] << 8) | tile.data[i+1]);
+    if (sample > highest) highest = sample;
+  }
+  tile.maxElevation = highest / fttom + tile.undulation;
+  TilesLoaded++;
+
+  if (debug_lvl > 0) cout << "Mapped the terrain tile " << path << endl;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGDEMGroundCallback::UnmapTile(Tile& tile) const
+{
+  if (tile.data == 0) return;
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  UnmapViewOfFile(tile.data);
+  CloseHandle(tile.mapping);
+  CloseHandle(tile.file);
+#else
+  munmap((void*)tile.data, tile.size);
+#endif
+  tile.data = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGDEMGroundCallback::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 0) { // Constructor
+      cout << "Terrain tiles read from " << Directory << " (" << MaxTiles
+           << " tiles cached)" << endl;
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGDEMGroundCallback" << endl;
+    if (from == 1) cout << "Destroyed:    FGDEMGroundCallback" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
@@ -0,0 +1,195 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGDEMGroundCallback.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGDEMGROUNDCALLBACK_H
+#define FGDEMGROUNDCALLBACK_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <map>
+#include <cstddef>
+#include "FGGroundCallback.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_DEMGROUNDCALLBACK "$Id: FGDEMGroundCallback.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A ground callback that reads the elevation of the terrain from a digital
+    elevation model. The model is a directory of tiles in the SRTM "height"
+    format: a tile covers one degree of latitude by one degree of longitude
+    and is named after its south west corner, N37W122.hgt for instance. It
+    holds a square grid of big endian 16 bit integers, the elevations in
+    meters, row after row from the north edge to the south edge, each row
+    going from the west edge to the east edge; the edges of neighbour tiles
+    are repeated. The size of the grid is found from the size of the file
+    (1201 x 1201 samples for 3 arc seconds, 3601 x 3601 for 1 arc second).
+
+    <b>The datum of the elevations.</b> The SRTM samples are heights above the
+    EGM96 geoid (mean sea level), while the ground is placed on the WGS84
+    ellipsoid. The two differ by the geoid undulation, which is up to about
+    +/-100 m, and which this class cannot compute: it must be given, or the
+    ground is off by that much (the samples are then taken as heights above
+    the ellipsoid). The undulation of a tile is added to each of its samples;
+    a tile takes the default undulation if it has none of its own. They are
+    set with SetGeoidUndulation(), or read from the file geoid.txt of the tile
+    directory when it exists, one entry per line, in meters:
+@code
+    # The undulation of the tiles not listed
+    default 20
+    N37W122 -32.5
+    S17W069 45.1
+@endcode
+    A single undulation per tile is an approximation: the geoid varies by up
+    to a few meters across a tile (much more in mountainous regions), which is
+    the precision to expect at the runway.
+
+    The tiles are mapped in memory (mmap(), or a file mapping on Windows) when
+    they are first needed, and kept in a cache of a given number of tiles: the
+    tile that was the least recently used is unmapped to make room for a new
+    one. A tile that is missing is remembered as such, and there the ground is
+    sea level, the geoid at the undulation of the tile (SRTM has no tile over
+    the ocean), as it is where no sample around the location is valid (-32768
+    is a void). The reference radius is not used for the ground.
+
+    <b>The altitude above sea level.</b> The sea level is also the geoid:
+    FGPropagate asks for it (see GetSeaLevelRadius()), so that the altitude
+    above sea level (position/h-sl-ft), and the altitude of the initial
+    conditions, are measured from the geoid below the aircraft, not from the
+    sphere of the reference radius, which is thousands of feet off the
+    ellipsoid away from the equator. The ground is that of the tiles only: the
+    terrain elevation of the initial conditions, and setting
+    position/terrain-elevation-asl-ft, have no effect on it, so initial
+    conditions should give the altitude above sea level rather than above
+    ground.
+
+    The elevation, and the normal to the ground, are those of the bilinear
+    interpolation of the four samples around the location. The ground does
+    not move: its velocity is zero. The gear units of a frame, which are
+    queried at once (see GetAGLevels()), share the lookup of the tile they
+    are in. The highest sample of a tile is found when it is mapped: it
+    bounds the ground around the aircraft (see GetMaxTerrainGeoCentRadius()),
+    for the tiles it spans; near the poles there is no bound.
+    @version "$Id: FGDEMGroundCallback.h,v 1.0 2026/10/16 00:00:00 $"
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGDEMGroundCallback : public FGGroundCallback
+{
+public:
+  /** Constructor
+      @param directory the directory of the tiles
+      @param ReferenceRadius the reference radius (see FGGroundCallback)
+      @param semimajor the semimajor axis of the ellipsoid in feet
+      @param semiminor the semiminor axis of the ellipsoid in feet
+      @param maxTiles the number of tiles kept mapped */
+  FGDEMGroundCallback(const std::string& directory, double ReferenceRadius,
+                      double semimajor, double semiminor,
+                      unsigned int maxTiles = 16);
+  /// Unmaps the tiles.
+  ~FGDEMGroundCallback();
+
+  double GetAGLevel(double t, const FGLocation& l, FGLocation& cont,
+                    FGColumnVector3& n, FGColumnVector3& v) const;
+  void GetAGLevels(double t, unsigned int count, const FGLocation* l,
+                   double* agl, FGLocation* cont, FGColumnVector3* n,
+                   FGColumnVector3* v) const;
+  double GetMaxTerrainGeoCentRadius(const FGLocation& l, double distance) const;
+  /** Returns the radius of the geoid below a location: the ellipsoid raised
+      by the undulation of the tile. */
+  bool GetSeaLevelRadius(const FGLocation& l, double& radius) const;
+
+  /** Sets the geoid undulation of the tiles that have none of their own.
+      @param undulation the height of the geoid above the ellipsoid in meters */
+  void SetGeoidUndulation(double undulation);
+  /** Sets the geoid undulation of a tile.
+      @param lat the latitude of the south west corner of the tile in degrees
+      @param lon the longitude of the south west corner of the tile in degrees
+      @param undulation the height of the geoid above the ellipsoid in meters */
+  void SetGeoidUndulation(int lat, int lon, double undulation);
+
+  /// Returns the number of tiles that were mapped so far.
+  unsigned long GetTilesLoaded(void) const {return TilesLoaded;}
+
+private:
+  struct Tile {
+    const unsigned char* data;  // 0 if the tile is missing
+    size_t size;
+    unsigned int samples;       // per row and per column
+    double maxElevation;        // in feet, of the valid samples and 0,
+                                // with the undulation
+    double undulation;          // in feet, added to the samples
+    unsigned long lastUsed;
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    void* file;
+    void* mapping;
+#endif
+  };
+
+  std::string Directory;
+  double a, b, e2;
+  unsigned int MaxTiles;
+  double DefaultUndulation;                 // in feet
+  std::map <int, double> Undulations;       // in feet, by tile (see TileKey())
+
+  // The tiles by their south west corner (see TileKey())
+  mutable std::map <int, Tile> Tiles;
+  mutable unsigned long UseCount;
+  mutable unsigned long TilesLoaded;
+
+  static int TileKey(int lat, int lon) {return (lat+90)*360 + lon+180;}
+  const Tile* FindTile(int lat, int lon) const;
+  bool MapTile(int lat, int lon, Tile& tile) const;
+  void UnmapTile(Tile& tile) const;
+  double GetUndulation(int lat, int lon) const;
+  void SetTileUndulation(int key, double undulation);
+  void LoadGeoid(void);
+  double Query(double t, const FGLocation& l, FGLocation& cont,
+               FGColumnVector3& n, FGColumnVector3& v,
+               const Tile*& tile, int& tileLat, int& tileLon) const;
+
+  void Debug(int from);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
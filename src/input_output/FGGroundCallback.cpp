@@ -34,6 +34,7 @@ SENTRY
 #include "math/FGColumnVector3.h"
 #include "math/FGLocation.h"
 #include "FGGroundCallback.h"
+#include <cmath>
 
 namespace JSBSim {
 
@@ -79,4 +80,46 @@ double FGGroundCallback::GetAGLevel(double t, const FGLocation& loc,
   return agl;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGroundCallback::GetAGLevels(double t, unsigned int count,
+                                   const FGLocation* loc, double* agl,
+                                   FGLocation* contact, FGColumnVector3* normal,
+                                   FGColumnVector3* vel) const
+{
+  for (unsigned int i=0; i<count; i++)
+    agl[i] = GetAGLevel(t, loc[i], contact[i], normal[i], vel[i]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGGroundCallback::GetMaxTerrainGeoCentRadius(const FGLocation& /*loc*/,
+                                                    double /*distance*/) const
+{
+  return HUGE_VAL;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGGroundCallback::GetSeaLevelRadius(const FGLocation& /*loc*/,
+                                         double& /*radius*/) const
+{
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGDefaultGroundCallback::FGDefaultGroundCallback(double ReferenceRadius)
+  : FGGroundCallback(ReferenceRadius)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGDefaultGroundCallback::GetMaxTerrainGeoCentRadius(const FGLocation& /*loc*/,
+                                                           double /*distance*/) const
+{
+  return GetTerrainGeoCentRadius();
+}
+
 }
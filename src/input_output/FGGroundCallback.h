@@ -56,7 +56,9 @@ CLASS DOCUMENTATION
 /** This class provides callback slots to get ground specific data like
     ground elevation and such.
     There is a default implementation, which returns values for a
-    ball formed earth.
+    ball formed earth. The ground is bounded only by FGDefaultGroundCallback,
+    which is that ball: a callback that overrides GetAGLevel() gets no bound
+    unless it also overrides GetMaxTerrainGeoCentRadius().
 
     @author Mathias Froehlich
     @version $Id: FGGroundCallback.h,v 1.8 2009/10/02 10:30:09 jberndt Exp $
@@ -86,6 +88,37 @@ public:
   /** Compute the altitude above ground. Defaults to sealevel altitude. */
   virtual double GetAGLevel(double t, const FGLocation& l, FGLocation& cont,
                             FGColumnVector3& n, FGColumnVector3& v) const;
+  /** Compute the altitudes above ground of several locations at once (the
+      gear units of a frame), so that an implementation can share its lookups
+      between them. Defaults to calling GetAGLevel() for each location.
+      @param t the simulation time
+      @param count the number of locations
+      @param l the locations
+      @param agl receives the altitudes above ground
+      @param cont receives the contact points
+      @param n receives the normals to the ground
+      @param v receives the velocities of the ground */
+  virtual void GetAGLevels(double t, unsigned int count, const FGLocation* l,
+                           double* agl, FGLocation* cont, FGColumnVector3* n,
+                           FGColumnVector3* v) const;
+  /** Returns a bound of the radius of the ground around a location: no point
+      of the ground within a distance of the location is farther from the
+      center of the earth. A location that is farther than that is clearly
+      above the ground, which need not be queried there. Defaults to no
+      bound (HUGE_VAL), since the ground of a derived class is not known.
+      @param l the location
+      @param distance the distance in feet */
+  virtual double GetMaxTerrainGeoCentRadius(const FGLocation& l,
+                                            double distance) const;
+  /** Returns the radius of sea level below a location, if the ground knows
+      it. FGPropagate then measures the altitude above sea level from there,
+      instead of from its own sea level radius. Defaults to not knowing it:
+      the ball of the reference radius is the terrain, not sea level.
+      @param l the location
+      @param radius receives the distance of sea level to the center of the
+                    earth in feet
+      @return true if the radius is known */
+  virtual bool GetSeaLevelRadius(const FGLocation& l, double& radius) const;
   virtual void SetTerrainGeoCentRadius(double radius) {mReferenceRadius = radius;}
   virtual double GetTerrainGeoCentRadius(void) const {return mReferenceRadius;}
 private:
@@ -93,6 +126,21 @@ private:
   double mReferenceRadius;
 };
 
+/** The ground callback that FGFDMExec uses unless another one is set: the
+    ball of the reference radius, which is also the bound of the ground
+    everywhere.
+*/
+
+class FGDefaultGroundCallback : public FGGroundCallback
+{
+public:
+  /** Constructor
+  @param ReferenceRadius the radius of the ball in feet */
+  FGDefaultGroundCallback(double ReferenceRadius);
+
+  double GetMaxTerrainGeoCentRadius(const FGLocation& l, double distance) const;
+};
+
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 #endif
@@ -0,0 +1,274 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputColumn.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTCOLUMN_H
+#define FGOUTPUTCOLUMN_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGOutputRecord.h"
+#include "FGPropertyManager.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTCOLUMN "$Id: FGOutputColumn.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** An entry of the list of values an output writes in each record.
+    The list is resolved once, when the output is loaded: each entry holds the
+    object its value comes from, the method that gives it, a scale factor and
+    the format it is printed with, so that collecting a record is a single
+    pass over the list, without looking at which subsystems are written.
+
+    The entries are built by the functions below, which deduce the types of
+    the object and of the method:
+<pre>
+    OutputValue(obj, method)                 obj->method()
+    OutputIndexedValue(obj, method, arg)     obj->method(arg)
+    OutputElement(obj, method, i)            obj->method()(i)
+    OutputMatrixElement(obj, method, i, j)   obj->method()(i,j)
+    OutputProperty(node)                     node->getDoubleValue()
+    OutputGroup(obj, method)                 obj->method(record)
+</pre>
+    The first five give one value, multiplied by the scale factor. The last
+    one lets a model append a group of values (the coefficients, the flight
+    control components...) of its own.
+    @version "$Id: FGOutputColumn.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputColumn
+{
+public:
+  virtual ~FGOutputColumn() {}
+  /// Appends the value(s) of the column to a record.
+  virtual void Push(FGOutputRecord& record) const = 0;
+};
+
+/** A column that gives a single value. */
+
+class FGOutputScalar : public FGOutputColumn
+{
+public:
+  FGOutputScalar(double scale, int precision, int width)
+    : Scale(scale), Precision(precision), Width(width) {}
+
+  void Push(FGOutputRecord& record) const {
+    record.Push(Scale*GetValue(), Precision, Width);
+  }
+  /// Returns the value, before it is scaled.
+  virtual double GetValue(void) const = 0;
+
+private:
+  double Scale;
+  int Precision, Width;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+template <class T, class G>
+class FGOutputMethodValue : public FGOutputScalar
+{
+public:
+  FGOutputMethodValue(T* object, G getter, double scale, int precision, int width)
+    : FGOutputScalar(scale, precision, width), Object(object), Getter(getter) {}
+  double GetValue(void) const { return (Object->*Getter)(); }
+private:
+  T* Object;
+  G Getter;
+};
+
+template <class T, class G>
+class FGOutputIndexedValue : public FGOutputScalar
+{
+public:
+  FGOutputIndexedValue(T* object, G getter, int arg, double scale, int precision,
+                       int width)
+    : FGOutputScalar(scale, precision, width), Object(object), Getter(getter),
+      Arg(arg) {}
+  double GetValue(void) const { return (Object->*Getter)(Arg); }
+private:
+  T* Object;
+  G Getter;
+  int Arg;
+};
+
+template <class T, class G>
+class FGOutputVectorElement : public FGOutputScalar
+{
+public:
+  FGOutputVectorElement(T* object, G getter, unsigned int idx, double scale,
+                        int precision, int width)
+    : FGOutputScalar(scale, precision, width), Object(object), Getter(getter),
+      Index(idx) {}
+  double GetValue(void) const { return (Object->*Getter)()(Index); }
+private:
+  T* Object;
+  G Getter;
+  unsigned int Index;
+};
+
+template <class T, class G>
+class FGOutputMatrixElement : public FGOutputScalar
+{
+public:
+  FGOutputMatrixElement(T* object, G getter, unsigned int row, unsigned int col,
+                        double scale, int precision, int width)
+    : FGOutputScalar(scale, precision, width), Object(object), Getter(getter),
+      Row(row), Col(col) {}
+  double GetValue(void) const { return (Object->*Getter)()(Row, Col); }
+private:
+  T* Object;
+  G Getter;
+  unsigned int Row, Col;
+};
+
+class FGOutputPropertyValue : public FGOutputScalar
+{
+public:
+  FGOutputPropertyValue(FGPropertyManager* node, int precision, int width)
+    : FGOutputScalar(1.0, precision, width), Node(node) {}
+  double GetValue(void) const { return Node->getDoubleValue(); }
+private:
+  FGPropertyManager* Node;
+};
+
+template <class T, class G>
+class FGOutputGroup : public FGOutputColumn
+{
+public:
+  FGOutputGroup(T* object, G getter) : Object(object), Getter(getter) {}
+  void Push(FGOutputRecord& record) const { (Object->*Getter)(record); }
+private:
+  T* Object;
+  G Getter;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FACTORY FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// The type of the method is spelled out in the parameters, rather than left to
+// a template parameter of its own, so that an overloaded method (GetPQR(void)
+// and GetPQR(int), say) resolves to the right overload.
+
+template <class T>
+FGOutputColumn* OutputValue(T* object, double (T::*getter)(void) const,
+                            int precision = 6, int width = 0, double scale = 1.0)
+{
+  return new FGOutputMethodValue<T, double (T::*)(void) const>(object, getter,
+                                                  scale, precision, width);
+}
+
+template <class T>
+FGOutputColumn* OutputValue(T* object, double (T::*getter)(void),
+                            int precision = 6, int width = 0, double scale = 1.0)
+{
+  return new FGOutputMethodValue<T, double (T::*)(void)>(object, getter,
+                                                  scale, precision, width);
+}
+
+// A flag is written as 1 or 0.
+template <class T>
+FGOutputColumn* OutputValue(T* object, bool (T::*getter)(void) const,
+                            int precision = 6, int width = 0, double scale = 1.0)
+{
+  return new FGOutputMethodValue<T, bool (T::*)(void) const>(object, getter,
+                                                  scale, precision, width);
+}
+
+template <class T>
+FGOutputColumn* OutputIndexedValue(T* object, double (T::*getter)(int) const,
+                                   int arg, int precision = 6, int width = 0,
+                                   double scale = 1.0)
+{
+  return new FGOutputIndexedValue<T, double (T::*)(int) const>(object, getter,
+                                              arg, scale, precision, width);
+}
+
+template <class T, class V>
+FGOutputColumn* OutputElement(T* object, V (T::*getter)(void) const,
+                              unsigned int idx, int precision = 6, int width = 0,
+                              double scale = 1.0)
+{
+  return new FGOutputVectorElement<T, V (T::*)(void) const>(object, getter, idx,
+                                                  scale, precision, width);
+}
+
+template <class T, class V>
+FGOutputColumn* OutputElement(T* object, V (T::*getter)(void), unsigned int idx,
+                              int precision = 6, int width = 0, double scale = 1.0)
+{
+  return new FGOutputVectorElement<T, V (T::*)(void)>(object, getter, idx,
+                                                  scale, precision, width);
+}
+
+template <class T, class V>
+FGOutputColumn* OutputMatrixElement(T* object, V (T::*getter)(void),
+                                    unsigned int row, unsigned int col,
+                                    int precision = 6, int width = 0)
+{
+  return new FGOutputMatrixElement<T, V (T::*)(void)>(object, getter, row, col,
+                                                  1.0, precision, width);
+}
+
+inline FGOutputColumn* OutputProperty(FGPropertyManager* node, int precision = 6,
+                                      int width = 0)
+{
+  return new FGOutputPropertyValue(node, precision, width);
+}
+
+template <class T>
+FGOutputColumn* OutputGroup(T* object, void (T::*getter)(FGOutputRecord&) const)
+{
+  return new FGOutputGroup<T, void (T::*)(FGOutputRecord&) const>(object, getter);
+}
+
+template <class T>
+FGOutputColumn* OutputGroup(T* object, void (T::*getter)(FGOutputRecord&))
+{
+  return new FGOutputGroup<T, void (T::*)(FGOutputRecord&)>(object, getter);
+}
+
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
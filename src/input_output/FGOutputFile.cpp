@@ -0,0 +1,287 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputFile.cpp
+ Date started: October 16 2026
+ Purpose:      Writes a data file in segments, optionally compressed
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGOutputFile.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+#ifdef HAVE_LIBZ
+#  include <zlib.h>
+#endif
+#ifdef HAVE_LIBZSTD
+#  include <zstd.h>
+#endif
+
+using std::cerr;
+using std::endl;
+using std::string;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGOutputFile.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_OUTPUTFILE;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGOutputFile::FGOutputFile()
+{
+  Compression = cmNone;
+  MaxBytes = 0;
+  MaxSeconds = 0.0;
+  Segment = 0;
+  SegmentBytes = 0;
+  SegmentStart = 0.0;
+  SegmentEmpty = true;
+  file = 0;
+  gz = 0;
+  zstd = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGOutputFile::~FGOutputFile()
+{
+  Close();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputFile::SetRotation(unsigned long bytes, double seconds)
+{
+  MaxBytes = bytes;
+  MaxSeconds = seconds > 0.0 ? seconds : 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputFile::SetCompression(const string& name)
+{
+  Compression = cmNone;
+
+  if (name.empty() || name == "none") return true;
+
+  if (name == "gzip") {
+#ifdef HAVE_LIBZ
+    Compression = cmGzip;
+    return true;
+#endif
+  } else if (name == "zstd") {
+#ifdef HAVE_LIBZSTD
+    Compression = cmZstd;
+    return true;
+#endif
+  } else {
+    cerr << "Unknown compression " << name << ", the output is not compressed" << endl;
+    return false;
+  }
+
+  cerr << "JSBSim was built without " << name << " support, the output is not compressed" << endl;
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputFile::Open(const string& name)
+{
+  Close();
+
+  BaseName = name;
+  Segment = 0;
+  return OpenSegment();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The segment number goes before the extension, if the name has one.
+
+bool FGOutputFile::OpenSegment(void)
+{
+  SegmentName = BaseName;
+  if (Rotating()) {
+    std::ostringstream buf;
+    string::size_type dot = BaseName.find_last_of('.');
+    string::size_type slash = BaseName.find_last_of("/\\");
+    if (dot == string::npos || (slash != string::npos && dot < slash)) dot = BaseName.size();
+    buf << BaseName.substr(0, dot) << '.' << std::setw(4) << std::setfill('0')
+        << Segment << BaseName.substr(dot);
+    SegmentName = buf.str();
+  }
+
+  // A compressor that cannot be started leaves the output uncompressed, for
+  // this segment and the next ones.
+  switch (Compression) {
+#ifdef HAVE_LIBZ
+  case cmGzip:
+    SegmentName += ".gz";
+    gz = gzopen(SegmentName.c_str(), "wb");
+    if (!gz) {
+      cerr << "Could not start the gzip compression of " << SegmentName
+           << ", the output is not compressed" << endl;
+      SegmentName.erase(SegmentName.size() - 3);
+      Compression = cmNone;
+    }
+    break;
+#endif
+#ifdef HAVE_LIBZSTD
+  case cmZstd:
+    SegmentName += ".zst";
+    file = fopen(SegmentName.c_str(), "wb");
+    if (file) {
+      ZSTD_CStream* stream = ZSTD_createCStream();
+      if (stream == 0 || ZSTD_isError(ZSTD_initCStream(stream, 3))) {
+        if (stream) ZSTD_freeCStream(stream);
+        fclose(file);
+        file = 0;
+        remove(SegmentName.c_str());
+        cerr << "Could not start the zstd compression of " << SegmentName
+             << ", the output is not compressed" << endl;
+        SegmentName.erase(SegmentName.size() - 4);
+        Compression = cmNone;
+      } else {
+        zstd = stream;
+        Buffer.resize(ZSTD_CStreamOutSize());
+      }
+    }
+    break;
+#endif
+  default:
+    break;
+  }
+
+  if (Compression == cmNone) file = fopen(SegmentName.c_str(), "wb");
+
+  if (!IsOpen()) {
+    cerr << "Could not create file: " << SegmentName << endl;
+    return false;
+  }
+
+  SegmentBytes = 0;
+  SegmentEmpty = true;
+  WriteBytes(Header.data(), Header.size());
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputFile::Close(void)
+{
+#ifdef HAVE_LIBZ
+  if (gz) {
+    gzclose((gzFile)gz);
+    gz = 0;
+  }
+#endif
+#ifdef HAVE_LIBZSTD
+  if (zstd) {
+    ZSTD_CStream* stream = (ZSTD_CStream*)zstd;
+    size_t remaining;
+    do {
+      ZSTD_outBuffer out = {&Buffer[0], Buffer.size(), 0};
+      remaining = ZSTD_endStream(stream, &out);
+      if (ZSTD_isError(remaining)) remaining = 0;
+      fwrite(out.dst, 1, out.pos, file);
+    } while (remaining > 0);
+    ZSTD_freeCStream(stream);
+    zstd = 0;
+  }
+#endif
+  if (file) {
+    fclose(file);
+    file = 0;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A segment holds at least one record, whatever its limits. When the time
+// goes back (a reset), a rotated file starts a new segment; a file that is not
+// rotated is only ever opened by Open(), and goes on.
+
+void FGOutputFile::Write(const char* data, size_t size, double time)
+{
+  if (!IsOpen()) return;
+
+  if (Rotating() && !SegmentEmpty
+      && ((MaxBytes > 0 && SegmentBytes >= MaxBytes)
+          || (MaxSeconds > 0.0 && time - SegmentStart >= MaxSeconds)
+          || time < SegmentStart)) {
+    Close();
+    Segment++;
+    if (!OpenSegment()) return;
+  }
+
+  if (SegmentEmpty) {
+    SegmentStart = time;
+    SegmentEmpty = false;
+  }
+  WriteBytes(data, size);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The size of a compressed segment is that of the compressed bytes that have
+// left the compressor; those it still holds are not counted.
+
+void FGOutputFile::WriteBytes(const char* data, size_t size)
+{
+  if (size == 0) return;
+
+  switch (Compression) {
+#ifdef HAVE_LIBZ
+  case cmGzip:
+    gzwrite((gzFile)gz, data, (unsigned int)size);
+    SegmentBytes = (unsigned long)gzoffset((gzFile)gz);
+    break;
+#endif
+#ifdef HAVE_LIBZSTD
+  case cmZstd:
+    {
+      ZSTD_inBuffer in = {data, size, 0};
+      while (in.pos < in.size) {
+        ZSTD_outBuffer out = {&Buffer[0], Buffer.size(), 0};
+        if (ZSTD_isError(ZSTD_compressStream((ZSTD_CStream*)zstd, &out, &in))) break;
+        fwrite(out.dst, 1, out.pos, file);
+        SegmentBytes += out.pos;
+      }
+    }
+    break;
+#endif
+  default:
+    fwrite(data, 1, size, file);
+    SegmentBytes += size;
+    break;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputFile::Flush(void)
+{
+  if (Compression == cmNone && file) fflush(file);
+}
+
+}
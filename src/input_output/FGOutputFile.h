@@ -0,0 +1,140 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputFile.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTFILE_H
+#define FGOUTPUTFILE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTFILE "$Id: FGOutputFile.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A data file that is split in segments and optionally compressed as it is
+    written. A new segment is started when the current one reaches a size, or
+    when the records written in it span a duration of simulation time; each
+    segment begins with the header of the file, so that it can be read on its
+    own. The segments are numbered from 0, the number going between the name
+    and the extension of the file (log.csv gives log.0000.csv, log.0001.csv...).
+    Without rotation, the file keeps its name.
+
+    The compression is done as the records are written, by the thread that
+    writes them: gzip (zlib) adds .gz to the names of the files and zstd adds
+    .zst. A compression that the library was built without, or whose
+    compressor cannot be started, falls back to none, with a warning. A
+    compressed file is only flushed when it is closed, or when a segment
+    ends: flushing it after every record would spoil the compression.
+    @version "$Id: FGOutputFile.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputFile
+{
+public:
+  enum eCompression {cmNone, cmGzip, cmZstd};
+
+  FGOutputFile();
+  /// Closes the file.
+  ~FGOutputFile();
+
+  /** Sets when a new segment is started. Applies to the next Open().
+      @param bytes the size of a segment on disk, 0 for no limit
+      @param seconds the simulation time a segment spans, 0 for no limit */
+  void SetRotation(unsigned long bytes, double seconds);
+  /** Sets the compression by name: "none", "gzip" or "zstd". Applies to the
+      next Open().
+      @return false if the name is unknown or the library was built without
+              this compression; the file is then not compressed */
+  bool SetCompression(const std::string& name);
+  /// Sets the bytes that begin each segment.
+  void SetHeader(const std::string& header) {Header = header;}
+
+  /** Opens the file (its first segment) and writes the header in it.
+      @param name the name of the file, before the segment number and the
+                  extension of the compression are added
+      @return false if the file could not be created */
+  bool Open(const std::string& name);
+  /// Flushes and closes the current segment.
+  void Close(void);
+  bool IsOpen(void) const {return file != 0 || gz != 0;}
+
+  /** Writes a record, after starting a new segment if the current one is
+      full.
+      @param data the bytes of the record
+      @param size the number of bytes
+      @param time the simulation time of the record */
+  void Write(const char* data, size_t size, double time);
+  /// Flushes the data written to the disk, for an uncompressed file.
+  void Flush(void);
+
+  /// Returns the name of the segment being written.
+  const std::string& GetSegmentName(void) const {return SegmentName;}
+  /// Returns the number of the segment being written.
+  unsigned int GetSegment(void) const {return Segment;}
+
+private:
+  std::string BaseName, SegmentName, Header;
+  eCompression Compression;
+  unsigned long MaxBytes;
+  double MaxSeconds;
+  unsigned int Segment;
+  unsigned long SegmentBytes; // Written to the disk in the current segment
+  double SegmentStart;        // The time of the first record of the segment
+  bool SegmentEmpty;
+
+  FILE* file;                 // Uncompressed or zstd
+  void* gz;                   // gzip: a gzFile
+  void* zstd;                 // zstd: a ZSTD_CStream
+  std::vector <char> Buffer;  // zstd: the compressed bytes
+
+  bool Rotating(void) const {return MaxBytes > 0 || MaxSeconds > 0.0;}
+  bool OpenSegment(void);
+  void WriteBytes(const char* data, size_t size);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
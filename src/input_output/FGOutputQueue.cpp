@@ -0,0 +1,180 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputQueue.cpp
+ Date started: October 16 2026
+ Purpose:      Passes output records from one thread to another without locks
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGOutputQueue.h"
+#include <cstring>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#  include <intrin.h>
+#else
+#  include <time.h>
+#endif
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGOutputQueue.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_OUTPUTQUEUE;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LOCAL FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// A load that no later memory access is moved before, and a store that no
+// earlier memory access is moved after. With MSVC, volatile accesses already
+// have these semantics on x86; the barrier keeps the compiler from reordering.
+
+#if defined(_MSC_VER)
+template <class T> static inline T LoadAcquire(volatile T* p)
+{
+  T value = *p;
+  _ReadWriteBarrier();
+  return value;
+}
+
+template <class T> static inline void StoreRelease(volatile T* p, T value)
+{
+  _ReadWriteBarrier();
+  *p = value;
+}
+#else
+template <class T> static inline T LoadAcquire(volatile T* p)
+{
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template <class T> static inline void StoreRelease(volatile T* p, T value)
+{
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+#endif
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGOutputQueue::FGOutputQueue(unsigned int width, unsigned int capacity)
+{
+  Width = width > 0 ? width : 1;
+  Capacity = capacity > 0 ? capacity : 1;
+  Records = new double[Width*Capacity];
+  Dropped = Backpressured = 0;
+  Head = Tail = 0;
+  Closed = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGOutputQueue::~FGOutputQueue()
+{
+  delete[] Records;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputQueue::Push(const double* record, bool wait)
+{
+  unsigned long head = Head; // Only this thread writes it
+
+  if (head - LoadAcquire(&Tail) >= Capacity) {
+    if (!wait) {
+      Dropped++;
+      return false;
+    }
+    Backpressured++;
+    while (head - LoadAcquire(&Tail) >= Capacity) Sleep(50);
+  }
+
+  memcpy(Records + (head % Capacity)*Width, record, Width*sizeof(double));
+  StoreRelease(&Head, head+1);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::Close(void)
+{
+  StoreRelease(&Closed, 1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::Drain(void) const
+{
+  while (LoadAcquire(&Tail) != Head) Sleep(100);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const double* FGOutputQueue::Front(void) const
+{
+  unsigned long tail = Tail; // Only this thread writes it
+
+  if (LoadAcquire(&Head) == tail) return 0;
+
+  return Records + (tail % Capacity)*Width;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::Pop(void)
+{
+  StoreRelease(&Tail, Tail+1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputQueue::IsClosed(void) const
+{
+  return LoadAcquire(&Closed) != 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned long FGOutputQueue::GetPending(void) const
+{
+  unsigned long tail = LoadAcquire(&Tail);
+  return LoadAcquire(&Head) - tail;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::Sleep(unsigned int usec)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  ::Sleep(usec >= 1000 ? usec/1000 : 0);
+#else
+  struct timespec ts;
+  ts.tv_sec = usec / 1000000;
+  ts.tv_nsec = (usec % 1000000) * 1000L;
+  nanosleep(&ts, 0);
+#endif
+}
+
+}
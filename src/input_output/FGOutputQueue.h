@@ -0,0 +1,128 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputQueue.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTQUEUE_H
+#define FGOUTPUTQUEUE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTQUEUE "$Id: FGOutputQueue.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A queue of fixed size records of doubles, passed from one producer thread to
+    one consumer thread without locks. The records are stored in a ring that is
+    allocated once: the producer copies a record in the slot at the head and
+    then publishes it by advancing the head index; the consumer reads the record
+    at the tail and then releases its slot by advancing the tail index. Each
+    index is written by one thread only, so a store with release semantics and
+    a load with acquire semantics are all the synchronization needed.
+
+    When the ring is full, the producer either drops the record or waits for
+    the consumer to release a slot; both cases are counted. The producer closes
+    the queue to tell the consumer that no more records will come.
+    @version "$Id: FGOutputQueue.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputQueue
+{
+public:
+  /** Constructor
+      @param width the number of doubles in a record
+      @param capacity the number of records the ring can hold */
+  FGOutputQueue(unsigned int width, unsigned int capacity);
+  /// Destructor
+  ~FGOutputQueue();
+
+  /** Copies a record at the head of the queue (producer side).
+      @param record the record, of GetWidth() doubles
+      @param wait true to wait for a free slot when the queue is full, false to
+                  drop the record
+      @return false if the record was dropped */
+  bool Push(const double* record, bool wait);
+  /// Tells the consumer that no more records will be pushed (producer side).
+  void Close(void);
+  /// Waits until the consumer has released every record (producer side).
+  void Drain(void) const;
+
+  /// Returns the record at the tail of the queue, or 0 if it is empty (consumer side).
+  const double* Front(void) const;
+  /// Releases the record returned by Front() (consumer side).
+  void Pop(void);
+  /// Returns true once the queue has been closed (consumer side).
+  bool IsClosed(void) const;
+
+  /// Returns the number of doubles in a record.
+  unsigned int GetWidth(void) const {return Width;}
+  /// Returns the number of records the ring can hold.
+  unsigned int GetCapacity(void) const {return Capacity;}
+  /// Returns the number of records waiting for the consumer.
+  unsigned long GetPending(void) const;
+  /// Returns the number of records dropped because the queue was full.
+  unsigned long GetDropped(void) const {return Dropped;}
+  /// Returns the number of records that had to wait for a free slot.
+  unsigned long GetBackpressured(void) const {return Backpressured;}
+
+  /** Suspends the calling thread.
+      @param usec the duration in microseconds */
+  static void Sleep(unsigned int usec);
+
+private:
+  enum {CacheLine = 64};
+
+  double* Records;
+  unsigned int Width;
+  unsigned int Capacity;
+  unsigned long Dropped;
+  unsigned long Backpressured;
+
+  // The indices count the records pushed and popped since the creation of the
+  // queue; each one sits on its own cache line so that the two threads do not
+  // contend for the line the other one writes.
+  char pad0[CacheLine];
+  volatile unsigned long Head;
+  char pad1[CacheLine - sizeof(unsigned long)];
+  volatile unsigned long Tail;
+  char pad2[CacheLine - sizeof(unsigned long)];
+  volatile int Closed;
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -0,0 +1,88 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputRecord.cpp
+ Date started: October 16 2026
+ Purpose:      Collects the values of an output record
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGOutputRecord.h"
+#include "math/FGColumnVector3.h"
+#include "math/FGMatrix33.h"
+#include <cstdio>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  #define snprintf _snprintf
+#endif
+
+using namespace std;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGOutputRecord.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_OUTPUTRECORD;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+void FGOutputRecord::Push(const FGColumnVector3& v)
+{
+  for (unsigned int i=1; i<=3; i++) Push(v(i), 16, 18);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputRecord::Push(const FGMatrix33& m)
+{
+  for (unsigned int i=1; i<=3; i++)
+    for (unsigned int j=1; j<=3; j++)
+      Push(m(i,j), 10, 12);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGOutputRecord::Print(const string& delimiter) const
+{
+  string line;
+  Print(GetValues(), GetFormats(), GetSize(), delimiter, line);
+  return line;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The %g conversion is what an ostream uses for doubles in its default
+// floating point notation, so the text is the same as that of operator<<.
+
+void FGOutputRecord::Print(const double* values, const Format* formats, unsigned int size,
+                           const string& delimiter, string& line)
+{
+  char buf[64];
+
+  for (unsigned int i=0; i<size; i++) {
+    if (i > 0) line += delimiter;
+    int n = snprintf(buf, sizeof(buf), "%*.*g", formats[i].Width, formats[i].Precision, values[i]);
+    if (n < 0 || n > (int)sizeof(buf)-1) n = sizeof(buf)-1;
+    line.append(buf, n);
+  }
+}
+
+}
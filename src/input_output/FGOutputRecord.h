@@ -0,0 +1,123 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputRecord.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTRECORD_H
+#define FGOUTPUTRECORD_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTRECORD "$Id: FGOutputRecord.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGColumnVector3;
+class FGMatrix33;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Collects the values of an output record along with the way each of them is
+    printed. The models push their raw values (with the precision and width
+    their text output has always used) rather than formatting them, so that a
+    record can be copied as is and printed later, possibly by another thread.
+
+    Print() gives the same text as an ostream with the same precision and
+    width: the vectors and matrices are pushed with the formats of their Dump()
+    methods. Once the vectors have grown to the size of a record, collecting
+    the following records does not allocate memory.
+    @version "$Id: FGOutputRecord.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputRecord
+{
+public:
+  /// The way a value is printed: significant digits and minimum field width.
+  struct Format {
+    int Precision;
+    int Width;
+  };
+
+  /// Removes the values, keeping the memory allocated for them.
+  void Clear(void) {Values.clear(); Formats.clear();}
+
+  /** Appends a value.
+      @param value the value
+      @param precision the number of significant digits it is printed with
+      @param width the minimum width of its field (padded with leading spaces) */
+  void Push(double value, int precision = 6, int width = 0) {
+    Format format = {precision, width};
+    Values.push_back(value);
+    Formats.push_back(format);
+  }
+  /// Appends the three components of a vector, printed as by FGColumnVector3::Dump().
+  void Push(const FGColumnVector3& v);
+  /// Appends the nine elements of a matrix, printed as by FGMatrix33::Dump().
+  void Push(const FGMatrix33& m);
+
+  /// Returns the number of values.
+  unsigned int GetSize(void) const {return (unsigned int)Values.size();}
+  /// Returns the values.
+  const double* GetValues(void) const {return Values.empty() ? 0 : &Values[0];}
+  /// Returns the formats of the values.
+  const Format* GetFormats(void) const {return Formats.empty() ? 0 : &Formats[0];}
+
+  /// Returns the values printed and separated by a delimiter.
+  std::string Print(const std::string& delimiter) const;
+
+  /** Appends values printed and separated by a delimiter to a line of text.
+      @param values the values
+      @param formats their formats
+      @param size the number of values
+      @param delimiter the text that separates the values
+      @param line the text the values are appended to */
+  static void Print(const double* values, const Format* formats, unsigned int size,
+                    const std::string& delimiter, std::string& line);
+
+private:
+  std::vector <double> Values;
+  std::vector <Format> Formats;
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -48,10 +48,6 @@ COMMENTS, REFERENCES, and NOTES [use "class documentation" below for API docs]
 
 namespace JSBSim {
 
-bool FGPropertyManager::suppress_warning = true;
-
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-
 string FGPropertyManager::mkPropertyName(string name, bool lowercase) {
 
   /* do this two pass to avoid problems with characters getting skipped
@@ -73,7 +69,7 @@ FGPropertyManager*
 FGPropertyManager::GetNode (const string &path, bool create)
 {
   SGPropertyNode* node=this->getNode(path.c_str(), create);
-  if (node == 0 && !suppress_warning) {
+  if (node == 0) {
     cerr << "FGPropertyManager::GetNode() No node found for " << path << endl;
   }
   return (FGPropertyManager*)node;
@@ -93,10 +89,7 @@ FGPropertyManager::GetNode (const string &relpath, int index, bool create)
 bool FGPropertyManager::HasNode (const string &path)
 {
   // Checking if a node exists shouldn't write a warning if it doesn't exist
-  suppress_warning = true;
-  bool has_node = (GetNode(path, false) != 0);
-  suppress_warning = false;
-  return has_node;
+  return (getNode(path.c_str(), false) != 0);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
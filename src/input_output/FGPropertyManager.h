@@ -75,11 +75,9 @@ CLASS DECLARATION
 
 class FGPropertyManager : public SGPropertyNode, public FGJSBBase
 {
-  private:
-    static bool suppress_warning;
   public:
     /// Constructor
-    FGPropertyManager(void) {suppress_warning = false;}
+    FGPropertyManager(void) {}
     /// Destructor
     virtual ~FGPropertyManager(void) {}
 
@@ -175,12 +175,12 @@ bool FGScript::LoadScript(string script, double deltaT)
   }
 
   // Now, read input spec if given.
-  if (input_element > 0) {
+  if (input_element != 0) {
     FDMExec->GetInput()->Load(input_element);
   }
 
   // Now, read output spec if given.
-  if (output_element > 0) {
+  if (output_element != 0) {
     string output_file = output_element->GetAttributeValue("file");
     if (output_file.empty()) {
       cerr << "No logging directives file was specified." << endl;
@@ -45,8 +45,174 @@ namespace JSBSim {
 static const char *IdSrc = "$Id: FGXMLElement.cpp,v 1.30 2010/09/04 14:15:15 jberndt Exp $";
 static const char *IdHdr = ID_XMLELEMENT;
 
-bool Element::converterIsInitialized = false;
-map <string, map <string, double> > Element::convert;
+// The unit conversions: from * factor = to. The table is immutable, so that
+// XML documents may be read by several FDM instances at the same time.
+
+struct UnitConversion {
+  const char* from;
+  const char* to;
+  double factor;
+};
+
+static const UnitConversion ConversionTable[] = {
+  // Length
+  {"M", "FT", 3.2808399},
+  {"FT", "M", 1.0/3.2808399},
+  {"FT", "IN", 12.0},
+  {"IN", "FT", 1.0/12.0},
+  {"IN", "M", (1.0/12.0) * (1.0/3.2808399)},
+  {"M", "IN", 3.2808399 * 12.0},
+  // Area
+  {"M2", "FT2", 3.2808399*3.2808399},
+  {"FT2", "M2", 1.0/(3.2808399*3.2808399)},
+  {"M2", "IN2", (3.2808399 * 12.0)*(3.2808399 * 12.0)},
+  {"IN2", "M2", 1.0/((3.2808399 * 12.0)*(3.2808399 * 12.0))},
+  {"FT2", "IN2", 144.0},
+  {"IN2", "FT2", 1.0/144.0},
+  // Volume
+  {"IN3", "CC", 16.387064},
+  {"CC", "IN3", 1.0/16.387064},
+  {"FT3", "IN3", 1728.0},
+  {"IN3", "FT3", 1.0/1728.0},
+  {"M3", "FT3", 35.3146667},
+  {"FT3", "M3", 1.0/35.3146667},
+  {"LTR", "IN3", 61.0237441},
+  {"IN3", "LTR", 1.0/61.0237441},
+  // Mass & Weight
+  {"LBS", "KG", 0.45359237},
+  {"KG", "LBS", 1.0/0.45359237},
+  {"SLUG", "KG", 14.59390},
+  {"KG", "SLUG", 1.0/14.59390},
+  // Moments of Inertia
+  {"SLUG*FT2", "KG*M2", 1.35594},
+  {"KG*M2", "SLUG*FT2", 1.0/1.35594},
+  // Angles
+  {"RAD", "DEG", 360.0/(2.0*3.1415926)},
+  {"DEG", "RAD", 1.0/(360.0/(2.0*3.1415926))},
+  // Angular rates
+  {"RAD/SEC", "DEG/SEC", 360.0/(2.0*3.1415926)},
+  {"DEG/SEC", "RAD/SEC", 1.0/(360.0/(2.0*3.1415926))},
+  // Spring force
+  {"LBS/FT", "N/M", 14.5939},
+  {"N/M", "LBS/FT", 1.0/14.5939},
+  // Damping force
+  {"LBS/FT/SEC", "N/M/SEC", 14.5939},
+  {"N/M/SEC", "LBS/FT/SEC", 1.0/14.5939},
+  // Damping force (Square Law)
+  {"LBS/FT2/SEC2", "N/M2/SEC2", 47.880259},
+  {"N/M2/SEC2", "LBS/FT2/SEC2", 1.0/47.880259},
+  // Power
+  {"WATTS", "HP", 0.001341022},
+  {"HP", "WATTS", 1.0/0.001341022},
+  // Force
+  {"N", "LBS", 0.22482},
+  {"LBS", "N", 1.0/0.22482},
+  // Velocity
+  {"KTS", "FT/SEC", 1.68781},
+  {"FT/SEC", "KTS", 1.0/1.68781},
+  {"M/S", "FT/S", 3.2808399},
+  {"M/SEC", "FT/SEC", 3.2808399},
+  {"FT/S", "M/S", 1.0/3.2808399},
+  {"FT/SEC", "M/SEC", 1.0/3.2808399},
+  // Torque
+  {"FT*LBS", "N*M", 1.35581795},
+  {"N*M", "FT*LBS", 1/1.35581795},
+  // Valve
+  {"M4*SEC/KG", "FT4*SEC/SLUG", 3.2808399*3.2808399*3.2808399*3.2808399/(1.0/14.59390)},
+  {"FT4*SEC/SLUG", "M4*SEC/KG", 1.0/(3.2808399*3.2808399*3.2808399*3.2808399/(1.0/14.59390))},
+  // Pressure
+  {"INHG", "PSF", 70.7180803},
+  {"PSF", "INHG", 1.0/70.7180803},
+  {"ATM", "INHG", 29.9246899},
+  {"INHG", "ATM", 1.0/29.9246899},
+  {"PSI", "INHG", 2.03625437},
+  {"INHG", "PSI", 1.0/2.03625437},
+  {"INHG", "PA", 3386.0}, // inches Mercury to pascals
+  {"PA", "INHG", 1.0/3386.0},
+  {"LBS/FT2", "N/M2", 14.5939/(1.0/3.2808399)},
+  {"N/M2", "LBS/FT2", 1.0/(14.5939/(1.0/3.2808399))},
+  {"LBS/FT2", "PA", 14.5939/(1.0/3.2808399)},
+  {"PA", "LBS/FT2", 1.0/(14.5939/(1.0/3.2808399))},
+  // Mass flow
+  {"KG/MIN", "LBS/MIN", 1.0/0.45359237},
+  // Fuel Consumption
+  {"LBS/HP*HR", "KG/KW*HR", 0.6083},
+  {"KG/KW*HR", "LBS/HP*HR", 1.0/0.6083},
+  // Density
+  {"KG/L", "LBS/GAL", 8.3454045},
+  {"LBS/GAL", "KG/L", 1.0/8.3454045},
+
+  // Length
+  {"M", "M", 1.00},
+  {"FT", "FT", 1.00},
+  {"IN", "IN", 1.00},
+  // Area
+  {"M2", "M2", 1.00},
+  {"FT2", "FT2", 1.00},
+  // Volume
+  {"IN3", "IN3", 1.00},
+  {"CC", "CC", 1.0},
+  {"M3", "M3", 1.0},
+  {"FT3", "FT3", 1.0},
+  {"LTR", "LTR", 1.0},
+  // Mass & Weight
+  {"KG", "KG", 1.00},
+  {"LBS", "LBS", 1.00},
+  // Moments of Inertia
+  {"KG*M2", "KG*M2", 1.00},
+  {"SLUG*FT2", "SLUG*FT2", 1.00},
+  // Angles
+  {"DEG", "DEG", 1.00},
+  {"RAD", "RAD", 1.00},
+  // Angular rates
+  {"DEG/SEC", "DEG/SEC", 1.00},
+  {"RAD/SEC", "RAD/SEC", 1.00},
+  // Spring force
+  {"LBS/FT", "LBS/FT", 1.00},
+  {"N/M", "N/M", 1.00},
+  // Damping force
+  {"LBS/FT/SEC", "LBS/FT/SEC", 1.00},
+  {"N/M/SEC", "N/M/SEC", 1.00},
+  // Damping force (Square law)
+  {"LBS/FT2/SEC2", "LBS/FT2/SEC2", 1.00},
+  {"N/M2/SEC2", "N/M2/SEC2", 1.00},
+  // Power
+  {"HP", "HP", 1.00},
+  {"WATTS", "WATTS", 1.00},
+  // Force
+  {"N", "N", 1.00},
+  // Velocity
+  {"FT/SEC", "FT/SEC", 1.00},
+  {"KTS", "KTS", 1.00},
+  {"M/S", "M/S", 1.0},
+  {"M/SEC", "M/SEC", 1.0},
+  // Torque
+  {"FT*LBS", "FT*LBS", 1.00},
+  {"N*M", "N*M", 1.00},
+  // Valve
+  {"M4*SEC/KG", "M4*SEC/KG", 1.0},
+  {"FT4*SEC/SLUG", "FT4*SEC/SLUG", 1.0},
+  // Pressure
+  {"PSI", "PSI", 1.00},
+  {"PSF", "PSF", 1.00},
+  {"INHG", "INHG", 1.00},
+  {"ATM", "ATM", 1.0},
+  {"PA", "PA", 1.0},
+  {"N/M2", "N/M2", 1.00},
+  {"LBS/FT2", "LBS/FT2", 1.00},
+  // Mass flow
+  {"LBS/SEC", "LBS/SEC", 1.00},
+  {"KG/MIN", "KG/MIN", 1.0},
+  {"LBS/MIN", "LBS/MIN", 1.0},
+  // Fuel Consumption
+  {"LBS/HP*HR", "LBS/HP*HR", 1.0},
+  {"KG/KW*HR", "KG/KW*HR", 1.0},
+  // Density
+  {"KG/L", "KG/L", 1.0},
+  {"LBS/GAL", "LBS/GAL", 1.0}
+};
+
+static const unsigned int nConversions = sizeof(ConversionTable)/sizeof(ConversionTable[0]);
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
@@ -57,169 +223,6 @@ Element::Element(const string& nm)
   name   = nm;
   parent = 0L;
   element_index = 0;
-
-  if (!converterIsInitialized) {
-    converterIsInitialized = true;
-    // convert ["from"]["to"] = factor, so: from * factor = to
-    // Length
-    convert["M"]["FT"] = 3.2808399;
-    convert["FT"]["M"] = 1.0/convert["M"]["FT"];
-    convert["FT"]["IN"] = 12.0;
-    convert["IN"]["FT"] = 1.0/convert["FT"]["IN"];
-    convert["IN"]["M"] = convert["IN"]["FT"] * convert["FT"]["M"];
-    convert["M"]["IN"] = convert["M"]["FT"] * convert["FT"]["IN"];
-    // Area
-    convert["M2"]["FT2"] = convert["M"]["FT"]*convert["M"]["FT"];
-    convert["FT2"]["M2"] = 1.0/convert["M2"]["FT2"];
-    convert["M2"]["IN2"] = convert["M"]["IN"]*convert["M"]["IN"];
-    convert["IN2"]["M2"] = 1.0/convert["M2"]["IN2"];
-    convert["FT2"]["IN2"] = 144.0;
-    convert["IN2"]["FT2"] = 1.0/convert["FT2"]["IN2"];
-    // Volume
-    convert["IN3"]["CC"] = 16.387064;
-    convert["CC"]["IN3"] = 1.0/convert["IN3"]["CC"];
-    convert["FT3"]["IN3"] = 1728.0;
-    convert["IN3"]["FT3"] = 1.0/convert["FT3"]["IN3"];
-    convert["M3"]["FT3"] = 35.3146667;
-    convert["FT3"]["M3"] = 1.0/convert["M3"]["FT3"];
-    convert["LTR"]["IN3"] = 61.0237441;
-    convert["IN3"]["LTR"] = 1.0/convert["LTR"]["IN3"];
-    // Mass & Weight
-    convert["LBS"]["KG"] = 0.45359237;
-    convert["KG"]["LBS"] = 1.0/convert["LBS"]["KG"];
-    convert["SLUG"]["KG"] = 14.59390;
-    convert["KG"]["SLUG"] = 1.0/convert["SLUG"]["KG"];
-    // Moments of Inertia
-    convert["SLUG*FT2"]["KG*M2"] = 1.35594;
-    convert["KG*M2"]["SLUG*FT2"] = 1.0/convert["SLUG*FT2"]["KG*M2"];
-    // Angles
-    convert["RAD"]["DEG"] = 360.0/(2.0*3.1415926);
-    convert["DEG"]["RAD"] = 1.0/convert["RAD"]["DEG"];
-    // Angular rates
-    convert["RAD/SEC"]["DEG/SEC"] = 360.0/(2.0*3.1415926);
-    convert["DEG/SEC"]["RAD/SEC"] = 1.0/convert["RAD/SEC"]["DEG/SEC"];
-    // Spring force
-    convert["LBS/FT"]["N/M"] = 14.5939;
-    convert["N/M"]["LBS/FT"] = 1.0/convert["LBS/FT"]["N/M"];
-    // Damping force
-    convert["LBS/FT/SEC"]["N/M/SEC"] = 14.5939;
-    convert["N/M/SEC"]["LBS/FT/SEC"] = 1.0/convert["LBS/FT/SEC"]["N/M/SEC"];
-    // Damping force (Square Law)
-    convert["LBS/FT2/SEC2"]["N/M2/SEC2"] = 47.880259;
-    convert["N/M2/SEC2"]["LBS/FT2/SEC2"] = 1.0/convert["LBS/FT2/SEC2"]["N/M2/SEC2"];
-    // Power
-    convert["WATTS"]["HP"] = 0.001341022;
-    convert["HP"]["WATTS"] = 1.0/convert["WATTS"]["HP"];
-    // Force
-    convert["N"]["LBS"] = 0.22482;
-    convert["LBS"]["N"] = 1.0/convert["N"]["LBS"];
-    // Velocity
-    convert["KTS"]["FT/SEC"] = 1.68781;
-    convert["FT/SEC"]["KTS"] = 1.0/convert["KTS"]["FT/SEC"];
-    convert["M/S"]["FT/S"] = 3.2808399;
-    convert["M/SEC"]["FT/SEC"] = 3.2808399;
-    convert["FT/S"]["M/S"] = 1.0/convert["M/S"]["FT/S"];
-    convert["M/SEC"]["FT/SEC"] = 3.2808399;
-    convert["FT/SEC"]["M/SEC"] = 1.0/convert["M/SEC"]["FT/SEC"];
-    // Torque
-    convert["FT*LBS"]["N*M"] = 1.35581795;
-    convert["N*M"]["FT*LBS"] = 1/convert["FT*LBS"]["N*M"];
-    // Valve
-    convert["M4*SEC/KG"]["FT4*SEC/SLUG"] = convert["M"]["FT"]*convert["M"]["FT"]*
-      convert["M"]["FT"]*convert["M"]["FT"]/convert["KG"]["SLUG"];
-    convert["FT4*SEC/SLUG"]["M4*SEC/KG"] =
-      1.0/convert["M4*SEC/KG"]["FT4*SEC/SLUG"];
-    // Pressure
-    convert["INHG"]["PSF"] = 70.7180803;
-    convert["PSF"]["INHG"] = 1.0/convert["INHG"]["PSF"];
-    convert["ATM"]["INHG"] = 29.9246899;
-    convert["INHG"]["ATM"] = 1.0/convert["ATM"]["INHG"];
-    convert["PSI"]["INHG"] = 2.03625437;
-    convert["INHG"]["PSI"] = 1.0/convert["PSI"]["INHG"];
-    convert["INHG"]["PA"] = 3386.0; // inches Mercury to pascals
-    convert["PA"]["INHG"] = 1.0/convert["INHG"]["PA"];
-    convert["LBS/FT2"]["N/M2"] = 14.5939/convert["FT"]["M"];
-    convert["N/M2"]["LBS/FT2"] = 1.0/convert["LBS/FT2"]["N/M2"];
-    convert["LBS/FT2"]["PA"] = convert["LBS/FT2"]["N/M2"];
-    convert["PA"]["LBS/FT2"] = 1.0/convert["LBS/FT2"]["PA"];
-    // Mass flow
-    convert["KG/MIN"]["LBS/MIN"] = convert["KG"]["LBS"];
-    // Fuel Consumption
-    convert["LBS/HP*HR"]["KG/KW*HR"] = 0.6083;
-    convert["KG/KW*HR"]["LBS/HP*HR"] = 1.0/convert["LBS/HP*HR"]["KG/KW*HR"];
-    // Density
-    convert["KG/L"]["LBS/GAL"] = 8.3454045;
-    convert["LBS/GAL"]["KG/L"] = 1.0/convert["KG/L"]["LBS/GAL"];
-
-    // Length
-    convert["M"]["M"] = 1.00;
-    convert["FT"]["FT"] = 1.00;
-    convert["IN"]["IN"] = 1.00;
-    // Area
-    convert["M2"]["M2"] = 1.00;
-    convert["FT2"]["FT2"] = 1.00;
-    // Volume
-    convert["IN3"]["IN3"] = 1.00;
-    convert["CC"]["CC"] = 1.0;
-    convert["M3"]["M3"] = 1.0;
-    convert["FT3"]["FT3"] = 1.0;
-    convert["LTR"]["LTR"] = 1.0;
-    // Mass & Weight
-    convert["KG"]["KG"] = 1.00;
-    convert["LBS"]["LBS"] = 1.00;
-    // Moments of Inertia
-    convert["KG*M2"]["KG*M2"] = 1.00;
-    convert["SLUG*FT2"]["SLUG*FT2"] = 1.00;
-    // Angles
-    convert["DEG"]["DEG"] = 1.00;
-    convert["RAD"]["RAD"] = 1.00;
-    // Angular rates
-    convert["DEG/SEC"]["DEG/SEC"] = 1.00;
-    convert["RAD/SEC"]["RAD/SEC"] = 1.00;
-    // Spring force
-    convert["LBS/FT"]["LBS/FT"] = 1.00;
-    convert["N/M"]["N/M"] = 1.00;
-    // Damping force
-    convert["LBS/FT/SEC"]["LBS/FT/SEC"] = 1.00;
-    convert["N/M/SEC"]["N/M/SEC"] = 1.00;
-    // Damping force (Square law)
-    convert["LBS/FT2/SEC2"]["LBS/FT2/SEC2"] = 1.00;
-    convert["N/M2/SEC2"]["N/M2/SEC2"] = 1.00;
-    // Power
-    convert["HP"]["HP"] = 1.00;
-    convert["WATTS"]["WATTS"] = 1.00;
-    // Force
-    convert["N"]["N"] = 1.00;
-    // Velocity
-    convert["FT/SEC"]["FT/SEC"] = 1.00;
-    convert["KTS"]["KTS"] = 1.00;
-    convert["M/S"]["M/S"] = 1.0;
-    convert["M/SEC"]["M/SEC"] = 1.0;
-    // Torque
-    convert["FT*LBS"]["FT*LBS"] = 1.00;
-    convert["N*M"]["N*M"] = 1.00;
-    // Valve
-    convert["M4*SEC/KG"]["M4*SEC/KG"] = 1.0;
-    convert["FT4*SEC/SLUG"]["FT4*SEC/SLUG"] = 1.0;
-    // Pressure
-    convert["PSI"]["PSI"] = 1.00;
-    convert["PSF"]["PSF"] = 1.00;
-    convert["INHG"]["INHG"] = 1.00;
-    convert["ATM"]["ATM"] = 1.0;
-    convert["PA"]["PA"] = 1.0;
-    convert["N/M2"]["N/M2"] = 1.00;
-    convert["LBS/FT2"]["LBS/FT2"] = 1.00;
-    // Mass flow
-    convert["LBS/SEC"]["LBS/SEC"] = 1.00;
-    convert["KG/MIN"]["KG/MIN"] = 1.0;
-    convert["LBS/MIN"]["LBS/MIN"] = 1.0;
-    // Fuel Consumption
-    convert["LBS/HP*HR"]["LBS/HP*HR"] = 1.0;
-    convert["KG/KW*HR"]["KG/KW*HR"] = 1.0;
-    // Density
-    convert["KG/L"]["KG/L"] = 1.0;
-    convert["LBS/GAL"]["LBS/GAL"] = 1.0;
-  }
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -394,22 +397,12 @@ double Element::FindElementValueAsNumberConvertTo(const string& el, const string
 
   string supplied_units = element->GetAttributeValue("unit");
 
-  if (!supplied_units.empty()) {
-    if (convert.find(supplied_units) == convert.end()) {
-      cerr << endl << "Supplied unit: \"" << supplied_units << "\" does not exist (typo?). Add new unit"
-           << " conversion in FGXMLElement.cpp." << endl;
-      exit(-1);
-    }
-    if (convert[supplied_units].find(target_units) == convert[supplied_units].end()) {
-      cerr << endl << "Supplied unit: \"" << supplied_units << "\" cannot be converted to "
-                   << target_units << ". Add new unit conversion in FGXMLElement.cpp or fix typo" << endl;
-      exit(-1);
-    }
-  }
+  double factor = 1.0;
+  if (!supplied_units.empty()) factor = GetConversionFactor(supplied_units, target_units);
 
   double value = element->GetDataAsNumber();
   if (!supplied_units.empty()) {
-    value *= convert[supplied_units][target_units];
+    value *= factor;
   }
 
   return value;
@@ -428,22 +421,12 @@ double Element::FindElementValueAsNumberConvertFromTo( const string& el,
     exit(0);
   }
 
-  if (!supplied_units.empty()) {
-    if (convert.find(supplied_units) == convert.end()) {
-      cerr << endl << "Supplied unit: \"" << supplied_units << "\" does not exist (typo?). Add new unit"
-           << " conversion in FGXMLElement.cpp." << endl;
-      exit(-1);
-    }
-    if (convert[supplied_units].find(target_units) == convert[supplied_units].end()) {
-      cerr << endl << "Supplied unit: \"" << supplied_units << "\" cannot be converted to "
-                   << target_units << ". Add new unit conversion in FGXMLElement.cpp or fix typo" << endl;
-      exit(-1);
-    }
-  }
+  double factor = 1.0;
+  if (!supplied_units.empty()) factor = GetConversionFactor(supplied_units, target_units);
 
   double value = element->GetDataAsNumber();
   if (!supplied_units.empty()) {
-    value *= convert[supplied_units][target_units];
+    value *= factor;
   }
 
   return value;
@@ -458,24 +441,14 @@ FGColumnVector3 Element::FindElementTripletConvertTo( const string& target_units
   double value=0.0;
   string supplied_units = GetAttributeValue("unit");
 
-  if (!supplied_units.empty()) {
-    if (convert.find(supplied_units) == convert.end()) {
-      cerr << endl << "Supplied unit: \"" << supplied_units << "\" does not exist (typo?). Add new unit"
-           << " conversion in FGXMLElement.cpp." << endl;
-      exit(-1);
-    }
-    if (convert[supplied_units].find(target_units) == convert[supplied_units].end()) {
-      cerr << endl << "Supplied unit: \"" << supplied_units << "\" cannot be converted to "
-                   << target_units << ". Add new unit conversion in FGXMLElement.cpp or fix typo" << endl;
-      exit(-1);
-    }
-  }
+  double factor = 1.0;
+  if (!supplied_units.empty()) factor = GetConversionFactor(supplied_units, target_units);
 
   item = FindElement("x");
   if (!item) item = FindElement("roll");
   if (item) {
     value = item->GetDataAsNumber();
-    if (!supplied_units.empty()) value *= convert[supplied_units][target_units];
+    if (!supplied_units.empty()) value *= factor;
   } else {
     value = 0.0;
     cerr << "Could not find an X triplet item for this column vector." << endl;
@@ -486,7 +459,7 @@ FGColumnVector3 Element::FindElementTripletConvertTo( const string& target_units
   if (!item) item = FindElement("pitch");
   if (item) {
     value = item->GetDataAsNumber();
-    if (!supplied_units.empty()) value *= convert[supplied_units][target_units];
+    if (!supplied_units.empty()) value *= factor;
   } else {
     value = 0.0;
     cerr << "Could not find a Y triplet item for this column vector." << endl;
@@ -497,7 +470,7 @@ FGColumnVector3 Element::FindElementTripletConvertTo( const string& target_units
   if (!item) item = FindElement("yaw");
   if (item) {
     value = item->GetDataAsNumber();
-    if (!supplied_units.empty()) value *= convert[supplied_units][target_units];
+    if (!supplied_units.empty()) value *= factor;
   } else {
     value = 0.0;
     cerr << "Could not find a Z triplet item for this column vector." << endl;
@@ -509,6 +482,28 @@ FGColumnVector3 Element::FindElementTripletConvertTo( const string& target_units
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+double Element::GetConversionFactor(const string& supplied_units, const string& target_units)
+{
+  bool known = false;
+
+  for (unsigned int i=0; i<nConversions; i++) {
+    if (supplied_units != ConversionTable[i].from) continue;
+    if (target_units == ConversionTable[i].to) return ConversionTable[i].factor;
+    known = true;
+  }
+
+  if (!known) {
+    cerr << endl << "Supplied unit: \"" << supplied_units << "\" does not exist (typo?). Add new unit"
+         << " conversion in FGXMLElement.cpp." << endl;
+  } else {
+    cerr << endl << "Supplied unit: \"" << supplied_units << "\" cannot be converted to "
+                 << target_units << ". Add new unit conversion in FGXMLElement.cpp or fix typo" << endl;
+  }
+  exit(-1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void Element::Print(unsigned int level)
 {
   unsigned int i, spaces;
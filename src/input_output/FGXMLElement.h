@@ -332,9 +332,11 @@ private:
   std::vector <std::string> attribute_key;
   Element *parent;
   unsigned int element_index;
-  typedef std::map <std::string, std::map <std::string, double> > tMapConvert;
-  static tMapConvert convert;
-  static bool converterIsInitialized;
+
+  /** Returns the factor that converts a value from one unit to another.
+      The program exits if the conversion is not known. */
+  static double GetConversionFactor(const std::string& supplied_units,
+                                    const std::string& target_units);
 };
 
 } // namespace JSBSim
@@ -0,0 +1,543 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGfdmServer.cpp
+ Date started: October 16 2026
+ Purpose:      Serves line based commands to any number of TCP clients
+ Called by:    FGInput
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+This class accepts the connections of the clients of the input port and
+buffers what they send and what is sent to them, without ever blocking.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <cstring>
+#include "FGfdmServer.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  #include <winsock.h>
+  typedef int socklen_t;
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #include <errno.h>
+  #include <sys/types.h>
+  #include <sys/socket.h>
+  #include <sys/select.h>
+  #include <sys/time.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+  #if defined(__linux__)
+    #include <sys/epoll.h>
+    #define USE_EPOLL
+  #endif
+#endif
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGfdmServer.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_FDMSERVER;
+
+static const char prompt[] = "JSBSim> ";
+static const char greeting[] = "Connected to JSBSim server\nJSBSim> ";
+
+// The bytes read from a client in one Poll(): the rest waits for the next one
+static const size_t max_read = 65536;
+// What a client may have waiting, in each direction, before it is disconnected
+static const size_t max_input = 1 << 20;
+static const size_t max_output = 1 << 20;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static void SetNonBlocking(int fd)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  unsigned long NoBlock = true;
+  ioctlsocket(fd, FIONBIO, &NoBlock);
+#else
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static void CloseSocket(int fd)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  closesocket(fd);
+#else
+  close(fd);
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns true if the last call on a socket failed only because it would have
+// had to wait.
+
+static bool WouldBlock(void)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmServer::FGfdmServer(int port)
+{
+  int one = 1;
+
+  sckt = epoll_fd = -1;
+  listening = false;
+  next_client = next_message = 0;
+
+  #if defined(_MSC_VER) || defined(__MINGW32__)
+    WSADATA wsaData;
+    int wsaReturnCode;
+    wsaReturnCode = WSAStartup(MAKEWORD(1,1), &wsaData);
+    if (wsaReturnCode == 0) cout << "Winsock DLL loaded ..." << endl;
+    else cerr << "Winsock DLL not initialized ..." << endl;
+  #endif
+
+  sckt = socket(AF_INET, SOCK_STREAM, 0);
+
+  if (sckt >= 0) {  // successful
+    // this allows us to reuse the port number as soon as JSBSim exits
+    setsockopt(sckt, SOL_SOCKET, SO_REUSEADDR, (const char*)&one, sizeof(one));
+
+    struct sockaddr_in scktName;
+    memset(&scktName, 0, sizeof(struct sockaddr_in));
+    scktName.sin_family = AF_INET;
+    scktName.sin_port = htons(port);
+    if (bind(sckt, (struct sockaddr*)&scktName, sizeof(scktName)) == 0 &&
+        listen(sckt, SOMAXCONN) == 0)
+    {
+      SetNonBlocking(sckt);
+#ifdef USE_EPOLL
+      epoll_fd = epoll_create(64);
+      if (epoll_fd >= 0) {
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = 0;   // The listening socket
+        listening = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sckt, &event) == 0;
+      }
+#else
+      listening = true;
+#endif
+      if (listening)
+        cout << "Successfully bound to socket for input on port " << port << endl;
+      else
+        cerr << "Could not watch the socket for input ..." << endl;
+    } else {                // unsuccessful
+      cerr << "Could not bind to socket for input ..." << endl;
+    }
+  } else {          // unsuccessful
+    cerr << "Could not create socket for FDM input, error = " << errno << endl;
+  }
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmServer::~FGfdmServer()
+{
+  for (unsigned int i=0; i<Clients.size(); i++) Remove(Clients[i]);
+  Clients.clear();
+  if (sckt >= 0) CloseSocket(sckt);
+#ifdef USE_EPOLL
+  if (epoll_fd >= 0) close(epoll_fd);
+#endif
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGfdmServer::Poll(int timeout)
+{
+  bool activity = false;
+
+  if (!listening) return false;
+
+  // The lines returned since the last call are dropped along with the clients
+  // that have gone.
+  unsigned int kept = 0;
+  for (unsigned int i=0; i<Clients.size(); i++) {
+    Client* client = Clients[i];
+    if (client->dead) {
+      Remove(client);
+    } else {
+      client->in.erase(0, client->parsed);
+      client->parsed = 0;
+      Clients[kept++] = client;
+    }
+  }
+  Clients.resize(kept);
+  next_client = next_message = 0;
+
+#ifdef USE_EPOLL
+  struct epoll_event events[64];
+  int count = epoll_wait(epoll_fd, events, 64, timeout);
+
+  for (int i=0; i<count; i++) {
+    Client* client = (Client*)events[i].data.ptr;
+    if (client == 0) Accept();
+    else Read(client);
+    activity = true;
+  }
+#else
+  fd_set fds;
+  int max_fd = sckt;
+  unsigned int watched = Clients.size();
+
+  FD_ZERO(&fds);
+  FD_SET(sckt, &fds);
+  for (unsigned int i=0; i<watched; i++) {
+    FD_SET(Clients[i]->fd, &fds);
+    if (Clients[i]->fd > max_fd) max_fd = Clients[i]->fd;
+  }
+
+  struct timeval tv;
+  tv.tv_sec = timeout / 1000;
+  tv.tv_usec = (timeout % 1000) * 1000;
+
+  if (select(max_fd+1, &fds, NULL, NULL, timeout < 0 ? NULL : &tv) > 0) {
+    for (unsigned int i=0; i<watched; i++) {
+      if (FD_ISSET(Clients[i]->fd, &fds)) Read(Clients[i]);
+    }
+    if (FD_ISSET(sckt, &fds)) Accept();
+    activity = true;
+  }
+#endif
+
+  return activity;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGfdmServer::Wait(void)
+{
+  if (!listening) return false;
+
+  while (1) {
+    bool pending = false;
+
+    Flush();
+    for (unsigned int i=0; i<Clients.size(); i++)
+      if (!Clients[i]->dead && !Clients[i]->out.empty()) pending = true;
+
+    // The replies that could not be sent yet are retried every 10 ms
+    if (Poll(pending ? 10 : -1)) return true;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Accept(void)
+{
+  while (1) {
+    struct sockaddr_in address;
+    socklen_t len = sizeof(address);
+    int fd = (int)accept(sckt, (struct sockaddr*)&address, &len);
+    if (fd < 0) break;
+
+    int one = 1;
+    SetNonBlocking(fd);
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&one, sizeof(one));
+#endif
+
+    Client* client = new Client;
+    client->fd = fd;
+    client->parsed = 0;
+    client->closing = client->dead = client->binary = false;
+    client->out.assign(greeting, sizeof(greeting)-1);
+
+#ifdef USE_EPOLL
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = client;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+      CloseSocket(fd);
+      delete client;
+      continue;
+    }
+#endif
+
+    Clients.push_back(client);
+    Send(client);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Read(Client* client)
+{
+  char buf[4096];
+  size_t total = 0;
+
+  if (client->dead) return;
+
+  while (total < max_read) {
+    int num_chars = recv(client->fd, buf, sizeof(buf), 0);
+    if (num_chars > 0) {
+      client->in.append(buf, num_chars);
+      total += num_chars;
+    } else {
+      // 0 means that the client has closed the connection
+      if (num_chars < 0 && WouldBlock()) break;
+      client->dead = true;
+      break;
+    }
+  }
+
+  if (client->in.size() > max_input) {
+    cerr << "Input client sent too long a line, disconnecting it" << endl;
+    client->dead = true;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGfdmServer::NextLine(unsigned int& index, const char*& line, size_t& length)
+{
+  while (next_client < Clients.size()) {
+    Client* client = Clients[next_client];
+
+    if (!client->closing && !client->binary) {
+      const char* data = client->in.data();
+      size_t size = client->in.size();
+      size_t start = client->parsed;
+
+      while (start < size && (data[start] == '\r' || data[start] == '\n')) start++;
+      size_t end = start;
+      while (end < size && data[end] != '\r' && data[end] != '\n') end++;
+      client->parsed = start;
+
+      if (end < size) {   // A complete line
+        client->parsed = end;
+        index = next_client;
+        line = data + start;
+        length = end - start;
+        return true;
+      }
+    }
+    next_client++;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGfdmServer::NextMessage(unsigned int& index, const char*& message, size_t& length)
+{
+  while (next_message < Clients.size()) {
+    Client* client = Clients[next_message];
+
+    if (!client->closing && !client->dead && client->binary) {
+      const unsigned char* data = (const unsigned char*)client->in.data();
+      size_t available = client->in.size() - client->parsed;
+
+      if (available >= 4) {
+        const unsigned char* p = data + client->parsed;
+        size_t size = p[0] | (p[1] << 8) | (p[2] << 16) | ((size_t)p[3] << 24);
+        if (size < 8 || size > max_input) {
+          cerr << "Input client sent a malformed message, disconnecting it" << endl;
+          client->dead = true;
+        } else if (available >= size) {
+          index = next_message;
+          message = client->in.data() + client->parsed;
+          length = size;
+          client->parsed += size;
+          return true;
+        }
+      }
+    }
+    next_message++;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::SetBinary(unsigned int index)
+{
+  if (index >= Clients.size()) return;
+
+  Client* client = Clients[index];
+  const string& in = client->in;
+
+  if (client->parsed < in.size() && in[client->parsed] == '\r') client->parsed++;
+  if (client->parsed < in.size() && in[client->parsed] == '\n') client->parsed++;
+  client->binary = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Reply(unsigned int index, const char* text, size_t length)
+{
+  if (index >= Clients.size()) return;
+
+  Client* client = Clients[index];
+  if (client->dead) return;
+
+  client->out.append(text, length);
+  client->out.append(prompt, sizeof(prompt)-1);
+
+  if (client->out.size() > max_output) {
+    cerr << "Input client does not read its replies, disconnecting it" << endl;
+    client->dead = true;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Write(unsigned int index, const char* data, size_t length)
+{
+  if (index >= Clients.size()) return;
+
+  Client* client = Clients[index];
+  if (client->dead) return;
+
+  client->out.append(data, length);
+
+  if (client->out.size() > max_output) {
+    cerr << "Input client does not read its replies, disconnecting it" << endl;
+    client->dead = true;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Close(unsigned int index)
+{
+  if (index < Clients.size()) Clients[index]->closing = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Flush(void)
+{
+  for (unsigned int i=0; i<Clients.size(); i++) {
+    Client* client = Clients[i];
+    if (client->dead) continue;
+    if (!client->out.empty()) Send(client);
+    if (client->closing && client->out.empty()) client->dead = true;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Send(Client* client)
+{
+  size_t sent = 0;
+
+  while (sent < client->out.size()) {
+    int num_chars = send(client->fd, client->out.data() + sent,
+                         client->out.size() - sent, MSG_NOSIGNAL);
+    if (num_chars > 0) {
+      sent += num_chars;
+    } else {
+      if (num_chars < 0 && WouldBlock()) break;
+      client->dead = true;
+      break;
+    }
+  }
+
+  client->out.erase(0, sent);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmServer::Remove(Client* client)
+{
+#ifdef USE_EPOLL
+  struct epoll_event event;   // Needed by kernels older than 2.6.9
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client->fd, &event);
+#endif
+  CloseSocket(client->fd);
+  delete client;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGfdmServer::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 0) { // Constructor
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGfdmServer" << endl;
+    if (from == 1) cout << "Destroyed:    FGfdmServer" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
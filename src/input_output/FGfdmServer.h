@@ -0,0 +1,166 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGfdmServer.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGFDMSERVER_H
+#define FGFDMSERVER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_FDMSERVER "$Id: FGfdmServer.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A TCP server for line based commands, serving any number of clients at once.
+    Nothing in it blocks: the listening socket and the connections are non
+    blocking, and they are watched with epoll on Linux (select() elsewhere).
+    Poll() accepts the waiting clients and appends what each one has sent to
+    a buffer of its own; NextLine() then returns the complete lines, pointing
+    into those buffers, so that they can be parsed without being copied. A
+    line that is not complete yet stays in the buffer until the rest of it
+    has arrived.
+
+    The replies are appended to an output buffer per client, and Flush()
+    sends as much of them as the sockets accept; the rest is sent later. A
+    client that sends a line longer than the input limit, or that does not
+    read its replies, is disconnected rather than allowed to hold memory.
+
+    Each reply is followed by the "JSBSim> " prompt, as with FGfdmSocket.
+
+    A client can also be switched to binary messages (SetBinary()). The
+    bytes it sends are then cut in messages, each one beginning with its size
+    as a 32 bit little endian integer (the size includes these 4 bytes), and
+    returned by NextMessage() instead of NextLine(); Write() sends bytes to it
+    as they are, without a prompt.
+    @version "$Id: FGfdmServer.h,v 1.0 2026/10/16 00:00:00 $"
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGfdmServer : public FGJSBBase
+{
+public:
+  /** Listens for clients on a port of all the interfaces of the machine.
+      @param port the TCP port */
+  FGfdmServer(int port);
+  ~FGfdmServer();
+
+  /// Returns true if the server could bind its port and listen.
+  bool IsListening(void) const {return listening;}
+  /// Returns the number of clients connected.
+  unsigned int GetNumClients(void) const {return (unsigned int)Clients.size();}
+
+  /** Accepts the clients waiting and reads what the clients have sent.
+      The lines returned by NextLine() before the call are no longer valid
+      after it, and neither are the numbers of the clients.
+      @param timeout the time to wait for something to happen, in
+             milliseconds: 0 returns at once, -1 waits as long as needed
+      @return true if a client connected or sent something */
+  bool Poll(int timeout = 0);
+
+  /** Waits until a client connects or sends something, then reads it.
+      @return true unless the server is not listening */
+  bool Wait(void);
+
+  /** Returns the next complete line received, from any client. The line does
+      not include its end of line characters; empty lines are skipped.
+      @param client receives the number of the client that sent it
+      @param line receives the start of the line, which is not null terminated
+      @param length receives the length of the line
+      @return false when there are no more complete lines */
+  bool NextLine(unsigned int& client, const char*& line, size_t& length);
+
+  /** Returns the next complete message received from a client in binary
+      mode, from its size field to its end.
+      @param client receives the number of the client that sent it
+      @param message receives the start of the message
+      @param length receives the length of the message, at least 8
+      @return false when there are no more complete messages */
+  bool NextMessage(unsigned int& client, const char*& message, size_t& length);
+
+  /** Switches a client to binary messages. The end of line of the command
+      that asked for it is skipped: the first message follows it. */
+  void SetBinary(unsigned int client);
+
+  /** Queues a reply to a client, followed by the prompt.
+      @param client the number of the client, as given by NextLine() */
+  void Reply(unsigned int client, const char* text, size_t length);
+  void Reply(unsigned int client, const std::string& text) {
+    Reply(client, text.data(), text.size());
+  }
+  /// Queues bytes to send to a client, as they are.
+  void Write(unsigned int client, const char* data, size_t length);
+  /// Closes a connection once the replies queued for it have been sent.
+  void Close(unsigned int client);
+
+  /// Sends the replies queued, as far as the sockets accept them.
+  void Flush(void);
+
+private:
+  struct Client {
+    int fd;
+    std::string in;     // The bytes received and not returned as lines yet
+    size_t parsed;      // The start of the bytes in "in" not parsed yet
+    std::string out;    // The bytes waiting to be sent
+    bool closing;       // Closed once "out" has been sent
+    bool binary;        // Sends messages instead of lines
+    bool dead;          // Removed by the next Poll()
+  };
+
+  int sckt;
+  int epoll_fd;
+  bool listening;
+  std::vector <Client*> Clients;
+  unsigned int next_client, next_message;
+
+  void Accept(void);
+  void Read(Client* client);
+  void Send(Client* client);
+  void Remove(Client* client);
+  void Debug(int from);
+};
+}
+#endif
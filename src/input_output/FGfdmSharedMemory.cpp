@@ -0,0 +1,209 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGfdmSharedMemory.cpp
+ Date started: October 16 2026
+ Purpose:      Publishes output values in a shared memory segment
+ Called by:    FGOutput
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+This class maps a named shared memory segment and copies the values of an
+output into it under a sequence lock, so that the readers never see a half
+written set of values and the writer never waits for them.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <cstring>
+#include "FGfdmSharedMemory.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  #include <windows.h>
+  #define MEMORY_BARRIER() MemoryBarrier()
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #include <sys/types.h>
+  #include <sys/mman.h>
+  #define MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGfdmSharedMemory.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_FDMSHAREDMEMORY;
+
+static const char magic[8] = {'J','S','B','S','S','H','M','\0'};
+static const unsigned int version = 1;
+static const size_t names_offset = 64;
+static const size_t line_size = 64;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGfdmSharedMemory::FGfdmSharedMemory(const string& name, const string& names,
+                                     unsigned int columns)
+{
+  base = 0;
+  sequence = 0;
+  Columns = columns;
+  Name = name;
+  if (Name.empty() || Name[0] != '/') Name = "/" + Name;
+
+  // The values start on a cache line of their own, after the names
+  data_offset = (names_offset + names.size() + line_size - 1) / line_size * line_size;
+  size = data_offset + Columns*sizeof(double);
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  string mapping_name = Name.substr(1);
+  mapping_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                      0, (DWORD)size, mapping_name.c_str());
+  if (mapping_handle != NULL) {
+    base = (char*)MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (base == 0) {
+      CloseHandle(mapping_handle);
+      mapping_handle = NULL;
+    }
+  }
+#else
+  int fd = shm_open(Name.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd >= 0) {
+    if (ftruncate(fd, size) == 0) {
+      void* mapping = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (mapping != MAP_FAILED) base = (char*)mapping;
+    }
+    close(fd);  // The mapping stays valid
+    if (base == 0) shm_unlink(Name.c_str());
+  }
+#endif
+
+  if (base == 0) {
+    cerr << "Could not create the shared memory segment " << Name << endl;
+    Debug(0);
+    return;
+  }
+
+  // A reader that maps the segment before the header is complete sees an
+  // odd sequence number, and the magic is written last.
+  sequence = (volatile unsigned int*)(base + 20);
+  *sequence = 1;
+  MEMORY_BARRIER();
+  unsigned int fields[3];
+  fields[0] = version;
+  fields[1] = Columns;
+  fields[2] = (unsigned int)data_offset;
+  memcpy(base + 8, fields, sizeof(fields));
+  memset(base + 24, 0, data_offset - 24);
+  memcpy(base + names_offset, names.data(), names.size());
+  memset(base + data_offset, 0, Columns*sizeof(double));
+  MEMORY_BARRIER();
+  memcpy(base, magic, sizeof(magic));
+  MEMORY_BARRIER();
+  *sequence = 2;
+
+  cout << "Publishing " << Columns << " values in the shared memory segment "
+       << Name << endl;
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmSharedMemory::~FGfdmSharedMemory()
+{
+  if (base != 0) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    UnmapViewOfFile(base);
+    CloseHandle(mapping_handle);
+#else
+    munmap(base, size);
+    shm_unlink(Name.c_str());
+#endif
+  }
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmSharedMemory::Publish(const double* values)
+{
+  if (base == 0) return;
+
+  unsigned int seq = *sequence;
+  *sequence = seq + 1;
+  MEMORY_BARRIER();
+  memcpy(base + data_offset, values, Columns*sizeof(double));
+  MEMORY_BARRIER();
+  *sequence = seq + 2;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGfdmSharedMemory::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 0) { // Constructor
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGfdmSharedMemory" << endl;
+    if (from == 1) cout << "Destroyed:    FGfdmSharedMemory" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
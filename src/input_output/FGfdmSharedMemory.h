@@ -0,0 +1,125 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGfdmSharedMemory.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGFDMSHAREDMEMORY_H
+#define FGFDMSHAREDMEMORY_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <cstddef>
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_FDMSHAREDMEMORY "$Id: FGfdmSharedMemory.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Publishes the values of an output in a named shared memory segment.
+    The programs running on the same machine map the segment and read the
+    latest values from it, without a system call and without the simulation
+    ever waiting for them. The segment is created with shm_open() (a file
+    mapping on Windows), under the name of the output.
+
+    The values are protected by a sequence lock: the sequence number is made
+    odd before they are written and even again after, so a reader copies them
+    between two reads of the number and starts over if the two differ or are
+    odd:
+<pre>
+    do {
+      s1 = sequence; (memory barrier)
+      copy the values
+      (memory barrier) s2 = sequence;
+    } while (s1 != s2 || (s1 & 1));
+</pre>
+    The segment begins with the following header, where the integers are
+    unsigned and 32 bits wide:
+<pre>
+    offset  0   magic       8 characters, "JSBSSHM" and a null character
+    offset  8   version     1
+    offset 12   columns     the number of values
+    offset 16   data        the offset of the values, a multiple of 64
+    offset 20   sequence    the sequence number, odd while being written
+    offset 24   reserved    0, up to offset 64
+    offset 64   names       the header of a BINARY output (see FGOutput),
+                            which gives the name and the unit of each value
+    offset data values      one double per column, in the byte order of the
+                            machine
+</pre>
+    @version "$Id: FGfdmSharedMemory.h,v 1.0 2026/10/16 00:00:00 $"
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGfdmSharedMemory : public FGJSBBase
+{
+public:
+  /** Creates the segment, or resizes it if it already exists.
+      @param name the name of the segment; a leading '/' is added if missing
+      @param names the header of a BINARY output that describes the columns
+      @param columns the number of values published */
+  FGfdmSharedMemory(const std::string& name, const std::string& names,
+                    unsigned int columns);
+  /// Unmaps and removes the segment. The readers keep their mapping.
+  ~FGfdmSharedMemory();
+
+  /// Returns true if the segment could be created and mapped.
+  bool IsOpen(void) const {return base != 0;}
+
+  /** Publishes a set of values.
+      @param values the values, as many as the columns */
+  void Publish(const double* values);
+
+private:
+  std::string Name;
+  char* base;
+  size_t size;
+  unsigned int Columns;
+  size_t data_offset;
+  volatile unsigned int* sequence;
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  void* mapping_handle;
+#endif
+
+  void Debug(int from);
+};
+}
+#endif
@@ -61,6 +61,7 @@ CLASS IMPLEMENTATION
 
 FGfdmSocket::FGfdmSocket(const string& address, int port, int protocol)
 {
+  this->protocol = protocol;
   sckt = sckt_in = 0;
   connected = false;
 
@@ -109,6 +110,7 @@ FGfdmSocket::FGfdmSocket(const string& address, int port, int protocol)
 
 FGfdmSocket::FGfdmSocket(const string& address, int port)
 {
+  protocol = ptTCP;
   sckt = sckt_in = 0;
   connected = false;
 
@@ -155,6 +157,7 @@ FGfdmSocket::FGfdmSocket(const string& address, int port)
 
 FGfdmSocket::FGfdmSocket(int port)
 {
+  protocol = ptTCP;
   connected = false;
   unsigned long NoBlock = true;
   int one = 1;
@@ -356,6 +359,129 @@ void FGfdmSocket::Send(const char *data, int length)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmSocketBatch::~FGfdmSocketBatch()
+{
+#if defined(__linux__)
+  std::map <in_addr_t, int>::iterator it;
+  for (it = HostSockets.begin(); it != HostSockets.end(); ++it)
+    if (it->second >= 0) close(it->second);
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmSocketBatch::Add(FGfdmSocket* socket, const char* data, int length)
+{
+  if (length <= 0) return;
+
+  Packet packet;
+  packet.socket = socket;
+  packet.data = data;
+  packet.length = length;
+  Packets.push_back(packet);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGfdmSocketBatch::Holds(const char* data) const
+{
+  for (unsigned int i=0; i<Packets.size(); i++)
+    if (Packets[i].data == data) return true;
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+#if defined(__linux__)
+int FGfdmSocketBatch::HostSocket(in_addr_t host)
+{
+  std::map <in_addr_t, int>::iterator it = HostSockets.find(host);
+  if (it != HostSockets.end()) return it->second;
+
+  int sckt = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sckt < 0) perror("socket");
+  HostSockets[host] = sckt;
+  return sckt;
+}
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmSocketBatch::Send(void)
+{
+  if (Packets.empty()) return;
+
+#if defined(__linux__)
+  // A packet is done (socket = 0) once it is sent or dropped. The UDP packets
+  // to the host of the first one left go together. The headers keep their
+  // memory between frames.
+  Buffers.resize(Packets.size());
+
+  for (unsigned int i=0; i<Packets.size(); i++) {
+    FGfdmSocket* socket = Packets[i].socket;
+    if (socket == 0) continue;
+
+    if (!socket->GetConnectStatus()) {
+      Packets[i].socket = 0;
+      continue;
+    }
+
+    if (socket->protocol != FGfdmSocket::ptUDP) {
+      socket->Send(Packets[i].data, Packets[i].length);
+      Packets[i].socket = 0;
+      continue;
+    }
+
+    in_addr_t host = socket->scktName.sin_addr.s_addr;
+    int sckt = HostSocket(host);
+
+    Headers.clear();
+    for (unsigned int j=i; j<Packets.size(); j++) {
+      FGfdmSocket* s = Packets[j].socket;
+      if (s == 0 || !s->GetConnectStatus() || s->protocol != FGfdmSocket::ptUDP
+          || s->scktName.sin_addr.s_addr != host) continue;
+
+      if (sckt < 0) {
+        s->Send(Packets[j].data, Packets[j].length);
+      } else {
+        struct mmsghdr header;
+        memset(&header, 0, sizeof(header));
+        Buffers[j].iov_base = const_cast<char*>(Packets[j].data);
+        Buffers[j].iov_len = Packets[j].length;
+        header.msg_hdr.msg_name = &s->scktName;
+        header.msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        header.msg_hdr.msg_iov = &Buffers[j];
+        header.msg_hdr.msg_iovlen = 1;
+        Headers.push_back(header);
+      }
+      Packets[j].socket = 0;
+    }
+
+    unsigned int sent = 0;
+    while (sent < Headers.size()) {
+      int n = sendmmsg(sckt, &Headers[sent], Headers.size() - sent, 0);
+      if (n > 0) {
+        sent += n;
+      } else {
+        // The packet that failed is lost, as it could be on the way, but not
+        // the ones after it
+        perror("sendmmsg");
+        sent++;
+      }
+    }
+  }
+#else
+  for (unsigned int i=0; i<Packets.size(); i++) {
+    if (!Packets[i].socket->GetConnectStatus()) continue;
+    Packets[i].socket->Send(Packets[i].data, Packets[i].length);
+  }
+#endif
+
+  Packets.clear();
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
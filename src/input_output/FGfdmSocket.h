@@ -41,6 +41,8 @@ INCLUDES
 
 #include <string>
 #include <sstream>
+#include <vector>
+#include <map>
 #include <sys/types.h>
 #include "FGJSBBase.h"
 
@@ -55,6 +57,9 @@ INCLUDES
   #include <netdb.h>
   #include <errno.h>
   #include <sys/ioctl.h>
+  #if defined(__linux__)
+    #include <sys/uio.h>
+  #endif
 #endif
 
 #ifdef _MSC_VER
@@ -111,6 +116,9 @@ public:
   enum {ptUDP, ptTCP};
 
 private:
+  friend class FGfdmSocketBatch;
+
+  int protocol;
   int sckt;
   int sckt_in;
   struct sockaddr_in scktName;
@@ -119,5 +127,54 @@ private:
   bool connected;
   void Debug(int from);
 };
+
+/** Sends the packets of several output sockets together.
+    The packets are queued during a frame and sent at its end. On Linux, the
+    UDP packets to the same host are then handed to the kernel in a single
+    sendmmsg() call, each with its own destination (host and port), through
+    one unconnected UDP socket that the batch keeps for that host: they leave
+    from the port of that socket, not from the ones of their output sockets.
+    Elsewhere, for TCP, and if the socket of a host cannot be created, the
+    packets are sent one by one through their own sockets. The packets of a
+    socket that is not connected are dropped.
+
+    The packets are not copied: their data must be left unchanged until they
+    are sent, which the FlightGear output does by filling two packets in turn
+    (and, when it is run more than once in a frame, by sending the batch
+    before it fills a packet still queued).
+  */
+
+class FGfdmSocketBatch
+{
+public:
+  /// Closes the sockets of the hosts.
+  ~FGfdmSocketBatch();
+
+  /** Queues a packet.
+      @param socket the socket it is sent to
+      @param data the packet, which is not copied
+      @param length its size in bytes */
+  void Add(FGfdmSocket* socket, const char* data, int length);
+  /// Tells whether a packet is queued and not sent yet.
+  bool Holds(const char* data) const;
+  /// Sends the packets queued.
+  void Send(void);
+
+private:
+  struct Packet {
+    FGfdmSocket* socket;
+    const char* data;
+    int length;
+  };
+  std::vector <Packet> Packets;
+#if defined(__linux__)
+  std::vector <struct mmsghdr> Headers;
+  std::vector <struct iovec> Buffers;
+  // The UDP socket of each host (-1 if it could not be created), by address
+  std::map <in_addr_t, int> HostSockets;
+
+  int HostSocket(in_addr_t host);
+#endif
+};
 }
 #endif
@@ -0,0 +1,571 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGfdmTelemetry.cpp
+ Date started: October 16 2026
+ Purpose:      Streams the properties clients subscribe to over UDP
+ Called by:    FGOutput
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+This class keeps the subscriptions of the telemetry clients and sends each of
+them the values of its properties that changed, at the rate it asked for.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include "FGfdmTelemetry.h"
+#include "FGPropertyManager.h"
+#include "math/FGRandom.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  #include <winsock.h>
+  typedef int socklen_t;
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #include <errno.h>
+  #include <sys/types.h>
+  #include <sys/socket.h>
+  #include <netinet/in.h>
+  #include <netdb.h>
+#endif
+
+static const int endianTest = 1;
+#define isLittleEndian (*((char *) &endianTest ) != 0)
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGfdmTelemetry.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_FDMTELEMETRY;
+
+enum {msgSubscribe=1, msgSubscribed, msgUnsubscribe, msgKeyframe, msgUpdate, msgError,
+      msgChallenge};
+
+// A keyframe of this many values still fits in a datagram
+static const size_t max_properties = 4096;
+static const size_t max_subscriptions = 256;
+// The datagrams read in one Run(): the rest waits for the next one
+static const int max_reads = 64;
+// The seconds a subscription lasts without being renewed
+static const time_t lease = 30;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static unsigned int GetLE32(const char* p)
+{
+  const unsigned char* b = (const unsigned char*)p;
+  return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int)b[3] << 24);
+}
+
+static double GetLEDouble(const char* p)
+{
+  double value;
+  char* bytes = (char*)&value;
+
+  if (isLittleEndian) memcpy(bytes, p, 8);
+  else for (int i=0; i<8; i++) bytes[i] = p[7-i];
+  return value;
+}
+
+static void AppendLE16(string& buf, unsigned int value)
+{
+  buf += (char)(value & 0xff);
+  buf += (char)((value >> 8) & 0xff);
+}
+
+static void AppendLE32(string& buf, unsigned int value)
+{
+  for (int i=0; i<4; i++) buf += (char)((value >> 8*i) & 0xff);
+}
+
+static void AppendLEDouble(string& buf, double value)
+{
+  const char* bytes = (const char*)&value;
+
+  if (isLittleEndian) buf.append(bytes, 8);
+  else for (int i=7; i>=0; i--) buf += bytes[i];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmTelemetry::FGfdmTelemetry(FGPropertyManager* root, const string& address,
+                               int port)
+{
+  Root = root;
+  last_time = 0.0;
+  MaxRate = 0.0;
+  Datagram.resize(65536);
+
+  // The cookies must not be guessed by a client that does not receive them
+  Secret[0] = (unsigned int)::time(0);
+  Secret[1] = (unsigned int)(size_t)this ^ (unsigned int)clock();
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+  FILE* random = fopen("/dev/urandom", "rb");
+  if (random) {
+    unsigned int bytes[2];
+    if (fread(bytes, sizeof(bytes), 1, random) == 1) {
+      Secret[0] ^= bytes[0];
+      Secret[1] ^= bytes[1];
+    }
+    fclose(random);
+  }
+#endif
+
+  #if defined(_MSC_VER) || defined(__MINGW32__)
+    WSADATA wsaData;
+    int wsaReturnCode;
+    wsaReturnCode = WSAStartup(MAKEWORD(1,1), &wsaData);
+    if (wsaReturnCode == 0) cout << "Winsock DLL loaded ..." << endl;
+    else cerr << "Winsock DLL not initialized ..." << endl;
+  #endif
+
+  struct sockaddr_in scktName;
+  memset(&scktName, 0, sizeof(struct sockaddr_in));
+  scktName.sin_family = AF_INET;
+  scktName.sin_port = htons(port);
+  scktName.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  // Only the clients of this machine are served, unless an interface is given
+  bool resolved = true;
+  if (!address.empty()) {
+    struct hostent *host = gethostbyname(address.c_str());
+    if (host != NULL) {
+      memcpy(&scktName.sin_addr, host->h_addr_list[0], host->h_length);
+    } else {
+      cerr << "Could not get the address of " << address << " for telemetry" << endl;
+      resolved = false;
+    }
+  }
+
+  sckt = resolved ? (int)socket(AF_INET, SOCK_DGRAM, 0) : -1;
+
+  if (sckt >= 0) {  // successful
+    if (bind(sckt, (struct sockaddr*)&scktName, sizeof(scktName)) == 0) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+      unsigned long NoBlock = true;
+      ioctlsocket(sckt, FIONBIO, &NoBlock);
+#else
+      fcntl(sckt, F_SETFL, fcntl(sckt, F_GETFL, 0) | O_NONBLOCK);
+#endif
+      cout << "Successfully bound to UDP port " << port << " of "
+           << (address.empty() ? "the loopback interface" : address)
+           << " for telemetry" << endl;
+    } else {                // unsuccessful
+      cerr << "Could not bind to UDP port " << port << " for telemetry" << endl;
+#if defined(_MSC_VER) || defined(__MINGW32__)
+      closesocket(sckt);
+#else
+      close(sckt);
+#endif
+      sckt = -1;
+    }
+  } else if (resolved) {          // unsuccessful
+    cerr << "Could not create socket for telemetry" << endl;
+  }
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmTelemetry::~FGfdmTelemetry()
+{
+  for (unsigned int i=0; i<Subscriptions.size(); i++) delete Subscriptions[i];
+  Subscriptions.clear();
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  if (sckt >= 0) closesocket(sckt);
+#else
+  if (sckt >= 0) close(sckt);
+#endif
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmTelemetry::Run(double time, double max_rate)
+{
+  if (sckt < 0) return;
+
+  MaxRate = max_rate;
+
+  for (int i=0; i<max_reads; i++) {
+    struct sockaddr_in from;
+    socklen_t len = sizeof(from);
+    int size = recvfrom(sckt, &Datagram[0], (int)Datagram.size(), 0,
+                        (struct sockaddr*)&from, &len);
+    if (size < 0) break;  // Nothing more to read (or an ICMP error, ignored)
+    Receive(from.sin_addr.s_addr, from.sin_port, &Datagram[0], size);
+  }
+
+  // The simulation has been reset: the schedules start over
+  if (time < last_time) {
+    for (unsigned int i=0; i<Subscriptions.size(); i++) {
+      Subscriptions[i]->next = time;
+      Subscriptions[i]->keyframe_due = true;
+    }
+  }
+  last_time = time;
+
+  time_t now = ::time(0);
+  unsigned int kept = 0;
+  for (unsigned int i=0; i<Subscriptions.size(); i++) {
+    Subscription* sub = Subscriptions[i];
+    if (now - sub->renewed > lease) {
+      delete sub;
+      continue;
+    }
+    Subscriptions[kept++] = sub;
+    // A small margin, so that a rate that divides the rate of the output is
+    // not pushed back by a frame by the rounding of the time
+    if (time + 1e-9 >= sub->next) {
+      Update(sub, time);
+      sub->next += sub->period;
+      if (sub->next <= time) sub->next = time + sub->period;
+    }
+  }
+  Subscriptions.resize(kept);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmTelemetry::Receive(unsigned long host, unsigned short port,
+                             const char* data, size_t length)
+{
+  if (length < 16 || GetLE32(data) != length) return; // Not one of ours
+
+  unsigned int type = GetLE32(data+4);
+  unsigned int id = GetLE32(data+8);
+  unsigned int cookie = Cookie(host, port, id);
+
+  // Nothing else is sent before the client has shown that it gets the replies
+  if (GetLE32(data+12) != cookie) {
+    StartMessage(msgChallenge);
+    AppendLE32(Message, id);
+    AppendLE32(Message, cookie);
+    SendMessage(host, port);
+    return;
+  }
+
+  Subscription* sub = Find(host, port, id);
+
+  switch (type) {
+  case msgSubscribe:
+    Subscribe(host, port, id, data+16, length-16);
+    break;
+  case msgUnsubscribe:
+    for (unsigned int i=0; i<Subscriptions.size(); i++)
+      if (Subscriptions[i] == sub) Remove(i);
+    break;
+  case msgKeyframe:
+    if (sub) {
+      sub->keyframe_due = true;
+      sub->renewed = ::time(0);
+    } else {
+      SendError(host, port, id, "No such subscription");
+    }
+    break;
+  default:
+    SendError(host, port, id, "Unknown message type");
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmTelemetry::Subscribe(unsigned long host, unsigned short port,
+                               unsigned int id, const char* data, size_t length)
+{
+  Subscription* sub = Find(host, port, id);
+  const char* p = data + 12;
+  const char* end = data + length;
+
+  if (sub && sub->request.size() == length &&
+      memcmp(sub->request.data(), data, length) == 0)
+  {
+    sub->renewed = ::time(0);  // Renewed, the stream goes on
+  } else {
+    if (length < 12) {
+      SendError(host, port, id, "Message too short");
+      return;
+    }
+    unsigned int rate = GetLE32(data);
+    unsigned int keyframe = GetLE32(data+4);
+    size_t count = GetLE32(data+8);
+    if (count > max_properties) {
+      SendError(host, port, id, "Too many properties");
+      return;
+    }
+
+    vector <FGPropertyManager*> nodes;
+    vector <double> deadbands;
+    nodes.reserve(count);
+    deadbands.reserve(count);
+    for (size_t i=0; i<count; i++) {
+      if (end - p < 9) {
+        SendError(host, port, id, "Missing properties");
+        return;
+      }
+      double deadband = GetLEDouble(p);
+      p += 8;
+      const char* name_end = (const char*)memchr(p, '\0', end - p);
+      if (name_end == 0) {
+        SendError(host, port, id, "Missing properties");
+        return;
+      }
+      string name(p, name_end - p);
+      FGPropertyManager* node;
+      try {
+        node = Root->GetNode(name);
+      } catch(...) {
+        node = 0;
+      }
+      if (node == 0) {
+        SendError(host, port, id, "Unknown property: " + name);
+        return;
+      }
+      nodes.push_back(node);
+      deadbands.push_back(deadband);
+      p = name_end + 1;
+    }
+
+    if (sub == 0) {
+      if (Subscriptions.size() >= max_subscriptions) {
+        SendError(host, port, id, "Too many subscriptions");
+        return;
+      }
+      sub = new Subscription;
+      sub->id = id;
+      sub->host = host;
+      sub->port = port;
+      sub->sequence = 0;
+      Subscriptions.push_back(sub);
+    }
+    sub->request.assign(data, length);
+    sub->nodes.swap(nodes);
+    sub->deadbands.swap(deadbands);
+    sub->sent.assign(count, 0.0);
+    // A rate above that of the output (or 0) gets every frame of the output
+    if (rate > 0 && (MaxRate <= 0.0 || rate < MaxRate)) {
+      sub->rate = rate;
+      sub->period = 1.0/rate;
+    } else {
+      sub->rate = MaxRate;
+      sub->period = 0.0;
+    }
+    sub->next = last_time;
+    sub->keyframe_interval = keyframe;
+    sub->since_keyframe = 0;
+    sub->keyframe_time = last_time;
+    sub->keyframe_due = true;
+    sub->renewed = ::time(0);
+  }
+
+  StartMessage(msgSubscribed);
+  AppendLE32(Message, id);
+  AppendLE32(Message, (unsigned int)sub->nodes.size());
+  AppendLEDouble(Message, sub->rate);
+  SendMessage(host, port);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Sends the values of a subscription that moved by more than their deadband,
+// or all of them for a keyframe. The values a delta is taken from are those
+// last sent, not those of the last update, so that a slow drift is sent once
+// it adds up to the deadband.
+
+void FGfdmTelemetry::Update(Subscription* sub, double time)
+{
+  size_t count = sub->nodes.size();
+  size_t changed = 0;
+  bool keyframe = sub->keyframe_due;
+
+  if (sub->keyframe_interval > 0) {
+    if (++sub->since_keyframe >= sub->keyframe_interval) keyframe = true;
+  } else if (time - sub->keyframe_time >= 1.0) {
+    keyframe = true;
+  }
+
+  StartMessage(msgUpdate);
+  AppendLE32(Message, sub->id);
+  AppendLE32(Message, sub->sequence);
+  AppendLE32(Message, keyframe ? 1 : 0);
+  AppendLE32(Message, 0);            // The count, filled in below
+  AppendLEDouble(Message, time);
+
+  for (size_t i=0; i<count; i++) {
+    double value = sub->nodes[i]->getDoubleValue();
+    if (keyframe) {
+      AppendLEDouble(Message, value);
+      sub->sent[i] = value;
+    } else if (value != sub->sent[i] &&
+               !(fabs(value - sub->sent[i]) <= sub->deadbands[i])) {
+      AppendLE16(Message, (unsigned int)i);
+      AppendLEDouble(Message, value);
+      sub->sent[i] = value;
+      changed++;
+    }
+  }
+
+  if (keyframe) {
+    changed = count;
+    sub->keyframe_due = false;
+    sub->since_keyframe = 0;
+    sub->keyframe_time = time;
+  } else if (changed == 0) {
+    return;
+  }
+
+  for (int i=0; i<4; i++) Message[20+i] = (char)((changed >> 8*i) & 0xff);
+  SendMessage(sub->host, sub->port);
+  sub->sequence++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGfdmTelemetry::Subscription* FGfdmTelemetry::Find(unsigned long host,
+                                       unsigned short port, unsigned int id)
+{
+  for (unsigned int i=0; i<Subscriptions.size(); i++) {
+    Subscription* sub = Subscriptions[i];
+    if (sub->id == id && sub->host == host && sub->port == port) return sub;
+  }
+  return 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The cookie of a client is a keyed hash of its address, port and id: it is
+// not stored, and a client gets the same one as long as JSBSim runs. It is
+// never 0, which a client sends before it knows its cookie.
+
+unsigned int FGfdmTelemetry::Cookie(unsigned long host, unsigned short port,
+                                    unsigned int id) const
+{
+  unsigned int counter[4] = {(unsigned int)host, port, id, 0};
+  unsigned int out[4];
+
+  FGRandom::Block(counter, Secret, out);
+  return out[0] != 0 ? out[0] : 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmTelemetry::Remove(unsigned int index)
+{
+  delete Subscriptions[index];
+  Subscriptions.erase(Subscriptions.begin() + index);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The messages are built in Message, which keeps its memory from one update to
+// the next. The size in the header is filled in by SendMessage().
+
+void FGfdmTelemetry::StartMessage(unsigned int type)
+{
+  Message.clear();
+  AppendLE32(Message, 0);
+  AppendLE32(Message, type);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmTelemetry::SendMessage(unsigned long host, unsigned short port)
+{
+  struct sockaddr_in to;
+  unsigned int size = (unsigned int)Message.size();
+
+  for (int i=0; i<4; i++) Message[i] = (char)((size >> 8*i) & 0xff);
+
+  memset(&to, 0, sizeof(to));
+  to.sin_family = AF_INET;
+  to.sin_addr.s_addr = host;
+  to.sin_port = port;
+  // A datagram the socket cannot take now is lost, as it could be on the way
+  sendto(sckt, Message.data(), (int)Message.size(), 0, (struct sockaddr*)&to,
+         sizeof(to));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmTelemetry::SendError(unsigned long host, unsigned short port,
+                               unsigned int id, const string& text)
+{
+  StartMessage(msgError);
+  AppendLE32(Message, id);
+  Message.append(text.c_str(), text.size()+1);
+  SendMessage(host, port);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGfdmTelemetry::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 0) { // Constructor
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGfdmTelemetry" << endl;
+    if (from == 1) cout << "Destroyed:    FGfdmTelemetry" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
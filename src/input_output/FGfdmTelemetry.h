@@ -0,0 +1,168 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGfdmTelemetry.h
+ Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGFDMTELEMETRY_H
+#define FGFDMTELEMETRY_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <vector>
+#include <ctime>
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_FDMTELEMETRY "$Id: FGfdmTelemetry.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGPropertyManager;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Streams properties over UDP to the clients that subscribe to them.
+    A client sends a subscription, a list of property names with a deadband
+    each and a rate, to the port of the telemetry output; it then receives
+    updates at that rate. An update only carries the values that moved by
+    more than their deadband since they were last sent, except for the
+    keyframes, sent at regular intervals, which carry all of them so that a
+    client recovers from lost packets. The updates are numbered: a client
+    that sees a gap can also ask for a keyframe at once.
+
+    Each datagram holds one message. All the numbers are little endian: the
+    integers are unsigned, on 32 bits unless noted, and the values are
+    doubles. A message starts with its size in bytes and its type:
+<pre>
+    type           direction  contents after the header
+    1 SUBSCRIBE    to JSBSim  id, cookie, rate (Hz, 0 for every frame of the
+                              output), keyframe (the updates from one
+                              keyframe to the next, 0 for one per second),
+                              count, then count times: deadband, property
+                              name followed by a null character
+    2 SUBSCRIBED   to client  id, count, rate the updates are sent at (Hz)
+    3 UNSUBSCRIBE  to JSBSim  id, cookie
+    4 KEYFRAME     to JSBSim  id, cookie
+    5 UPDATE       to client  id, sequence, flags (1: keyframe), count, time,
+                              then, for a keyframe, count values in the order
+                              of the subscription, else count times: index
+                              (16 bits), value
+    6 ERROR        to client  id, text of the error, followed by a null
+                              character
+    7 CHALLENGE    to client  id, cookie
+</pre>
+    The id is chosen by the client; together with its address and port it
+    identifies a subscription. A message whose cookie is not the one of its
+    sender is only answered by a CHALLENGE, which gives the cookie; the client
+    then sends its message again with it (the first one can carry 0). So
+    nothing is streamed to an address that did not prove that it receives,
+    and a CHALLENGE being smaller than the message it answers, a forged
+    source address cannot be flooded. The rate of a subscription is capped
+    at the rate of the output. A subscription lasts 30 seconds after the last
+    message received for it: a client renews it by sending the same SUBSCRIBE
+    again, which does not restart the stream. A different SUBSCRIBE with the
+    same id replaces it. An update is not sent when no value has moved.
+    @version "$Id: FGfdmTelemetry.h,v 1.0 2026/10/16 00:00:00 $"
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGfdmTelemetry : public FGJSBBase
+{
+public:
+  /** Listens for subscriptions on a UDP port.
+      @param root the property tree the names are looked up in
+      @param address the name or address of the interface to listen on, the
+                     loopback one if empty (0.0.0.0 for all of them)
+      @param port the UDP port */
+  FGfdmTelemetry(FGPropertyManager* root, const std::string& address, int port);
+  ~FGfdmTelemetry();
+
+  /// Returns true if the port could be bound.
+  bool IsListening(void) const {return sckt >= 0;}
+  /// Returns the number of subscriptions being served.
+  unsigned int GetNumSubscriptions(void) const {return (unsigned int)Subscriptions.size();}
+
+  /** Reads the messages of the clients, without waiting for any, then sends
+      the updates that are due.
+      @param time the simulation time, which the rates are counted in
+      @param max_rate the rate of the output (Hz), which caps the rates of
+                      the subscriptions */
+  void Run(double time, double max_rate);
+
+private:
+  struct Subscription {
+    unsigned int id;
+    unsigned long host;         // The address of the client, network order
+    unsigned short port;        // Its port, network order
+    std::string request;        // The SUBSCRIBE it was made from
+    std::vector <FGPropertyManager*> nodes;
+    std::vector <double> deadbands;
+    std::vector <double> sent;  // The values as the client last received them
+    double rate;                // Hz, as served
+    double period, next;        // In simulation time
+    unsigned int keyframe_interval, since_keyframe, sequence;
+    double keyframe_time;       // Of the last keyframe, when the interval is 0
+    bool keyframe_due;
+    time_t renewed;
+  };
+
+  int sckt;
+  FGPropertyManager* Root;
+  std::vector <Subscription*> Subscriptions;
+  std::vector <char> Datagram;
+  std::string Message;
+  double last_time;
+  double MaxRate;
+  unsigned int Secret[2];       // The key of the cookies
+
+  void Receive(unsigned long host, unsigned short port, const char* data, size_t length);
+  void Subscribe(unsigned long host, unsigned short port, unsigned int id,
+                 const char* data, size_t length);
+  void Update(Subscription* sub, double time);
+  Subscription* Find(unsigned long host, unsigned short port, unsigned int id);
+  unsigned int Cookie(unsigned long host, unsigned short port, unsigned int id) const;
+  void Remove(unsigned int index);
+  void StartMessage(unsigned int type);
+  void SendMessage(unsigned long host, unsigned short port);
+  void SendError(unsigned long host, unsigned short port, unsigned int id,
+                 const std::string& text);
+  void Debug(int from);
+};
+}
+#endif
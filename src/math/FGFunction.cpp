@@ -58,6 +58,12 @@ FGFunction::FGFunction(FGPropertyManager* propMan, Element* el, const string& pr
   cached = false;
   cachedValue = -HUGE_VAL;
   invlog2val = 1.0/log10(2.0);
+  DirtyTracking = false;
+  Deterministic = true;
+  Evaluated = false;
+  CompileFailed = false;
+  LastValue = 0.0;
+  nEvaluations = nSkipped = 0;
 
   property_string = "property";
   value_string = "value";
@@ -245,6 +251,19 @@ void FGFunction::cacheValue(bool cache)
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGFunction::GetValue(void) const
+{
+  if (cached) return cachedValue;
+
+  if (!Program.empty() || (!CompileFailed && const_cast<FGFunction*>(this)->Compile()))
+    return Execute();
+
+  nEvaluations++;
+  return GetTreeValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGFunction::GetTreeValue(void) const
 {
   unsigned int i;
   double scratch;
@@ -257,6 +276,7 @@ double FGFunction::GetValue(void) const
   } catch (string prop) {
     if (PropertyManager->HasNode(prop)) {
       ((FGPropertyValue*)Parameters[0])->SetNode(PropertyManager->GetNode(prop));
+      CompileFailed = false; // The program may now be built
       temp = Parameters[0]->GetValue();
     } else {
       throw("Property " + prop + " was not defined anywhere.");
@@ -366,6 +386,327 @@ double FGFunction::GetValue(void) const
   return temp;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The parameter tree is flattened into a postfix program: each operation is
+// preceded by the code of its arguments, so that at runtime the arguments of an
+// operation are the topmost nArgs values of the stack. The maximum stack depth
+// is known at compile time, so the stack is allocated once here. Each distinct
+// property read by the function (directly or as a table lookup key) becomes an
+// input, which is read once per evaluation.
+
+bool FGFunction::Compile(void)
+{
+  vector <Instruction> program;
+  vector <FGPropertyManager*> inputs;
+  unsigned int maxDepth = 0;
+
+  CompileFailed = !Emit(program, inputs, 0, maxDepth);
+  if (CompileFailed) return false;
+
+  Program = program;
+  InputNodes = inputs;
+  InputValues.assign(inputs.size(), 0.0);
+  Stack.assign(maxDepth, 0.0);
+  Evaluated = false;
+
+  Deterministic = true;
+  for (unsigned int i=0; i<Program.size(); i++) {
+    if (Program[i].op == opRandom) Deterministic = false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFunction::Emit(vector <Instruction>& program, vector <FGPropertyManager*>& inputs,
+                      unsigned int depth, unsigned int& maxDepth) const
+{
+  unsigned int nArgs;
+  Instruction ins;
+
+  switch (Type) {
+  case eTopLevel:
+    nArgs = 1;
+    break;
+  case eQuotient:
+  case ePow:
+  case eATan2:
+  case eMod:
+    nArgs = 2;
+    break;
+  case eProduct:
+  case eDifference:
+  case eSum:
+  case eMin:
+  case eMax:
+  case eAvg:
+    nArgs = Parameters.size();
+    break;
+  default:
+    nArgs = 1;
+    break;
+  }
+
+  if (nArgs == 0 || Parameters.size() < nArgs) return false;
+
+  for (unsigned int i=0; i<nArgs; i++) {
+    if (!EmitParameter(Parameters[i], program, inputs, depth+i, maxDepth)) return false;
+  }
+
+  if (Type == eTopLevel) return true;
+
+  switch (Type) {
+  case eProduct:    ins.op = opProduct;    break;
+  case eDifference: ins.op = opDifference; break;
+  case eSum:        ins.op = opSum;        break;
+  case eQuotient:   ins.op = opQuotient;   break;
+  case ePow:        ins.op = opPow;        break;
+  case eExp:        ins.op = opExp;        break;
+  case eLog2:       ins.op = opLog2;       break;
+  case eLn:         ins.op = opLn;         break;
+  case eLog10:      ins.op = opLog10;      break;
+  case eAbs:        ins.op = opAbs;        break;
+  case eSin:        ins.op = opSin;        break;
+  case eCos:        ins.op = opCos;        break;
+  case eTan:        ins.op = opTan;        break;
+  case eASin:       ins.op = opASin;       break;
+  case eACos:       ins.op = opACos;       break;
+  case eATan:       ins.op = opATan;       break;
+  case eATan2:      ins.op = opATan2;      break;
+  case eMin:        ins.op = opMin;        break;
+  case eMax:        ins.op = opMax;        break;
+  case eAvg:        ins.op = opAvg;        break;
+  case eFrac:       ins.op = opFrac;       break;
+  case eInteger:    ins.op = opInteger;    break;
+  case eMod:        ins.op = opMod;        break;
+  case eRandom:     ins.op = opRandom;     break;
+  default:
+    return false;
+  }
+
+  ins.nArgs = nArgs;
+  ins.index = 0;
+  ins.value = 0.0;
+  ins.table = 0L;
+  program.push_back(ins);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFunction::EmitParameter(FGParameter* parameter, vector <Instruction>& program,
+                               vector <FGPropertyManager*>& inputs, unsigned int depth,
+                               unsigned int& maxDepth) const
+{
+  Instruction ins;
+
+  ins.nArgs = 0;
+  ins.index = 0;
+  ins.value = 0.0;
+  ins.table = 0L;
+
+  if (FGFunction* f = dynamic_cast<FGFunction*>(parameter)) {
+    return f->Emit(program, inputs, depth, maxDepth);
+  } else if (FGPropertyValue* p = dynamic_cast<FGPropertyValue*>(parameter)) {
+    if (!p->GetNode()) { // Late bind a property that was initially undefined
+      if (!PropertyManager->HasNode(p->GetName())) return false;
+      p->SetNode(PropertyManager->GetNode(p->GetName()));
+    }
+    return EmitProperty(p->GetNode(), program, inputs, depth, maxDepth);
+  } else if (FGTable* t = dynamic_cast<FGTable*>(parameter)) {
+    // The lookup keys are pushed in the order row, column, table.
+    FGPropertyManager* keys[3] = {t->GetRowIndexProperty(),
+                                  t->GetColumnIndexProperty(),
+                                  t->GetTableIndexProperty()};
+    ins.op = opTable;
+    ins.nArgs = t->GetNumDimensions();
+    ins.table = t;
+    for (unsigned int i=0; i<ins.nArgs; i++) {
+      if (keys[i] == 0L) return false;
+      if (!EmitProperty(keys[i], program, inputs, depth+i, maxDepth)) return false;
+    }
+  } else if (FGRealValue* v = dynamic_cast<FGRealValue*>(parameter)) {
+    ins.op = opValue;
+    ins.value = v->GetValue();
+    if (depth+1 > maxDepth) maxDepth = depth+1;
+  } else {
+    return false;
+  }
+
+  program.push_back(ins);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFunction::EmitProperty(FGPropertyManager* node, vector <Instruction>& program,
+                              vector <FGPropertyManager*>& inputs, unsigned int depth,
+                              unsigned int& maxDepth) const
+{
+  Instruction ins;
+  unsigned int i;
+
+  for (i=0; i<inputs.size(); i++) {
+    if (inputs[i] == node) break;
+  }
+  if (i == inputs.size()) inputs.push_back(node);
+
+  ins.op = opProperty;
+  ins.nArgs = 0;
+  ins.index = i;
+  ins.value = 0.0;
+  ins.table = 0L;
+  program.push_back(ins);
+  if (depth+1 > maxDepth) maxDepth = depth+1;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs the compiled program. The arithmetic mirrors GetTreeValue() operation
+// for operation, so that both evaluations give identical results.
+
+double FGFunction::Execute(void) const
+{
+  double* stack = &Stack[0];
+  double* input = InputValues.empty() ? 0L : &InputValues[0];
+  double* arg;
+  double scratch;
+  unsigned int sp = 0, i, n;
+  bool changed = !(DirtyTracking && Deterministic && Evaluated);
+  vector <Instruction>::const_iterator ins, end = Program.end();
+
+  for (i=0; i<InputNodes.size(); i++) {
+    double value = InputNodes[i]->getDoubleValue();
+    if (value != input[i]) {
+      input[i] = value;
+      changed = true;
+    }
+  }
+
+  if (!changed) {
+    nSkipped++;
+    return LastValue;
+  }
+
+  for (ins = Program.begin(); ins != end; ++ins) {
+    switch (ins->op) {
+    case opValue:
+      stack[sp++] = ins->value;
+      continue;
+    case opProperty:
+      stack[sp++] = input[ins->index];
+      continue;
+    default:
+      break;
+    }
+
+    // The arguments of the operation are the top n values of the stack. The
+    // result replaces the first of them.
+    n = ins->nArgs;
+    sp -= n;
+    arg = stack + sp;
+
+    switch (ins->op) {
+    case opTable:
+      if (n == 1) arg[0] = ins->table->GetValue(arg[0]);
+      else if (n == 2) arg[0] = ins->table->GetValue(arg[0], arg[1]);
+      else arg[0] = ins->table->GetValue(arg[0], arg[1], arg[2]);
+      break;
+    case opProduct:
+      for (i=1; i<n; i++) arg[0] *= arg[i];
+      break;
+    case opDifference:
+      for (i=1; i<n; i++) arg[0] -= arg[i];
+      break;
+    case opSum:
+      for (i=1; i<n; i++) arg[0] += arg[i];
+      break;
+    case opQuotient:
+      if (arg[1] != 0.0) arg[0] /= arg[1];
+      else arg[0] = HUGE_VAL;
+      break;
+    case opPow:
+      arg[0] = pow(arg[0], arg[1]);
+      break;
+    case opExp:
+      arg[0] = exp(arg[0]);
+      break;
+    case opLog2:
+      if (arg[0] > 0.00) arg[0] = log10(arg[0])*invlog2val;
+      else arg[0] = -HUGE_VAL;
+      break;
+    case opLn:
+      if (arg[0] > 0.00) arg[0] = log(arg[0]);
+      else arg[0] = -HUGE_VAL;
+      break;
+    case opLog10:
+      if (arg[0] > 0.00) arg[0] = log10(arg[0]);
+      else arg[0] = -HUGE_VAL;
+      break;
+    case opAbs:
+      arg[0] = fabs(arg[0]);
+      break;
+    case opSin:
+      arg[0] = sin(arg[0]);
+      break;
+    case opCos:
+      arg[0] = cos(arg[0]);
+      break;
+    case opTan:
+      arg[0] = tan(arg[0]);
+      break;
+    case opASin:
+      arg[0] = asin(arg[0]);
+      break;
+    case opACos:
+      arg[0] = acos(arg[0]);
+      break;
+    case opATan:
+      arg[0] = atan(arg[0]);
+      break;
+    case opATan2:
+      arg[0] = atan2(arg[0], arg[1]);
+      break;
+    case opMod:
+      arg[0] = ((int)arg[0]) % ((int)arg[1]);
+      break;
+    case opMin:
+      for (i=1; i<n; i++) if (arg[i] < arg[0]) arg[0] = arg[i];
+      break;
+    case opMax:
+      for (i=1; i<n; i++) if (arg[i] > arg[0]) arg[0] = arg[i];
+      break;
+    case opAvg:
+      for (i=1; i<n; i++) arg[0] += arg[i];
+      arg[0] /= n;
+      break;
+    case opFrac:
+      arg[0] = modf(arg[0], &scratch);
+      break;
+    case opInteger:
+      modf(arg[0], &scratch);
+      arg[0] = scratch;
+      break;
+    case opRandom:
+      arg[0] = GaussianRandomNumber();
+      break;
+    default:
+      break;
+    }
+    sp++;
+  }
+
+  nEvaluations++;
+  Evaluated = true;
+  LastValue = stack[0];
+
+  return LastValue;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 string FGFunction::GetValueAsString(void) const
@@ -51,6 +51,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGPropertyManager;
+class FGTable;
 class Element;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -141,6 +142,24 @@ an operation (such as sum) which can contain other items. The point to keep in
 mind is that it evaluates to a single value - which is just what the trigonometric
 functions require (except atan2, which takes two arguments).
 
+The first time a function is evaluated (by which point the aircraft model has
+been loaded and the properties it refers to have been bound) the parameter tree
+is compiled into a flat postfix program. Nested operations, tables, properties
+and values all become entries of one contiguous instruction array, which is
+then executed by a single interpreter loop working on a preallocated value
+stack, with no virtual calls or exception handling per node. If the tree cannot
+be compiled - for instance because a property it refers to is still undefined -
+the function is evaluated by walking the parameter tree as before, and
+compilation is retried on the next evaluation.
+
+A compiled function reads each of its input properties (including the lookup
+properties of its tables) once per evaluation. When dirty tracking is enabled
+with SetDirtyTracking(), the function also remembers the input values of its
+last evaluation, and if none of them has changed it returns the previous result
+without executing the program. Functions that use the random operation are
+never skipped. Since an evaluation only depends on the inputs, the results are
+identical with or without dirty tracking.
+
 @author Jon Berndt
 */
 
@@ -177,6 +196,36 @@ public:
     @return the total value of the function. */
   double GetValue(void) const;
 
+/** Retrieves the value of the function object by recursively walking the
+    parameter tree. This is the reference evaluation, and bypasses the compiled
+    program (but not the cached value).
+    @return the total value of the function. */
+  double GetTreeValue(void) const;
+
+/** Compiles the parameter tree into a flat program. This is done automatically
+    the first time the function is evaluated, and only needs to be called
+    explicitly to force compilation ahead of time. After a failure, the
+    evaluations walk the tree and compilation is only attempted again when a
+    property of the function is bound late, or when Compile() is called.
+    @return true if the function has been compiled, false if the tree has to be
+            walked (for instance because a property is still undefined). */
+  bool Compile(void);
+
+/// Returns true if the function is evaluated through a compiled program.
+  bool IsCompiled(void) const {return !Program.empty();}
+
+/** Enables or disables dirty tracking. When enabled, a compiled function is
+    only re-evaluated when at least one of its input properties has changed
+    since its last evaluation.
+    @param track true to skip evaluations when the inputs are unchanged. */
+  void SetDirtyTracking(bool track) {DirtyTracking = track;}
+
+/// Returns the number of times the function value has been computed.
+  unsigned long GetNumEvaluations(void) const {return nEvaluations;}
+
+/// Returns the number of evaluations skipped because the inputs were unchanged.
+  unsigned long GetNumSkipped(void) const {return nSkipped;}
+
 /** The value that the function evaluates to, as a string.
   @return the value of the function as a string. */
   std::string GetValueAsString(void) const;
@@ -235,6 +284,45 @@ private:
                      eExp, eAbs, eSin, eCos, eTan, eASin, eACos, eATan, eATan2,
                      eMin, eMax, eAvg, eFrac, eInteger, eMod, eRandom, eLog2, eLn, eLog10} Type;
   std::string Name;
+
+  enum opCode {opValue=0, opProperty, opTable, opProduct, opDifference, opSum,
+               opQuotient, opPow, opExp, opAbs, opSin, opCos, opTan, opASin,
+               opACos, opATan, opATan2, opMin, opMax, opAvg, opFrac, opInteger,
+               opMod, opRandom, opLog2, opLn, opLog10};
+
+  /** An instruction of the compiled program. Leaf instructions (values and
+      properties) push one value on the stack, operations and table lookups pop
+      nArgs values and push their result. A property instruction pushes the
+      input value stored at index. */
+  struct Instruction {
+    opCode op;
+    unsigned int nArgs;
+    unsigned int index;
+    double value;
+    const FGTable* table;
+  };
+
+  std::vector <Instruction> Program;
+  std::vector <FGPropertyManager*> InputNodes;
+  mutable std::vector <double> InputValues;
+  mutable std::vector <double> Stack;
+  bool DirtyTracking;
+  bool Deterministic;
+  mutable bool Evaluated;
+  mutable bool CompileFailed;
+  mutable double LastValue;
+  mutable unsigned long nEvaluations;
+  mutable unsigned long nSkipped;
+
+  bool Emit(std::vector <Instruction>& program, std::vector <FGPropertyManager*>& inputs,
+            unsigned int depth, unsigned int& maxDepth) const;
+  bool EmitParameter(FGParameter* parameter, std::vector <Instruction>& program,
+                     std::vector <FGPropertyManager*>& inputs, unsigned int depth,
+                     unsigned int& maxDepth) const;
+  bool EmitProperty(FGPropertyManager* node, std::vector <Instruction>& program,
+                    std::vector <FGPropertyManager*>& inputs, unsigned int depth,
+                    unsigned int& maxDepth) const;
+  double Execute(void) const;
   void bind(void);
   void Debug(int from);
 };
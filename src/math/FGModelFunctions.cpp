@@ -163,4 +163,12 @@ void FGModelFunctions::RunPostFunctions(void)
     (*it)->GetValue();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGModelFunctions::GetFunctions(vector <FGFunction*>& functions) const
+{
+  functions.insert(functions.end(), PreFunctions.begin(), PreFunctions.end());
+  functions.insert(functions.end(), PostFunctions.begin(), PostFunctions.end());
+}
+
 }
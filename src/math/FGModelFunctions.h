@@ -73,6 +73,11 @@ public:
   bool Load(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
   void PreLoad(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
   void PostLoad(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
+  /** Appends the functions owned by this object to a list. The default
+      implementation appends the pre- and post-functions; models and engines
+      that own other functions append them too.
+      @param functions the list the functions are appended to. */
+  virtual void GetFunctions(std::vector <FGFunction*>& functions) const;
 
 protected:
   std::vector <FGFunction*> PreFunctions;
@@ -71,6 +71,8 @@ public:
 
   double GetValue(void) const;
   void SetNode(FGPropertyManager* node) {PropertyManager = node;} 
+  FGPropertyManager* GetNode(void) const {return PropertyManager;}
+  const std::string& GetName(void) const {return PropertyName;}
 
 private:
   FGPropertyManager* PropertyManager;
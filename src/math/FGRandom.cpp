@@ -0,0 +1,153 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGRandom.cpp
+Date started: October 16 2026
+Purpose: Counter based random number generator
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGRandom.h"
+#include <cmath>
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGRandom.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_RANDOM;
+
+// The multipliers and the key increments (Weyl sequence) of Philox4x32
+static const unsigned long long M0 = 0xD2511F53ULL;
+static const unsigned long long M1 = 0xCD9E8D57ULL;
+static const unsigned int W0 = 0x9E3779B9U;
+static const unsigned int W1 = 0xBB67AE85U;
+
+static const double TwoPi = 6.283185307179586476925286766559;
+// 2^-32 and 2^-53
+static const double Scale32 = 1.0 / 4294967296.0;
+static const double Scale53 = 1.0 / 9007199254740992.0;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+void FGRandom::Seed(unsigned long seed, unsigned int stream)
+{
+  SeedValue = seed;
+  Stream = stream;
+  Key[0] = (unsigned int)(seed & 0xFFFFFFFFUL);
+  Key[1] = (unsigned int)(((seed >> 16) >> 16) & 0xFFFFFFFFUL); // long may be 32 bits
+  UniformCounter = 0;
+  GaussianCounter = 0;
+  UniformLeft = 0;
+  GaussianLeft = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRandom::Block(const unsigned int counter[4], const unsigned int key[2],
+                     unsigned int out[4])
+{
+  unsigned int c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  unsigned int k0 = key[0], k1 = key[1];
+
+  for (int round=0; round<10; round++) {
+    if (round > 0) {
+      k0 += W0;
+      k1 += W1;
+    }
+    unsigned long long p0 = M0 * c0;
+    unsigned long long p1 = M1 * c2;
+    unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+    unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+  }
+
+  out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The counter is made of the position in the sequence (64 bits), the stream
+// and the sequence.
+
+void FGRandom::NextBlock(unsigned long long& counter, unsigned int sequence,
+                         unsigned int out[4])
+{
+  unsigned int c[4];
+  c[0] = (unsigned int)counter;
+  c[1] = (unsigned int)(counter >> 32);
+  c[2] = Stream;
+  c[3] = sequence;
+  counter++;
+  Block(c, Key, out);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A block gives two uniform numbers of 53 bits each.
+
+void FGRandom::NextUniforms(void)
+{
+  unsigned int r[4];
+  NextBlock(UniformCounter, UniformSequence, r);
+  Uniforms[1] = ((r[0] >> 5) * 67108864.0 + (r[1] >> 6)) * Scale53;
+  Uniforms[0] = ((r[2] >> 5) * 67108864.0 + (r[3] >> 6)) * Scale53;
+  UniformLeft = 2;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Box-Muller transform: a block gives two pairs of normal numbers. The radius
+// is taken from a uniform number in (0, 1] so that its logarithm is finite.
+// The count n is a multiple of 4.
+
+void FGRandom::MakeGaussians(double* values, unsigned int n)
+{
+  unsigned int r[4];
+  for (unsigned int i=0; i<n; i+=4) {
+    NextBlock(GaussianCounter, GaussianSequence, r);
+    for (unsigned int j=0; j<4; j+=2) {
+      double radius = sqrt(-2.0 * log(((double)r[j] + 1.0) * Scale32));
+      double angle = TwoPi * (double)r[j+1] * Scale32;
+      values[i+j]   = radius * cos(angle);
+      values[i+j+1] = radius * sin(angle);
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The values left from the last batch are handed out first. The batch always
+// ends on a block, so the values that follow can be made straight into the
+// array and the sequence is the same as if they were drawn one at a time.
+
+void FGRandom::GetGaussian(double* values, unsigned int n)
+{
+  while (n > 0 && GaussianLeft > 0) {
+    *values++ = Gaussians[GaussianBatch - GaussianLeft--];
+    n--;
+  }
+
+  unsigned int blocks = n & ~3U;
+  MakeGaussians(values, blocks);
+  for (unsigned int i=blocks; i<n; i++) values[i] = GetGaussian();
+}
+
+}
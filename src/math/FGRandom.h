@@ -0,0 +1,136 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGRandom.h
+Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGRANDOM_H
+#define FGRANDOM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_RANDOM "$Id: FGRandom.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A counter based random number generator (Philox4x32-10). Each number is
+    a function of the seed, the stream and its position in the stream only: a
+    block of four 32 bit numbers is obtained by ciphering a counter with the
+    seed as the key, so there is no state beyond the counter and two
+    generators with the same seed and stream give the same numbers, in any
+    thread. Different streams of a seed (the runs of a Monte Carlo batch, for
+    instance) are independent.
+
+    The uniform and the normal numbers are drawn from two separate sequences
+    of the stream, so that the normal numbers of a run do not depend on how
+    many uniform numbers were drawn meanwhile. The normal numbers are made in
+    batches with the Box-Muller transform, which unlike the polar method does
+    not loop, and are then handed out one at a time.
+    @version "$Id: FGRandom.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGRandom
+{
+public:
+  /** Constructor
+      @param seed the seed, which is the key of the cipher
+      @param stream the stream of the seed */
+  FGRandom(unsigned long seed = 0, unsigned int stream = 0) {Seed(seed, stream);}
+
+  /** Restarts the generator at the beginning of a stream.
+      @param seed the seed, which is the key of the cipher
+      @param stream the stream of the seed */
+  void Seed(unsigned long seed, unsigned int stream = 0);
+
+  unsigned long GetSeed(void) const {return SeedValue;}
+  unsigned int GetStream(void) const {return Stream;}
+
+  /// Returns a uniformly distributed number in [0, 1).
+  double GetUniform(void) {
+    if (UniformLeft == 0) NextUniforms();
+    return Uniforms[--UniformLeft];
+  }
+
+  /// Returns a normally distributed number, of mean 0 and variance 1.
+  double GetGaussian(void) {
+    if (GaussianLeft == 0) {
+      MakeGaussians(Gaussians, GaussianBatch);
+      GaussianLeft = GaussianBatch;
+    }
+    return Gaussians[GaussianBatch - GaussianLeft--];
+  }
+
+  /** Fills an array with normally distributed numbers. They continue the
+      sequence of GetGaussian().
+      @param values the array
+      @param n the number of values */
+  void GetGaussian(double* values, unsigned int n);
+
+  /** Ciphers a counter with the ten rounds of Philox4x32-10.
+      @param counter the counter, four 32 bit words
+      @param key the key, two 32 bit words
+      @param out receives the four 32 bit random words */
+  static void Block(const unsigned int counter[4], const unsigned int key[2],
+                    unsigned int out[4]);
+
+private:
+  enum {GaussianBatch = 64};
+  enum {UniformSequence = 0, GaussianSequence = 1};
+
+  unsigned long SeedValue;
+  unsigned int Stream;
+  unsigned int Key[2];
+  unsigned long long UniformCounter;
+  unsigned long long GaussianCounter;
+
+  double Uniforms[2];
+  unsigned int UniformLeft;
+  double Gaussians[GaussianBatch];
+  unsigned int GaussianLeft;
+
+  void NextBlock(unsigned long long& counter, unsigned int sequence,
+                 unsigned int out[4]);
+  void NextUniforms(void);
+  void MakeGaussians(double* values, unsigned int n);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
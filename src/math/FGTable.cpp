@@ -42,6 +42,30 @@ INCLUDES
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
+#include <algorithm>
+
+#if defined(__AVX__)
+#  include <immintrin.h>
+#  define FGTABLE_USE_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define FGTABLE_USE_SSE2
+#endif
+
+// The reference count of the table data is updated atomically so that copies
+// of a table can be created and destroyed by different threads.
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#  define FGTABLE_ATOMIC_INCREMENT(x) _InterlockedIncrement(x)
+#  define FGTABLE_ATOMIC_DECREMENT(x) _InterlockedDecrement(x)
+#elif defined(__GNUC__)
+#  define FGTABLE_ATOMIC_INCREMENT(x) __sync_add_and_fetch(x, 1)
+#  define FGTABLE_ATOMIC_DECREMENT(x) __sync_sub_and_fetch(x, 1)
+#else
+#  define FGTABLE_ATOMIC_INCREMENT(x) (++(*(x)))
+#  define FGTABLE_ATOMIC_DECREMENT(x) (--(*(x)))
+#endif
 
 using namespace std;
 
@@ -50,64 +74,214 @@ namespace JSBSim {
 static const char *IdSrc = "$Id: FGTable.cpp,v 1.24 2010/09/23 11:34:29 jberndt Exp $";
 static const char *IdHdr = ID_TABLE;
 
+// Number of keys that the batched lookups process at a time.
+static const unsigned int BlockSize = 64;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Finds, for each key, the index i of the breakpoint that ends the interval
+// containing the key so that bp[i-1] < key <= bp[i]. Keys outside the table get
+// the first or the last interval. For tables of usual size the index is found
+// by counting the breakpoints below each key, which is vectorized over the keys
+// and does not suffer from branch mispredictions when the keys are in random
+// order; large tables use a binary search.
+
+static void FindIntervals(const vector<double>& breakpoints, unsigned int n,
+                          const double* key, unsigned int* index)
+{
+  const double* bp = &breakpoints[0];
+  unsigned int last = breakpoints.size() - 1;
+  unsigned int i = 0, j;
+
+  if (last > 32) {
+    for (; i<n; i++) index[i] = lower_bound(bp+1, bp+last, key[i]) - bp;
+    return;
+  }
+
+#ifdef FGTABLE_USE_AVX
+  const __m256d one4 = _mm256_set1_pd(1.0);
+  for (; i+4 <= n; i+=4) {
+    __m256d k = _mm256_loadu_pd(key+i);
+    __m256d count = one4;
+    for (j=1; j<last; j++) {
+      __m256d below = _mm256_cmp_pd(_mm256_set1_pd(bp[j]), k, _CMP_LT_OQ);
+      count = _mm256_add_pd(count, _mm256_and_pd(below, one4));
+    }
+    _mm_storeu_si128((__m128i*)(index+i), _mm256_cvttpd_epi32(count));
+  }
+#endif
+#ifdef FGTABLE_USE_SSE2
+  const __m128d one2 = _mm_set1_pd(1.0);
+  for (; i+2 <= n; i+=2) {
+    __m128d k = _mm_loadu_pd(key+i);
+    __m128d count = one2;
+    for (j=1; j<last; j++) {
+      __m128d below = _mm_cmplt_pd(_mm_set1_pd(bp[j]), k);
+      count = _mm_add_pd(count, _mm_and_pd(below, one2));
+    }
+    _mm_storel_epi64((__m128i*)(index+i), _mm_cvttpd_epi32(count));
+  }
+#endif
+  for (; i<n; i++) {
+    unsigned int count = 1;
+    for (j=1; j<last; j++) count += bp[j] < key[i];
+    index[i] = count;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Computes the interpolation factors f = (key - lo) * inv, clamped to [0, 1].
+
+static void ComputeFactors(unsigned int n, const double* key, const double* lo,
+                           const double* inv, double* f)
+{
+  unsigned int i = 0;
+
+#ifdef FGTABLE_USE_AVX
+  const __m256d zero4 = _mm256_setzero_pd();
+  const __m256d one4 = _mm256_set1_pd(1.0);
+  for (; i+4 <= n; i+=4) {
+    __m256d x = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(key+i), _mm256_loadu_pd(lo+i)),
+                              _mm256_loadu_pd(inv+i));
+    _mm256_storeu_pd(f+i, _mm256_min_pd(_mm256_max_pd(x, zero4), one4));
+  }
+#endif
+#ifdef FGTABLE_USE_SSE2
+  const __m128d zero2 = _mm_setzero_pd();
+  const __m128d one2 = _mm_set1_pd(1.0);
+  for (; i+2 <= n; i+=2) {
+    __m128d x = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(key+i), _mm_loadu_pd(lo+i)),
+                           _mm_loadu_pd(inv+i));
+    _mm_storeu_pd(f+i, _mm_min_pd(_mm_max_pd(x, zero2), one2));
+  }
+#endif
+  for (; i<n; i++) {
+    double x = (key[i] - lo[i]) * inv[i];
+    if (x > 1.0) x = 1.0;
+    else if (!(x > 0.0)) x = 0.0;
+    f[i] = x;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Interpolates out = f*(v1 - v0) + v0.
+
+static void Interpolate(unsigned int n, const double* f, const double* v0,
+                        const double* v1, double* out)
+{
+  unsigned int i = 0;
+
+#ifdef FGTABLE_USE_AVX
+  for (; i+4 <= n; i+=4) {
+    __m256d a = _mm256_loadu_pd(v0+i);
+    __m256d d = _mm256_sub_pd(_mm256_loadu_pd(v1+i), a);
+    _mm256_storeu_pd(out+i, _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(f+i), d), a));
+  }
+#endif
+#ifdef FGTABLE_USE_SSE2
+  for (; i+2 <= n; i+=2) {
+    __m128d a = _mm_loadu_pd(v0+i);
+    __m128d d = _mm_sub_pd(_mm_loadu_pd(v1+i), a);
+    _mm_storeu_pd(out+i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(f+i), d), a));
+  }
+#endif
+  for (; i<n; i++) out[i] = f[i]*(v1[i] - v0[i]) + v0[i];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Stores the inverse of the span of each interval: inv[i] = 1/(keys[i]-keys[i-1]).
+
+static void ComputeInverseSpans(const vector<double>& keys, vector<double>& inv)
+{
+  inv.assign(keys.size(), 0.0);
+  for (unsigned int i=1; i<keys.size(); i++) {
+    double span = keys[i] - keys[i-1];
+    if (span != 0.0) inv[i] = 1.0 / span;
+  }
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
-FGTable::FGTable(int NRows) : nRows(NRows), nCols(1), PropertyManager(0)
+FGTable::FGTable(int NRows) : PropertyManager(0)
 {
-  Type = tt1D;
+  Store = new TableData;
+  Store->Type = tt1D;
+  Store->nRows = NRows;
+  Store->nCols = 1;
   colCounter = 0;
   rowCounter = 1;
-  nTables = 0;
 
-  Data = Allocate();
+  Store->Allocate();
   Debug(0);
-  lastRowIndex=lastColumnIndex=2;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-FGTable::FGTable(int NRows, int NCols) : nRows(NRows), nCols(NCols), PropertyManager(0)
+FGTable::FGTable(int NRows, int NCols) : PropertyManager(0)
 {
-  Type = tt2D;
+  Store = new TableData;
+  Store->Type = tt2D;
+  Store->nRows = NRows;
+  Store->nCols = NCols;
   colCounter = 1;
   rowCounter = 0;
-  nTables = 0;
 
-  Data = Allocate();
+  Store->Allocate();
   Debug(0);
-  lastRowIndex=lastColumnIndex=2;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The copy shares the table data with the original. It gets its own lookup
+// cursor.
 
 FGTable::FGTable(const FGTable& t) : PropertyManager(t.PropertyManager)
 {
-  Type = t.Type;
+  Store = t.Store;
+  FGTABLE_ATOMIC_INCREMENT(&Store->RefCount);
+
   colCounter = t.colCounter;
   rowCounter = t.rowCounter;
   tableCounter = t.tableCounter;
-  nRows = t.nRows;
-  nCols = t.nCols;
-  nTables = t.nTables;
   dimension = t.dimension;
   internal = t.internal;
   Name = t.Name;
   lookupProperty[0] = t.lookupProperty[0];
   lookupProperty[1] = t.lookupProperty[1];
   lookupProperty[2] = t.lookupProperty[2];
+}
 
-  Tables = t.Tables;
-  Data = Allocate();
-  for (unsigned int r=0; r<=nRows; r++) {
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = t.Data[r][c];
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The lookup properties are found again by their names relative to the
+// property manager of the original, in the property manager of the copy.
+
+FGTable::FGTable(const FGTable& t, FGPropertyManager* propMan)
+  : PropertyManager(propMan)
+{
+  Store = t.Store;
+  FGTABLE_ATOMIC_INCREMENT(&Store->RefCount);
+
+  colCounter = t.colCounter;
+  rowCounter = t.rowCounter;
+  tableCounter = t.tableCounter;
+  dimension = t.dimension;
+  internal = t.internal;
+  Name = t.Name;
+
+  string base = t.PropertyManager ? t.PropertyManager->GetFullyQualifiedName() + "/" : "";
+  for (unsigned int i=0; i<3; i++) {
+    lookupProperty[i] = 0;
+    if (t.lookupProperty[i] == 0) continue;
+
+    string property_string = t.lookupProperty[i]->GetRelativeName(base);
+    lookupProperty[i] = PropertyManager->GetNode(property_string);
+    if (lookupProperty[i] == 0) {
+      FGTABLE_ATOMIC_DECREMENT(&Store->RefCount);
+      throw("IndependentVar property, " + property_string + " in Table copy is not defined.");
     }
   }
-  lastRowIndex = t.lastRowIndex;
-  lastColumnIndex = t.lastColumnIndex;
-  lastTableIndex = t.lastTableIndex;
+
+  bind();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -129,7 +303,8 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
   string operation_types = "function, product, sum, difference, quotient,"
                            "pow, abs, sin, cos, asin, acos, tan, atan, table";
 
-  nTables = 0;
+  Store = new TableData;
+  TableData& t = *Store;
 
   // Is this an internal lookup table?
 
@@ -153,10 +328,10 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
   }
 
   // Determine and store the lookup properties for this table unless this table
-  // is part of a 3D table, in which case its independentVar property indexes will
-  // be set by a call from the owning table during creation
+  // is part of a 3D table, in which case it is only used for its data.
 
   dimension = 0;
+  for (i=0; i<3; i++) lookupProperty[i] = 0;
 
   axisElement = el->FindElement("independentVar");
   if (axisElement) {
@@ -171,8 +346,6 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
       internal = false;
     }
 
-    for (i=0; i<3; i++) lookupProperty[i] = 0;
-
     while (axisElement) {
       property_string = axisElement->GetDataLine();
       // The property string passed into GetNode() must have no spaces or tabs.
@@ -236,52 +409,50 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
   }
   switch (dimension) {
   case 1:
-    nRows = tableData->GetNumDataLines();
-    nCols = 1;
-    Type = tt1D;
+    t.nRows = tableData->GetNumDataLines();
+    t.nCols = 1;
+    t.Type = tt1D;
     colCounter = 0;
     rowCounter = 1;
-    Data = Allocate();
+    t.Allocate();
     Debug(0);
-    lastRowIndex = lastColumnIndex = 2;
     *this << buf;
     break;
   case 2:
-    nRows = tableData->GetNumDataLines()-1;
+    t.nRows = tableData->GetNumDataLines()-1;
 
-    if (nRows >= 2) nCols = FindNumColumns(tableData->GetDataLine(0));
+    if (t.nRows >= 2) t.nCols = FindNumColumns(tableData->GetDataLine(0));
     else {
       cerr << endl << fgred << "Not enough rows in this table." << fgdef << endl;
       abort();
     }
 
-    Type = tt2D;
+    t.Type = tt2D;
     colCounter = 1;
     rowCounter = 0;
 
-    Data = Allocate();
-    lastRowIndex = lastColumnIndex = 2;
+    t.Allocate();
     *this << buf;
     break;
   case 3:
-    nTables = el->GetNumElements("tableData");
-    nRows = nTables;
-    nCols = 1;
-    Type = tt3D;
+    t.nTables = el->GetNumElements("tableData");
+    t.nRows = t.nTables;
+    t.nCols = 1;
+    t.Type = tt3D;
     colCounter = 1;
     rowCounter = 1;
-    lastRowIndex = lastColumnIndex = 2;
 
-    Data = Allocate(); // this data array will contain the keys for the associated tables
-    Tables.reserve(nTables); // necessary?
+    t.Allocate(); // this data array will contain the keys for the associated tables
+    t.Tables.reserve(t.nTables);
     tableData = el->FindElement("tableData");
-    for (i=0; i<nTables; i++) {
-      Tables.push_back(new FGTable(PropertyManager, tableData));
-      Data[i+1][1] = tableData->GetAttributeValueAsNumber("breakPoint");
-      Tables[i]->SetRowIndexProperty(lookupProperty[eRow]);
-      Tables[i]->SetColumnIndexProperty(lookupProperty[eColumn]);
+    for (i=0; i<t.nTables; i++) {
+      FGTable table(PropertyManager, tableData);
+      t.Tables.push_back(table.Store);
+      FGTABLE_ATOMIC_INCREMENT(&table.Store->RefCount);
+      t.Data[i+1][1] = tableData->GetAttributeValueAsNumber("breakPoint");
       tableData = el->FindNextElement("tableData");
     }
+    t.Pack();
 
     Debug(0);
     break;
@@ -292,6 +463,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 
   // Sanity checks: lookup indices must be increasing monotonically
   unsigned int r,c,b;
+  double** Data = t.Data;
 
   // find next xml element containing a name attribute
   // to indicate where the error occured
@@ -301,7 +473,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 
   // check breakpoints, if applicable
   if (dimension > 2) {
-    for (b=2; b<=nTables; ++b) {
+    for (b=2; b<=t.nTables; ++b) {
       if (Data[b][1] <= Data[b-1][1]) {
         cerr << fgred << highint << endl
              << "  FGTable: breakpoint lookup is not monotonically increasing" << endl
@@ -317,7 +489,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 
   // check columns, if applicable
   if (dimension > 1) {
-    for (c=2; c<=nCols; ++c) {
+    for (c=2; c<=t.nCols; ++c) {
       if (Data[0][c] <= Data[0][c-1]) {
         cerr << fgred << highint << endl
              << "  FGTable: column lookup is not monotonically increasing" << endl
@@ -333,7 +505,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 
   // check rows
   if (dimension < 3) { // in 3D tables, check only rows of subtables
-    for (r=2; r<=nRows; ++r) {
+    for (r=2; r<=t.nRows; ++r) {
       if (Data[r][0]<=Data[r-1][0]) {
         cerr << fgred << highint << endl
              << "  FGTable: row lookup is not monotonically increasing" << endl
@@ -353,30 +525,46 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double** FGTable::Allocate(void)
+FGTable::~FGTable()
 {
-  Data = new double*[nRows+1];
-  for (unsigned int r=0; r<=nRows; r++) {
-    Data[r] = new double[nCols+1];
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = 0.0;
-    }
-  }
-  return Data;
+  if (FGTABLE_ATOMIC_DECREMENT(&Store->RefCount) == 0) delete Store;
+
+  Debug(1);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-FGTable::~FGTable()
+FGTable::TableData::TableData(void)
+  : RefCount(1), Type(tt1D), nRows(0), nCols(0), nTables(0), Data(0), Packed(false)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGTable::TableData::~TableData()
 {
-  if (nTables > 0) {
-    for (unsigned int i=0; i<nTables; i++) delete Tables[i];
-    Tables.clear();
+  for (unsigned int i=0; i<Tables.size(); i++) {
+    if (FGTABLE_ATOMIC_DECREMENT(&Tables[i]->RefCount) == 0) delete Tables[i];
   }
-  for (unsigned int r=0; r<=nRows; r++) delete[] Data[r];
-  delete[] Data;
+  Tables.clear();
 
-  Debug(1);
+  if (Data) {
+    for (unsigned int r=0; r<=nRows; r++) delete[] Data[r];
+    delete[] Data;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::TableData::Allocate(void)
+{
+  Data = new double*[nRows+1];
+  for (unsigned int r=0; r<=nRows; r++) {
+    Data[r] = new double[nCols+1];
+    for (unsigned int c=0; c<=nCols; c++) {
+      Data[r][c] = 0.0;
+    }
+  }
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -397,14 +585,9 @@ unsigned int FGTable::FindNumColumns(const string& test_line)
 
 double FGTable::GetValue(void) const
 {
-  double temp = 0;
-  double temp2 = 0;
-
-  switch (Type) {
+  switch (Store->Type) {
   case tt1D:
-    temp = lookupProperty[eRow]->getDoubleValue();
-    temp2 = GetValue(temp);
-    return temp2;
+    return GetValue(lookupProperty[eRow]->getDoubleValue());
   case tt2D:
     return GetValue(lookupProperty[eRow]->getDoubleValue(),
                     lookupProperty[eColumn]->getDoubleValue());
@@ -421,6 +604,71 @@ double FGTable::GetValue(void) const
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGTable::GetValue(double key) const
+{
+  return Store->Lookup(LookupCursor.Row, key);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(double rowKey, double colKey) const
+{
+  return Store->Lookup(LookupCursor.Row, LookupCursor.Column, rowKey, colKey);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
+{
+  return Store->Lookup(LookupCursor, rowKey, colKey, tableKey);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(Cursor& cursor, double key) const
+{
+  return Store->Lookup(cursor.Row, key);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(Cursor& cursor, double rowKey, double colKey) const
+{
+  return Store->Lookup(cursor.Row, cursor.Column, rowKey, colKey);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetValue(Cursor& cursor, double rowKey, double colKey, double tableKey) const
+{
+  return Store->Lookup(cursor, rowKey, colKey, tableKey);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetReferenceValue(double key) const
+{
+  return Store->LookupReference(LookupCursor.Row, key);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetReferenceValue(double rowKey, double colKey) const
+{
+  return Store->LookupReference(LookupCursor.Row, LookupCursor.Column, rowKey, colKey);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::GetReferenceValue(double rowKey, double colKey, double tableKey) const
+{
+  return Store->LookupReference(LookupCursor, rowKey, colKey, tableKey);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The reference lookups work on the unpacked data. The cursor r designates the
+// interval between the rows r-1 and r of Data.
+
+double FGTable::TableData::LookupReference(unsigned int& lastRowIndex, double key) const
 {
   double Factor, Value, Span;
   unsigned int r = lastRowIndex;
@@ -463,7 +711,9 @@ double FGTable::GetValue(double key) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double FGTable::GetValue(double rowKey, double colKey) const
+double FGTable::TableData::LookupReference(unsigned int& lastRowIndex,
+                                           unsigned int& lastColumnIndex,
+                                           double rowKey, double colKey) const
 {
   double rFactor, cFactor, col1temp, col2temp, Value;
   unsigned int r = lastRowIndex;
@@ -497,20 +747,24 @@ double FGTable::GetValue(double rowKey, double colKey) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
+double FGTable::TableData::LookupReference(Cursor& cursor, double rowKey, double colKey,
+                                           double tableKey) const
 {
   double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
+  unsigned int r = cursor.Row;
+
+  cursor.Reserve(nTables);
 
   //if the key is off the end  (or before the beginning) of the table,
   // just return the boundary-table value, do not extrapolate
 
   if( tableKey <= Data[1][1] ) {
-    lastRowIndex=2;
-    return Tables[0]->GetValue(rowKey, colKey);
+    cursor.Row=2;
+    return Tables[0]->LookupReference(cursor.SubRows[0], cursor.SubColumns[0], rowKey, colKey);
   } else if ( tableKey >= Data[nRows][1] ) {
-    lastRowIndex=nRows;
-    return Tables[nRows-1]->GetValue(rowKey, colKey);
+    cursor.Row=nRows;
+    return Tables[nRows-1]->LookupReference(cursor.SubRows[nRows-1], cursor.SubColumns[nRows-1],
+                                            rowKey, colKey);
   }
 
   // the key is somewhere in the middle, search for the right breakpoint
@@ -521,7 +775,7 @@ double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
   while(r > 2     && Data[r-1][1] > tableKey) { r--; }
   while(r < nRows && Data[r]  [1] < tableKey) { r++; }
 
-  lastRowIndex=r;
+  cursor.Row=r;
   // make sure denominator below does not go to zero.
 
   Span = Data[r][1] - Data[r-1][1];
@@ -532,12 +786,327 @@ double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
     Factor = 1.0;
   }
 
-  Value = Factor*(Tables[r-1]->GetValue(rowKey, colKey) - Tables[r-2]->GetValue(rowKey, colKey))
-                              + Tables[r-2]->GetValue(rowKey, colKey);
+  double Value1 = Tables[r-1]->LookupReference(cursor.SubRows[r-1], cursor.SubColumns[r-1],
+                                               rowKey, colKey);
+  double Value0 = Tables[r-2]->LookupReference(cursor.SubRows[r-2], cursor.SubColumns[r-2],
+                                               rowKey, colKey);
+  Value = Factor*(Value1 - Value0) + Value0;
+
+  return Value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The lookups below use the packed data. In the arrays, index 0 is the first
+// breakpoint, so the cursor r (which counts breakpoints from 1, as the rows of
+// Data do) designates the interval between RowKeys[r-2] and RowKeys[r-1].
+
+double FGTable::TableData::Lookup(unsigned int& lastRowIndex, double key) const
+{
+  if (!Packed) return LookupReference(lastRowIndex, key);
+
+  const double* keys = &RowKeys[0];
+  const double* values = &Values[0];
+  double Factor, Value, Span;
+  unsigned int r = lastRowIndex;
+
+  //if the key is off the end of the table, just return the
+  //end-of-table value, do not extrapolate
+  if( key <= keys[0] ) {
+    lastRowIndex=2;
+    return values[0];
+  } else if ( key >= keys[nRows-1] ) {
+    lastRowIndex=nRows;
+    return values[nRows-1];
+  }
+
+  while (r > 2     && keys[r-2] > key) { r--; }
+  while (r < nRows && keys[r-1] < key) { r++; }
+
+  lastRowIndex=r;
+
+  Span = keys[r-1] - keys[r-2];
+  if (Span != 0.0) {
+    Factor = (key - keys[r-2]) / Span;
+    if (Factor > 1.0) Factor = 1.0;
+  } else {
+    Factor = 1.0;
+  }
+
+  Value = Factor*(values[r-1] - values[r-2]) + values[r-2];
+
+  return Value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::TableData::Lookup(unsigned int& lastRowIndex, unsigned int& lastColumnIndex,
+                                  double rowKey, double colKey) const
+{
+  if (!Packed) return LookupReference(lastRowIndex, lastColumnIndex, rowKey, colKey);
+
+  const double* rowKeys = &RowKeys[0];
+  const double* colKeys = &ColumnKeys[0];
+  double rFactor, cFactor, col1temp, col2temp, Value;
+  unsigned int r = lastRowIndex;
+  unsigned int c = lastColumnIndex;
+
+  while(r > 2     && rowKeys[r-2] > rowKey) { r--; }
+  while(r < nRows && rowKeys[r-1] < rowKey) { r++; }
+
+  while(c > 2     && colKeys[c-2] > colKey) { c--; }
+  while(c < nCols && colKeys[c-1] < colKey) { c++; }
+
+  lastRowIndex=r;
+  lastColumnIndex=c;
+
+  rFactor = (rowKey - rowKeys[r-2]) / (rowKeys[r-1] - rowKeys[r-2]);
+  cFactor = (colKey - colKeys[c-2]) / (colKeys[c-1] - colKeys[c-2]);
+
+  if (rFactor > 1.0) rFactor = 1.0;
+  else if (rFactor < 0.0) rFactor = 0.0;
+
+  if (cFactor > 1.0) cFactor = 1.0;
+  else if (cFactor < 0.0) cFactor = 0.0;
+
+  const double* row1 = &Values[(r-2)*nCols];
+  const double* row2 = row1 + nCols;
+
+  col1temp = rFactor*(row2[c-2] - row1[c-2]) + row1[c-2];
+  col2temp = rFactor*(row2[c-1] - row1[c-1]) + row1[c-1];
+
+  Value = col1temp + cFactor*(col2temp - col1temp);
+
+  return Value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::TableData::Lookup(Cursor& cursor, double rowKey, double colKey,
+                                  double tableKey) const
+{
+  if (!Packed) return LookupReference(cursor, rowKey, colKey, tableKey);
+
+  const double* keys = &TableKeys[0];
+  double Factor, Value, Span;
+  unsigned int r = cursor.Row;
+
+  cursor.Reserve(nTables);
+
+  //if the key is off the end  (or before the beginning) of the table,
+  // just return the boundary-table value, do not extrapolate
+
+  if( tableKey <= keys[0] ) {
+    cursor.Row=2;
+    return Tables[0]->Lookup(cursor.SubRows[0], cursor.SubColumns[0], rowKey, colKey);
+  } else if ( tableKey >= keys[nRows-1] ) {
+    cursor.Row=nRows;
+    return Tables[nRows-1]->Lookup(cursor.SubRows[nRows-1], cursor.SubColumns[nRows-1],
+                                   rowKey, colKey);
+  }
+
+  while(r > 2     && keys[r-2] > tableKey) { r--; }
+  while(r < nRows && keys[r-1] < tableKey) { r++; }
+
+  cursor.Row=r;
+
+  Span = keys[r-1] - keys[r-2];
+  if (Span != 0.0) {
+    Factor = (tableKey - keys[r-2]) / Span;
+    if (Factor > 1.0) Factor = 1.0;
+  } else {
+    Factor = 1.0;
+  }
+
+  double Value1 = Tables[r-1]->Lookup(cursor.SubRows[r-1], cursor.SubColumns[r-1], rowKey, colKey);
+  double Value0 = Tables[r-2]->Lookup(cursor.SubRows[r-2], cursor.SubColumns[r-2], rowKey, colKey);
+  Value = Factor*(Value1 - Value0) + Value0;
 
   return Value;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Makes room for the cursors of the sub-tables of a 3D table.
+
+void FGTable::Cursor::Reserve(unsigned int nTables)
+{
+  if (SubRows.size() < nTables) {
+    SubRows.resize(nTables, 2);
+    SubColumns.resize(nTables, 2);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(unsigned int n, const double* keys, double* values) const
+{
+  const TableData& t = *Store;
+
+  if (!t.Packed || t.nRows < 2) {
+    Cursor cursor;
+    for (unsigned int i=0; i<n; i++) values[i] = t.Lookup(cursor.Row, keys[i]);
+    return;
+  }
+
+  double lo[BlockSize], inv[BlockSize], f[BlockSize];
+  double v1[BlockSize], v2[BlockSize];
+  unsigned int index[BlockSize];
+
+  for (unsigned int start=0; start<n; start+=BlockSize) {
+    unsigned int m = min(BlockSize, n-start);
+    const double* key = keys + start;
+
+    FindIntervals(t.RowKeys, m, key, index);
+
+    for (unsigned int i=0; i<m; i++) {
+      unsigned int r = index[i];
+      lo[i] = t.RowKeys[r-1];
+      inv[i] = t.RowInvSpan[r];
+      v1[i] = t.Values[r-1];
+      v2[i] = t.Values[r];
+    }
+
+    ComputeFactors(m, key, lo, inv, f);
+    Interpolate(m, f, v1, v2, values + start);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(unsigned int n, const double* rowKeys, const double* colKeys,
+                        double* values) const
+{
+  const TableData& t = *Store;
+
+  if (!t.Packed) {
+    Cursor cursor;
+    for (unsigned int i=0; i<n; i++)
+      values[i] = t.Lookup(cursor.Row, cursor.Column, rowKeys[i], colKeys[i]);
+    return;
+  }
+
+  double rlo[BlockSize], rinv[BlockSize], rf[BlockSize];
+  double clo[BlockSize], cinv[BlockSize], cf[BlockSize];
+  double v11[BlockSize], v21[BlockSize], v12[BlockSize], v22[BlockSize];
+  double col1[BlockSize], col2[BlockSize];
+  unsigned int rindex[BlockSize], cindex[BlockSize];
+
+  for (unsigned int start=0; start<n; start+=BlockSize) {
+    unsigned int m = min(BlockSize, n-start);
+    const double* rowKey = rowKeys + start;
+    const double* colKey = colKeys + start;
+
+    FindIntervals(t.RowKeys, m, rowKey, rindex);
+    FindIntervals(t.ColumnKeys, m, colKey, cindex);
+
+    for (unsigned int i=0; i<m; i++) {
+      unsigned int r = rindex[i];
+      unsigned int c = cindex[i];
+      const double* row1 = &t.Values[(r-1)*t.nCols];
+      const double* row2 = row1 + t.nCols;
+      rlo[i] = t.RowKeys[r-1];
+      rinv[i] = t.RowInvSpan[r];
+      clo[i] = t.ColumnKeys[c-1];
+      cinv[i] = t.ColumnInvSpan[c];
+      v11[i] = row1[c-1];
+      v21[i] = row2[c-1];
+      v12[i] = row1[c];
+      v22[i] = row2[c];
+    }
+
+    ComputeFactors(m, rowKey, rlo, rinv, rf);
+    ComputeFactors(m, colKey, clo, cinv, cf);
+    Interpolate(m, rf, v11, v21, col1);
+    Interpolate(m, rf, v12, v22, col2);
+    Interpolate(m, cf, col1, col2, values + start);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The two tables that bracket each table key are looked up one key at a time;
+// only the interpolation between them is batched.
+
+void FGTable::GetValues(unsigned int n, const double* rowKeys, const double* colKeys,
+                        const double* tableKeys, double* values) const
+{
+  const TableData& t = *Store;
+  Cursor cursor;
+
+  if (!t.Packed || t.nRows < 2) {
+    for (unsigned int i=0; i<n; i++)
+      values[i] = t.Lookup(cursor, rowKeys[i], colKeys[i], tableKeys[i]);
+    return;
+  }
+
+  double lo[BlockSize], inv[BlockSize], f[BlockSize];
+  double v1[BlockSize], v2[BlockSize];
+  unsigned int index[BlockSize];
+
+  cursor.Reserve(t.nTables);
+
+  for (unsigned int start=0; start<n; start+=BlockSize) {
+    unsigned int m = min(BlockSize, n-start);
+    const double* tableKey = tableKeys + start;
+
+    FindIntervals(t.TableKeys, m, tableKey, index);
+
+    for (unsigned int i=0; i<m; i++) {
+      unsigned int k = index[i];
+      double rowKey = rowKeys[start+i];
+      double colKey = colKeys[start+i];
+      lo[i] = t.TableKeys[k-1];
+      inv[i] = t.TableInvSpan[k];
+      v1[i] = t.Tables[k-1]->Lookup(cursor.SubRows[k-1], cursor.SubColumns[k-1], rowKey, colKey);
+      v2[i] = t.Tables[k]->Lookup(cursor.SubRows[k], cursor.SubColumns[k], rowKey, colKey);
+    }
+
+    ComputeFactors(m, tableKey, lo, inv, f);
+    Interpolate(m, f, v1, v2, values + start);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Builds the packed copy of the table data. Tables whose shape the lookups
+// cannot handle are left unpacked and are looked up from Data.
+
+void FGTable::TableData::Pack(void)
+{
+  unsigned int r, c;
+
+  RowKeys.clear();
+  ColumnKeys.clear();
+  TableKeys.clear();
+  Values.clear();
+  Packed = false;
+
+  switch (Type) {
+  case tt1D:
+    if (nRows < 1) return;
+    for (r=1; r<=nRows; r++) {
+      RowKeys.push_back(Data[r][0]);
+      Values.push_back(Data[r][1]);
+    }
+    break;
+  case tt2D:
+    if (nRows < 2 || nCols < 2) return;
+    for (r=1; r<=nRows; r++) RowKeys.push_back(Data[r][0]);
+    for (c=1; c<=nCols; c++) ColumnKeys.push_back(Data[0][c]);
+    Values.reserve(nRows*nCols);
+    for (r=1; r<=nRows; r++) {
+      for (c=1; c<=nCols; c++) Values.push_back(Data[r][c]);
+    }
+    break;
+  case tt3D:
+    if (nRows < 1) return;
+    for (r=1; r<=nRows; r++) TableKeys.push_back(Data[r][1]);
+    break;
+  }
+
+  ComputeInverseSpans(RowKeys, RowInvSpan);
+  ComputeInverseSpans(ColumnKeys, ColumnInvSpan);
+  ComputeInverseSpans(TableKeys, TableInvSpan);
+  Packed = true;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGTable::operator<<(istream& in_stream)
@@ -546,25 +1115,27 @@ void FGTable::operator<<(istream& in_stream)
   int startCol=0;
 
 // In 1D table, no pseudo-row of column-headers (i.e. keys):
-  if (Type == tt1D) startRow = 1;
+  if (Store->Type == tt1D) startRow = 1;
 
-  for (unsigned int r=startRow; r<=nRows; r++) {
-    for (unsigned int c=startCol; c<=nCols; c++) {
+  for (unsigned int r=startRow; r<=Store->nRows; r++) {
+    for (unsigned int c=startCol; c<=Store->nCols; c++) {
       if (r != 0 || c != 0) {
-        in_stream >> Data[r][c];
+        in_stream >> Store->Data[r][c];
       }
     }
   }
+  Store->Pack();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGTable& FGTable::operator<<(const double n)
 {
-  Data[rowCounter][colCounter] = n;
-  if (colCounter == (int)nCols) {
+  Store->Data[rowCounter][colCounter] = n;
+  if (colCounter == (int)Store->nCols) {
     colCounter = 0;
     rowCounter++;
+    if (rowCounter > (int)Store->nRows) Store->Pack(); // the table is now filled in
   } else {
     colCounter++;
   }
@@ -582,6 +1153,13 @@ FGTable& FGTable::operator<<(const int n)
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGTable::Print(void)
+{
+  Store->Print();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::TableData::Print(void) const
 {
   int startRow=0;
   int startCol=0;
@@ -232,6 +232,27 @@ referring to combustion efficiency). Later on, the table is used like this:
 combustion_efficiency = Lookup_Combustion_Efficiency->GetValue(equivalence_ratio);
 @endcode
 
+Once a table has been completely filled in, its data is also stored in a
+packed form: the row, column and table breakpoints are kept in separate
+contiguous arrays together with the inverse of the span of each interval, and
+the values are kept in a single row-major array. The lookups are made from this
+packed data. They give exactly the same results as the original lookups, which
+are still available from the GetReferenceValue() methods.
+
+When a table must be evaluated for many sets of keys at once (e.g. for a Monte
+Carlo run or a trim sweep), the GetValues() methods look up all of the keys in
+a single call. The interpolation is then done by multiplying by the inverse
+spans and is vectorized with SSE2 or AVX instructions when the compiler targets
+them. Since a multiplication by the inverse span is not rounded the same way as
+a division by the span, the results of GetValues() can differ from those of
+GetValue() in the last bits.
+
+@code
+double alpha[100], cl[100];
+...
+CL_Table->GetValues(100, alpha, cl);
+@endcode
+
 @author Jon S. Berndt
 @version $Id: FGTable.h,v 1.12 2010/09/16 11:01:24 jberndt Exp $
 */
@@ -246,10 +267,37 @@ public:
   /// Destructor
   ~FGTable();
 
-  /** This is the very important copy constructor.
+  /** This is the very important copy constructor. The copy shares the data
+      of the table, which is not modified once the table is filled in, and has
+      its own lookup cursor.
       @param table a const reference to a table.*/
   FGTable(const FGTable& table);
 
+  /** Copies a table for another property tree, for instance the one of
+      another FGFDMExec. The copy shares the data of the table as above, but
+      looks up the properties of the same names in propMan, relative to it as
+      the original's are to the property manager of the original, and a named
+      table is tied in propMan. Several instances, such as the ones of a batch
+      run, can thus use the data of a table that was read once.
+      @param table a const reference to a table.
+      @param propMan the property manager the copy is bound to.*/
+  FGTable(const FGTable& table, FGPropertyManager* propMan);
+
+  /** Search hints for the lookups of a table. A cursor remembers the
+      intervals of the keys that were last looked up, so that the next lookup
+      with nearby keys is fast. The lookups that take a cursor do not modify
+      the table, so a table can be used concurrently by several threads as
+      long as each of them uses its own cursor. */
+  class Cursor {
+  public:
+    Cursor(void) : Row(2), Column(2) {}
+  private:
+    friend class FGTable;
+    unsigned int Row, Column;
+    std::vector <unsigned int> SubRows, SubColumns; // for the tables of a 3D table
+    void Reserve(unsigned int nTables);
+  };
+
   /// The constructor for a table
   FGTable (FGPropertyManager* propMan, Element* el);
   FGTable (int );
@@ -258,6 +306,41 @@ public:
   double GetValue(double key) const;
   double GetValue(double rowKey, double colKey) const;
   double GetValue(double rowKey, double colKey, double TableKey) const;
+
+  /** Looks up the table with the search hints of a cursor. The lookups above
+      use the cursor of this instance of the table.
+      @param cursor the cursor, which is updated by the lookup */
+  double GetValue(Cursor& cursor, double key) const;
+  double GetValue(Cursor& cursor, double rowKey, double colKey) const;
+  double GetValue(Cursor& cursor, double rowKey, double colKey, double TableKey) const;
+
+  /** Looks up a 1D table for n keys.
+      @param n the number of keys
+      @param keys array of n row keys
+      @param values array of n values that receives the results */
+  void GetValues(unsigned int n, const double* keys, double* values) const;
+  /** Looks up a 2D table for n pairs of keys.
+      @param n the number of keys
+      @param rowKeys array of n row keys
+      @param colKeys array of n column keys
+      @param values array of n values that receives the results */
+  void GetValues(unsigned int n, const double* rowKeys, const double* colKeys,
+                 double* values) const;
+  /** Looks up a 3D table for n triplets of keys.
+      @param n the number of keys
+      @param rowKeys array of n row keys
+      @param colKeys array of n column keys
+      @param tableKeys array of n table keys
+      @param values array of n values that receives the results */
+  void GetValues(unsigned int n, const double* rowKeys, const double* colKeys,
+                 const double* tableKeys, double* values) const;
+
+  /** Looks up the table from its unpacked data. These are the original lookup
+      algorithms which are kept for reference and for benchmarking. */
+  double GetReferenceValue(double key) const;
+  double GetReferenceValue(double rowKey, double colKey) const;
+  double GetReferenceValue(double rowKey, double colKey, double TableKey) const;
+
   /** Read the table in.
       Data in the config file should be in matrix format with the row
       independents as the first column and the column independents in
@@ -284,28 +367,64 @@ public:
   FGTable& operator<<(const double n);
   FGTable& operator<<(const int n);
 
-  inline double GetElement(int r, int c) {return Data[r][c];}
+  inline double GetElement(int r, int c) {return Store->Data[r][c];}
   inline double GetElement(int r, int c, int t);
 
   void SetRowIndexProperty(FGPropertyManager *node) {lookupProperty[eRow] = node;}
   void SetColumnIndexProperty(FGPropertyManager *node) {lookupProperty[eColumn] = node;}
 
+  FGPropertyManager* GetRowIndexProperty(void) const {return lookupProperty[eRow];}
+  FGPropertyManager* GetColumnIndexProperty(void) const {return lookupProperty[eColumn];}
+  FGPropertyManager* GetTableIndexProperty(void) const {return lookupProperty[eTable];}
+
+  /// Returns the number of lookup keys of the table (1, 2 or 3).
+  unsigned int GetNumDimensions(void) const {return (unsigned int)Store->Type + 1;}
+
   void Print(void);
 
 private:
-  enum type {tt1D, tt2D, tt3D} Type;
+  enum type {tt1D, tt2D, tt3D};
   enum axis {eRow=0, eColumn, eTable};
+
+  /** The data of a table. It is shared by the copies of the table and is not
+      modified once the table is filled in. */
+  struct TableData {
+    TableData(void);
+    ~TableData();
+
+    volatile long RefCount;
+    type Type;
+    unsigned int nRows, nCols, nTables;
+    double** Data;
+    std::vector <TableData*> Tables;
+
+    // Packed copy of Data, built by Pack() once the table is filled in.
+    bool Packed;
+    std::vector <double> RowKeys, ColumnKeys, TableKeys;
+    std::vector <double> RowInvSpan, ColumnInvSpan, TableInvSpan;
+    std::vector <double> Values;
+
+    void Allocate(void);
+    void Pack(void);
+    void Print(void) const;
+    double Lookup(unsigned int& r, double key) const;
+    double Lookup(unsigned int& r, unsigned int& c, double rowKey, double colKey) const;
+    double Lookup(Cursor& cursor, double rowKey, double colKey, double tableKey) const;
+    double LookupReference(unsigned int& r, double key) const;
+    double LookupReference(unsigned int& r, unsigned int& c, double rowKey, double colKey) const;
+    double LookupReference(Cursor& cursor, double rowKey, double colKey, double tableKey) const;
+  };
+
+  TableData* Store;
+  mutable Cursor LookupCursor; // search hints of this instance
   bool internal;
   FGPropertyManager *lookupProperty[3];
-  double** Data;
-  std::vector <FGTable*> Tables;
-  unsigned int nRows, nCols, nTables, dimension;
+  unsigned int dimension;
   int colCounter, rowCounter, tableCounter;
-  mutable int lastRowIndex, lastColumnIndex, lastTableIndex;
-  double** Allocate(void);
   FGPropertyManager* const PropertyManager;
   std::string Name;
   void bind(void);
+  FGTable& operator=(const FGTable&); // not implemented
 
   unsigned int FindNumColumns(const std::string&);
   void Debug(int from);
@@ -0,0 +1,110 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGTimingStats.cpp
+Date started: October 16 2026
+Purpose: Accumulates the statistics of execution times
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGTimingStats.h"
+#include "input_output/FGPropertyManager.h"
+#include <cmath>
+
+using namespace std;
+
+namespace JSBSim {
+
+static const char *IdSrc = "$Id: FGTimingStats.cpp,v 1.0 2026/10/16 00:00:00 $";
+static const char *IdHdr = ID_TIMINGSTATS;
+
+// The lower bound of the first bin of the histogram (seconds).
+static const double BinOrigin = 1e-8;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+void FGTimingStats::Reset(void)
+{
+  Count = 0;
+  Last = Min = Max = Total = 0.0;
+  for (int i=0; i<NumBins; i++) Bins[i] = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The bin is found from the binary exponent and the leading bits of the mantissa
+// of the time, which spares a logarithm: with t/BinOrigin = m*2^e and m in
+// [0.5, 1), the octave is e-1 and the bin within the octave is given by m.
+
+void FGTimingStats::Add(double t)
+{
+  if (Count == 0 || t < Min) Min = t;
+  if (t > Max) Max = t;
+  Last = t;
+  Total += t;
+  Count++;
+
+  int bin = 0;
+  double x = t/BinOrigin;
+  if (x >= 1.0) {
+    int e;
+    double m = frexp(x, &e);
+    bin = (e-1)*BinsPerOctave + (int)((m - 0.5)*2*BinsPerOctave);
+    if (bin >= NumBins) bin = NumBins-1;
+  }
+  Bins[bin]++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTimingStats::GetPercentile(double p) const
+{
+  if (Count == 0) return 0.0;
+
+  double target = p*Count;
+  unsigned long cumulated = 0;
+
+  for (int bin=0; bin<NumBins-1; bin++) {
+    cumulated += Bins[bin];
+    if (cumulated >= target) {
+      int octave = bin / BinsPerOctave;
+      int sub = bin % BinsPerOctave;
+      double upper = ldexp(BinOrigin*(1.0 + (double)(sub+1)/BinsPerOctave), octave);
+      return upper < Max ? upper : Max;
+    }
+  }
+
+  return Max;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTimingStats::Bind(FGPropertyManager* pm, const string& base)
+{
+  pm->Tie(base + "/last-sec", this, &FGTimingStats::GetLast);
+  pm->Tie(base + "/min-sec", this, &FGTimingStats::GetMin);
+  pm->Tie(base + "/mean-sec", this, &FGTimingStats::GetMean);
+  pm->Tie(base + "/max-sec", this, &FGTimingStats::GetMax);
+  pm->Tie(base + "/p99-sec", this, &FGTimingStats::GetP99);
+}
+
+}
@@ -0,0 +1,119 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGTimingStats.h
+Date started: October 16 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGTIMINGSTATS_H
+#define FGTIMINGSTATS_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_TIMINGSTATS "$Id: FGTimingStats.h,v 1.0 2026/10/16 00:00:00 $"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGPropertyManager;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Accumulates the statistics of a series of execution times: the last, minimum,
+    mean and maximum times, and percentiles. The times are counted in a fixed
+    histogram of logarithmic bins (four per octave, from 10 ns to about 0.17 s,
+    longer times falling in the last bin), so adding a time is cheap and never
+    allocates memory. The percentiles are given as the upper bound of the bin
+    they fall in (bounded by the maximum time), that is to within 19%.
+
+    The statistics can be bound to properties: under a given base path, the
+    properties last-sec, min-sec, mean-sec, max-sec and p99-sec (read only)
+    give the times in seconds.
+    @version "$Id: FGTimingStats.h,v 1.0 2026/10/16 00:00:00 $"
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGTimingStats
+{
+public:
+  /// Constructor
+  FGTimingStats(void) {Reset();}
+
+  /// Clears the statistics.
+  void Reset(void);
+
+  /** Adds a time to the statistics.
+      @param t the time in seconds */
+  void Add(double t);
+
+  /// Returns the number of times added.
+  unsigned long GetCount(void) const {return Count;}
+  /// Returns the last time added, in seconds.
+  double GetLast(void) const {return Last;}
+  /// Returns the minimum time, in seconds.
+  double GetMin(void) const {return Count > 0 ? Min : 0.0;}
+  /// Returns the mean time, in seconds.
+  double GetMean(void) const {return Count > 0 ? Total/Count : 0.0;}
+  /// Returns the maximum time, in seconds.
+  double GetMax(void) const {return Max;}
+  /** Returns a percentile of the times.
+      @param p the fraction of the times (for instance 0.99)
+      @return the time, in seconds, that the fraction p of the times does not
+              exceed */
+  double GetPercentile(double p) const;
+  /// Returns the 99th percentile of the times, in seconds.
+  double GetP99(void) const {return GetPercentile(0.99);}
+
+  /** Ties the statistics to properties.
+      @param pm the property manager
+      @param base the path under which the properties are created */
+  void Bind(FGPropertyManager* pm, const std::string& base);
+
+private:
+  enum {BinsPerOctave = 4, NumBins = 96};
+
+  unsigned long Count;
+  double Last;
+  double Min;
+  double Max;
+  double Total;
+  unsigned int Bins[NumBins];
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -47,6 +47,7 @@ INCLUDES
 #include "FGAuxiliary.h"
 #include "FGMassBalance.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -411,6 +412,18 @@ void FGAerodynamics::DetermineAxisSystem()
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGAerodynamics::GetFunctions(vector <FGFunction*>& functions) const
+{
+  FGModel::GetFunctions(functions);
+
+  for (unsigned int axis = 0; axis < 6; axis++)
+    functions.insert(functions.end(), Coeff[axis].begin(), Coeff[axis].end());
+
+  if (AeroRPShift) functions.push_back(AeroRPShift);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 string FGAerodynamics::GetCoefficientStrings(const string& delimeter) const
 {
   string CoeffStrings = "";
@@ -434,16 +447,21 @@ string FGAerodynamics::GetCoefficientStrings(const string& delimeter) const
 
 string FGAerodynamics::GetCoefficientValues(const string& delimeter) const
 {
-  ostringstream buf;
+  FGOutputRecord record;
+
+  GetCoefficientValues(record);
 
+  return record.Print(delimeter);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAerodynamics::GetCoefficientValues(FGOutputRecord& record) const
+{
   for (unsigned int axis = 0; axis < 6; axis++) {
-    for (unsigned int sd = 0; sd < Coeff[axis].size(); sd++) {
-      if (buf.tellp() > 0) buf << delimeter;
-      buf << setw(9) << Coeff[axis][sd]->GetValue();
-    }
+    for (unsigned int sd = 0; sd < Coeff[axis].size(); sd++)
+      record.Push(Coeff[axis][sd]->GetValue(), 6, 9);
   }
-
-  return buf.str();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -60,6 +60,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGOutputRecord;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -197,6 +199,10 @@ public:
       coefficients */
   std::string GetCoefficientValues(const std::string& delimeter) const;
 
+  /** Gets the coefficient values.
+      @param record the output record the values are appended to */
+  void GetCoefficientValues(FGOutputRecord& record) const;
+
   /** Calculates and returns the wind-to-body axis transformation matrix.
       @return a reference to the wind-to-body transformation matrix.
       */
@@ -209,6 +215,10 @@ public:
 
   std::vector <FGFunction*> * GetCoeff(void) const { return Coeff; }
 
+  /** Appends the aerodynamic coefficient functions, the reference point shift
+      function and the model functions to a list. */
+  void GetFunctions(std::vector <FGFunction*>& functions) const;
+
 private:
   enum eAxisType {atNone, atLiftDrag, atAxialNormal, atBodyXYZ} axisType;
   typedef std::map<std::string,int> AxisIndex;
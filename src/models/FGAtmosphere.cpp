@@ -145,6 +145,13 @@ bool FGAtmosphere::InitModel(void)
   rSLdensity     = 1.0/StdSLdensity;
   rSLsoundspeed  = 1.0/StdSLsoundspeed;
 
+  // the Milspec and Tustin turbulence start from rest
+  xi_u_km1 = nu_u_km1 = 0.0;
+  xi_v_km1 = xi_v_km2 = nu_v_km1 = nu_v_km2 = 0.0;
+  xi_w_km1 = xi_w_km2 = nu_w_km1 = nu_w_km2 = 0.0;
+  xi_p_km1 = nu_p_km1 = 0.0;
+  xi_q_km1 = xi_r_km1 = 0.0;
+
   return true;
 }
 
@@ -410,11 +417,11 @@ void FGAtmosphere::Turbulence(void)
   case ttStandard: {
     // TurbGain = TurbGain * TurbGain * 100.0; // what is this!?
 
-    vDirectiondAccelDt(eX) = 1 - 2.0*(double(rand())/double(RAND_MAX));
-    vDirectiondAccelDt(eY) = 1 - 2.0*(double(rand())/double(RAND_MAX));
-    vDirectiondAccelDt(eZ) = 1 - 2.0*(double(rand())/double(RAND_MAX));
+    vDirectiondAccelDt(eX) = 1 - 2.0*UniformRandomNumber();
+    vDirectiondAccelDt(eY) = 1 - 2.0*UniformRandomNumber();
+    vDirectiondAccelDt(eZ) = 1 - 2.0*UniformRandomNumber();
 
-    MagnitudedAccelDt = 1 - 2.0*(double(rand())/double(RAND_MAX)) - Magnitude;
+    MagnitudedAccelDt = 1 - 2.0*UniformRandomNumber() - Magnitude;
                                 // Scale the magnitude so that it moves
                                 // away from the peaks
     MagnitudedAccelDt = ((MagnitudedAccelDt - Magnitude) /
@@ -537,7 +544,7 @@ void FGAtmosphere::Turbulence(void)
 
     double random = 0.0;
     if (target_time == 0.0) {
-      strength = random = 1 - 2.0*(double(rand())/double(RAND_MAX));
+      strength = random = 1 - 2.0*UniformRandomNumber();
       target_time = time + 0.71 + (random * 0.5);
     }
     if (time > target_time) {
@@ -603,16 +610,6 @@ void FGAtmosphere::Turbulence(void)
       sig_u = sig_w = POE_Table->GetValue(probability_of_exceedence_index, h);
     }
 
-    // keep values from last timesteps
-    // TODO maybe use deque?
-    static double
-      xi_u_km1 = 0, nu_u_km1 = 0,
-      xi_v_km1 = 0, xi_v_km2 = 0, nu_v_km1 = 0, nu_v_km2 = 0,
-      xi_w_km1 = 0, xi_w_km2 = 0, nu_w_km1 = 0, nu_w_km2 = 0,
-      xi_p_km1 = 0, nu_p_km1 = 0,
-      xi_q_km1 = 0, xi_r_km1 = 0;
-
-
     double
       T_V = DeltaT, // for compatibility of nomenclature
       sig_p = 1.9/sqrt(L_w*b_w)*sig_w, // Yeager1998, eq. (8)
@@ -99,7 +99,7 @@ bool FGBuoyantForces::Run(void)
   vTotalMoments.InitMatrix();
 
   for (unsigned int i=0; i<Cells.size(); i++) {
-    Cells[i]->Calculate(FDMExec->GetDeltaT());
+    Cells[i]->Calculate(FDMExec->GetDeltaT()*rate);
     vTotalForces  += Cells[i]->GetBodyForces();
     vTotalMoments += Cells[i]->GetMoments();
   }
@@ -155,6 +155,10 @@ public:
       @return . */
   const FGMatrix33& GetGasMassInertia(void);
 
+  /** Gets the number of gas cells.
+      @return the number of gas cells. */
+  unsigned int GetNumGasCells(void) const {return (unsigned int)Cells.size();}
+
   /** Gets the strings for the current set of gas cells.
       @param delimeter either a tab or comma string depending on output type
       @return a string containing the descriptive names for all parameters */
@@ -62,6 +62,7 @@ CLASS IMPLEMENTATION
 
 FGExternalReactions::FGExternalReactions(FGFDMExec* fdmex) : FGModel(fdmex)
 {
+  Name = "FGExternalReactions";
   NoneDefined = true;
   Debug(0);
 }
@@ -41,6 +41,7 @@ INCLUDES
 #include "FGFDMExec.h"
 #include "FGGroundReactions.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGOutputRecord.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -80,6 +81,8 @@ FGFCS::FGFCS(FGFDMExec* fdmex) : FGModel(fdmex)
   GearCmd = GearPos = 1; // default to gear down
   LeftBrake = RightBrake = CenterBrake = 0.0;
   TailhookPos = WingFoldPos = 0.0; 
+  ComponentTiming = false;
+  ComponentsDt = 0.0;
 
   bind();
   for (i=0;i<NForms;i++) {
@@ -194,6 +197,28 @@ void FGFCS::LateBind(void)
   for (i=0; i<FCSComponents.size(); i++) FCSComponents[i]->LateBind();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::GetFunctions(vector <FGFunction*>& functions) const
+{
+  unsigned int i;
+
+  FGModel::GetFunctions(functions);
+
+  for (i=0; i<Systems.size(); i++) {
+    if (Systems[i]->GetType() == "FCS_FUNCTION")
+      functions.push_back(((FGFCSFunction*)Systems[i])->GetFunction());
+  }
+  for (i=0; i<APComponents.size(); i++) {
+    if (APComponents[i]->GetType() == "FCS_FUNCTION")
+      functions.push_back(((FGFCSFunction*)APComponents[i])->GetFunction());
+  }
+  for (i=0; i<FCSComponents.size(); i++) {
+    if (FCSComponents[i]->GetType() == "FCS_FUNCTION")
+      functions.push_back(((FGFCSFunction*)FCSComponents[i])->GetFunction());
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 // Notes: In this logic the default engine commands are set. This is simply a
 // sort of safe-mode method in case the user has not defined control laws for
@@ -211,6 +236,17 @@ bool FGFCS::Run(void)
 
   RunPreFunctions();
 
+  // The components run at the rate of the FCS, which may change (as may the
+  // time step of the executive): they are then given the new time step. The
+  // time step is zero while integration is suspended, and ignored then.
+  double dt = GetDt();
+  if (dt > 0.0 && dt != ComponentsDt) {
+    ComponentsDt = dt;
+    for (i=0; i<Systems.size(); i++) Systems[i]->SetDt(dt);
+    for (i=0; i<APComponents.size(); i++) APComponents[i]->SetDt(dt);
+    for (i=0; i<FCSComponents.size(); i++) FCSComponents[i]->SetDt(dt);
+  }
+
   for (i=0; i<ThrottlePos.size(); i++) ThrottlePos[i] = ThrottleCmd[i];
   for (i=0; i<MixturePos.size(); i++) MixturePos[i] = MixtureCmd[i];
   for (i=0; i<PropAdvance.size(); i++) PropAdvance[i] = PropAdvanceCmd[i];
@@ -223,19 +259,82 @@ bool FGFCS::Run(void)
   }
 
   // Execute Systems in order
-  for (i=0; i<Systems.size(); i++) Systems[i]->Run();
+  RunComponents(Systems, SystemsStats);
 
   // Execute Autopilot
-  for (i=0; i<APComponents.size(); i++) APComponents[i]->Run();
+  RunComponents(APComponents, AutopilotStats);
 
   // Execute Flight Control System
-  for (i=0; i<FCSComponents.size(); i++) FCSComponents[i]->Run();
+  RunComponents(FCSComponents, FCSStats);
 
   RunPostFunctions();
 
   return false;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Like the models in the executive, the components are timed from the end of
+// the previous one, and only in the frames where the time advances.
+
+void FGFCS::RunComponents(FCSCompVec& components, FGTimingStats& stats)
+{
+  unsigned int i;
+
+  if (components.empty()) return;
+
+  if (FDMExec->IntegrationSuspended()) {
+    for (i=0; i<components.size(); i++) components[i]->Run();
+    return;
+  }
+
+  double start = GetMonotonicSeconds();
+  double now = start;
+
+  if (ComponentTiming) {
+    for (i=0; i<components.size(); i++) {
+      components[i]->Run();
+      double end = GetMonotonicSeconds();
+      components[i]->GetExecStats().Add(end - now);
+      now = end;
+    }
+  } else {
+    for (i=0; i<components.size(); i++) components[i]->Run();
+    now = GetMonotonicSeconds();
+  }
+
+  stats.Add(now - start);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::ResetExecStats(void)
+{
+  FGModel::ResetExecStats();
+  SystemsStats.Reset();
+  AutopilotStats.Reset();
+  FCSStats.Reset();
+
+  unsigned int i;
+  for (i=0; i<Systems.size(); i++) Systems[i]->GetExecStats().Reset();
+  for (i=0; i<APComponents.size(); i++) APComponents[i]->GetExecStats().Reset();
+  for (i=0; i<FCSComponents.size(); i++) FCSComponents[i]->GetExecStats().Reset();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::BindComponentStats(FGFCSComponent* component)
+{
+  string name = PropertyManager->mkPropertyName(component->GetName(), true);
+  for (unsigned int i=0; i<name.size(); i++)
+    if (name[i] == '/') name[i] = '-';
+
+  string base = "simulation/perf/fcs/components/" + name;
+  for (int idx=1; PropertyManager->HasNode(base + "/mean-sec"); idx++)
+    base = CreateIndexedPropertyName("simulation/perf/fcs/components/" + name, idx);
+
+  component->GetExecStats().Bind(PropertyManager, base);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGFCS::SetDaLPos( int form , double pos )
@@ -620,6 +719,8 @@ bool FGFCS::Load(Element* el, SystemType systype)
     }
   }
 
+  unsigned int first_component = Components->size();
+
   channel_element = document->FindElement("channel");
   while (channel_element) {
   
@@ -677,6 +778,9 @@ bool FGFCS::Load(Element* el, SystemType systype)
     channel_element = document->FindNextElement("channel");
   }
 
+  for (unsigned int i=first_component; i<Components->size(); i++)
+    BindComponentStats((*Components)[i]);
+
   ResetParser();
 
   return true;
@@ -799,37 +903,27 @@ string FGFCS::GetComponentStrings(const string& delimiter)
 
 string FGFCS::GetComponentValues(const string& delimiter)
 {
-  std::ostringstream buf;
-
-  unsigned int comp;
-  bool firstime = true;
-  int total_count=0;
+  FGOutputRecord record;
 
-  for (unsigned int i=0; i<Systems.size(); i++) {
-    if (firstime) firstime = false;
-    else          buf << delimiter;
+  GetComponentValues(record);
 
-    buf << setprecision(9) << Systems[i]->GetOutput();
-    total_count++;
-  }
+  return record.Print(delimiter);
+}
 
-  for (comp = 0; comp < APComponents.size(); comp++) {
-    if (firstime) firstime = false;
-    else          buf << delimiter;
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-    buf << setprecision(9) << APComponents[comp]->GetOutput();
-    total_count++;
-  }
+void FGFCS::GetComponentValues(FGOutputRecord& record)
+{
+  unsigned int comp;
 
-  for (comp = 0; comp < FCSComponents.size(); comp++) {
-    if (firstime) firstime = false;
-    else          buf << delimiter;
+  for (comp = 0; comp < Systems.size(); comp++)
+    record.Push(Systems[comp]->GetOutput(), 9);
 
-    buf << setprecision(9) << FCSComponents[comp]->GetOutput();
-    total_count++;
-  }
+  for (comp = 0; comp < APComponents.size(); comp++)
+    record.Push(APComponents[comp]->GetOutput(), 9);
 
-  return buf.str();
+  for (comp = 0; comp < FCSComponents.size(); comp++)
+    record.Push(FCSComponents[comp]->GetOutput(), 9);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -920,6 +1014,12 @@ void FGFCS::bind(void)
 
   PropertyManager->Tie("gear/tailhook-pos-norm", this, &FGFCS::GetTailhookPos, &FGFCS::SetTailhookPos);
   PropertyManager->Tie("fcs/wing-fold-pos-norm", this, &FGFCS::GetWingFoldPos, &FGFCS::SetWingFoldPos);
+
+  SystemsStats.Bind(PropertyManager, "simulation/perf/fcs/systems");
+  AutopilotStats.Bind(PropertyManager, "simulation/perf/fcs/autopilot");
+  FCSStats.Bind(PropertyManager, "simulation/perf/fcs/flight-control");
+  PropertyManager->Tie("simulation/perf/fcs/component-timing", this,
+                       &FGFCS::GetComponentTiming, &FGFCS::SetComponentTiming);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
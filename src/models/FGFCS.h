@@ -59,6 +59,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGOutputRecord;
+
 typedef enum { ofRad=0, ofDeg, ofNorm, ofMag , NForms} OutputForm;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -166,6 +168,18 @@ CLASS DOCUMENTATION
     @property fcs/wing-fold-pos-norm
     @property gear/gear-pos-norm
     @property gear/tailhook-pos-norm
+    @property simulation/perf/fcs/systems/mean-sec, ... the statistics of the
+              wall clock times of the systems at each run (see FGTimingStats);
+              likewise for simulation/perf/fcs/autopilot and
+              simulation/perf/fcs/flight-control
+    @property simulation/perf/fcs/component-timing set to 1 to time each
+              component as well (0 by default, as it takes a clock reading
+              per component)
+    @property simulation/perf/fcs/components/<name>/mean-sec, ... the
+              statistics of the wall clock times of each component, when
+              simulation/perf/fcs/component-timing is set. The name is that of
+              the component, in lower case, with the spaces and slashes
+              replaced by hyphens.
 
     @author Jon S. Berndt
     @version $Revision: 1.31 $
@@ -356,6 +370,10 @@ public:
       component outputs */
   std::string GetComponentValues(const std::string& delimiter);
 
+  /** Retrieves all component outputs for inclusion in output stream
+      @param record the output record the values are appended to */
+  void GetComponentValues(FGOutputRecord& record);
+
   /// @name Pilot input command setting
   //@{
   /** Sets the aileron command
@@ -542,6 +560,16 @@ public:
 
   void LateBind(void);
 
+  /** Appends the functions of the system, autopilot and flight control
+      function components, as well as the model functions, to a list. */
+  void GetFunctions(std::vector <FGFunction*>& functions) const;
+
+  /// Enables (1) or disables (0) the timing of each component.
+  void SetComponentTiming(int tt) {ComponentTiming = tt != 0;}
+  int GetComponentTiming(void) const {return ComponentTiming ? 1 : 0;}
+  /// Clears the timing statistics of the FCS, its channels and components.
+  void ResetExecStats(void);
+
 private:
   double DaCmd, DeCmd, DrCmd, DsCmd, DfCmd, DsbCmd, DspCmd;
   double DePos[NForms], DaLPos[NForms], DaRPos[NForms], DrPos[NForms];
@@ -564,6 +592,13 @@ private:
   FCSCompVec Systems;
   FCSCompVec FCSComponents;
   FCSCompVec APComponents;
+  FGTimingStats SystemsStats;
+  FGTimingStats AutopilotStats;
+  FGTimingStats FCSStats;
+  bool ComponentTiming;
+  double ComponentsDt;
+  void RunComponents(FCSCompVec& components, FGTimingStats& stats);
+  void BindComponentStats(FGFCSComponent* component);
   void bind(void);
   void bindModel(void);
   void bindThrottle(unsigned int);
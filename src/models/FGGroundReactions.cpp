@@ -41,6 +41,7 @@ INCLUDES
 #include "FGGroundReactions.h"
 #include "FGFCS.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -133,13 +134,74 @@ bool FGGroundReactions::Run(void)
   vForces.InitMatrix();
   vMoments.InitMatrix();
 
+  unsigned int num = lGear.size();
+  FGGroundCallback* GroundCallback = FDMExec->GetGroundCallback();
+
+  // The farthest wheel that is down from the CG bounds the ground that the
+  // aircraft can reach.
+  double reach = 0.0;
+  GearDown.resize(num);
+  for (unsigned int i=0; i<num; i++) {
+    GearDown[i] = lGear[i]->UpdateLocation();
+    if (GearDown[i]) reach = max(reach, lGear[i]->GetBodyLocation().Magnitude());
+  }
+
+  // A wheel that is higher than any ground within that reach is clearly off
+  // the ground. The ground is queried once for all the other units that are
+  // down, so that the ground callback can share its lookups between them.
+  double ceiling = 0.0;
+  if (num > 0)
+    ceiling = GroundCallback->GetMaxTerrainGeoCentRadius(Propagate->GetLocation(), reach);
+
+  unsigned int count = 0;
+  Airborne.resize(num);
+  QueryLocations.resize(num);
+  for (unsigned int i=0; i<num; i++) {
+    Airborne[i] = GearDown[i] && lGear[i]->GetGearLocation().GetRadius() > ceiling;
+    if (GearDown[i] && !Airborne[i]) QueryLocations[count++] = lGear[i]->GetGearLocation();
+  }
+
+  QueryHeights.resize(num);
+  QueryContacts.resize(num);
+  QueryNormals.resize(num);
+  QueryVelocities.resize(num);
+  if (count > 0)
+    GroundCallback->GetAGLevels(FDMExec->GetSimTime(), count, &QueryLocations[0],
+                                &QueryHeights[0], &QueryContacts[0],
+                                &QueryNormals[0], &QueryVelocities[0]);
+
+  // The compression of the struts. A gear unit that is up ignores the answer
+  // it is given (that of the next unit that is queried).
+  unsigned int query = 0;
+  Compressions.resize(num);
+  CompressSpeeds.resize(num);
+  for (unsigned int i=0; i<num; i++) {
+    Compressions[i] = 0.0;
+    CompressSpeeds[i] = 0.0;
+    if (Airborne[i]) {
+      lGear[i]->SetAirborne();
+      continue;
+    }
+    if (lGear[i]->ComputeCompression(QueryHeights[query], QueryContacts[query],
+                                     QueryNormals[query], QueryVelocities[query])) {
+      Compressions[i] = lGear[i]->GetCompLen();
+      CompressSpeeds[i] = lGear[i]->GetCompVel();
+    }
+    if (GearDown[i]) query++;
+  }
+
+  // The strut forces of all the units in one pass: a strut that is not
+  // compressed gives no force.
+  StrutForces.resize(num);
+  for (unsigned int i=0; i<num; i++)
+    StrutForces[i] = FGLGear::ComputeStrutForce(Compressions[i], CompressSpeeds[i],
+                                                SpringCoeffs[i], DampCoeffs[i],
+                                                DampCoeffsRebound[i], DampTypes[i],
+                                                DampTypesRebound[i]);
+
   // Sum forces and moments for all gear, here.
-  // Some optimizations may be made here - or rather in the gear code itself.
-  // The gear ::Run() method is called several times - once for each gear.
-  // Perhaps there is some commonality for things which only need to be
-  // calculated once.
-  for (unsigned int i=0; i<lGear.size(); i++) {
-    vForces  += lGear[i]->GetBodyForces();
+  for (unsigned int i=0; i<num; i++) {
+    vForces  += lGear[i]->GetContactForces(StrutForces[i]);
     vMoments += lGear[i]->GetMoments();
   }
 
@@ -195,6 +257,19 @@ bool FGGroundReactions::Load(Element* el)
 
   for (unsigned int i=0; i<lGear.size();i++) lGear[i]->bind();
 
+  SpringCoeffs.resize(lGear.size());
+  DampCoeffs.resize(lGear.size());
+  DampCoeffsRebound.resize(lGear.size());
+  DampTypes.resize(lGear.size());
+  DampTypesRebound.resize(lGear.size());
+  for (unsigned int i=0; i<lGear.size(); i++) {
+    SpringCoeffs[i] = lGear[i]->GetSpringCoeff();
+    DampCoeffs[i] = lGear[i]->GetDampCoeff();
+    DampCoeffsRebound[i] = lGear[i]->GetDampCoeffRebound();
+    DampTypes[i] = lGear[i]->GetDampType();
+    DampTypesRebound[i] = lGear[i]->GetDampTypeRebound();
+  }
+
   PostLoad(el, PropertyManager);
 
   return true;
@@ -239,35 +314,38 @@ string FGGroundReactions::GetGroundReactionStrings(string delimeter)
 
 string FGGroundReactions::GetGroundReactionValues(string delimeter)
 {
-  std::ostringstream buf;
+  FGOutputRecord record;
+
+  GetGroundReactionValues(record);
+
+  return record.Print(delimeter);
+}
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGroundReactions::GetGroundReactionValues(FGOutputRecord& record)
+{
   for (unsigned int i=0;i<lGear.size();i++) {
     if (lGear[i]->IsBogey()) {
       FGLGear *gear = lGear[i];
-      buf << (gear->GetWOW() ? "1" : "0") << delimeter
-          << setprecision(5) << gear->GetCompLen() << delimeter
-          << setprecision(6) << gear->GetCompVel() << delimeter
-          << setprecision(10) << gear->GetCompForce() << delimeter
-          << gear->GetWheelSideForce() << delimeter
-          << gear->GetWheelRollForce() << delimeter
-          << gear->GetBodyXForce() << delimeter
-          << gear->GetBodyYForce() << delimeter
-          << setprecision(6) << gear->GetWheelVel(eX) << delimeter
-          << gear->GetWheelVel(eY) << delimeter
-          << gear->GetWheelRollVel() << delimeter
-          << gear->GetWheelSideVel() << delimeter
-          << gear->GetWheelSlipAngle() << delimeter;
+      record.Push(gear->GetWOW() ? 1.0 : 0.0);
+      record.Push(gear->GetCompLen(), 5);
+      record.Push(gear->GetCompVel(), 6);
+      record.Push(gear->GetCompForce(), 10);
+      record.Push(gear->GetWheelSideForce(), 10);
+      record.Push(gear->GetWheelRollForce(), 10);
+      record.Push(gear->GetBodyXForce(), 10);
+      record.Push(gear->GetBodyYForce(), 10);
+      record.Push(gear->GetWheelVel(eX), 6);
+      record.Push(gear->GetWheelVel(eY), 6);
+      record.Push(gear->GetWheelRollVel(), 6);
+      record.Push(gear->GetWheelSideVel(), 6);
+      record.Push(gear->GetWheelSlipAngle(), 6);
     }
   }
 
-  buf << vForces(eX) << delimeter
-      << vForces(eY) << delimeter
-      << vForces(eZ) << delimeter
-      << vMoments(eX) << delimeter
-      << vMoments(eY) << delimeter
-      << vMoments(eZ);
-
-  return buf.str();
+  for (int i=1; i<=3; i++) record.Push(vForces(i), 6);
+  for (int i=1; i<=3; i++) record.Push(vMoments(i), 6);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -53,6 +53,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGOutputRecord;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -61,6 +63,11 @@ CLASS DOCUMENTATION
     ground contact points, all instances of FGLGear.  Sums their forces and
     moments so that these may be provided to FGPropagate.  Parses the 
     \<ground_reactions> section of the aircraft configuration file.
+
+    The gear units are computed together, in stages (see FGLGear): the ground
+    is queried once for all of them, skipping the units that are higher than
+    any ground the aircraft can reach, and the forces of the struts are found
+    in one pass over arrays that hold their coefficients.
  <h3>Configuration File Format of \<ground_reactions> Section:</h3>
 @code
     <ground_reactions>
@@ -106,6 +113,7 @@ public:
   double GetMoments(int idx) const {return vMoments(idx);}
   string GetGroundReactionStrings(string delimeter);
   string GetGroundReactionValues(string delimeter);
+  void GetGroundReactionValues(FGOutputRecord& record);
   bool GetWOW(void) const;
   void UpdateForcesAndMoments(void);
 
@@ -121,6 +129,18 @@ private:
   FGColumnVector3 vForces;
   FGColumnVector3 vMoments;
 
+  // The struts, by gear unit (see Load())
+  vector <double> SpringCoeffs, DampCoeffs, DampCoeffsRebound;
+  vector <FGLGear::DampType> DampTypes, DampTypesRebound;
+
+  // The state of the gear units in the frame, and the ground query of those
+  // that are down and not clearly airborne
+  vector <bool> GearDown, Airborne;
+  vector <double> Compressions, CompressSpeeds, StrutForces;
+  vector <FGLocation> QueryLocations, QueryContacts;
+  vector <double> QueryHeights;
+  vector <FGColumnVector3> QueryNormals, QueryVelocities;
+
   void bind(void);
   void Debug(int from);
 };
@@ -118,7 +118,7 @@ bool FGInertial::Run(void)
   // Gravitation accel
   double r = Propagate->GetRadius();
   gAccel = GetGAccel(r);
-  earthPosAngle += FDMExec->GetDeltaT()*RotationRate;
+  earthPosAngle += FDMExec->GetDeltaT()*rate*RotationRate;
 
   RunPostFunctions();
 
@@ -144,9 +144,10 @@ FGColumnVector3 FGInertial::GetGravityJ2(FGColumnVector3 position) const
   FGColumnVector3 J2Gravity;
 
   // Gravitation accel
+  // The geocentric latitude of the given position (not necessarily that of
+  // the vehicle).
   double r = position.Magnitude();
-  double lat = Propagate->GetLatitude();
-  double sinLat = sin(lat);
+  double sinLat = position(eZ)/r;
 
   double preCommon = 1.5*J2*(a/r)*(a/r);
   double xy = 1.0 - 5.0*(sinLat*sinLat);
@@ -42,13 +42,22 @@ INCLUDES
 #include "FGAircraft.h"
 #include "FGFDMExec.h"
 
-#include "input_output/FGfdmSocket.h"
+#include "input_output/FGfdmServer.h"
 #include "input_output/FGXMLElement.h"
 
 #include <sstream>
 #include <iomanip>
 #include <cstdlib>
-#include <unistd.h>
+#include <cstdio>
+#include <cctype>
+#include <cstring>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  #define snprintf _snprintf
+#endif
+
+static const int endianTest = 1;
+#define isLittleEndian (*((char *) &endianTest ) != 0)
 
 using namespace std;
 
@@ -57,6 +66,9 @@ namespace JSBSim {
 static const char *IdSrc = "$Id: FGInput.cpp,v 1.19 2010/02/25 05:21:36 jberndt Exp $";
 static const char *IdHdr = ID_INPUT;
 
+// The handle sets registered by the binary clients, all together
+static const unsigned int max_handles = 4096;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -65,9 +77,10 @@ FGInput::FGInput(FGFDMExec* fdmex) : FGModel(fdmex)
 {
   Name = "FGInput";
   sFirstPass = dFirstPass = true;
-  socket = 0;
+  server = 0;
   port = 0;
   enabled = true;
+  PropertyManager->getRootNode()->addChangeListener(&Listener);
 
   Debug(0);
 }
@@ -76,7 +89,10 @@ FGInput::FGInput(FGFDMExec* fdmex) : FGModel(fdmex)
 
 FGInput::~FGInput()
 {
-  delete socket;
+  // Unregistered here: the listener destructor cannot remove itself from a
+  // node safely.
+  PropertyManager->getRootNode()->removeChangeListener(&Listener);
+  delete server;
   Debug(1);
 }
 
@@ -89,16 +105,268 @@ bool FGInput::InitModel(void)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Finds the next word of a line, separated by spaces or tabs. The word points
+// into the line: it is not copied.
+
+static void NextToken(const char*& p, const char* end, const char*& token, size_t& size)
+{
+  while (p < end && (*p == ' ' || *p == '\t')) p++;
+  token = p;
+  while (p < end && *p != ' ' && *p != '\t') p++;
+  size = p - token;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Compares a word to a command, regardless of case.
+
+static bool IsCommand(const char* token, size_t size, const char* command)
+{
+  size_t i;
+  for (i=0; i<size && command[i] != '\0'; i++)
+    if (tolower((unsigned char)token[i]) != command[i]) return false;
+  return i == size && command[i] == '\0';
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Reads and appends the little endian numbers of the binary messages.
+
+static unsigned int GetLE32(const char* p)
+{
+  const unsigned char* b = (const unsigned char*)p;
+  return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int)b[3] << 24);
+}
+
+static double GetLEDouble(const char* p)
+{
+  double value;
+  char* bytes = (char*)&value;
+
+  if (isLittleEndian) memcpy(bytes, p, 8);
+  else for (int i=0; i<8; i++) bytes[i] = p[7-i];
+  return value;
+}
+
+static void AppendLE32(string& buf, unsigned int value)
+{
+  for (int i=0; i<4; i++) buf += (char)((value >> 8*i) & 0xff);
+}
+
+static void AppendLEDouble(string& buf, double value)
+{
+  const char* bytes = (const char*)&value;
+
+  if (isLittleEndian) buf.append(bytes, 8);
+  else for (int i=7; i>=0; i--) buf += bytes[i];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The nodes are looked up in the property tree once: the following get and set
+// commands on the same property find them in the cache. Nodes leave a shared
+// tree when the instance they belong to is deleted: the cache is then
+// invalidated by Revalidate().
+
+FGPropertyManager* FGInput::GetNode(const char* name, size_t size)
+{
+  Key.assign(name, size);
+
+  map <string, FGPropertyManager*>::const_iterator it = Nodes.find(Key);
+  if (it != Nodes.end()) return it->second;
+
+  FGPropertyManager* node = PropertyManager->GetNode(Key);
+  if (node) Nodes[Key] = node;
+  return node;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Looks up again the nodes of the registered handles, after nodes left the
+// tree. A name that is no longer a property gets no node, and its handle
+// fails from then on.
+
+void FGInput::Revalidate(void)
+{
+  Listener.removed = false;
+  Nodes.clear();
+
+  map <string, unsigned int>::const_iterator it;
+  for (it = Handles.begin(); it != Handles.end(); ++it) {
+    vector <FGPropertyManager*>& nodes = HandleSets[it->second-1];
+    const char* p = it->first.c_str();
+    for (size_t i=0; i<nodes.size(); i++) {
+      size_t size = strlen(p);
+      try {
+        nodes[i] = GetNode(p, size);
+      } catch(...) {
+        nodes[i] = 0;
+      }
+      p += size + 1;
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The replies are built in Message, which keeps its memory from one frame to
+// the next. The size in the header is filled in by SendMessage().
+
+void FGInput::StartMessage(unsigned int type)
+{
+  Message.clear();
+  AppendLE32(Message, 0);
+  AppendLE32(Message, type);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInput::SendMessage(unsigned int client)
+{
+  unsigned int size = (unsigned int)Message.size();
+  for (int i=0; i<4; i++) Message[i] = (char)((size >> 8*i) & 0xff);
+  server->Write(client, Message.data(), Message.size());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInput::SendError(unsigned int client, const string& text)
+{
+  StartMessage(msgError);
+  Message.append(text.c_str(), text.size()+1);
+  SendMessage(client);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs a binary message (see the documentation of the class). The message has
+// been checked to be at least as long as its header.
+
+void FGInput::RunMessage(unsigned int client, const char* message, size_t length)
+{
+  unsigned int type = GetLE32(message+4);
+  const char* p = message + 8;
+  const char* end = message + length;
+  unsigned int handle = 0;
+  size_t count = 0;
+
+  if (type == msgGet || type == msgSet) {
+    if (end - p < 4) {
+      SendError(client, "Message too short");
+      return;
+    }
+    handle = GetLE32(p);
+    p += 4;
+    if (handle == 0 || handle > HandleSets.size()) {
+      SendError(client, "Unknown handle");
+      return;
+    }
+    count = HandleSets[handle-1].size();
+    for (size_t i=0; i<count; i++) {
+      if (HandleSets[handle-1][i] == 0) {
+        SendError(client, "A property of the handle left the tree");
+        return;
+      }
+    }
+  }
+
+  switch (type) {
+  case msgRegister:
+    {
+      if (end - p < 4) {
+        SendError(client, "Message too short");
+        return;
+      }
+      count = GetLE32(p);
+      p += 4;
+      // The names and their null characters, as they came, identify the set
+      string names(p, end - p);
+
+      map <string, unsigned int>::const_iterator it = Handles.find(names);
+      if (it != Handles.end()) {
+        handle = it->second;
+      } else {
+        if (count > names.size()) {
+          SendError(client, "Missing property names");
+          return;
+        }
+        vector <FGPropertyManager*> nodes;
+        nodes.reserve(count);
+        for (size_t i=0; i<count; i++) {
+          const char* name_end = (const char*)memchr(p, '\0', end - p);
+          if (name_end == 0) {
+            SendError(client, "Missing property names");
+            return;
+          }
+          FGPropertyManager* node;
+          try {
+            node = GetNode(p, name_end - p);
+          } catch(...) {
+            node = 0;
+          }
+          if (node == 0) {
+            SendError(client, "Unknown property: " + string(p, name_end - p));
+            return;
+          }
+          nodes.push_back(node);
+          p = name_end + 1;
+        }
+        if (p != end) {
+          SendError(client, "More property names than announced");
+          return;
+        }
+        if (HandleSets.size() >= max_handles) {
+          SendError(client, "Too many handles");
+          return;
+        }
+        HandleSets.push_back(nodes);
+        handle = (unsigned int)HandleSets.size();
+        Handles[names] = handle;
+      }
+      StartMessage(msgHandle);
+      AppendLE32(Message, handle);
+      AppendLE32(Message, (unsigned int)HandleSets[handle-1].size());
+      SendMessage(client);
+    }
+    break;
+
+  case msgGet:
+    {
+      const vector <FGPropertyManager*>& nodes = HandleSets[handle-1];
+      StartMessage(msgValues);
+      AppendLE32(Message, handle);
+      for (size_t i=0; i<count; i++)
+        AppendLEDouble(Message, nodes[i]->getDoubleValue());
+      SendMessage(client);
+    }
+    break;
+
+  case msgSet:
+    {
+      const vector <FGPropertyManager*>& nodes = HandleSets[handle-1];
+      if ((size_t)(end - p) != 8*count) {
+        SendError(client, "Wrong number of values");
+        return;
+      }
+      for (size_t i=0; i<count; i++, p += 8)
+        nodes[i]->setDoubleValue(GetLEDouble(p));
+    }
+    break;
+
+  default:
+    SendError(client, "Unknown message type");
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //
 // This function handles accepting input commands from the socket interface.
+// It reads what has arrived and never waits for more: a command that has not
+// been received completely is run on a later frame.
 //
 
 bool FGInput::Run(void)
 {
-  string line, token;
-  size_t start=0, string_start=0, string_end=0;
-  double value=0;
+  unsigned int client;
+  const char* line;
+  size_t length;
+  bool received;
+  char value[32];
   FGPropertyManager* node=0;
 
   if (FGModel::Run()) return true; // fast exit if nothing to do
@@ -108,125 +376,141 @@ bool FGInput::Run(void)
 
   RunPreFunctions();
 
-  data = socket->Receive(); // get socket transmission if present
-
-  if (data.size() > 0) {
-    // parse lines
-    while (1) {
-      string_start = data.find_first_not_of("\r\n", start);
-      if (string_start == string::npos) break;
-      string_end = data.find_first_of("\r\n", string_start);
-      if (string_end == string::npos) break;
-      line = data.substr(string_start, string_end-string_start);
-      if (line.size() == 0) break;
-
-      // now parse individual line
-      vector <string> tokens = split(line,' ');
-  
-      string command="", argument="", str_value="";
-      if (tokens.size() > 0) {
-        command = to_lower(tokens[0]);
-        if (tokens.size() > 1) {
-          argument = trim(tokens[1]);
-          if (tokens.size() > 2) {
-            str_value = trim(tokens[2]);
-          }
-        }
+  if (Listener.removed) Revalidate();
+
+  received = server->Poll(); // accept clients and get their commands, if any
+
+  while (server->NextLine(client, line, length)) {
+    const char* end = line + length;
+    const char *command, *argument, *str_value;
+    size_t command_size, argument_size, value_size;
+
+    // now parse individual line
+    NextToken(line, end, command, command_size);
+    NextToken(line, end, argument, argument_size);
+    NextToken(line, end, str_value, value_size);
+
+    if (IsCommand(command, command_size, "set")) {       // SET PROPERTY
+
+      try {
+        node = GetNode(argument, argument_size);
+      } catch(...) {
+        node = 0;
+      }
+      if (node == 0)
+        server->Reply(client, "Unknown property\n");
+      else {
+        // The line ends with an end of line character, where strtod() stops
+        node->setDoubleValue(value_size > 0 ? strtod(str_value, 0) : 0.0);
       }
+      server->Reply(client, "", 0);
 
-      if (command == "set") {                   // SET PROPERTY
+    } else if (IsCommand(command, command_size, "get")) { // GET PROPERTY
 
-        node = PropertyManager->GetNode(argument);
-        if (node == 0)
-          socket->Reply("Unknown property\n");
-        else {
-          value = atof(str_value.c_str());
-          node->setDoubleValue(value);
+      if (argument_size == 0) {
+        server->Reply(client, "No property argument supplied.\n");
+        continue;
+      }
+      try {
+        node = GetNode(argument, argument_size);
+      } catch(...) {
+        server->Reply(client, "Badly formed property query\n");
+        continue;
+      }
+      if (node == 0) {
+        if (FDMExec->Holding()) { // if holding can query property list
+          string query = FDMExec->QueryPropertyCatalog(string(argument, argument_size));
+          server->Reply(client, query);
+        } else {
+          server->Reply(client, "Must be in HOLD to search properties\n");
         }
-        socket->Reply("");
+      } else {
+        // The format of "setw(12) << setprecision(6)" on a stream
+        int n = snprintf(value, sizeof(value), "%12.6g\n", node->getDoubleValue());
+        if (n < 0 || n > (int)sizeof(value)-1) n = sizeof(value)-1;
+        Text.assign(argument, argument_size);
+        Text.append(" = ");
+        Text.append(value, n);
+        server->Reply(client, Text);
+      }
 
-      } else if (command == "get") {             // GET PROPERTY
+    } else if (IsCommand(command, command_size, "hold")) {     // PAUSE
 
-        if (argument.size() == 0) {
-          socket->Reply("No property argument supplied.\n");
-          break;
-        }
-        try {
-          node = PropertyManager->GetNode(argument);
-        } catch(...) {
-          socket->Reply("Badly formed property query\n");
-          break;
-        }
-        if (node == 0) {
-          if (FDMExec->Holding()) { // if holding can query property list
-            string query = FDMExec->QueryPropertyCatalog(argument);
-            socket->Reply(query);
-          } else {
-            socket->Reply("Must be in HOLD to search properties\n");
-          }
-        } else if (node > 0) {
-          ostringstream buf;
-          buf << argument << " = " << setw(12) << setprecision(6) << node->getDoubleValue() << endl;
-          socket->Reply(buf.str());
-        }
+      FDMExec->Hold();
+      server->Reply(client, "", 0);
 
-      } else if (command == "hold") {                  // PAUSE
+    } else if (IsCommand(command, command_size, "resume")) {   // RESUME
 
-        FDMExec->Hold();
-        socket->Reply("");
+      FDMExec->Resume();
+      FDMExec->SetStepping(false);
+      server->Reply(client, "", 0);
 
-      } else if (command == "resume") {             // RESUME
+    } else if (IsCommand(command, command_size, "step")) {     // STEP
 
-        FDMExec->Resume();
-        FDMExec->SetStepping(false);
-        socket->Reply("");
+      FDMExec->SetStepping(true);
+      FDMExec->IncrTime();
+      server->Reply(client, "", 0);
 
-      } else if (command == "step") {               // STEP
+    } else if (IsCommand(command, command_size, "quit")) {     // QUIT
 
-        FDMExec->SetStepping(true);
-        FDMExec->IncrTime();
-        socket->Reply("");
+      // close the connection of this client
+      server->Reply(client, "", 0);
+      server->Close(client);
 
-      } else if (command == "quit") {                   // QUIT
+    } else if (IsCommand(command, command_size, "info")) {     // INFO
 
-        // close the socket connection
-        socket->Reply("");
-        socket->Close();
+      // get info about the sim run and/or aircraft, etc.
+      ostringstream info;
+      info << "JSBSim version: " << JSBSim_version << endl;
+      info << "Config File version: " << needed_cfg_version << endl;
+      info << "Aircraft simulated: " << Aircraft->GetAircraftName() << endl;
+      info << "Simulation time: " << setw(8) << setprecision(3) << FDMExec->GetSimTime() << endl;
+      server->Reply(client, info.str());
 
-      } else if (command == "info") {                   // INFO
+    } else if (IsCommand(command, command_size, "perf")) {     // PERF
 
-        // get info about the sim run and/or aircraft, etc.
-        ostringstream info;
-        info << "JSBSim version: " << JSBSim_version << endl;
-        info << "Config File version: " << needed_cfg_version << endl;
-        info << "Aircraft simulated: " << Aircraft->GetAircraftName() << endl;
-        info << "Simulation time: " << setw(8) << setprecision(3) << FDMExec->GetSimTime() << endl;
-        socket->Reply(info.str());
+      // execution times of the models (see simulation/perf)
+      server->Reply(client, FDMExec->GetPerformanceReport());
 
-      } else if (command == "help") {                   // HELP
+    } else if (IsCommand(command, command_size, "binary")) {   // BINARY
 
-        socket->Reply(
-        " JSBSim Server commands:\n\n"
-        "   get {property name}\n"
-        "   set {property name} {value}\n"
-        "   hold\n"
-        "   resume\n"
-        "   step\n"
-        "   help\n"
-        "   quit\n"
-        "   info\n\n");
+      // the rest of the connection carries binary messages: no prompt
+      server->SetBinary(client);
 
-      } else {
-        socket->Reply(string("Unknown command: ") +  token + string("\n"));
-      }
+    } else if (IsCommand(command, command_size, "help")) {     // HELP
+
+      server->Reply(client,
+      " JSBSim Server commands:\n\n"
+      "   get {property name}\n"
+      "   set {property name} {value}\n"
+      "   hold\n"
+      "   resume\n"
+      "   step\n"
+      "   help\n"
+      "   quit\n"
+      "   info\n"
+      "   perf\n"
+      "   binary\n\n");
 
-      start = string_end;
+    } else {
+      Text.assign("Unknown command: ");
+      Text.append(command, command_size);
+      Text.append("\n");
+      server->Reply(client, Text);
     }
   }
 
+  // the messages of the clients in binary mode
+  while (server->NextMessage(client, line, length)) {
+    RunMessage(client, line, length);
+    received = true;
+  }
+
+  server->Flush();
+
   RunPostFunctions();
 
-  return data.size() > 0;
+  return received;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -247,7 +531,7 @@ bool FGInput::Load(Element* element)
   if (port == 0) {
     cerr << endl << "No port assigned in input element" << endl;
   } else {
-    socket = new FGfdmSocket(port);
+    server = new FGfdmServer(port);
   }
 
   Debug(2);
@@ -307,8 +591,8 @@ void FGInput::Debug(int from)
 // wait for new input and process it
 void FGInput::Wait(void)
 {
-    if (socket->Wait()) {
-        if (!Run()) {
+    if (server->Wait()) {
+        if (!Run() && server->GetNumClients() == 0) {
             exit(0);
         }
     }
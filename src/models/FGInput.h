@@ -39,8 +39,11 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include "FGModel.h"
+#include "input_output/FGPropertyManager.h"
 
 #include <string>
+#include <vector>
+#include <map>
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -56,13 +59,48 @@ namespace JSBSim {
 
 class FGFDMExec;
 class Element;
-class FGfdmSocket;
+class FGfdmServer;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 /** Handles simulation socket input.
+    The input port serves any number of clients at once (see FGfdmServer).
+    Each frame, the commands received completely are run, without waiting for
+    any more; the replies are sent as the clients accept them.
+
+    <h3>Binary protocol</h3>
+
+    A client that needs many values each frame can send the command "binary"
+    instead, after which its connection carries binary messages rather than
+    lines of text. It registers a list of property names once and receives a
+    handle for it; it then reads or writes all the properties of a handle in
+    a single message of fixed layout, without any parsing or lookup on
+    either side. The text commands of the other clients are unaffected.
+
+    All the numbers are little endian: the integers are unsigned, on 32 bits,
+    and the values are doubles. Each message starts with a header of two
+    integers, its size in bytes (header included) and its type:
+<pre>
+    type           direction  contents after the header
+    1 REGISTER     to JSBSim  count, then count property names, each one
+                              followed by a null character
+    2 HANDLE       to client  handle, count
+    3 GET          to JSBSim  handle
+    4 VALUES       to client  handle, then count values
+    5 SET          to JSBSim  handle, then count values
+    6 ERROR        to client  text of the error, followed by a null character
+</pre>
+    A SET is not answered, unless it fails: a client that writes its inputs
+    and reads its outputs each frame sends a SET and a GET together, and waits
+    for the VALUES. The messages are handled in the order they arrive, at the
+    start of a frame. A handle stays valid as long as JSBSim runs, and the
+    same list of names always gives the same handle, so a client can reconnect
+    and register again at no cost. A registration fails, with an ERROR, if one
+    of the names is not a property. A handle one of whose properties has left
+    the tree since (the instance it belonged to was deleted from a shared
+    tree) gives an ERROR as well.
  */
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -87,8 +125,31 @@ public:
 private:
   bool sFirstPass, dFirstPass, enabled;
   unsigned int port;
-  FGfdmSocket* socket;
-  std::string data;
+  FGfdmServer* server;
+  std::map <std::string, FGPropertyManager*> Nodes;
+  std::string Key, Text;
+  std::vector < std::vector <FGPropertyManager*> > HandleSets;
+  std::map <std::string, unsigned int> Handles;
+  std::string Message;
+
+  // Notes that nodes left the tree, as those of an instance deleted from a
+  // shared tree do: the nodes cached above are then looked up again.
+  class RemovalListener : public SGPropertyChangeListener {
+  public:
+    RemovalListener(void) : removed(false) {}
+    void childRemoved(SGPropertyNode*, SGPropertyNode*) {removed = true;}
+    bool removed;
+  };
+  RemovalListener Listener;
+
+  enum {msgRegister=1, msgHandle, msgGet, msgValues, msgSet, msgError};
+
+  FGPropertyManager* GetNode(const char* name, size_t size);
+  void Revalidate(void);
+  void RunMessage(unsigned int client, const char* message, size_t length);
+  void StartMessage(unsigned int type);
+  void SendMessage(unsigned int client);
+  void SendError(unsigned int client, const std::string& text);
   void Debug(int from);
 };
 }
@@ -271,13 +271,8 @@ FGLGear::~FGLGear()
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-FGColumnVector3& FGLGear::GetBodyForces(void)
+bool FGLGear::UpdateLocation(void)
 {
-  double t = fdmex->GetSimTime();
-  dT = fdmex->GetDeltaT()*GroundReactions->GetRate();
-
-  vFn.InitMatrix();
-
   if (isRetractable) ComputeRetractionState();
 
   if (GearDown) {
@@ -285,91 +280,182 @@ FGColumnVector3& FGLGear::GetBodyForces(void)
     vLocalGear = Propagate->GetTb2l() * vWhlBodyVec; // Get local frame wheel location
 
     gearLoc = Propagate->GetLocation().LocalToLocation(vLocalGear);
-    // Compute the height of the theoretical location of the wheel (if strut is
-    // not compressed) with respect to the ground level
-    double height = fdmex->GetGroundCallback()->GetAGLevel(t, gearLoc, contact, normal, cvel);
-    vGroundNormal = Propagate->GetTec2b() * normal;
-
-    // The height returned above is the AGL and is expressed in the Z direction
-    // of the ECEF coordinate frame. We now need to transform this height in
-    // actual compression of the strut (BOGEY) of in the normal direction to the
-    // ground (STRUCTURE)
-    double normalZ = (Propagate->GetTec2l()*normal)(eZ);
-    double LGearProj = -(mTGear.Transposed() * vGroundNormal)(eZ);
+  }
 
-    switch (eContactType) {
-    case ctBOGEY:
-      compressLength = LGearProj > 0.0 ? height * normalZ / LGearProj : 0.0;
-      break;
-    case ctSTRUCTURE:
-      compressLength = height * normalZ / DotProduct(normal, normal);
-      break;
-    }
+  return GearDown;
+}
 
-    if (compressLength > 0.00) {
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-      WOW = true;
+FGColumnVector3& FGLGear::GetBodyForces(void)
+{
+  double height = 0.0;
+  FGLocation cont;
+  FGColumnVector3 n, v;
 
-      // The following equations use the vector to the tire contact patch
-      // including the strut compression.
-      FGColumnVector3 vWhlDisplVec;
+  // Compute the height of the theoretical location of the wheel (if strut is
+  // not compressed) with respect to the ground level
+  if (UpdateLocation()) {
+    double t = fdmex->GetSimTime();
+    height = fdmex->GetGroundCallback()->GetAGLevel(t, gearLoc, cont, n, v);
+  }
 
-      switch(eContactType) {
-      case ctBOGEY:
-        vWhlDisplVec = mTGear * FGColumnVector3(0., 0., -compressLength);
-        break;
-      case ctSTRUCTURE:
-        vWhlDisplVec = compressLength * vGroundNormal;
-        break;
-      }
+  double strutForce = 0.0;
+  if (ComputeCompression(height, cont, n, v))
+    strutForce = ComputeStrutForce(compressLength, compressSpeed, kSpring, bDamp,
+                                   bDampRebound, eDampType, eDampTypeRebound);
 
-      FGColumnVector3 vWhlContactVec = vWhlBodyVec + vWhlDisplVec;
-      vActingXYZn = vXYZn + Tb2s * vWhlDisplVec;
-      FGColumnVector3 vBodyWhlVel = Propagate->GetPQR() * vWhlContactVec;
-      vBodyWhlVel += Propagate->GetUVW() - Propagate->GetTec2b() * cvel;
+  return GetContactForces(strutForce);
+}
 
-      vWhlVelVec = mTGear.Transposed() * vBodyWhlVel;
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The location of the wheel is up to date (see UpdateLocation()).
 
-      InitializeReporting();
-      ComputeSteeringAngle();
-      ComputeGroundCoordSys();
+bool FGLGear::ComputeCompression(double height, const FGLocation& cont,
+                                 const FGColumnVector3& n,
+                                 const FGColumnVector3& v)
+{
+  dT = fdmex->GetDeltaT()*GroundReactions->GetRate();
 
-      vLocalWhlVel = Transform().Transposed() * vBodyWhlVel;
+  vFn.InitMatrix();
 
-      compressSpeed = -vLocalWhlVel(eX);
-      if (eContactType == ctBOGEY)
-        compressSpeed /= LGearProj;
+  if (!GearDown) return false;
 
-      ComputeVerticalStrutForce();
+  contact = cont;
+  normal = n;
+  cvel = v;
+  vGroundNormal = Propagate->GetTec2b() * normal;
 
-      // Compute the friction coefficients in the wheel ground plane.
-      if (eContactType == ctBOGEY) {
-        ComputeSlipAngle();
-        ComputeBrakeForceCoefficient();
-        ComputeSideForceCoefficient();
-      }
+  // The height returned above is the AGL and is expressed in the Z direction
+  // of the ECEF coordinate frame. We now need to transform this height in
+  // actual compression of the strut (BOGEY) of in the normal direction to the
+  // ground (STRUCTURE)
+  double normalZ = (Propagate->GetTec2l()*normal)(eZ);
+  double LGearProj = -(mTGear.Transposed() * vGroundNormal)(eZ);
+
+  switch (eContactType) {
+  case ctBOGEY:
+    compressLength = LGearProj > 0.0 ? height * normalZ / LGearProj : 0.0;
+    break;
+  case ctSTRUCTURE:
+    compressLength = height * normalZ / DotProduct(normal, normal);
+    break;
+  }
+
+  if (compressLength <= 0.00) { // Gear is NOT compressed
+    LeaveGround();
+    return false;
+  }
+
+  WOW = true;
+
+  // The following equations use the vector to the tire contact patch
+  // including the strut compression.
+  FGColumnVector3 vWhlDisplVec;
+
+  switch(eContactType) {
+  case ctBOGEY:
+    vWhlDisplVec = mTGear * FGColumnVector3(0., 0., -compressLength);
+    break;
+  case ctSTRUCTURE:
+    vWhlDisplVec = compressLength * vGroundNormal;
+    break;
+  }
+
+  vWhlContactVec = vWhlBodyVec + vWhlDisplVec;
+  vActingXYZn = vXYZn + Tb2s * vWhlDisplVec;
+  FGColumnVector3 vBodyWhlVel = Propagate->GetPQR() * vWhlContactVec;
+  vBodyWhlVel += Propagate->GetUVW() - Propagate->GetTec2b() * cvel;
+
+  vWhlVelVec = mTGear.Transposed() * vBodyWhlVel;
+
+  InitializeReporting();
+  ComputeSteeringAngle();
+  ComputeGroundCoordSys();
+
+  vLocalWhlVel = Transform().Transposed() * vBodyWhlVel;
+
+  compressSpeed = -vLocalWhlVel(eX);
+  if (eContactType == ctBOGEY)
+    compressSpeed /= LGearProj;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// No ground is queried: the ground values of the unit are reset, rather than
+// kept from the last frame it was queried in.
+
+void FGLGear::SetAirborne(void)
+{
+  dT = fdmex->GetDeltaT()*GroundReactions->GetRate();
+
+  vFn.InitMatrix();
+
+  if (!GearDown) return;
 
-      // Prepare the Jacobians and the Lagrange multipliers for later friction
-      // forces calculations.
-      ComputeJacobian(vWhlContactVec);
+  contact = FGLocation();
+  normal.InitMatrix();
+  cvel.InitMatrix();
+  vGroundNormal.InitMatrix();
 
-    } else { // Gear is NOT compressed
+  LeaveGround();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGLGear::LeaveGround(void)
+{
+  WOW = false;
+  compressLength = 0.0;
+  compressSpeed = 0.0;
+  WheelSlip = 0.0;
+  StrutForce = 0.0;
 
-      WOW = false;
-      compressLength = 0.0;
-      compressSpeed = 0.0;
-      WheelSlip = 0.0;
-      StrutForce = 0.0;
+  // Let wheel spin down slowly
+  vWhlVelVec(eX) -= 13.0*dT;
+  if (vWhlVelVec(eX) < 0.0) vWhlVelVec(eX) = 0.0;
 
-      // Let wheel spin down slowly
-      vWhlVelVec(eX) -= 13.0*dT;
-      if (vWhlVelVec(eX) < 0.0) vWhlVelVec(eX) = 0.0;
+  // Return to neutral position between 1.0 and 0.8 gear pos.
+  SteerAngle *= max(GetGearUnitPos()-0.8, 0.0)/0.2;
+
+  ResetReporting();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The wheel is on the ground when the gear is down and WOW was set by
+// ComputeCompression(): the strut force is then that of its compression.
+
+FGColumnVector3& FGLGear::GetContactForces(double strutForce)
+{
+  if (GearDown && WOW) {
+    StrutForce = strutForce;
+
+    // The reaction force of the wheel is always normal to the ground
+    switch (eContactType) {
+    case ctBOGEY:
+      // Project back the strut force in the local coordinate frame of the ground
+      vFn(eX) = StrutForce / (mTGear.Transposed()*vGroundNormal)(eZ);
+      break;
+    case ctSTRUCTURE:
+      vFn(eX) = -StrutForce;
+      break;
+    }
 
-      // Return to neutral position between 1.0 and 0.8 gear pos.
-      SteerAngle *= max(GetGearUnitPos()-0.8, 0.0)/0.2;
+    // Remember these values for reporting
+    MaximumStrutForce = max(MaximumStrutForce, fabs(StrutForce));
+    MaximumStrutTravel = max(MaximumStrutTravel, fabs(compressLength));
 
-      ResetReporting();
+    // Compute the friction coefficients in the wheel ground plane.
+    if (eContactType == ctBOGEY) {
+      ComputeSlipAngle();
+      ComputeBrakeForceCoefficient();
+      ComputeSideForceCoefficient();
     }
+
+    // Prepare the Jacobians and the Lagrange multipliers for later friction
+    // forces calculations.
+    ComputeJacobian();
   }
 
   ReportTakeoffOrLanding();
@@ -550,7 +636,7 @@ void FGLGear::ReportTakeoffOrLanding(void)
     if (debug_lvl > 0) Report(erTakeoff);
   }
 
-  if (lastWOW != WOW) PutMessage("GEAR_CONTACT: " + name, WOW);
+  if (lastWOW != WOW) fdmex->PutMessage("GEAR_CONTACT: " + name, WOW);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -563,7 +649,7 @@ void FGLGear::CrashDetect(void)
       GetMoments().Magnitude() > 5000000000.0 ||
       SinkRate > 1.4666*30 ) && !fdmex->IntegrationSuspended())
   {
-    PutMessage("Crash Detected: Simulation FREEZE.");
+    fdmex->PutMessage("Crash Detected: Simulation FREEZE.");
     fdmex->SuspendIntegration();
   }
 }
@@ -628,52 +714,6 @@ void FGLGear::ComputeSideForceCoefficient(void)
   }
 }
 
-//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-// Compute the vertical force on the wheel using square-law damping (per comment
-// in paper AIAA-2000-4303 - see header prologue comments). We might consider
-// allowing for both square and linear damping force calculation. Also need to
-// possibly give a "rebound damping factor" that differs from the compression
-// case.
-
-void FGLGear::ComputeVerticalStrutForce(void)
-{
-  double springForce = 0;
-  double dampForce = 0;
-
-  springForce = -compressLength * kSpring;
-
-  if (compressSpeed >= 0.0) {
-
-    if (eDampType == dtLinear)   dampForce = -compressSpeed * bDamp;
-    else         dampForce = -compressSpeed * compressSpeed * bDamp;
-
-  } else {
-
-    if (eDampTypeRebound == dtLinear)
-      dampForce   = -compressSpeed * bDampRebound;
-    else
-      dampForce   =  compressSpeed * compressSpeed * bDampRebound;
-
-  }
-
-  StrutForce = min(springForce + dampForce, (double)0.0);
-
-  // The reaction force of the wheel is always normal to the ground
-  switch (eContactType) {
-  case ctBOGEY:
-    // Project back the strut force in the local coordinate frame of the ground
-    vFn(eX) = StrutForce / (mTGear.Transposed()*vGroundNormal)(eZ);
-    break;
-  case ctSTRUCTURE:
-    vFn(eX) = -StrutForce;
-    break;
-  }
-
-  // Remember these values for reporting
-  MaximumStrutForce = max(MaximumStrutForce, fabs(StrutForce));
-  MaximumStrutTravel = max(MaximumStrutTravel, fabs(compressLength));
-}
-
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGLGear::GetGearUnitPos(void)
@@ -690,7 +730,7 @@ double FGLGear::GetGearUnitPos(void)
 // Compute the jacobian entries for the friction forces resolution later
 // in FGPropagate
 
-void FGLGear::ComputeJacobian(const FGColumnVector3& vWhlContactVec)
+void FGLGear::ComputeJacobian(void)
 {
   // When the point of contact is moving, dynamic friction is used
   // This type of friction is limited to ctSTRUCTURE elements because their
@@ -42,6 +42,7 @@ INCLUDES
 #include "models/FGPropagate.h"
 #include "math/FGColumnVector3.h"
 #include <string>
+#include <algorithm>
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -220,6 +221,64 @@ public:
   /// The Force vector for this gear
   FGColumnVector3& GetBodyForces(void);
 
+  /** @name Staged computation of the forces
+      FGGroundReactions computes the forces of all the gear units together,
+      in stages: UpdateLocation() for each unit, one ground query for them
+      all, ComputeCompression() (or SetAirborne()) for each unit, the strut
+      forces of all the units in one pass with ComputeStrutForce(), and then
+      GetContactForces() for each unit. GetBodyForces() goes through the same
+      stages for a single unit. */
+  //@{
+  /** Updates the retraction state and computes the location of the wheel,
+      with the strut not compressed, for the ground query of the frame.
+      @return false if the gear is up: the ground need not be queried */
+  bool UpdateLocation(void);
+  /** Computes the compression of the strut and its speed, from the answer of
+      a ground query made at the location of the uncompressed wheel.
+      @param height the height of the wheel above the ground
+      @param contact the contact point on the ground
+      @param normal the normal to the ground, in the ECEF frame
+      @param vel the velocity of the ground, in the ECEF frame
+      @return true if the wheel is on the ground: the force of its strut is
+              then to be computed from GetCompLen() and GetCompVel() */
+  bool ComputeCompression(double height, const FGLocation& contact,
+                          const FGColumnVector3& normal,
+                          const FGColumnVector3& vel);
+  /** Takes the place of ComputeCompression() for a unit that is known to be
+      off the ground, without a ground query. The contact point, the normal
+      and the velocity of the ground are reset. */
+  void SetAirborne(void);
+  /** The Force vector for this gear, once its compression is computed.
+      @param strutForce the force of the strut, ignored if the wheel is not on
+                        the ground */
+  FGColumnVector3& GetContactForces(double strutForce);
+  /** Computes the force of a strut, in pounds: negative as it pushes the
+      wheel away from the aircraft, and never positive. The damping is linear
+      or square, and may differ in rebound (per comment in paper
+      AIAA-2000-4303 - see header prologue comments).
+      @param compression the compression of the strut in feet
+      @param speed the compression speed in ft/sec
+      @param kSpring the spring coefficient
+      @param bDamp the damping coefficient, in compression
+      @param bDampRebound the damping coefficient, in rebound
+      @param damp the damping type, in compression
+      @param dampRebound the damping type, in rebound */
+  static double ComputeStrutForce(double compression, double speed,
+                                  double kSpring, double bDamp,
+                                  double bDampRebound, DampType damp,
+                                  DampType dampRebound) {
+    double springForce = -compression * kSpring;
+    double dampForce;
+    if (speed >= 0.0)
+      dampForce = (damp == dtLinear ? -speed : -speed * speed) * bDamp;
+    else
+      dampForce = (dampRebound == dtLinear ? -speed : speed * speed) * bDampRebound;
+    return std::min(springForce + dampForce, 0.0);
+  }
+  //@}
+  /// Gets the location of the uncompressed wheel, as of UpdateLocation()
+  const FGLocation& GetGearLocation(void) const { return gearLoc; }
+
   /// Gets the location of the gear in Body axes
   FGColumnVector3& GetBodyLocation(void) { return vWhlBodyVec; }
   double GetBodyLocation(int idx) const { return vWhlBodyVec(idx); }
@@ -238,6 +297,14 @@ public:
   /// Gets the gear compression force in pounds
   double  GetCompForce(void) const {return StrutForce;   }
   double  GetBrakeFCoeff(void) const {return BrakeFCoeff;}
+  /// Gets the spring coefficient of the strut in lbs/ft
+  double GetSpringCoeff(void) const {return kSpring;}
+  /// Gets the damping coefficient of the strut in compression
+  double GetDampCoeff(void) const {return bDamp;}
+  /// Gets the damping coefficient of the strut in rebound
+  double GetDampCoeffRebound(void) const {return bDampRebound;}
+  DampType GetDampType(void) const {return eDampType;}
+  DampType GetDampTypeRebound(void) const {return eDampTypeRebound;}
 
   /// Gets the current normalized tire pressure
   double  GetTirePressure(void) const { return TirePressureNorm; }
@@ -294,6 +361,7 @@ private:
   FGMatrix33 mTGear;
   FGColumnVector3 vGearOrient;
   FGColumnVector3 vWhlBodyVec;
+  FGColumnVector3 vWhlContactVec;
   FGColumnVector3 vLocalGear;
   FGColumnVector3 vWhlVelVec, vLocalWhlVel;     // Velocity of this wheel
   FGColumnVector3 normal, cvel, vGroundNormal;
@@ -357,13 +425,13 @@ private:
   FGGroundReactions* GroundReactions;
 
   void ComputeRetractionState(void);
+  void LeaveGround(void);
   void ComputeBrakeForceCoefficient(void);
   void ComputeSteeringAngle(void);
   void ComputeSlipAngle(void);
   void ComputeSideForceCoefficient(void);
-  void ComputeVerticalStrutForce(void);
   void ComputeGroundCoordSys(void);
-  void ComputeJacobian(const FGColumnVector3& vWhlContactVec);
+  void ComputeJacobian(void);
   void CrashDetect(void);
   void InitializeReporting(void);
   void ResetReporting(void);
@@ -54,6 +54,17 @@ namespace JSBSim {
 static const char *IdSrc = "$Id: FGMassBalance.cpp,v 1.33 2010/09/07 00:40:03 jberndt Exp $";
 static const char *IdHdr = ID_MASSBALANCE;
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Compares two matrices element by element.
+
+static bool SameMatrix(const FGMatrix33& A, const FGMatrix33& B)
+{
+  for (unsigned int i=1; i<=3; i++)
+    for (unsigned int j=1; j<=3; j++)
+      if (A(i,j) != B(i,j)) return false;
+  return true;
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -73,6 +84,15 @@ FGMassBalance::FGMassBalance(FGFDMExec* fdmex) : FGModel(fdmex)
   mJinv.InitMatrix();
   pmJ.InitMatrix();
 
+  BaseMass = TanksMass = PointMassWeight = LastChildFDMWeight = 0.0;
+  BaseMoment.InitMatrix(0.0);
+  BaseInertia.InitMatrix();
+  TanksMoment.InitMatrix(0.0);
+  TanksJ.InitMatrix();
+  mJlast.InitMatrix();
+  BaseChanged = true;
+  FullRecomputes = TankUpdates = InverseRecomputes = 0;
+
   bind();
 
   Debug(0);
@@ -96,6 +116,7 @@ bool FGMassBalance::InitModel(void)
 
   vLastXYZcg.InitMatrix(0.0);
   vDeltaXYZcg.InitMatrix(0.0);
+  BaseChanged = true;
 
   return true;
 }
@@ -166,9 +187,6 @@ bool FGMassBalance::Load(Element* el)
 
 bool FGMassBalance::Run(void)
 {
-  double denom, k1, k2, k3, k4, k5, k6;
-  double Ixx, Iyy, Izz, Ixy, Ixz, Iyz;
-
   if (FGModel::Run()) return true;
   if (FDMExec->Holding()) return false;
 
@@ -179,16 +197,34 @@ bool FGMassBalance::Run(void)
     if (FDMExec->GetChildFDM(fdm)->mated) ChildFDMWeight += FDMExec->GetChildFDM(fdm)->exec->GetMassBalance()->GetWeight();
   }
 
-  Weight = EmptyWeight + Propulsion->GetTanksWeight() + GetTotalPointMassWeight()
-    + BuoyantForces->GetGasMass()*slugtolb + ChildFDMWeight;
+// Update the contributions that changed since the last frame
 
-  Mass = lbtoslug*Weight;
+  bool changed = false;
+  if (BaseChanged || PointMassesChanged()) {
+    CalculateBaseInertias();
+    FullRecomputes++;
+    changed = true;
+  }
+  if (UpdateTankInertias()) {
+    if (!changed) TankUpdates++;
+    changed = true;
+  }
+  if (ChildFDMWeight != LastChildFDMWeight) changed = true;
+  if (BuoyantForces->GetNumGasCells() > 0) changed = true;
+  LastChildFDMWeight = ChildFDMWeight;
+
+  if (changed) {
+    Weight = EmptyWeight + Propulsion->GetTanksWeight() + PointMassWeight
+      + BuoyantForces->GetGasMass()*slugtolb + ChildFDMWeight;
+
+    Mass = lbtoslug*Weight;
 
 // Calculate new CG
 
-  vXYZcg = (Propulsion->GetTanksMoment() + EmptyWeight*vbaseXYZcg
-            + GetPointMassMoment()
-            + BuoyantForces->GetGasMassMoment()) / Weight;
+    vXYZcg = (Propulsion->GetTanksMoment() + EmptyWeight*vbaseXYZcg
+              + PointMassCG
+              + BuoyantForces->GetGasMassMoment()) / Weight;
+  }
 
   // Track frame-by-frame delta CG, and move the EOM-tracked location
   // by this amount.
@@ -198,16 +234,140 @@ bool FGMassBalance::Run(void)
   vLastXYZcg = vXYZcg;
   Propagate->NudgeBodyLocation(vDeltaXYZcgBody);
 
-// Calculate new total moments of inertia
+  if (changed) {
+    CalculateInertias();
+    if (InverseRecomputes == 0 || !SameMatrix(mJ, mJlast)) CalculateInverse();
+  }
+
+  RunPostFunctions();
+
+  Debug(0);
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGMassBalance::PointMassesChanged(void)
+{
+  bool changed = false;
+
+  for (unsigned int i=0; i<PointMasses.size(); i++) {
+    if (PointMasses[i]->Changed) changed = true;
+    PointMasses[i]->Changed = false;
+  }
+  return changed;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//
+// Sums the base vehicle and the point masses, referred to the empty weight CG
+// (where the base vehicle itself lies).
+//
+void FGMassBalance::CalculateBaseInertias(void)
+{
+  PointMassWeight = GetTotalPointMassWeight();
+  GetPointMassMoment();
+
+  BaseMass = lbtoslug * EmptyWeight;
+  BaseMoment.InitMatrix(0.0);
+  for (unsigned int i=0; i<PointMasses.size(); i++) {
+    BaseMass += lbtoslug * PointMasses[i]->Weight;
+    BaseMoment += lbtoslug * PointMasses[i]->Weight
+                  * StructuralToReference(PointMasses[i]->Location);
+  }
+
+  BaseInertia = baseJ;
+  BaseInertia += CalculatePMInertias();
+
+  BaseChanged = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//
+// Recomputes the contribution of the tanks whose contents changed (as the fuel
+// burns), and sums them again if any did. Returns true in that case.
+//
+bool FGMassBalance::UpdateTankInertias(void)
+{
+  unsigned int size = Propulsion->GetNumTanks();
+  bool resized = TankTerms.size() != size;
+  bool changed = resized;
+
+  if (resized) TankTerms.resize(size);
+
+  for (unsigned int i=0; i<size; i++) {
+    FGTank* tank = Propulsion->GetTank(i);
+    TankTerm& term = TankTerms[i];
+
+    if (!resized && tank->GetContents() == term.Contents
+        && tank->GetIxx() == term.Ixx && tank->GetIyy() == term.Iyy
+        && tank->GetIzz() == term.Izz) continue;
+
+    term.Contents = tank->GetContents();
+    term.Ixx = tank->GetIxx();
+    term.Iyy = tank->GetIyy();
+    term.Izz = tank->GetIzz();
+
+    FGColumnVector3 v = StructuralToReference(tank->GetXYZ());
+    term.Mass = lbtoslug * term.Contents;
+    term.Moment = term.Mass * v;
+    term.J = PointmassInertia(term.Mass, v);
+    term.J(1,1) += term.Ixx;
+    term.J(2,2) += term.Iyy;
+    term.J(3,3) += term.Izz;
+    changed = true;
+  }
+
+  if (!changed) return false;
+
+  TanksMass = 0.0;
+  TanksMoment.InitMatrix(0.0);
+  TanksJ.InitMatrix();
+  for (unsigned int i=0; i<size; i++) {
+    TanksMass += TankTerms[i].Mass;
+    TanksMoment += TankTerms[i].Moment;
+    TanksJ += TankTerms[i].J;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//
+// The inertia matrix about the CG c, from the mass m, the first moment s and
+// the inertia matrix J0 referred to the empty weight CG (parallel axis theorem):
+//
+//   J = J0 - (2 s.c - m c.c) I + s c^T + c s^T - m c c^T
+//
+// which is J0 - m ((c.c) I - c c^T) when c is the CG of the masses summed in J0.
+// The weight of the mated child FDMs moves the CG but adds no inertia, so the
+// general form is used.
+//
+void FGMassBalance::CalculateInertias(void)
+{
+  double m = BaseMass + TanksMass;
+  FGColumnVector3 s = BaseMoment + TanksMoment;
+  FGColumnVector3 c = StructuralToReference(vXYZcg);
+  double shift = 2.0*DotProduct(s, c) - m*DotProduct(c, c);
+
+  mJ = BaseInertia;
+  mJ += TanksJ;
+  for (unsigned int i=1; i<=3; i++) {
+    for (unsigned int j=1; j<=3; j++)
+      mJ(i,j) += s(i)*c(j) + c(i)*s(j) - m*c(i)*c(j);
+    mJ(i,i) -= shift;
+  }
 
-  // At first it is the base configuration inertia matrix ...
-  mJ = baseJ;
-  // ... with the additional term originating from the parallel axis theorem.
-  mJ += GetPointmassInertia( lbtoslug * EmptyWeight, vbaseXYZcg );
-  // Then add the contributions from the additional pointmasses.
-  mJ += CalculatePMInertias();
-  mJ += Propulsion->CalculateTankInertias();
   mJ += BuoyantForces->GetGasMassInertia();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMassBalance::CalculateInverse(void)
+{
+  double denom, k1, k2, k3, k4, k5, k6;
+  double Ixx, Iyy, Izz, Ixy, Ixz, Iyz;
 
   Ixx = mJ(1,1);
   Iyy = mJ(2,2);
@@ -234,11 +394,8 @@ bool FGMassBalance::Run(void)
                     k2, k4, k5,
                     k3, k5, k6 );
 
-  RunPostFunctions();
-
-  Debug(0);
-
-  return false;
+  mJlast = mJ;
+  InverseRecomputes++;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -318,17 +475,19 @@ FGColumnVector3& FGMassBalance::GetPointMassMoment(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+// The point masses inertia, referred to the empty weight CG
+
 FGMatrix33& FGMassBalance::CalculatePMInertias(void)
 {
   unsigned int size;
 
   size = PointMasses.size();
-  if (size == 0) return pmJ;
-
   pmJ = FGMatrix33();
+  if (size == 0) return pmJ;
 
   for (unsigned int i=0; i<size; i++) {
-    pmJ += GetPointmassInertia( lbtoslug * PointMasses[i]->Weight, PointMasses[i]->Location );
+    pmJ += PointmassInertia( lbtoslug * PointMasses[i]->Weight,
+                             StructuralToReference( PointMasses[i]->Location ) );
     pmJ += PointMasses[i]->GetPointMassInertia();
   }
 
@@ -368,6 +527,17 @@ FGColumnVector3 FGMassBalance::StructuralToBody(const FGColumnVector3& r) const
                          inchtoft*(vXYZcg(3)-r(3)));
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//
+// The same conversion, from the empty weight CG instead of the current CG.
+//
+FGColumnVector3 FGMassBalance::StructuralToReference(const FGColumnVector3& r) const
+{
+  return FGColumnVector3(inchtoft*(vbaseXYZcg(1)-r(1)),
+                         inchtoft*(r(2)-vbaseXYZcg(2)),
+                         inchtoft*(vbaseXYZcg(3)-r(3)));
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGMassBalance::bind(void)
@@ -385,6 +555,12 @@ void FGMassBalance::bind(void)
                        (PMF)&FGMassBalance::GetXYZcg);
   PropertyManager->Tie("inertia/cg-z-in", this,3,
                        (PMF)&FGMassBalance::GetXYZcg);
+  PropertyManager->Tie("inertia/full-recomputes", this,
+                       &FGMassBalance::GetFullRecomputes);
+  PropertyManager->Tie("inertia/tank-updates", this,
+                       &FGMassBalance::GetTankUpdates);
+  PropertyManager->Tie("inertia/inverse-recomputes", this,
+                       &FGMassBalance::GetInverseRecomputes);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -71,6 +71,17 @@ CLASS DOCUMENTATION
     the shape. Note that a cylinder is solid, a tube is hollow, a ball is solid
     and a sphere is hollow.
 
+    The contributions to the moments of inertia are kept from one frame to the
+    next, referred to the empty weight CG, and only those which changed are
+    recomputed: the base vehicle and the point masses when any of them was
+    modified (a full recompute), and the tanks whose contents changed (fuel
+    burn). The inertia matrix about the current CG is then obtained from these
+    sums with the parallel axis theorem, and its inverse is recomputed only if
+    the matrix changed. Gas cells are summed every frame. The number of full
+    recomputes, of frames where only tanks changed and of inverse recomputes
+    are available as the properties inertia/full-recomputes,
+    inertia/tank-updates and inertia/inverse-recomputes.
+
     <h3>Configuration File Format:</h3>
 @code
     <mass_balance>
@@ -136,7 +147,16 @@ public:
    */
   FGMatrix33 GetPointmassInertia(double slugs, const FGColumnVector3& r) const
   {
-    FGColumnVector3 v = StructuralToBody( r );
+    return PointmassInertia( slugs, StructuralToBody( r ) );
+  }
+
+  /** Computes the inertia matrix of a pointmass about a given point.
+      @param slugs the mass of this single pointmass given in slugs
+      @param v the location of this single pointmass in the body frame, in
+               feet from the point
+   */
+  static FGMatrix33 PointmassInertia(double slugs, const FGColumnVector3& v)
+  {
     FGColumnVector3 sv = slugs*v;
     double xx = sv(1)*v(1);
     double yy = sv(2)*v(2);
@@ -160,8 +180,8 @@ public:
    */
   FGColumnVector3 StructuralToBody(const FGColumnVector3& r) const;
 
-  inline void SetEmptyWeight(double EW) { EmptyWeight = EW;}
-  inline void SetBaseCG(const FGColumnVector3& CG) {vbaseXYZcg = vXYZcg = CG;}
+  inline void SetEmptyWeight(double EW) { EmptyWeight = EW; BaseChanged = true;}
+  inline void SetBaseCG(const FGColumnVector3& CG) {vbaseXYZcg = vXYZcg = CG; BaseChanged = true;}
 
   void AddPointMass(Element* el);
   double GetTotalPointMassWeight(void);
@@ -169,8 +189,15 @@ public:
   FGColumnVector3& GetPointMassMoment(void);
   FGMatrix33& GetJ(void) {return mJ;}
   FGMatrix33& GetJinv(void) {return mJinv;}
-  void SetAircraftBaseInertias(FGMatrix33 BaseJ) {baseJ = BaseJ;}
+  void SetAircraftBaseInertias(FGMatrix33 BaseJ) {baseJ = BaseJ; BaseChanged = true;}
   void GetMassPropertiesReport(void) const;
+
+  /// Returns the number of recomputes of the base vehicle and point masses.
+  long GetFullRecomputes(void) const {return FullRecomputes;}
+  /// Returns the number of frames where only tank contributions changed.
+  long GetTankUpdates(void) const {return TankUpdates;}
+  /// Returns the number of recomputes of the inertia matrix inverse.
+  long GetInverseRecomputes(void) const {return InverseRecomputes;}
   
 private:
   double Weight;
@@ -190,6 +217,41 @@ private:
   FGColumnVector3 PointMassCG;
   FGMatrix33& CalculatePMInertias(void);
 
+  // The contribution of a tank, referred to the empty weight CG, with the
+  // tank state it was computed for.
+  struct TankTerm {
+    double Contents;
+    double Ixx, Iyy, Izz;
+    double Mass;
+    FGColumnVector3 Moment;
+    FGMatrix33 J;
+  };
+
+  // The sums of the contributions (mass in slugs, first moment in slug-ft and
+  // inertia in slug-ft2) referred to the empty weight CG: base vehicle and
+  // point masses, then tanks.
+  double BaseMass;
+  FGColumnVector3 BaseMoment;
+  FGMatrix33 BaseInertia;
+  std::vector <TankTerm> TankTerms;
+  double TanksMass;
+  FGColumnVector3 TanksMoment;
+  FGMatrix33 TanksJ;
+  double PointMassWeight;
+  double LastChildFDMWeight;
+  FGMatrix33 mJlast;
+  bool BaseChanged;
+  long FullRecomputes;
+  long TankUpdates;
+  long InverseRecomputes;
+
+  FGColumnVector3 StructuralToReference(const FGColumnVector3& r) const;
+  bool PointMassesChanged(void);
+  void CalculateBaseInertias(void);
+  bool UpdateTankInertias(void);
+  void CalculateInertias(void);
+  void CalculateInverse(void);
+
 
   /** The PointMass structure encapsulates a point mass object, moments of inertia
      mass, location, etc. */
@@ -200,6 +262,7 @@ private:
       mPMInertia.InitMatrix();
       Radius = 0.0;
       Length = 0.0;
+      Changed = true;
     }
 
     void CalculateShapeInertia(void) {
@@ -235,6 +298,7 @@ private:
     double Length; /// Length in feet.
     string Name;
     FGMatrix33 mPMInertia;
+    bool Changed; /// Set when the weight or the location is modified.
 
     double GetPointMassLocation(int axis) const {return Location(axis);}
     double GetPointMassWeight(void) const {return Weight;}
@@ -243,8 +307,8 @@ private:
     FGMatrix33 GetPointMassInertia(void) {return mPMInertia;}
     string GetName(void) {return Name;}
 
-    void SetPointMassLocation(int axis, double value) {Location(axis) = value;}
-    void SetPointMassWeight(double wt) {Weight = wt;}
+    void SetPointMassLocation(int axis, double value) {Location(axis) = value; Changed = true;}
+    void SetPointMassWeight(double wt) {Weight = wt; Changed = true;}
     void SetPointMassShapeType(esShape st) {eShapeType = st;}
     void SetRadius(double r) {Radius = r;}
     void SetLength(double l) {Length = l;}
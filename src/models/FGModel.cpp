@@ -89,8 +89,9 @@ FGModel::FGModel(FGFDMExec* fdmex)
   //must be brought up now.
   PropertyManager = FDMExec->GetPropertyManager();
 
-  exe_ctr     = 1;
   rate        = 1;
+  phase       = 0;
+  first_run   = true;
 
   if (debug_lvl & 2) cout << "              FGModel Base Class" << endl;
 }
@@ -106,6 +107,8 @@ FGModel::~FGModel()
 
 bool FGModel::InitModel(void)
 {
+  first_run = true;
+
   Atmosphere      = FDMExec->GetAtmosphere();
   FCS             = FDMExec->GetFCS();
   Propulsion      = FDMExec->GetPropulsion();
@@ -139,12 +142,9 @@ bool FGModel::Run()
 {
   if (debug_lvl & 4) cout << "Entering Run() for model " << Name << endl;
 
-  if (rate == 1) return false; // Fast exit if nothing to do
-
-  if (exe_ctr >= rate) exe_ctr = 1;
-
-  if (exe_ctr++ == 1) return false;
-  else              return true;
+  // The executive only calls Run() at the frames where the model is due (see
+  // IsDue()), so there is nothing to skip here.
+  return false;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
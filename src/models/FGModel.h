@@ -40,6 +40,7 @@ INCLUDES
 
 #include "math/FGFunction.h"
 #include "math/FGModelFunctions.h"
+#include "math/FGTimingStats.h"
 
 #include <string>
 #include <vector>
@@ -77,6 +78,19 @@ CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 /** Base class for all scheduled JSBSim models
+
+    The executive (FGFDMExec) runs a model at the frames where the model is
+    due: a model scheduled at rate N and phase P runs once every N frames, at
+    the frames whose number modulo N is P, and its outputs (forces, moments,
+    atmospheric properties, ...) are held in between. Models that integrate
+    over time use the time step of the executive multiplied by their rate. A
+    model always runs at the first frame following its initialization
+    (InitModel()), whatever its phase, so that its outputs are valid from the
+    start.
+
+    The executive also measures the wall clock time spent in each scheduled
+    call to Run(); the statistics of these times are kept by the model (see
+    GetExecStats()).
     @author Jon S. Berndt
   */
 
@@ -100,15 +114,45 @@ public:
       @return false if no error */
   virtual bool Run(void);
   virtual bool InitModel(void);
-  virtual void SetRate(int tt) {rate = tt;}
-  virtual int  GetRate(void)   {return rate;}
+  /// Sets the rate (in frames) at which the model is run.
+  void SetRate(int tt) {rate = tt > 1 ? tt : 1;}
+  int  GetRate(void) const     {return rate;}
+  /** Sets the phase of the model: the frame, in each period of rate frames,
+      at which the model is run. The phase is taken modulo the rate. */
+  void SetPhase(int tt) {phase = tt > 0 ? tt : 0;}
+  int  GetPhase(void) const    {return phase % rate;}
   FGFDMExec* GetExec(void)     {return FDMExec;}
 
+  /** Tells whether the model is due at a frame, as per its rate and phase.
+      This is called by the executive, once per frame.
+      @param frame the number of the frame
+      @return true if the model is to be run at this frame */
+  bool IsDue(unsigned int frame) {
+    bool due = first_run || frame % rate == (unsigned int)(phase % rate);
+    first_run = false;
+    return due;
+  }
+
+  /** Records the wall clock time spent in a call to Run().
+      @param dt the time in seconds */
+  void AddExecTime(double dt) {ExecStats.Add(dt);}
+  /// Returns the statistics of the wall clock times of the calls to Run().
+  const FGTimingStats& GetExecStats(void) const {return ExecStats;}
+  /** Resets the execution time statistics. Models that time parts of their
+      work as well reset these statistics too. */
+  virtual void ResetExecStats(void) {ExecStats.Reset();}
+  /** Ties the execution time statistics to properties. Models that keep
+      statistics of their own tie them under the same path.
+      @param base the path under which the properties are created */
+  virtual void BindExecStats(const std::string& base) {ExecStats.Bind(PropertyManager, base);}
+
   void SetPropertyManager(FGPropertyManager *fgpm) { PropertyManager=fgpm;}
 
 protected:
-  int exe_ctr;
   int rate;
+  int phase;
+  bool first_run;
+  FGTimingStats ExecStats;
 
   /** Loads this model.
       @param el a pointer to the element
@@ -60,9 +60,16 @@ INCLUDES
 #include <iomanip>
 #include <cstring>
 #include <cstdlib>
+#include <cstddef>
 
 #include "input_output/net_fdm.hxx"
 #include "input_output/FGfdmSocket.h"
+#include "input_output/FGfdmTelemetry.h"
+#include "input_output/FGfdmSharedMemory.h"
+
+#include "input_output/FGOutputQueue.h"
+#include "input_output/FGOutputFile.h"
+#include "input_output/string_utilities.h"
 
 #if defined(WIN32) && !defined(__CYGWIN__)
 #  include <windows.h>
@@ -70,9 +77,16 @@ INCLUDES
 #  include <netinet/in.h>       // htonl() ntohl()
 #endif
 
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#  include <pthread.h>
+#endif
+
 static const int endianTest = 1;
 #define isLittleEndian (*((char *) &endianTest ) != 0)
 
+static const char BinaryLogMagic[] = "JSBSBLOG";
+static const unsigned int BinaryLogVersion = 1;
+
 using namespace std;
 
 namespace JSBSim {
@@ -123,19 +137,112 @@ static void htonf (float &x)
 }
 
 
+// Appends an unsigned 32 bits integer in little endian byte order.
+static void AppendLE32(string& buf, unsigned int value)
+{
+  for (int i=0; i<4; i++) buf += (char)((value >> 8*i) & 0xff);
+}
+
+// Returns the unit of a column of the output: what is between the parentheses
+// at the end of the name of a built-in column, or the unit suffix of a
+// property name (velocities/vc-kts). An empty string if there is none.
+static string ColumnUnit(const string& name)
+{
+  static const char* suffixes[] = {"ft", "fps", "kts", "mph", "deg", "rad",
+                                   "deg_sec", "rad_sec", "ft_sec", "ft_sec2",
+                                   "sec", "lbs", "lbsft", "psf", "psi", "inHg",
+                                   "rpm", "hp", "slugs", "norm", "R", "degF"};
+  string::size_type open = name.rfind(" (");
+
+  if (name == "Time") return "sec";
+  if (open != string::npos && name[name.size()-1] == ')') {
+    string unit = name.substr(open+2, name.size()-open-3);
+    return trim(unit);
+  }
+  string::size_type dash = name.rfind('-');
+  if (name.find('/') != string::npos && dash != string::npos) {
+    string suffix = name.substr(dash+1);
+    for (unsigned int i=0; i<sizeof(suffixes)/sizeof(suffixes[0]); i++)
+      if (suffix == suffixes[i]) return suffix;
+  }
+  return "";
+}
+
+// Returns the header of a binary log with the given column names. See the
+// class documentation for its layout.
+static string BinaryLogHeader(const vector <string>& names)
+{
+  string columns;
+
+  for (unsigned int i=0; i<names.size(); i++)
+    columns += names[i] + '\0' + ColumnUnit(names[i]) + '\0';
+
+  unsigned int size = 24 + columns.size();
+  size = (size + 7) & ~7U;
+
+  string header(BinaryLogMagic, 8);
+  AppendLE32(header, BinaryLogVersion);
+  AppendLE32(header, (unsigned int)names.size());
+  AppendLE32(header, size);
+  AppendLE32(header, 0);
+
+  header += columns;
+  header.resize(size, '\0');
+  return header;
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+// The state of an engine as FlightGear expects it: 2 running, 1 cranking, 0 off
+class FGEngineStateColumn : public FGOutputScalar
+{
+public:
+  FGEngineStateColumn(FGEngine* engine)
+    : FGOutputScalar(1.0, 1, 0), Engine(engine) {}
+  double GetValue(void) const {
+    if (Engine->GetRunning()) return 2.0;
+    return Engine->GetCranking() ? 1.0 : 0.0;
+  }
+private:
+  FGEngine* Engine;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct FGOutput::WriterThread {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  HANDLE Handle;
+
+  static DWORD WINAPI Entry(LPVOID output) {
+    ((FGOutput*)output)->WriteRecords();
+    return 0;
+  }
+#else
+  pthread_t Handle;
+
+  static void* Entry(void* output) {
+    ((FGOutput*)output)->WriteRecords();
+    return 0;
+  }
+#endif
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 FGOutput::FGOutput(FGFDMExec* fdmex) : FGModel(fdmex)
 {
   Name = "FGOutput";
   sFirstPass = dFirstPass = true;
   socket = 0;
   flightGearSocket = 0;
+  telemetry = 0;
+  sharedMemory = 0;
   runID_postfix = 0;
   Type = otNone;
   SubSystems = 0;
+  ColumnsValid = false;
   enabled = true;
   StartNewFile = false;
   delimeter = ", ";
@@ -143,7 +250,15 @@ FGOutput::FGOutput(FGFDMExec* fdmex) : FGModel(fdmex)
   DirectivesFile = "";
   output_file_name = "";
 
-  memset(&fgSockBuf, 0x00, sizeof(fgSockBuf));
+  memset(NetPacket, 0x00, sizeof(NetPacket));
+  NetPacketIndex = 0;
+
+  DataStream = &cout;
+  Queue = 0;
+  Writer = 0;
+  QueueSize = 0;
+  DropOnOverflow = false;
+  DroppedRecords = BackpressuredRecords = 0;
 
   Debug(0);
 }
@@ -152,8 +267,12 @@ FGOutput::FGOutput(FGFDMExec* fdmex) : FGModel(fdmex)
 
 FGOutput::~FGOutput()
 {
+  StopWriter();
   delete socket;
   delete flightGearSocket;
+  delete telemetry;
+  delete sharedMemory;
+  ClearColumns();
   OutputProperties.clear();
   Debug(1);
 }
@@ -173,7 +292,8 @@ bool FGOutput::InitModel(void)
       buf << BaseFilename << '_' << runID_postfix++;
     }
     Filename = buf.str();
-    datafile.close();
+    StopWriter();
+    DataFile.Close();
     StartNewFile = false;
     dFirstPass = true;
   }
@@ -193,8 +313,14 @@ bool FGOutput::Run(void)
       SocketOutput();
     } else if (Type == otFlightGear) {
       FlightGearSocketOutput();
+    } else if (Type == otTelemetry) {
+      TelemetryOutput();
+    } else if (Type == otSharedMemory) {
+      SharedMemoryOutput();
     } else if (Type == otCSV || Type == otTab) {
       DelimitedOutput(Filename);
+    } else if (Type == otBinary) {
+      BinaryOutput(Filename);
     } else if (Type == otTerminal) {
       // Not done yet
     } else if (Type == otNone) {
@@ -217,486 +343,763 @@ void FGOutput::SetType(const string& type)
   } else if (type == "TABULAR") {
     Type = otTab;
     delimeter = "\t";
+  } else if (type == "BINARY") {
+    Type = otBinary;
+    delimeter = ",";
   } else if (type == "SOCKET") {
     Type = otSocket;
   } else if (type == "FLIGHTGEAR") {
     Type = otFlightGear;
+  } else if (type == "TELEMETRY") {
+    Type = otTelemetry;
+  } else if (type == "SHARED_MEMORY") {
+    Type = otSharedMemory;
   } else if (type == "TERMINAL") {
     Type = otTerminal;
   } else if (type != string("NONE")) {
     Type = otUnknown;
     cerr << "Unknown type of output specified in config file" << endl;
   }
+  ColumnsValid = false;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGOutput::DelimitedOutput(const string& fname)
 {
-  streambuf* buffer;
-  string scratch = "";
+  // The header is written here, before the writer thread (if any) is started.
+  if (dFirstPass) {
+    ostringstream header;
+    DelimitedHeader(header);
+    header << endl;
+    StartDataFile(fname, header.str());
+    dFirstPass = false;
+  }
+
+  CollectRecord();
+  EmitRecord();
+}
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A binary log holds the same columns as a CSV file, with the values stored as
+// they are in memory instead of as text. See the class documentation for the
+// layout of the file.
+
+void FGOutput::BinaryOutput(const string& fname)
+{
+  if (dFirstPass) {
+    StartDataFile(fname, BinaryHeader());
+    dFirstPass = false;
+  }
+
+  CollectRecord();
+  EmitRecord();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The header of a file (of each of its segments when it is rotated) is kept by
+// the file, which writes it again whenever it starts a new segment.
+
+void FGOutput::StartDataFile(const string& fname, const string& header)
+{
   if (fname == "COUT" || fname == "cout") {
-    buffer = cout.rdbuf();
+    DataStream = &cout;
+    cout.write(header.data(), header.size());
+    cout.flush();
   } else {
-    if (!datafile.is_open()) datafile.open(fname.c_str());
-    buffer = datafile.rdbuf();
+    DataStream = 0;
+    DataFile.SetHeader(header);
+    DataFile.Open(fname);
   }
+}
 
-  ostream outstream(buffer);
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The column names are those of the CSV header, which is written with a comma
+// as the delimiter and split again.
 
-  outstream.precision(10);
+string FGOutput::BinaryHeader(void)
+{
+  ostringstream buf;
+  DelimitedHeader(buf);
+
+  string header = buf.str();
+  vector <string> names;
+  string::size_type start = 0;
+
+  while (start <= header.size()) {
+    string::size_type end = header.find(',', start);
+    if (end == string::npos) end = header.size();
+    string name = header.substr(start, end-start);
+    names.push_back(trim(name));
+    start = end+1;
+  }
 
-  if (dFirstPass) {
-    outstream << "Time";
-    if (SubSystems & ssSimulation) {
-      // Nothing here, yet
-    }
-    if (SubSystems & ssAerosurfaces) {
-      outstream << delimeter;
-      outstream << "Aileron Command (norm)" + delimeter;
-      outstream << "Elevator Command (norm)" + delimeter;
-      outstream << "Rudder Command (norm)" + delimeter;
-      outstream << "Flap Command (norm)" + delimeter;
-      outstream << "Left Aileron Position (deg)" + delimeter;
-      outstream << "Right Aileron Position (deg)" + delimeter;
-      outstream << "Elevator Position (deg)" + delimeter;
-      outstream << "Rudder Position (deg)" + delimeter;
-      outstream << "Flap Position (deg)";
-    }
-    if (SubSystems & ssRates) {
-      outstream << delimeter;
-      outstream << "P (deg/s)" + delimeter + "Q (deg/s)" + delimeter + "R (deg/s)" + delimeter;
-      outstream << "P dot (deg/s^2)" + delimeter + "Q dot (deg/s^2)" + delimeter + "R dot (deg/s^2)" + delimeter;
-      outstream << "P_{inertial} (deg/s)" + delimeter + "Q_{inertial} (deg/s)" + delimeter + "R_{inertial} (deg/s)";
-    }
-    if (SubSystems & ssVelocities) {
-      outstream << delimeter;
-      outstream << "q bar (psf)" + delimeter;
-      outstream << "Reynolds Number" + delimeter;
-      outstream << "V_{Total} (ft/s)" + delimeter;
-      outstream << "V_{Inertial} (ft/s)" + delimeter;
-      outstream << "UBody" + delimeter + "VBody" + delimeter + "WBody" + delimeter;
-      outstream << "Aero V_{X Body} (ft/s)" + delimeter + "Aero V_{Y Body} (ft/s)" + delimeter + "Aero V_{Z Body} (ft/s)" + delimeter;
-      outstream << "V_{X_{inertial}} (ft/s)" + delimeter + "V_{Y_{inertial}} (ft/s)" + delimeter + "V_{Z_{inertial}} (ft/s)" + delimeter;
-      outstream << "V_{North} (ft/s)" + delimeter + "V_{East} (ft/s)" + delimeter + "V_{Down} (ft/s)";
-    }
-    if (SubSystems & ssForces) {
-      outstream << delimeter;
-      outstream << "F_{Drag} (lbs)" + delimeter + "F_{Side} (lbs)" + delimeter + "F_{Lift} (lbs)" + delimeter;
-      outstream << "L/D" + delimeter;
-      outstream << "F_{Aero x} (lbs)" + delimeter + "F_{Aero y} (lbs)" + delimeter + "F_{Aero z} (lbs)" + delimeter;
-      outstream << "F_{Prop x} (lbs)" + delimeter + "F_{Prop y} (lbs)" + delimeter + "F_{Prop z} (lbs)" + delimeter;
-      outstream << "F_{Gear x} (lbs)" + delimeter + "F_{Gear y} (lbs)" + delimeter + "F_{Gear z} (lbs)" + delimeter;
-      outstream << "F_{Ext x} (lbs)" + delimeter + "F_{Ext y} (lbs)" + delimeter + "F_{Ext z} (lbs)" + delimeter;
-      outstream << "F_{Buoyant x} (lbs)" + delimeter + "F_{Buoyant y} (lbs)" + delimeter + "F_{Buoyant z} (lbs)" + delimeter;
-      outstream << "F_{Total x} (lbs)" + delimeter + "F_{Total y} (lbs)" + delimeter + "F_{Total z} (lbs)";
-    }
-    if (SubSystems & ssMoments) {
-      outstream << delimeter;
-      outstream << "L_{Aero} (ft-lbs)" + delimeter + "M_{Aero} ( ft-lbs)" + delimeter + "N_{Aero} (ft-lbs)" + delimeter;
-      outstream << "L_{Prop} (ft-lbs)" + delimeter + "M_{Prop} (ft-lbs)" + delimeter + "N_{Prop} (ft-lbs)" + delimeter;
-      outstream << "L_{Gear} (ft-lbs)" + delimeter + "M_{Gear} (ft-lbs)" + delimeter + "N_{Gear} (ft-lbs)" + delimeter;
-      outstream << "L_{ext} (ft-lbs)" + delimeter + "M_{ext} (ft-lbs)" + delimeter + "N_{ext} (ft-lbs)" + delimeter;
-      outstream << "L_{Buoyant} (ft-lbs)" + delimeter + "M_{Buoyant} (ft-lbs)" + delimeter + "N_{Buoyant} (ft-lbs)" + delimeter;
-      outstream << "L_{Total} (ft-lbs)" + delimeter + "M_{Total} (ft-lbs)" + delimeter + "N_{Total} (ft-lbs)";
-    }
-    if (SubSystems & ssAtmosphere) {
-      outstream << delimeter;
-      outstream << "Rho (slugs/ft^3)" + delimeter;
-      outstream << "Absolute Viscosity" + delimeter;
-      outstream << "Kinematic Viscosity" + delimeter;
-      outstream << "Temperature (R)" + delimeter;
-      outstream << "P_{SL} (psf)" + delimeter;
-      outstream << "P_{Ambient} (psf)" + delimeter;
-      outstream << "Turbulence Magnitude (ft/sec)" + delimeter;
-      outstream << "Turbulence X Direction (rad)" + delimeter + "Turbulence Y Direction (rad)" + delimeter + "Turbulence Z Direction (rad)" + delimeter;
-      outstream << "Wind V_{North} (ft/s)" + delimeter + "Wind V_{East} (ft/s)" + delimeter + "Wind V_{Down} (ft/s)";
-    }
-    if (SubSystems & ssMassProps) {
-      outstream << delimeter;
-      outstream << "I_{xx}" + delimeter;
-      outstream << "I_{xy}" + delimeter;
-      outstream << "I_{xz}" + delimeter;
-      outstream << "I_{yx}" + delimeter;
-      outstream << "I_{yy}" + delimeter;
-      outstream << "I_{yz}" + delimeter;
-      outstream << "I_{zx}" + delimeter;
-      outstream << "I_{zy}" + delimeter;
-      outstream << "I_{zz}" + delimeter;
-      outstream << "Mass" + delimeter;
-      outstream << "X_{cg}" + delimeter + "Y_{cg}" + delimeter + "Z_{cg}";
-    }
-    if (SubSystems & ssPropagate) {
-      outstream << delimeter;
-      outstream << "Altitude ASL (ft)" + delimeter;
-      outstream << "Altitude AGL (ft)" + delimeter;
-      outstream << "Phi (deg)" + delimeter + "Theta (deg)" + delimeter + "Psi (deg)" + delimeter;
-      outstream << "Alpha (deg)" + delimeter;
-      outstream << "Beta (deg)" + delimeter;
-      outstream << "Latitude (deg)" + delimeter;
-      outstream << "Longitude (deg)" + delimeter;
-      outstream << "X_{ECI} (ft)" + delimeter + "Y_{ECI} (ft)" + delimeter + "Z_{ECI} (ft)" + delimeter;
-      outstream << "X_{ECEF} (ft)" + delimeter + "Y_{ECEF} (ft)" + delimeter + "Z_{ECEF} (ft)" + delimeter;
-      outstream << "Earth Position Angle (deg)" + delimeter;
-      outstream << "Distance AGL (ft)" + delimeter;
-      outstream << "Terrain Elevation (ft)";
-    }
-    if (SubSystems & ssCoefficients) {
-      scratch = Aerodynamics->GetCoefficientStrings(delimeter);
-      if (scratch.length() != 0) outstream << delimeter << scratch;
-    }
-    if (SubSystems & ssFCS) {
-      scratch = FCS->GetComponentStrings(delimeter);
-      if (scratch.length() != 0) outstream << delimeter << scratch;
-    }
-    if (SubSystems & ssGroundReactions) {
-      outstream << delimeter;
-      outstream << GroundReactions->GetGroundReactionStrings(delimeter);
-    }
-    if (SubSystems & ssPropulsion && Propulsion->GetNumEngines() > 0) {
-      outstream << delimeter;
-      outstream << Propulsion->GetPropulsionStrings(delimeter);
-    }
-    if (OutputProperties.size() > 0) {
-      for (unsigned int i=0;i<OutputProperties.size();i++) {
-        outstream << delimeter << OutputProperties[i]->GetPrintableName();
-      }
-    }
+  return BinaryLogHeader(names);
+}
 
-    outstream << endl;
-    dFirstPass = false;
-  }
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-  outstream << FDMExec->GetSimTime();
+void FGOutput::DelimitedHeader(ostream& outstream)
+{
+  string scratch = "";
+
+  outstream << "Time";
   if (SubSystems & ssSimulation) {
+    // Nothing here, yet
   }
   if (SubSystems & ssAerosurfaces) {
     outstream << delimeter;
-    outstream << FCS->GetDaCmd() << delimeter;
-    outstream << FCS->GetDeCmd() << delimeter;
-    outstream << FCS->GetDrCmd() << delimeter;
-    outstream << FCS->GetDfCmd() << delimeter;
-    outstream << FCS->GetDaLPos(ofDeg) << delimeter;
-    outstream << FCS->GetDaRPos(ofDeg) << delimeter;
-    outstream << FCS->GetDePos(ofDeg) << delimeter;
-    outstream << FCS->GetDrPos(ofDeg) << delimeter;
-    outstream << FCS->GetDfPos(ofDeg);
+    outstream << "Aileron Command (norm)" + delimeter;
+    outstream << "Elevator Command (norm)" + delimeter;
+    outstream << "Rudder Command (norm)" + delimeter;
+    outstream << "Flap Command (norm)" + delimeter;
+    outstream << "Left Aileron Position (deg)" + delimeter;
+    outstream << "Right Aileron Position (deg)" + delimeter;
+    outstream << "Elevator Position (deg)" + delimeter;
+    outstream << "Rudder Position (deg)" + delimeter;
+    outstream << "Flap Position (deg)";
   }
   if (SubSystems & ssRates) {
     outstream << delimeter;
-    outstream << (radtodeg*Propagate->GetPQR()).Dump(delimeter) << delimeter;
-    outstream << (radtodeg*Propagate->GetPQRdot()).Dump(delimeter) << delimeter;
-    outstream << (radtodeg*Propagate->GetPQRi()).Dump(delimeter);
+    outstream << "P (deg/s)" + delimeter + "Q (deg/s)" + delimeter + "R (deg/s)" + delimeter;
+    outstream << "P dot (deg/s^2)" + delimeter + "Q dot (deg/s^2)" + delimeter + "R dot (deg/s^2)" + delimeter;
+    outstream << "P_{inertial} (deg/s)" + delimeter + "Q_{inertial} (deg/s)" + delimeter + "R_{inertial} (deg/s)";
   }
   if (SubSystems & ssVelocities) {
     outstream << delimeter;
-    outstream << Auxiliary->Getqbar() << delimeter;
-    outstream << Auxiliary->GetReynoldsNumber() << delimeter;
-    outstream << setprecision(12) << Auxiliary->GetVt() << delimeter;
-    outstream << Propagate->GetInertialVelocityMagnitude() << delimeter;
-    outstream << setprecision(12) << Propagate->GetUVW().Dump(delimeter) << delimeter;
-    outstream << Auxiliary->GetAeroUVW().Dump(delimeter) << delimeter;
-    outstream << Propagate->GetInertialVelocity().Dump(delimeter) << delimeter;
-    outstream << Propagate->GetVel().Dump(delimeter);
-    outstream.precision(10);
+    outstream << "q bar (psf)" + delimeter;
+    outstream << "Reynolds Number" + delimeter;
+    outstream << "V_{Total} (ft/s)" + delimeter;
+    outstream << "V_{Inertial} (ft/s)" + delimeter;
+    outstream << "UBody" + delimeter + "VBody" + delimeter + "WBody" + delimeter;
+    outstream << "Aero V_{X Body} (ft/s)" + delimeter + "Aero V_{Y Body} (ft/s)" + delimeter + "Aero V_{Z Body} (ft/s)" + delimeter;
+    outstream << "V_{X_{inertial}} (ft/s)" + delimeter + "V_{Y_{inertial}} (ft/s)" + delimeter + "V_{Z_{inertial}} (ft/s)" + delimeter;
+    outstream << "V_{North} (ft/s)" + delimeter + "V_{East} (ft/s)" + delimeter + "V_{Down} (ft/s)";
   }
   if (SubSystems & ssForces) {
     outstream << delimeter;
-    outstream << Aerodynamics->GetvFw().Dump(delimeter) << delimeter;
-    outstream << Aerodynamics->GetLoD() << delimeter;
-    outstream << Aerodynamics->GetForces().Dump(delimeter) << delimeter;
-    outstream << Propulsion->GetForces().Dump(delimeter) << delimeter;
-    outstream << GroundReactions->GetForces().Dump(delimeter) << delimeter;
-    outstream << ExternalReactions->GetForces().Dump(delimeter) << delimeter;
-    outstream << BuoyantForces->GetForces().Dump(delimeter) << delimeter;
-    outstream << Aircraft->GetForces().Dump(delimeter);
+    outstream << "F_{Drag} (lbs)" + delimeter + "F_{Side} (lbs)" + delimeter + "F_{Lift} (lbs)" + delimeter;
+    outstream << "L/D" + delimeter;
+    outstream << "F_{Aero x} (lbs)" + delimeter + "F_{Aero y} (lbs)" + delimeter + "F_{Aero z} (lbs)" + delimeter;
+    outstream << "F_{Prop x} (lbs)" + delimeter + "F_{Prop y} (lbs)" + delimeter + "F_{Prop z} (lbs)" + delimeter;
+    outstream << "F_{Gear x} (lbs)" + delimeter + "F_{Gear y} (lbs)" + delimeter + "F_{Gear z} (lbs)" + delimeter;
+    outstream << "F_{Ext x} (lbs)" + delimeter + "F_{Ext y} (lbs)" + delimeter + "F_{Ext z} (lbs)" + delimeter;
+    outstream << "F_{Buoyant x} (lbs)" + delimeter + "F_{Buoyant y} (lbs)" + delimeter + "F_{Buoyant z} (lbs)" + delimeter;
+    outstream << "F_{Total x} (lbs)" + delimeter + "F_{Total y} (lbs)" + delimeter + "F_{Total z} (lbs)";
   }
   if (SubSystems & ssMoments) {
     outstream << delimeter;
-    outstream << Aerodynamics->GetMoments().Dump(delimeter) << delimeter;
-    outstream << Propulsion->GetMoments().Dump(delimeter) << delimeter;
-    outstream << GroundReactions->GetMoments().Dump(delimeter) << delimeter;
-    outstream << ExternalReactions->GetMoments().Dump(delimeter) << delimeter;
-    outstream << BuoyantForces->GetMoments().Dump(delimeter) << delimeter;
-    outstream << Aircraft->GetMoments().Dump(delimeter);
+    outstream << "L_{Aero} (ft-lbs)" + delimeter + "M_{Aero} ( ft-lbs)" + delimeter + "N_{Aero} (ft-lbs)" + delimeter;
+    outstream << "L_{Prop} (ft-lbs)" + delimeter + "M_{Prop} (ft-lbs)" + delimeter + "N_{Prop} (ft-lbs)" + delimeter;
+    outstream << "L_{Gear} (ft-lbs)" + delimeter + "M_{Gear} (ft-lbs)" + delimeter + "N_{Gear} (ft-lbs)" + delimeter;
+    outstream << "L_{ext} (ft-lbs)" + delimeter + "M_{ext} (ft-lbs)" + delimeter + "N_{ext} (ft-lbs)" + delimeter;
+    outstream << "L_{Buoyant} (ft-lbs)" + delimeter + "M_{Buoyant} (ft-lbs)" + delimeter + "N_{Buoyant} (ft-lbs)" + delimeter;
+    outstream << "L_{Total} (ft-lbs)" + delimeter + "M_{Total} (ft-lbs)" + delimeter + "N_{Total} (ft-lbs)";
   }
   if (SubSystems & ssAtmosphere) {
     outstream << delimeter;
-    outstream << Atmosphere->GetDensity() << delimeter;
-    outstream << Atmosphere->GetAbsoluteViscosity() << delimeter;
-    outstream << Atmosphere->GetKinematicViscosity() << delimeter;
-    outstream << Atmosphere->GetTemperature() << delimeter;
-    outstream << Atmosphere->GetPressureSL() << delimeter;
-    outstream << Atmosphere->GetPressure() << delimeter;
-    outstream << Atmosphere->GetTurbMagnitude() << delimeter;
-    outstream << Atmosphere->GetTurbDirection().Dump(delimeter) << delimeter;
-    outstream << Atmosphere->GetTotalWindNED().Dump(delimeter);
+    outstream << "Rho (slugs/ft^3)" + delimeter;
+    outstream << "Absolute Viscosity" + delimeter;
+    outstream << "Kinematic Viscosity" + delimeter;
+    outstream << "Temperature (R)" + delimeter;
+    outstream << "P_{SL} (psf)" + delimeter;
+    outstream << "P_{Ambient} (psf)" + delimeter;
+    outstream << "Turbulence Magnitude (ft/sec)" + delimeter;
+    outstream << "Turbulence X Direction (rad)" + delimeter + "Turbulence Y Direction (rad)" + delimeter + "Turbulence Z Direction (rad)" + delimeter;
+    outstream << "Wind V_{North} (ft/s)" + delimeter + "Wind V_{East} (ft/s)" + delimeter + "Wind V_{Down} (ft/s)";
   }
   if (SubSystems & ssMassProps) {
     outstream << delimeter;
-    outstream << MassBalance->GetJ().Dump(delimeter) << delimeter;
-    outstream << MassBalance->GetMass() << delimeter;
-    outstream << MassBalance->GetXYZcg().Dump(delimeter);
+    outstream << "I_{xx}" + delimeter;
+    outstream << "I_{xy}" + delimeter;
+    outstream << "I_{xz}" + delimeter;
+    outstream << "I_{yx}" + delimeter;
+    outstream << "I_{yy}" + delimeter;
+    outstream << "I_{yz}" + delimeter;
+    outstream << "I_{zx}" + delimeter;
+    outstream << "I_{zy}" + delimeter;
+    outstream << "I_{zz}" + delimeter;
+    outstream << "Mass" + delimeter;
+    outstream << "X_{cg}" + delimeter + "Y_{cg}" + delimeter + "Z_{cg}";
   }
   if (SubSystems & ssPropagate) {
-    outstream.precision(14);
     outstream << delimeter;
-    outstream << Propagate->GetAltitudeASL() << delimeter;
-    outstream << Propagate->GetDistanceAGL() << delimeter;
-    outstream << (radtodeg*Propagate->GetEuler()).Dump(delimeter) << delimeter;
-    outstream << Auxiliary->Getalpha(inDegrees) << delimeter;
-    outstream << Auxiliary->Getbeta(inDegrees) << delimeter;
-    outstream << Propagate->GetLocation().GetLatitudeDeg() << delimeter;
-    outstream << Propagate->GetLocation().GetLongitudeDeg() << delimeter;
-    outstream.precision(18);
-    outstream << ((FGColumnVector3)Propagate->GetInertialPosition()).Dump(delimeter) << delimeter;
-    outstream << ((FGColumnVector3)Propagate->GetLocation()).Dump(delimeter) << delimeter;
-    outstream.precision(14);
-    outstream << Inertial->GetEarthPositionAngleDeg() << delimeter;
-    outstream << Propagate->GetDistanceAGL() << delimeter;
-    outstream << Propagate->GetTerrainElevation();
-    outstream.precision(10);
+    outstream << "Altitude ASL (ft)" + delimeter;
+    outstream << "Altitude AGL (ft)" + delimeter;
+    outstream << "Phi (deg)" + delimeter + "Theta (deg)" + delimeter + "Psi (deg)" + delimeter;
+    outstream << "Alpha (deg)" + delimeter;
+    outstream << "Beta (deg)" + delimeter;
+    outstream << "Latitude (deg)" + delimeter;
+    outstream << "Longitude (deg)" + delimeter;
+    outstream << "X_{ECI} (ft)" + delimeter + "Y_{ECI} (ft)" + delimeter + "Z_{ECI} (ft)" + delimeter;
+    outstream << "X_{ECEF} (ft)" + delimeter + "Y_{ECEF} (ft)" + delimeter + "Z_{ECEF} (ft)" + delimeter;
+    outstream << "Earth Position Angle (deg)" + delimeter;
+    outstream << "Distance AGL (ft)" + delimeter;
+    outstream << "Terrain Elevation (ft)";
   }
   if (SubSystems & ssCoefficients) {
-    scratch = Aerodynamics->GetCoefficientValues(delimeter);
+    scratch = Aerodynamics->GetCoefficientStrings(delimeter);
     if (scratch.length() != 0) outstream << delimeter << scratch;
   }
   if (SubSystems & ssFCS) {
-    scratch = FCS->GetComponentValues(delimeter);
+    scratch = FCS->GetComponentStrings(delimeter);
     if (scratch.length() != 0) outstream << delimeter << scratch;
   }
   if (SubSystems & ssGroundReactions) {
     outstream << delimeter;
-    outstream << GroundReactions->GetGroundReactionValues(delimeter);
+    outstream << GroundReactions->GetGroundReactionStrings(delimeter);
   }
   if (SubSystems & ssPropulsion && Propulsion->GetNumEngines() > 0) {
     outstream << delimeter;
-    outstream << Propulsion->GetPropulsionValues(delimeter);
+    outstream << Propulsion->GetPropulsionStrings(delimeter);
+  }
+  if (SubSystems & ssPerformance) {
+    outstream << delimeter;
+    outstream << FDMExec->GetPerformanceStrings(delimeter);
   }
+  if (OutputProperties.size() > 0) {
+    for (unsigned int i=0;i<OutputProperties.size();i++) {
+      outstream << delimeter << OutputProperties[i]->GetPrintableName();
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The list of columns is resolved once for the type of the output and the
+// subsystems it writes; each record is then collected in one pass over it.
 
-  outstream.precision(18);
-  for (unsigned int i=0;i<OutputProperties.size();i++) {
-    outstream << delimeter << OutputProperties[i]->getDoubleValue();
+void FGOutput::CompileColumns(void)
+{
+  ClearColumns();
+
+  if (Type == otCSV || Type == otTab || Type == otBinary) {
+    DelimitedColumns();
+  } else if (Type == otSocket) {
+    SocketColumns();
+  } else if (Type == otFlightGear) {
+    FlightGearColumns();
+  } else if (Type == otSharedMemory) {
+    SharedMemoryColumns();
   }
-  outstream.precision(10);
 
-  outstream << endl;
-  outstream.flush();
+  ColumnsValid = true;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGOutput::SocketDataFill(FGNetFDM* net)
+void FGOutput::ClearColumns(void)
 {
-    unsigned int i;
-
-    // Version
-    net->version = FG_NET_FDM_VERSION;
-
-    // Positions
-    net->longitude = Propagate->GetLocation().GetLongitude(); // geodetic (radians)
-    net->latitude  = Propagate->GetLocation().GetLatitude(); // geodetic (radians)
-    net->altitude  = Propagate->GetAltitudeASL()*0.3048; // altitude, above sea level (meters)
-    net->agl       = (float)(Propagate->GetDistanceAGL()*0.3048); // altitude, above ground level (meters)
-
-    net->phi       = (float)(Propagate->GetEuler(ePhi)); // roll (radians)
-    net->theta     = (float)(Propagate->GetEuler(eTht)); // pitch (radians)
-    net->psi       = (float)(Propagate->GetEuler(ePsi)); // yaw or true heading (radians)
-
-    net->alpha     = (float)(Auxiliary->Getalpha()); // angle of attack (radians)
-    net->beta      = (float)(Auxiliary->Getbeta()); // side slip angle (radians)
-
-    // Velocities
-    net->phidot     = (float)(Auxiliary->GetEulerRates(ePhi)); // roll rate (radians/sec)
-    net->thetadot   = (float)(Auxiliary->GetEulerRates(eTht)); // pitch rate (radians/sec)
-    net->psidot     = (float)(Auxiliary->GetEulerRates(ePsi)); // yaw rate (radians/sec)
-    net->vcas       = (float)(Auxiliary->GetVcalibratedFPS()); // VCAS, ft/sec
-    net->climb_rate = (float)(Propagate->Gethdot());           // altitude rate, ft/sec
-    net->v_north    = (float)(Propagate->GetVel(eNorth));      // north vel in NED frame, fps
-    net->v_east     = (float)(Propagate->GetVel(eEast));       // east vel in NED frame, fps
-    net->v_down     = (float)(Propagate->GetVel(eDown));       // down vel in NED frame, fps
-//---ADD METHOD TO CALCULATE THESE TERMS---
-    net->v_wind_body_north = (float)(Propagate->GetVel(eNorth)); // north vel in NED relative to airmass, fps
-    net->v_wind_body_east = (float)(Propagate->GetVel(eEast)); // east vel in NED relative to airmass, fps
-    net->v_wind_body_down = (float)(Propagate->GetVel(eDown)); // down vel in NED relative to airmass, fps
-
-    // Accelerations
-    net->A_X_pilot   = (float)(Auxiliary->GetPilotAccel(1));    // X body accel, ft/s/s
-    net->A_Y_pilot   = (float)(Auxiliary->GetPilotAccel(2));    // Y body accel, ft/s/s
-    net->A_Z_pilot   = (float)(Auxiliary->GetPilotAccel(3));    // Z body accel, ft/s/s
-
-    // Stall
-    net->stall_warning = 0.0;  // 0.0 - 1.0 indicating the amount of stall
-    net->slip_deg    = (float)(Auxiliary->Getbeta(inDegrees));  // slip ball deflection, deg
-
-    // Engine status
-    net->num_engines = Propulsion->GetNumEngines(); // Number of valid engines
-
-    for (i=0; i<net->num_engines; i++) {
-       if (Propulsion->GetEngine(i)->GetRunning())
-          net->eng_state[i] = 2;       // Engine state running
-       else if (Propulsion->GetEngine(i)->GetCranking())
-          net->eng_state[i] = 1;       // Engine state cranking
-       else
-          net->eng_state[i] = 0;       // Engine state off
-
-       switch (Propulsion->GetEngine(i)->GetType()) {
-       case (FGEngine::etRocket):
-       break;
-       case (FGEngine::etPiston):
-          net->rpm[i]       = (float)(((FGPiston *)Propulsion->GetEngine(i))->getRPM());
-          net->fuel_flow[i] = (float)(((FGPiston *)Propulsion->GetEngine(i))->getFuelFlow_gph());
-          net->fuel_px[i]   = 0; // Fuel pressure, psi  (N/A in current model)
-          net->egt[i]       = (float)(((FGPiston *)Propulsion->GetEngine(i))->GetEGT());
-          net->cht[i]       = (float)(((FGPiston *)Propulsion->GetEngine(i))->getCylinderHeadTemp_degF());
-          net->mp_osi[i]    = (float)(((FGPiston *)Propulsion->GetEngine(i))->getManifoldPressure_inHg());
-          net->oil_temp[i]  = (float)(((FGPiston *)Propulsion->GetEngine(i))->getOilTemp_degF());
-          net->oil_px[i]    = (float)(((FGPiston *)Propulsion->GetEngine(i))->getOilPressure_psi());
-          net->tit[i]       = 0; // Turbine Inlet Temperature  (N/A for piston)
-       break;
-       case (FGEngine::etTurbine):
-       break;
-       case (FGEngine::etTurboprop):
-       break;
-       case (FGEngine::etElectric):
-       break;
-       case (FGEngine::etUnknown):
-       break;
-       }
-    }
+  for (unsigned int i=0; i<Columns.size(); i++) delete Columns[i];
+  Columns.clear();
+  ColumnsValid = false;
+}
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-    // Consumables
-    net->num_tanks = Propulsion->GetNumTanks();   // Max number of fuel tanks
+void FGOutput::CollectRecord(void)
+{
+  if (!ColumnsValid) CompileColumns();
 
-    for (i=0; i<net->num_tanks; i++) {
-       net->fuel_quantity[i] = (float)(((FGTank *)Propulsion->GetTank(i))->GetContents());
-    }
+  Record.Clear();
+  for (unsigned int i=0; i<Columns.size(); i++) Columns[i]->Push(Record);
+}
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The values are pushed with the precision (and, for the vectors and matrices,
+// the width) the stream formatting has always given them in the file.
 
-    // Gear status
-    net->num_wheels  = GroundReactions->GetNumGearUnits();
+void FGOutput::DelimitedColumns(void)
+{
+  unsigned int i, j;
 
-    for (i=0; i<net->num_wheels; i++) {
-       net->wow[i]              = GroundReactions->GetGearUnit(i)->GetWOW();
-       if (GroundReactions->GetGearUnit(i)->GetGearUnitDown())
-          net->gear_pos[i]      = 1;  //gear down, using FCS convention
-       else
-          net->gear_pos[i]      = 0;  //gear up, using FCS convention
-       net->gear_steer[i]       = (float)(GroundReactions->GetGearUnit(i)->GetSteerNorm());
-       net->gear_compression[i] = (float)(GroundReactions->GetGearUnit(i)->GetCompLen());
-    }
+  Columns.push_back(OutputValue(FDMExec, &FGFDMExec::GetSimTime, 10));
+  if (SubSystems & ssSimulation) {
+  }
+  if (SubSystems & ssAerosurfaces) {
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDaCmd, 10));
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDeCmd, 10));
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDrCmd, 10));
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDfCmd, 10));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDaLPos, ofDeg, 10));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDaRPos, ofDeg, 10));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDePos, ofDeg, 10));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDrPos, ofDeg, 10));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDfPos, ofDeg, 10));
+  }
+  if (SubSystems & ssRates) {
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetPQR, i, 16, 18, radtodeg));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetPQRdot, i, 16, 18, radtodeg));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetPQRi, i, 16, 18, radtodeg));
+  }
+  if (SubSystems & ssVelocities) {
+    Columns.push_back(OutputValue(Auxiliary, &FGAuxiliary::Getqbar, 10));
+    Columns.push_back(OutputValue(Auxiliary, &FGAuxiliary::GetReynoldsNumber, 10));
+    Columns.push_back(OutputValue(Auxiliary, &FGAuxiliary::GetVt, 12));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetInertialVelocityMagnitude, 12));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetUVW, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Auxiliary, &FGAuxiliary::GetAeroUVW, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetInertialVelocity, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetVel, i, 16, 18));
+  }
+  if (SubSystems & ssForces) {
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aerodynamics, &FGAerodynamics::GetvFw, i, 16, 18));
+    Columns.push_back(OutputValue(Aerodynamics, &FGAerodynamics::GetLoD, 10));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aerodynamics, &FGAerodynamics::GetForces, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propulsion, &FGPropulsion::GetForces, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(GroundReactions, &FGGroundReactions::GetForces, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(ExternalReactions, &FGExternalReactions::GetForces, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(BuoyantForces, &FGBuoyantForces::GetForces, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aircraft, &FGAircraft::GetForces, i, 16, 18));
+  }
+  if (SubSystems & ssMoments) {
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aerodynamics, &FGAerodynamics::GetMoments, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propulsion, &FGPropulsion::GetMoments, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(GroundReactions, &FGGroundReactions::GetMoments, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(ExternalReactions, &FGExternalReactions::GetMoments, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(BuoyantForces, &FGBuoyantForces::GetMoments, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aircraft, &FGAircraft::GetMoments, i, 16, 18));
+  }
+  if (SubSystems & ssAtmosphere) {
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetDensity, 10));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetAbsoluteViscosity, 10));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetKinematicViscosity, 10));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetTemperature, 10));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetPressureSL, 10));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetPressure, 10));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetTurbMagnitude, 10));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Atmosphere, &FGAtmosphere::GetTurbDirection, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Atmosphere, &FGAtmosphere::GetTotalWindNED, i, 16, 18));
+  }
+  if (SubSystems & ssMassProps) {
+    for (i=1; i<=3; i++)
+      for (j=1; j<=3; j++)
+        Columns.push_back(OutputMatrixElement(MassBalance, &FGMassBalance::GetJ, i, j, 10, 12));
+    Columns.push_back(OutputValue(MassBalance, &FGMassBalance::GetMass, 10));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(MassBalance, &FGMassBalance::GetXYZcg, i, 16, 18));
+  }
+  if (SubSystems & ssPropagate) {
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetAltitudeASL, 14));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetDistanceAGL, 14));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetEuler, i, 16, 18, radtodeg));
+    Columns.push_back(OutputIndexedValue(Auxiliary, &FGAuxiliary::Getalpha, inDegrees, 14));
+    Columns.push_back(OutputIndexedValue(Auxiliary, &FGAuxiliary::Getbeta, inDegrees, 14));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetLatitudeDeg, 14));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetLongitudeDeg, 14));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetInertialPosition, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetLocation, i, 16, 18));
+    Columns.push_back(OutputValue(Inertial, &FGInertial::GetEarthPositionAngleDeg, 14));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetDistanceAGL, 14));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetTerrainElevation, 14));
+  }
+  GroupColumns();
 
+  for (i=0;i<OutputProperties.size();i++) {
+    Columns.push_back(OutputProperty(OutputProperties[i], 18));
+  }
+}
 
-    // Environment
-    net->cur_time    = (long int)1234567890;	// Friday, Feb 13, 2009, 23:31:30 UTC (not processed by FGFS anyway)
-    net->warp        = 0;                       // offset in seconds to unix time
-    net->visibility  = 25000.0;                 // visibility in meters (for env. effects)
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The single values are pushed with the format of FGfdmSocket::Append(double).
 
+void FGOutput::SocketColumns(void)
+{
+  const int p = 7, w = 12;
+  unsigned int i, j;
 
-    // Control surface positions (normalized values)
-    net->elevator          = (float)(FCS->GetDePos(ofNorm));    // Norm Elevator Pos, --
-    net->elevator_trim_tab = (float)(FCS->GetPitchTrimCmd());   // Norm Elev Trim Tab Pos, --
-    net->left_flap         = (float)(FCS->GetDfPos(ofNorm));    // Norm Flap Pos, --
-    net->right_flap        = (float)(FCS->GetDfPos(ofNorm));    // Norm Flap Pos, --
-    net->left_aileron      = (float)(FCS->GetDaLPos(ofNorm));   // Norm L Aileron Pos, --
-    net->right_aileron     = (float)(FCS->GetDaRPos(ofNorm));   // Norm R Aileron Pos, --
-    net->rudder            = (float)(FCS->GetDrPos(ofNorm));    // Norm Rudder Pos, --
-    net->nose_wheel        = (float)(FCS->GetDrPos(ofNorm));    // *** FIX ***  Using Rudder Pos for NWS, --
-    net->speedbrake        = (float)(FCS->GetDsbPos(ofNorm));   // Norm Speedbrake Pos, --
-    net->spoilers          = (float)(FCS->GetDspPos(ofNorm));   // Norm Spoiler Pos, --
+  Columns.push_back(OutputValue(FDMExec, &FGFDMExec::GetSimTime, p, w));
 
+  if (SubSystems & ssAerosurfaces) {
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDaCmd, p, w));
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDeCmd, p, w));
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDrCmd, p, w));
+    Columns.push_back(OutputValue(FCS, &FGFCS::GetDfCmd, p, w));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDaLPos, ofRad, p, w));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDaRPos, ofRad, p, w));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDePos, ofRad, p, w));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDrPos, ofRad, p, w));
+    Columns.push_back(OutputIndexedValue(FCS, &FGFCS::GetDfPos, ofRad, p, w));
+  }
+  if (SubSystems & ssRates) {
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetPQR, i, p, w, radtodeg));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetPQRdot, i, p, w, radtodeg));
+  }
+  if (SubSystems & ssVelocities) {
+    Columns.push_back(OutputValue(Auxiliary, &FGAuxiliary::Getqbar, p, w));
+    Columns.push_back(OutputValue(Auxiliary, &FGAuxiliary::GetVt, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetUVW, i, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Auxiliary, &FGAuxiliary::GetAeroUVW, i, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetVel, i, p, w));
+  }
+  if (SubSystems & ssForces) {
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aerodynamics, &FGAerodynamics::GetvFw, i, p, w));
+    Columns.push_back(OutputValue(Aerodynamics, &FGAerodynamics::GetLoD, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aircraft, &FGAircraft::GetForces, i, p, w));
+  }
+  if (SubSystems & ssMoments) {
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Aircraft, &FGAircraft::GetMoments, i, p, w));
+  }
+  if (SubSystems & ssAtmosphere) {
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetDensity, p, w));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetPressureSL, p, w));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetPressure, p, w));
+    Columns.push_back(OutputValue(Atmosphere, &FGAtmosphere::GetTurbMagnitude, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Atmosphere, &FGAtmosphere::GetTurbDirection, i, 16, 18));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Atmosphere, &FGAtmosphere::GetTotalWindNED, i, 16, 18));
+  }
+  if (SubSystems & ssMassProps) {
+    for (i=1; i<=3; i++)
+      for (j=1; j<=3; j++)
+        Columns.push_back(OutputMatrixElement(MassBalance, &FGMassBalance::GetJ, i, j, p, w));
+    Columns.push_back(OutputValue(MassBalance, &FGMassBalance::GetMass, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(MassBalance, &FGMassBalance::GetXYZcg, i, p, w));
+  }
+  if (SubSystems & ssPropagate) {
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetAltitudeASL, p, w));
+    for (i=1; i<=3; i++)
+      Columns.push_back(OutputElement(Propagate, &FGPropagate::GetEuler, i, p, w, radtodeg));
+    Columns.push_back(OutputIndexedValue(Auxiliary, &FGAuxiliary::Getalpha, inDegrees, p, w));
+    Columns.push_back(OutputIndexedValue(Auxiliary, &FGAuxiliary::Getbeta, inDegrees, p, w));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetLatitudeDeg, p, w));
+    Columns.push_back(OutputValue(Propagate, &FGPropagate::GetLongitudeDeg, p, w));
+  }
+  GroupColumns();
 
-    // Convert the net buffer to network format
-    if ( isLittleEndian ) {
-        net->version = htonl(net->version);
-
-        htond(net->longitude);
-        htond(net->latitude);
-        htond(net->altitude);
-        htonf(net->agl);
-        htonf(net->phi);
-        htonf(net->theta);
-        htonf(net->psi);
-        htonf(net->alpha);
-        htonf(net->beta);
-
-        htonf(net->phidot);
-        htonf(net->thetadot);
-        htonf(net->psidot);
-        htonf(net->vcas);
-        htonf(net->climb_rate);
-        htonf(net->v_north);
-        htonf(net->v_east);
-        htonf(net->v_down);
-        htonf(net->v_wind_body_north);
-        htonf(net->v_wind_body_east);
-        htonf(net->v_wind_body_down);
-
-        htonf(net->A_X_pilot);
-        htonf(net->A_Y_pilot);
-        htonf(net->A_Z_pilot);
-
-        htonf(net->stall_warning);
-        htonf(net->slip_deg);
-
-        for (i=0; i<net->num_engines; ++i ) {
-            net->eng_state[i] = htonl(net->eng_state[i]);
-            htonf(net->rpm[i]);
-            htonf(net->fuel_flow[i]);
-            htonf(net->fuel_px[i]);
-            htonf(net->egt[i]);
-            htonf(net->cht[i]);
-            htonf(net->mp_osi[i]);
-            htonf(net->tit[i]);
-            htonf(net->oil_temp[i]);
-            htonf(net->oil_px[i]);
-        }
-        net->num_engines = htonl(net->num_engines);
-
-        for (i=0; i<net->num_tanks; ++i ) {
-            htonf(net->fuel_quantity[i]);
-        }
-        net->num_tanks = htonl(net->num_tanks);
-
-        for (i=0; i<net->num_wheels; ++i ) {
-            net->wow[i] = htonl(net->wow[i]);
-            htonf(net->gear_pos[i]);
-            htonf(net->gear_steer[i]);
-            htonf(net->gear_compression[i]);
-        }
-        net->num_wheels = htonl(net->num_wheels);
-
-        net->cur_time = htonl( net->cur_time );
-        net->warp = htonl( net->warp );
-        htonf(net->visibility);
-
-        htonf(net->elevator);
-        htonf(net->elevator_trim_tab);
-        htonf(net->left_flap);
-        htonf(net->right_flap);
-        htonf(net->left_aileron);
-        htonf(net->right_aileron);
-        htonf(net->rudder);
-        htonf(net->nose_wheel);
-        htonf(net->speedbrake);
-        htonf(net->spoilers);
+  for (i=0;i<OutputProperties.size();i++) {
+    Columns.push_back(OutputProperty(OutputProperties[i], p, w));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The groups of values of the models are the same for the files and the socket.
+
+void FGOutput::GroupColumns(void)
+{
+  if (SubSystems & ssCoefficients)
+    Columns.push_back(OutputGroup(Aerodynamics, &FGAerodynamics::GetCoefficientValues));
+  if (SubSystems & ssFCS)
+    Columns.push_back(OutputGroup(FCS, &FGFCS::GetComponentValues));
+  if (SubSystems & ssGroundReactions)
+    Columns.push_back(OutputGroup(GroundReactions, &FGGroundReactions::GetGroundReactionValues));
+  if (SubSystems & ssPropulsion && Propulsion->GetNumEngines() > 0)
+    Columns.push_back(OutputGroup(Propulsion, &FGPropulsion::GetPropulsionValues));
+  if (SubSystems & ssPerformance)
+    Columns.push_back(OutputGroup(FDMExec, &FGFDMExec::GetPerformanceValues));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The fixed part of a FlightGear packet, in the order SocketDataFill() reads it.
+// The values for the engines, the tanks and the gear units, whose number
+// depends on the aircraft, are filled in directly.
+
+void FGOutput::FlightGearColumns(void)
+{
+  unsigned int i;
+  FGNetFDM* net = &NetPacket[0];
+  const int nfDouble = NetField::nfDouble, nfFloat = NetField::nfFloat,
+            nfInt = NetField::nfInt;
+
+  NetFields.clear();
+  memset(net, 0x00, sizeof(FGNetFDM));
+
+  // Positions
+  NetColumn(offsetof(FGNetFDM, longitude), nfDouble, OutputValue(Propagate, &FGPropagate::GetLongitude));
+  NetColumn(offsetof(FGNetFDM, latitude), nfDouble, OutputValue(Propagate, &FGPropagate::GetLatitude));
+  NetColumn(offsetof(FGNetFDM, altitude), nfDouble, OutputValue(Propagate, &FGPropagate::GetAltitudeASL, 6, 0, 0.3048));
+  NetColumn(offsetof(FGNetFDM, agl), nfFloat, OutputValue(Propagate, &FGPropagate::GetDistanceAGL, 6, 0, 0.3048));
+  NetColumn(offsetof(FGNetFDM, phi), nfFloat, OutputIndexedValue(Propagate, &FGPropagate::GetEuler, 1));
+  NetColumn(offsetof(FGNetFDM, theta), nfFloat, OutputIndexedValue(Propagate, &FGPropagate::GetEuler, 2));
+  NetColumn(offsetof(FGNetFDM, psi), nfFloat, OutputIndexedValue(Propagate, &FGPropagate::GetEuler, 3));
+  NetColumn(offsetof(FGNetFDM, alpha), nfFloat, OutputValue(Auxiliary, &FGAuxiliary::Getalpha));
+  NetColumn(offsetof(FGNetFDM, beta), nfFloat, OutputValue(Auxiliary, &FGAuxiliary::Getbeta));
+
+  // Velocities
+  NetColumn(offsetof(FGNetFDM, phidot), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::GetEulerRates, 1));
+  NetColumn(offsetof(FGNetFDM, thetadot), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::GetEulerRates, 2));
+  NetColumn(offsetof(FGNetFDM, psidot), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::GetEulerRates, 3));
+  NetColumn(offsetof(FGNetFDM, vcas), nfFloat, OutputValue(Auxiliary, &FGAuxiliary::GetVcalibratedFPS));
+  NetColumn(offsetof(FGNetFDM, climb_rate), nfFloat, OutputValue(Propagate, &FGPropagate::Gethdot));
+  NetColumn(offsetof(FGNetFDM, v_north), nfFloat, OutputIndexedValue(Propagate, &FGPropagate::GetVel, 1));
+  //---ADD METHOD TO CALCULATE THESE TERMS---
+  NetAlias(offsetof(FGNetFDM, v_wind_body_north), nfFloat); // relative to airmass
+  NetColumn(offsetof(FGNetFDM, v_east), nfFloat, OutputIndexedValue(Propagate, &FGPropagate::GetVel, 2));
+  NetAlias(offsetof(FGNetFDM, v_wind_body_east), nfFloat);
+  NetColumn(offsetof(FGNetFDM, v_down), nfFloat, OutputIndexedValue(Propagate, &FGPropagate::GetVel, 3));
+  NetAlias(offsetof(FGNetFDM, v_wind_body_down), nfFloat);
+
+  // Accelerations
+  NetColumn(offsetof(FGNetFDM, A_X_pilot), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::GetPilotAccel, 1));
+  NetColumn(offsetof(FGNetFDM, A_Y_pilot), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::GetPilotAccel, 2));
+  NetColumn(offsetof(FGNetFDM, A_Z_pilot), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::GetPilotAccel, 3));
+
+  // Stall (stall_warning stays 0)
+  NetColumn(offsetof(FGNetFDM, slip_deg), nfFloat, OutputIndexedValue(Auxiliary, &FGAuxiliary::Getbeta, inDegrees));
+
+  // Engine status. Only the piston engines fill more than their state; the
+  // fuel pressure and the turbine inlet temperature are not modeled.
+  unsigned int num_engines = Propulsion->GetNumEngines();
+  if (num_engines > FGNetFDM::FG_MAX_ENGINES) num_engines = FGNetFDM::FG_MAX_ENGINES;
+  net->num_engines = htonl(num_engines);
+
+  for (i=0; i<num_engines; i++) {
+    FGEngine* engine = Propulsion->GetEngine(i);
+    NetColumn(offsetof(FGNetFDM, eng_state) + i*sizeof(uint32_t), nfInt, new FGEngineStateColumn(engine));
+
+    if (engine->GetType() == FGEngine::etPiston) {
+      FGPiston* piston = (FGPiston*)engine;
+      size_t f = i*sizeof(float);
+      NetColumn(offsetof(FGNetFDM, rpm) + f, nfFloat, OutputValue(piston, &FGPiston::getRPM));
+      NetColumn(offsetof(FGNetFDM, fuel_flow) + f, nfFloat, OutputValue(engine, &FGEngine::getFuelFlow_gph));
+      NetColumn(offsetof(FGNetFDM, egt) + f, nfFloat, OutputValue(piston, &FGPiston::GetEGT));
+      NetColumn(offsetof(FGNetFDM, cht) + f, nfFloat, OutputValue(piston, &FGPiston::getCylinderHeadTemp_degF));
+      NetColumn(offsetof(FGNetFDM, mp_osi) + f, nfFloat, OutputValue(piston, &FGPiston::getManifoldPressure_inHg));
+      NetColumn(offsetof(FGNetFDM, oil_temp) + f, nfFloat, OutputValue(piston, &FGPiston::getOilTemp_degF));
+      NetColumn(offsetof(FGNetFDM, oil_px) + f, nfFloat, OutputValue(piston, &FGPiston::getOilPressure_psi));
     }
+  }
+
+  // Consumables
+  unsigned int num_tanks = Propulsion->GetNumTanks();
+  if (num_tanks > FGNetFDM::FG_MAX_TANKS) num_tanks = FGNetFDM::FG_MAX_TANKS;
+  net->num_tanks = htonl(num_tanks);
+
+  for (i=0; i<num_tanks; i++)
+    NetColumn(offsetof(FGNetFDM, fuel_quantity) + i*sizeof(float), nfFloat, OutputValue(Propulsion->GetTank(i), &FGTank::GetContents));
+
+  // Gear status. The packet has room for the first gear units only.
+  unsigned int num_wheels = GroundReactions->GetNumGearUnits();
+  if (num_wheels > FGNetFDM::FG_MAX_WHEELS) num_wheels = FGNetFDM::FG_MAX_WHEELS;
+  net->num_wheels = htonl(num_wheels);
+
+  for (i=0; i<num_wheels; i++) {
+    FGLGear* gear = GroundReactions->GetGearUnit(i);
+    size_t f = i*sizeof(float);
+    NetColumn(offsetof(FGNetFDM, wow) + i*sizeof(uint32_t), nfInt, OutputValue(gear, &FGLGear::GetWOW));
+    NetColumn(offsetof(FGNetFDM, gear_pos) + f, nfFloat, OutputValue(gear, &FGLGear::GetGearUnitDown)); // 1 down, FCS convention
+    NetColumn(offsetof(FGNetFDM, gear_steer) + f, nfFloat, OutputValue(gear, &FGLGear::GetSteerNorm));
+    NetColumn(offsetof(FGNetFDM, gear_compression) + f, nfFloat, OutputValue(gear, &FGLGear::GetCompLen));
+  }
+
+  // Environment
+  net->version    = htonl(FG_NET_FDM_VERSION);
+  net->cur_time   = htonl(1234567890);   // Friday, Feb 13, 2009, 23:31:30 UTC (not processed by FGFS anyway)
+  net->warp       = 0;                   // offset in seconds to unix time
+  net->visibility = 25000.0;             // visibility in meters (for env. effects)
+  htonf(net->visibility);
+
+  // Control surface positions (normalized values)
+  NetColumn(offsetof(FGNetFDM, elevator), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDePos, ofNorm));
+  NetColumn(offsetof(FGNetFDM, elevator_trim_tab), nfFloat, OutputValue(FCS, &FGFCS::GetPitchTrimCmd));
+  NetColumn(offsetof(FGNetFDM, left_flap), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDfPos, ofNorm));
+  NetAlias(offsetof(FGNetFDM, right_flap), nfFloat);
+  NetColumn(offsetof(FGNetFDM, left_aileron), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDaLPos, ofNorm));
+  NetColumn(offsetof(FGNetFDM, right_aileron), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDaRPos, ofNorm));
+  NetColumn(offsetof(FGNetFDM, rudder), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDrPos, ofNorm));
+  NetAlias(offsetof(FGNetFDM, nose_wheel), nfFloat); // *** FIX ***  Using Rudder Pos for NWS
+  NetColumn(offsetof(FGNetFDM, speedbrake), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDsbPos, ofNorm));
+  NetColumn(offsetof(FGNetFDM, spoilers), nfFloat, OutputIndexedValue(FCS, &FGFCS::GetDspPos, ofNorm));
+
+  // Both packets hold the fields that never change
+  NetPacket[1] = NetPacket[0];
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Adds a column and the field of the FlightGear packet it fills.
 
-void FGOutput::FlightGearSocketOutput(void)
+void FGOutput::NetColumn(size_t offset, int type, FGOutputColumn* column)
+{
+  NetField field;
+  field.offset = (unsigned int)offset;
+  field.column = (unsigned int)Columns.size();
+  field.type = (NetField::Type)type;
+  Columns.push_back(column);
+  NetFields.push_back(field);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Adds a field of the FlightGear packet filled from the last column added.
+
+void FGOutput::NetAlias(size_t offset, int type)
+{
+  NetField field;
+  field.offset = (unsigned int)offset;
+  field.column = (unsigned int)Columns.size() - 1;
+  field.type = (NetField::Type)type;
+  NetFields.push_back(field);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutput::SocketDataFill(FGNetFDM* net)
 {
-  int length = sizeof(fgSockBuf);
+  char* packet = (char*)net;
+
+  CollectRecord();
+  const double* v = Record.GetValues();
+
+  for (unsigned int i=0; i<NetFields.size(); i++) {
+    const NetField& field = NetFields[i];
+    double value = v[field.column];
+
+    switch (field.type) {
+    case NetField::nfDouble:
+      htond(value);
+      memcpy(packet + field.offset, &value, sizeof(double));
+      break;
+    case NetField::nfFloat:
+      {
+        float f = (float)value;
+        htonf(f);
+        memcpy(packet + field.offset, &f, sizeof(float));
+      }
+      break;
+    case NetField::nfInt:
+      {
+        uint32_t n = htonl((uint32_t)value);
+        memcpy(packet + field.offset, &n, sizeof(uint32_t));
+      }
+      break;
+    }
+  }
+}
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGOutput::FlightGearSocketOutput(void)
+{
   if (flightGearSocket == NULL) return;
   if (!flightGearSocket->GetConnectStatus()) return;
 
-  SocketDataFill(&fgSockBuf);
-  flightGearSocket->Send((char *)&fgSockBuf, length);
+  // The packet is sent at the end of the frame, along with those of the
+  // other outputs; the batch does not copy it. The two packets are filled in
+  // turn, so the one queued is left alone until the batch is sent. An output
+  // run outside of the frames of the executive (a forced output) can come
+  // back to a packet still queued: the batch is then sent first.
+  FGfdmSocketBatch* batch = FDMExec->GetSocketBatch();
+  FGNetFDM* net = &NetPacket[NetPacketIndex];
+  NetPacketIndex ^= 1;
+  if (batch->Holds((const char*)net)) batch->Send();
+  SocketDataFill(net);
+  batch->Add(flightGearSocket, (const char*)net, sizeof(FGNetFDM));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The subscriptions choose their properties and rates: there are no columns.
+
+void FGOutput::TelemetryOutput(void)
+{
+  if (telemetry == NULL) return;
+
+  telemetry->Run(FDMExec->GetSimTime(), 1.0/(FDMExec->GetDeltaT()*rate));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The segment is created with the first record, once the columns are known,
+// and again if their number changes.
+
+void FGOutput::SharedMemoryOutput(void)
+{
+  CollectRecord();
+
+  if (sharedMemory && !sharedMemory->IsOpen()) return;
+
+  if (!sharedMemory || SharedMemoryNames.size() != Record.GetSize()) {
+    delete sharedMemory;
+    sharedMemory = new FGfdmSharedMemory(SegmentName,
+                                         BinaryLogHeader(SharedMemoryNames),
+                                         Record.GetSize());
+  }
+
+  sharedMemory->Publish(Record.GetValues());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The state a visual system needs to draw the aircraft, in the units the
+// models keep it in, followed by the properties of the output.
+
+void FGOutput::SharedMemoryColumns(void)
+{
+  unsigned int i;
+  static const char* quaternion[] = {"Q1", "Q2", "Q3", "Q4"};
+  static const char* euler[] = {"Phi (rad)", "Theta (rad)", "Psi (rad)"};
+  static const char* uvw[] = {"U (ft/s)", "V (ft/s)", "W (ft/s)"};
+  static const char* ned[] = {"V_{North} (ft/s)", "V_{East} (ft/s)", "V_{Down} (ft/s)"};
+  static const char* pqr[] = {"P (rad/s)", "Q (rad/s)", "R (rad/s)"};
+
+  SharedMemoryNames.clear();
+
+  SharedMemoryColumn("Time", OutputValue(FDMExec, &FGFDMExec::GetSimTime));
+  SharedMemoryColumn("Latitude (rad)", OutputValue(Propagate, &FGPropagate::GetLatitude));
+  SharedMemoryColumn("Longitude (rad)", OutputValue(Propagate, &FGPropagate::GetLongitude));
+  SharedMemoryColumn("Altitude ASL (ft)", OutputValue(Propagate, &FGPropagate::GetAltitudeASL));
+  for (i=1; i<=4; i++)
+    SharedMemoryColumn(quaternion[i-1], OutputElement(Propagate, &FGPropagate::GetQuaternion, i));
+  for (i=1; i<=3; i++)
+    SharedMemoryColumn(euler[i-1], OutputIndexedValue(Propagate, &FGPropagate::GetEuler, i));
+  for (i=1; i<=3; i++)
+    SharedMemoryColumn(uvw[i-1], OutputIndexedValue(Propagate, &FGPropagate::GetUVW, i));
+  for (i=1; i<=3; i++)
+    SharedMemoryColumn(ned[i-1], OutputIndexedValue(Propagate, &FGPropagate::GetVel, i));
+  for (i=1; i<=3; i++)
+    SharedMemoryColumn(pqr[i-1], OutputIndexedValue(Propagate, &FGPropagate::GetPQR, i));
+  SharedMemoryColumn("Alpha (rad)", OutputValue(Auxiliary, &FGAuxiliary::Getalpha));
+  SharedMemoryColumn("Beta (rad)", OutputValue(Auxiliary, &FGAuxiliary::Getbeta));
+
+  SharedMemoryColumn("Elevator Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDePos, ofNorm));
+  SharedMemoryColumn("Left Aileron Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDaLPos, ofNorm));
+  SharedMemoryColumn("Right Aileron Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDaRPos, ofNorm));
+  SharedMemoryColumn("Rudder Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDrPos, ofNorm));
+  SharedMemoryColumn("Flap Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDfPos, ofNorm));
+  SharedMemoryColumn("Speedbrake Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDsbPos, ofNorm));
+  SharedMemoryColumn("Spoiler Position (norm)", OutputIndexedValue(FCS, &FGFCS::GetDspPos, ofNorm));
+
+  for (i=0; i<OutputProperties.size(); i++)
+    SharedMemoryColumn(OutputProperties[i]->GetPrintableName(), OutputProperty(OutputProperties[i]));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Adds a column and the name it is published under.
+
+void FGOutput::SharedMemoryColumn(const string& name, FGOutputColumn* column)
+{
+  Columns.push_back(column);
+  SharedMemoryNames.push_back(name);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -812,6 +1215,9 @@ void FGOutput::SocketOutput(void)
     if (SubSystems & ssPropulsion && Propulsion->GetNumEngines() > 0) {
       socket->Append(Propulsion->GetPropulsionStrings(","));
     }
+    if (SubSystems & ssPerformance) {
+      socket->Append(FDMExec->GetPerformanceStrings(","));
+    }
     if (OutputProperties.size() > 0) {
       for (unsigned int i=0;i<OutputProperties.size();i++) {
         socket->Append(OutputProperties[i]->GetPrintableName());
@@ -822,108 +1228,173 @@ void FGOutput::SocketOutput(void)
     socket->Send();
   }
 
-  socket->Clear();
-  socket->Append(FDMExec->GetSimTime());
+  CollectRecord();
+  EmitRecord();
+}
 
-  if (SubSystems & ssAerosurfaces) {
-    socket->Append(FCS->GetDaCmd());
-    socket->Append(FCS->GetDeCmd());
-    socket->Append(FCS->GetDrCmd());
-    socket->Append(FCS->GetDfCmd());
-    socket->Append(FCS->GetDaLPos());
-    socket->Append(FCS->GetDaRPos());
-    socket->Append(FCS->GetDePos());
-    socket->Append(FCS->GetDrPos());
-    socket->Append(FCS->GetDfPos());
-  }
-  if (SubSystems & ssRates) {
-    socket->Append(radtodeg*Propagate->GetPQR(eP));
-    socket->Append(radtodeg*Propagate->GetPQR(eQ));
-    socket->Append(radtodeg*Propagate->GetPQR(eR));
-    socket->Append(radtodeg*Propagate->GetPQRdot(eP));
-    socket->Append(radtodeg*Propagate->GetPQRdot(eQ));
-    socket->Append(radtodeg*Propagate->GetPQRdot(eR));
-  }
-  if (SubSystems & ssVelocities) {
-    socket->Append(Auxiliary->Getqbar());
-    socket->Append(Auxiliary->GetVt());
-    socket->Append(Propagate->GetUVW(eU));
-    socket->Append(Propagate->GetUVW(eV));
-    socket->Append(Propagate->GetUVW(eW));
-    socket->Append(Auxiliary->GetAeroUVW(eU));
-    socket->Append(Auxiliary->GetAeroUVW(eV));
-    socket->Append(Auxiliary->GetAeroUVW(eW));
-    socket->Append(Propagate->GetVel(eNorth));
-    socket->Append(Propagate->GetVel(eEast));
-    socket->Append(Propagate->GetVel(eDown));
-  }
-  if (SubSystems & ssForces) {
-    socket->Append(Aerodynamics->GetvFw()(eDrag));
-    socket->Append(Aerodynamics->GetvFw()(eSide));
-    socket->Append(Aerodynamics->GetvFw()(eLift));
-    socket->Append(Aerodynamics->GetLoD());
-    socket->Append(Aircraft->GetForces(eX));
-    socket->Append(Aircraft->GetForces(eY));
-    socket->Append(Aircraft->GetForces(eZ));
-  }
-  if (SubSystems & ssMoments) {
-    socket->Append(Aircraft->GetMoments(eL));
-    socket->Append(Aircraft->GetMoments(eM));
-    socket->Append(Aircraft->GetMoments(eN));
-  }
-  if (SubSystems & ssAtmosphere) {
-    socket->Append(Atmosphere->GetDensity());
-    socket->Append(Atmosphere->GetPressureSL());
-    socket->Append(Atmosphere->GetPressure());
-    socket->Append(Atmosphere->GetTurbMagnitude());
-    socket->Append(Atmosphere->GetTurbDirection().Dump(","));
-    socket->Append(Atmosphere->GetTotalWindNED().Dump(","));
-  }
-  if (SubSystems & ssMassProps) {
-    socket->Append(MassBalance->GetJ()(1,1));
-    socket->Append(MassBalance->GetJ()(1,2));
-    socket->Append(MassBalance->GetJ()(1,3));
-    socket->Append(MassBalance->GetJ()(2,1));
-    socket->Append(MassBalance->GetJ()(2,2));
-    socket->Append(MassBalance->GetJ()(2,3));
-    socket->Append(MassBalance->GetJ()(3,1));
-    socket->Append(MassBalance->GetJ()(3,2));
-    socket->Append(MassBalance->GetJ()(3,3));
-    socket->Append(MassBalance->GetMass());
-    socket->Append(MassBalance->GetXYZcg()(eX));
-    socket->Append(MassBalance->GetXYZcg()(eY));
-    socket->Append(MassBalance->GetXYZcg()(eZ));
-  }
-  if (SubSystems & ssPropagate) {
-    socket->Append(Propagate->GetAltitudeASL());
-    socket->Append(radtodeg*Propagate->GetEuler(ePhi));
-    socket->Append(radtodeg*Propagate->GetEuler(eTht));
-    socket->Append(radtodeg*Propagate->GetEuler(ePsi));
-    socket->Append(Auxiliary->Getalpha(inDegrees));
-    socket->Append(Auxiliary->Getbeta(inDegrees));
-    socket->Append(Propagate->GetLocation().GetLatitudeDeg());
-    socket->Append(Propagate->GetLocation().GetLongitudeDeg());
-  }
-  if (SubSystems & ssCoefficients) {
-    scratch = Aerodynamics->GetCoefficientValues(",");
-    if (scratch.length() != 0) socket->Append(scratch);
-  }
-  if (SubSystems & ssFCS) {
-    scratch = FCS->GetComponentValues(",");
-    if (scratch.length() != 0) socket->Append(scratch);
-  }
-  if (SubSystems & ssGroundReactions) {
-    socket->Append(GroundReactions->GetGroundReactionValues(","));
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Without a queue, the record is written right away, as it has always been.
+// With a queue, it is copied in the queue for the writer thread; the thread is
+// started with the first record, once the header has been written, and again
+// whenever the size of the records changes.
+
+void FGOutput::EmitRecord(void)
+{
+  if (QueueSize == 0) {
+    WriteRecord(Record.GetValues(), Record.GetFormats(), Record.GetSize());
+    FlushRecords();
+    return;
   }
-  if (SubSystems & ssPropulsion && Propulsion->GetNumEngines() > 0) {
-    socket->Append(Propulsion->GetPropulsionValues(","));
+
+  if (Queue && Queue->GetWidth() != Record.GetSize()) StopWriter();
+  if (!Queue) StartWriter();
+
+  Queue->Push(Record.GetValues(), !DropOnOverflow);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutput::WriteRecord(const double* values, const FGOutputRecord::Format* formats,
+                           unsigned int size)
+{
+  Line.clear();
+
+  if (Type == otBinary) {
+    if (isLittleEndian) {
+      WriteData((const char*)values, size*sizeof(double), values[0]);
+    } else {
+      for (unsigned int i=0; i<size; i++) {
+        const char* bytes = (const char*)&values[i];
+        for (int j=sizeof(double)-1; j>=0; j--) Line += bytes[j];
+      }
+      WriteData(Line.data(), Line.size(), values[0]);
+    }
+  } else if (Type == otSocket) {
+    FGOutputRecord::Print(values, formats, size, ",", Line);
+    Line += '\n';
+    socket->Send(Line.c_str(), (int)Line.size());
+  } else {
+    FGOutputRecord::Print(values, formats, size, delimeter, Line);
+    Line += '\n';
+    WriteData(Line.c_str(), Line.size(), values[0]);
   }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The first value of a record is its time, which the segments of a file are
+// rotated on.
+
+void FGOutput::WriteData(const char* data, size_t size, double time)
+{
+  if (DataStream) DataStream->write(data, size);
+  else DataFile.Write(data, size, time);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-  for (unsigned int i=0;i<OutputProperties.size();i++) {
-    socket->Append(OutputProperties[i]->getDoubleValue());
+void FGOutput::FlushRecords(void)
+{
+  if (Type == otSocket) return;
+
+  if (DataStream) DataStream->flush();
+  else DataFile.Flush();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The writer thread. The file is flushed whenever the thread has caught up
+// with the simulation, before the last record is released so that
+// FGOutputQueue::Drain() returns once everything is written.
+
+void FGOutput::WriteRecords(void)
+{
+  const FGOutputRecord::Format* formats = &QueueFormats[0];
+
+  for (;;) {
+    bool closed = Queue->IsClosed();
+    const double* values = Queue->Front();
+
+    if (values) {
+      WriteRecord(values, formats, Queue->GetWidth());
+      if (Queue->GetPending() == 1) FlushRecords();
+      Queue->Pop();
+    } else if (closed) {
+      break;
+    } else {
+      FGOutputQueue::Sleep(1000);
+    }
   }
+}
 
-  socket->Send();
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutput::StartWriter(void)
+{
+  QueueFormats.assign(Record.GetFormats(), Record.GetFormats() + Record.GetSize());
+  Queue = new FGOutputQueue(Record.GetSize(), QueueSize);
+  Writer = new WriterThread;
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  Writer->Handle = CreateThread(0, 0, WriterThread::Entry, this, 0, 0);
+#else
+  pthread_create(&Writer->Handle, 0, WriterThread::Entry, this);
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Closing the queue lets the writer thread write the records left before it
+// returns.
+
+void FGOutput::StopWriter(void)
+{
+  if (!Queue) return;
+
+  Queue->Close();
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  WaitForSingleObject(Writer->Handle, INFINITE);
+  CloseHandle(Writer->Handle);
+#else
+  pthread_join(Writer->Handle, 0);
+#endif
+
+  DroppedRecords += Queue->GetDropped();
+  BackpressuredRecords += Queue->GetBackpressured();
+
+  delete Writer;
+  delete Queue;
+  Writer = 0;
+  Queue = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutput::GetQueuedRecords(void) const
+{
+  return Queue ? (double)Queue->GetPending() : 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutput::GetDroppedRecords(void) const
+{
+  return (double)(DroppedRecords + (Queue ? Queue->GetDropped() : 0));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutput::GetBackpressuredRecords(void) const
+{
+  return (double)(BackpressuredRecords + (Queue ? Queue->GetBackpressured() : 0));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutput::BindExecStats(const string& base)
+{
+  FGModel::BindExecStats(base);
+
+  PropertyManager->Tie(base + "/queued-records", this, &FGOutput::GetQueuedRecords);
+  PropertyManager->Tie(base + "/dropped-records", this, &FGOutput::GetDroppedRecords);
+  PropertyManager->Tie(base + "/backpressured-records", this, &FGOutput::GetBackpressuredRecords);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -933,6 +1404,7 @@ void FGOutput::SocketStatusOutput(const string& out_str)
   string asciiData;
 
   if (socket == NULL) return;
+  if (Queue) Queue->Drain(); // The writer thread sends on the same socket
 
   socket->Clear();
   asciiData = string("<STATUS>") + out_str;
@@ -980,6 +1452,12 @@ bool FGOutput::Load(Element* element)
        flightGearSocket = new FGfdmSocket(name, port, FGfdmSocket::ptUDP);  // create udp socket
     else
        flightGearSocket = new FGfdmSocket(name, port, FGfdmSocket::ptTCP);  // create tcp socket (default)
+  } else if (!document->GetAttributeValue("port").empty() && type == string("TELEMETRY")) {
+    port = atoi(document->GetAttributeValue("port").c_str());
+    telemetry = new FGfdmTelemetry(PropertyManager, document->GetAttributeValue("name"), port);
+  } else if (type == string("SHARED_MEMORY")) {
+    SegmentName = document->GetAttributeValue("name");
+    if (SegmentName.empty()) SegmentName = "jsbsim";
   } else {
     BaseFilename = Filename = name;
   }
@@ -988,6 +1466,31 @@ bool FGOutput::Load(Element* element)
   } else {
     OutRate = 1;
   }
+  if (!document->GetAttributeValue("queue").empty()) {
+    if (Type == otCSV || Type == otTab || Type == otBinary || Type == otSocket) {
+      int records = (int)document->GetAttributeValueAsNumber("queue");
+      QueueSize = records > 0 ? records : 0;
+    } else {
+      cerr << "The queue attribute is ignored for this type of output" << endl;
+    }
+  }
+  DropOnOverflow = document->GetAttributeValue("overflow") == "drop";
+  if (!document->GetAttributeValue("rotate_mb").empty()
+      || !document->GetAttributeValue("rotate_sec").empty()
+      || !document->GetAttributeValue("compression").empty()) {
+    if (Type == otCSV || Type == otTab || Type == otBinary) {
+      double mb = 0.0, sec = 0.0;
+      if (!document->GetAttributeValue("rotate_mb").empty())
+        mb = document->GetAttributeValueAsNumber("rotate_mb");
+      if (!document->GetAttributeValue("rotate_sec").empty())
+        sec = document->GetAttributeValueAsNumber("rotate_sec");
+      DataFile.SetRotation(mb > 0.0 ? (unsigned long)(mb*1048576.0) : 0,
+                           sec > 0.0 ? sec : 0.0);
+      DataFile.SetCompression(document->GetAttributeValue("compression"));
+    } else {
+      cerr << "The rotation and compression attributes are ignored for this type of output" << endl;
+    }
+  }
 
   if (document->FindElementValue("simulation") == string("ON"))
     SubSystems += ssSimulation;
@@ -1015,6 +1518,8 @@ bool FGOutput::Load(Element* element)
     SubSystems += ssFCS;
   if (document->FindElementValue("propulsion") == string("ON"))
     SubSystems += ssPropulsion;
+  if (document->FindElementValue("performance") == string("ON"))
+    SubSystems += ssPerformance;
   property_element = document->FindElement("property");
   while (property_element) {
     string property_str = property_element->GetDataLine();
@@ -1030,7 +1535,8 @@ bool FGOutput::Load(Element* element)
     property_element = document->FindNextElement("property");
   }
 
-  SetRate(OutRate);
+  SetRateHz(OutRate);
+  CompileColumns();
 
   Debug(2);
 
@@ -1039,14 +1545,14 @@ bool FGOutput::Load(Element* element)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGOutput::SetRate(int rtHz)
+void FGOutput::SetRateHz(int rtHz)
 {
   rtHz = rtHz>1000?1000:(rtHz<0?0:rtHz);
   if (rtHz > 0) {
-    rate = (int)(0.5 + 1.0/(FDMExec->GetDeltaT()*rtHz));
+    SetRate((int)(0.5 + 1.0/(FDMExec->GetDeltaT()*rtHz)));
     Enable();
   } else {
-    rate = 1;
+    SetRate(1);
     Disable();
   }
 }
@@ -1095,11 +1601,25 @@ void FGOutput::Debug(int from)
       case otCSV:
         cout << scratch << " in CSV format output at rate " << 1/(FDMExec->GetDeltaT()*rate) << " Hz" << endl;
         break;
+      case otBinary:
+        cout << scratch << " in binary format output at rate " << 1/(FDMExec->GetDeltaT()*rate) << " Hz" << endl;
+        break;
+      case otTelemetry:
+        cout << "    Telemetry served to subscribers at up to " << 1/(FDMExec->GetDeltaT()*rate) << " Hz" << endl;
+        break;
+      case otSharedMemory:
+        cout << "    State published in shared memory segment " << SegmentName
+             << " at rate " << 1/(FDMExec->GetDeltaT()*rate) << " Hz" << endl;
+        break;
       case otNone:
       default:
         cout << "  No log output" << endl;
         break;
       }
+      if (QueueSize > 0) {
+        cout << "    Written by a separate thread through a queue of " << QueueSize
+             << " records" << (DropOnOverflow ? " (dropped on overflow)" : "") << endl;
+      }
 
       if (SubSystems & ssSimulation)      cout << "    Simulation parameters logged" << endl;
       if (SubSystems & ssAerosurfaces)    cout << "    Aerosurface parameters logged" << endl;
@@ -1114,6 +1634,7 @@ void FGOutput::Debug(int from)
       if (SubSystems & ssGroundReactions) cout << "    Ground parameters logged" << endl;
       if (SubSystems & ssFCS)             cout << "    FCS parameters logged" << endl;
       if (SubSystems & ssPropulsion)      cout << "    Propulsion parameters logged" << endl;
+      if (SubSystems & ssPerformance)     cout << "    Performance statistics logged" << endl;
       if (OutputProperties.size() > 0)    cout << "    Properties logged:" << endl;
       for (unsigned int i=0;i<OutputProperties.size();i++) {
         cout << "      - " << OutputProperties[i]->GetName() << endl;
@@ -44,6 +44,9 @@ INCLUDES
 #include <fstream>
 
 #include "input_output/FGXMLFileRead.h"
+#include "input_output/FGOutputRecord.h"
+#include "input_output/FGOutputColumn.h"
+#include "input_output/FGOutputFile.h"
 #include "input_output/net_fdm.hxx"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -59,6 +62,9 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGfdmSocket;
+class FGfdmTelemetry;
+class FGfdmSharedMemory;
+class FGOutputQueue;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -82,7 +88,27 @@ CLASS DOCUMENTATION
       FLIGHTGEAR  A socket is created for sending binary data packets to
                   an external instance of FlightGear for visuals.  Parameters
                   defining the socket are given on the \<output> line.
+      TELEMETRY   Streams over UDP the properties that the clients subscribe
+                  to, each at the rate it chooses, sending only the values
+                  that changed by more than a deadband, with periodic
+                  keyframes (see FGfdmTelemetry). The port to subscribe to is
+                  given on the \<output> line, and the interface it listens
+                  on by NAME: the loopback one if there is none, 0.0.0.0 for
+                  all of them. The rate of the output is the highest rate the
+                  subscriptions are served at.
+      SHARED_MEMORY  Publishes the state of the aircraft in a shared memory
+                  segment named NAME, for the programs running on the same
+                  machine (see FGfdmSharedMemory): the time, the latitude and
+                  longitude (rad), the altitude ASL (ft), the attitude
+                  quaternion, the Euler angles (rad), the body velocities
+                  (ft/s), the NED velocities (ft/s), the body rates (rad/s),
+                  alpha and beta (rad), the normalized positions of the
+                  control surfaces and the properties listed. The subsystem
+                  flags are ignored.
       TABULAR     Columnar data.
+      BINARY      The columns of a CSV file, stored as binary values. The file
+                  begins with a header, followed by the records, each made of
+                  one little endian double per column (see below).
       TERMINAL    Output to terminal. NOT IMPLEMENTED YET!
       NONE        Specifies to do nothing. This setting makes it easy to turn on and
                   off the data output without having to mess with anything else.
@@ -92,12 +118,31 @@ CLASS DOCUMENTATION
 @code
 	<output name="localhost" type="FLIGHTGEAR" port="5500" protocol="tcp" rate="10"/>
 @endcode
+@code
+	<output type="TELEMETRY" port="5700" rate="60"/>
+@endcode
+@code
+	<output name="jsbsim-state" type="SHARED_MEMORY" rate="60">
+	   <property> propulsion/engine/thrust-lbs </property>
+	</output>
+@endcode
 @code
 	<output name="B737_datalog.csv" type="CSV" rate="20">
 	   <property> velocities/vc-kts </property>
 	   <velocities> ON </velocities>
 	</output>
 @endcode
+@code
+	<output name="B737_datalog.csv" type="CSV" rate="120" queue="4096" overflow="drop">
+	   <position> ON </position>
+	</output>
+@endcode
+@code
+	<output name="soak.bin" type="BINARY" rate="50" queue="4096"
+	        rotate_mb="512" rotate_sec="3600" compression="zstd">
+	   <position> ON </position>
+	</output>
+@endcode
 <br>
 <pre>
     The arguments that can be supplied, currently, are:
@@ -106,6 +151,31 @@ CLASS DOCUMENTATION
                 value may not be *exactly* what you want, due to the dependence
                 on dt, the cycle rate for the FDM.
 
+    QUEUE       The number of records that can be waiting to be written (CSV,
+                TABULAR and SOCKET outputs only). When it is given, the values
+                are copied in a queue and a thread of their own formats and
+                writes them, so that the file or the socket does not slow down
+                the simulation. The text is the same as without a queue.
+
+    OVERFLOW    What happens to a record when the queue is full: "block" (the
+                default) waits for the writer thread to catch up, "drop" throws
+                the record away. Both are counted under
+                simulation/perf/output[...]/backpressured-records and
+                dropped-records; queued-records gives the records waiting.
+
+    ROTATE_MB   The size, in megabytes on the disk, at which a file (CSV,
+                TABULAR and BINARY outputs only) is closed and the next one
+                started. The files are numbered: log.csv is written as
+                log.0000.csv, log.0001.csv... and each one begins with the
+                header, so that it can be read on its own.
+
+    ROTATE_SEC  The same, after a number of seconds of simulation time.
+
+    COMPRESSION "gzip" or "zstd" compresses the file as it is written (by the
+                writer thread, with a queue), adding .gz or .zst to its name;
+                "none" is the default. If JSBSim was built without the
+                library, the file is not compressed.
+
     The following parameters tell which subsystems of data to output:
 
     simulation       ON|OFF
@@ -121,8 +191,31 @@ CLASS DOCUMENTATION
     ground_reactions ON|OFF
     fcs              ON|OFF
     propulsion       ON|OFF
+    performance      ON|OFF
 </pre>
     NOTE that Time is always output with the data.
+
+    The subsystems and the properties are resolved in a list of columns when
+    the output is loaded (see FGOutputColumn); each record is then collected in
+    a single pass over the list, for every type of output.
+
+    A BINARY file begins with a header of the following layout, where the
+    integers are unsigned, 32 bits wide and little endian:
+<pre>
+    magic       8 characters, "JSBSBLOG"
+    version     1
+    columns     the number of columns
+    size        the size of the header in bytes, a multiple of 8
+    reserved    0
+    names       for each column, its name and its unit (possibly empty),
+                each terminated by a null character
+    padding     null characters up to the size of the header
+</pre>
+    The names are those of the header of a CSV file. The unit is taken from
+    the parentheses that end the name of a column, or from the suffix of the
+    name of a property (velocities/vc-kts is in kts).
+    The records follow the header, up to the end of the file. The utilities
+    binlog2csv and prep_plot read these files.
     @version $Id: FGOutput.h,v 1.17 2009/10/24 22:59:30 jberndt Exp $
  */
 
@@ -140,22 +233,38 @@ public:
   bool Run(void);
 
   void DelimitedOutput(const std::string&);
+  void BinaryOutput(const std::string&);
   void SocketOutput(void);
   void FlightGearSocketOutput(void);
+  void TelemetryOutput(void);
+  void SharedMemoryOutput(void);
   void SocketStatusOutput(const std::string&);
+  /** Fills the fields of a FlightGear packet that change from frame to frame,
+      in network byte order. The others (the version, the numbers of engines,
+      tanks and wheels...) never change: they are written once, when the
+      columns of an output of type FLIGHTGEAR are compiled, in the packets of
+      the output, which are the ones to pass here. */
   void SocketDataFill(FGNetFDM* net);
 
 
   void SetType(const std::string& type);
   void SetStartNewFile(bool tt) {StartNewFile = tt;}
-  void SetSubsystems(int tt) {SubSystems = tt;}
+  void SetSubsystems(int tt) {SubSystems = tt; ColumnsValid = false;}
   void Enable(void) { enabled = true; }
   void Disable(void) { enabled = false; }
   bool Toggle(void) {enabled = !enabled; return enabled;}
+  bool IsEnabled(void) const {return enabled;}
   bool Load(Element* el);
   void SetOutputFileName(const std::string& fname) {Filename = fname;}
   void SetDirectivesFile(const std::string& fname) {DirectivesFile = fname;}
-  void SetRate(int rt);
+  /** Sets the output rate in Hz (0 disables the output). The rate of the
+      model, in frames, is derived from it and from the time step.
+      @param rt the output rate in Hz */
+  void SetRateHz(int rt);
+  /** Ties the execution time statistics and, for an output with a queue, the
+      statistics of the queue to properties.
+      @param base the path under which the properties are created */
+  void BindExecStats(const std::string& base);
   string GetOutputFileName(void) const {return Filename;}
 
   /// Subsystem types for specifying which will be output in the FDM data logging
@@ -172,23 +281,76 @@ public:
     /** Subsystem: Propagate (= 512)         */ ssPropagate       = 512,
     /** Subsystem: Ground Reactions (= 1024) */ ssGroundReactions = 1024,
     /** Subsystem: FCS (= 2048)              */ ssFCS             = 2048,
-    /** Subsystem: Propulsion (= 4096)       */ ssPropulsion      = 4096
+    /** Subsystem: Propulsion (= 4096)       */ ssPropulsion      = 4096,
+    /** Subsystem: Performance (= 8192)      */ ssPerformance     = 8192
   } subsystems;
 
-
-  FGNetFDM fgSockBuf;
-
 private:
-  enum {otNone, otCSV, otTab, otSocket, otTerminal, otFlightGear, otUnknown} Type;
+  enum {otNone, otCSV, otTab, otBinary, otSocket, otTerminal, otFlightGear, otTelemetry,
+        otSharedMemory, otUnknown} Type;
   bool sFirstPass, dFirstPass, enabled;
   int SubSystems;
   int runID_postfix;
   bool StartNewFile;
   std::string output_file_name, delimeter, BaseFilename, Filename, DirectivesFile;
-  std::ofstream datafile;
+  FGOutputFile DataFile;
   FGfdmSocket* socket;
   FGfdmSocket* flightGearSocket;
+  FGfdmTelemetry* telemetry;
+  FGfdmSharedMemory* sharedMemory;
+  std::string SegmentName;
+  std::vector <std::string> SharedMemoryNames;
   std::vector <FGPropertyManager*> OutputProperties;
+  std::vector <FGOutputColumn*> Columns;
+  bool ColumnsValid;
+
+  // A field of the FlightGear packet that is filled from a column
+  struct NetField {
+    unsigned int offset;   // In the packet
+    unsigned int column;   // In the record
+    enum Type {nfDouble, nfFloat, nfInt} type;
+  };
+  std::vector <NetField> NetFields;
+  FGNetFDM NetPacket[2];          // Filled in turn, see FlightGearSocketOutput()
+  unsigned int NetPacketIndex;
+
+  struct WriterThread;
+
+  FGOutputRecord Record;
+  std::vector <FGOutputRecord::Format> QueueFormats;
+  std::string Line;
+  std::ostream* DataStream;
+  FGOutputQueue* Queue;
+  WriterThread* Writer;
+  unsigned int QueueSize;
+  bool DropOnOverflow;
+  unsigned long DroppedRecords, BackpressuredRecords;
+
+  void DelimitedHeader(std::ostream& outstream);
+  std::string BinaryHeader(void);
+  void StartDataFile(const std::string& fname, const std::string& header);
+  void WriteData(const char* data, size_t size, double time);
+  void CompileColumns(void);
+  void ClearColumns(void);
+  void DelimitedColumns(void);
+  void SocketColumns(void);
+  void FlightGearColumns(void);
+  void NetColumn(size_t offset, int type, FGOutputColumn* column);
+  void NetAlias(size_t offset, int type);
+  void SharedMemoryColumns(void);
+  void SharedMemoryColumn(const std::string& name, FGOutputColumn* column);
+  void GroupColumns(void);
+  void CollectRecord(void);
+  void EmitRecord(void);
+  void WriteRecord(const double* values, const FGOutputRecord::Format* formats,
+                   unsigned int size);
+  void FlushRecords(void);
+  void WriteRecords(void);
+  void StartWriter(void);
+  void StopWriter(void);
+  double GetQueuedRecords(void) const;
+  double GetDroppedRecords(void) const;
+  double GetBackpressuredRecords(void) const;
 
   void Debug(int from);
 };
@@ -56,6 +56,7 @@ INCLUDES
 
 #include <cmath>
 #include <cstdlib>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -93,11 +94,16 @@ FGPropagate::FGPropagate(FGFDMExec* fdmex) : FGModel(fdmex)
   integrator_translational_rate = eTrapezoidal;
   integrator_rotational_position = eAdamsBashforth2;
   integrator_translational_position = eTrapezoidal;
+  integration_method = imMultistep;
 
-  VState.dqPQRdot.resize(4, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqUVWidot.resize(4, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqInertialVelocity.resize(4, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqQtrndot.resize(4, FGQuaternion(0.0,0.0,0.0));
+  RKTolerance = 1e-9;
+  RKStepSize = 0.0;
+  RKSteps = 0;
+
+  VState.dqPQRdot.Fill(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqUVWidot.Fill(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqInertialVelocity.Fill(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqQtrndot.Fill(FGQuaternion(0.0,0.0,0.0));
 
   bind();
   Debug(0);
@@ -128,15 +134,12 @@ bool FGPropagate::InitModel(void)
   vUVWdot.InitMatrix();
   vInertialVelocity.InitMatrix();
 
-  VState.dqPQRdot.resize(4, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqUVWidot.resize(4, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqInertialVelocity.resize(4, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqQtrndot.resize(4, FGColumnVector3(0.0,0.0,0.0));
-
   integrator_rotational_rate = eAdamsBashforth2;
   integrator_translational_rate = eTrapezoidal;
   integrator_rotational_position = eAdamsBashforth2;
   integrator_translational_position = eTrapezoidal;
+  integration_method = imMultistep;
+  RKStepSize = 0.0;
 
   return true;
 }
@@ -155,6 +158,17 @@ void FGPropagate::SetInitialState(const FGInitialCondition *FGIC)
                                 FGIC->GetLatitudeRadIC(),
                                 FGIC->GetAltitudeASLFtIC() + FGIC->GetSeaLevelRadiusFtIC() );
 
+  // A ground that knows its sea level (a terrain model) places the altitude
+  // above sea level of the initial conditions. The geodetic latitude, hence
+  // the sea level, depends on the radius: a second pass settles it.
+  double radius;
+  for (int pass=0; pass<2; pass++) {
+    if (!FDMExec->GetGroundCallback()->GetSeaLevelRadius(VState.vLocation, radius))
+      break;
+    SeaLevelRadius = radius;
+    VState.vLocation.SetRadius(FGIC->GetAltitudeASLFtIC() + SeaLevelRadius);
+  }
+
   VState.vLocation.SetEarthPositionAngle(Inertial->GetEarthPositionAngle());
 
   Ti2ec = GetTi2ec();         // ECI to ECEF transform
@@ -245,11 +259,33 @@ bool FGPropagate::Run(void)
   CalculateQuatdot();          // Angular orientation derivative
   CalculateUVW();              // Translational position derivative (velocities are integrated in the inertial frame)
 
-  // Propagate rotational / translational velocity, angular /translational position, respectively.
-  Integrate(VState.vPQRi,             vPQRdot,           VState.dqPQRdot,           dt, integrator_rotational_rate);
-  Integrate(VState.vInertialVelocity, vUVWidot,          VState.dqUVWidot,          dt, integrator_translational_rate);
-  Integrate(VState.qAttitudeECI,      vQtrndot,          VState.dqQtrndot,          dt, integrator_rotational_position);
-  Integrate(VState.vInertialPosition, VState.vInertialVelocity, VState.dqInertialVelocity, dt, integrator_translational_position);
+  if (integration_method == imMultistep) {
+    // Propagate rotational / translational velocity, angular /translational position, respectively.
+    Integrate(VState.vPQRi,             vPQRdot,           VState.dqPQRdot,           dt, integrator_rotational_rate);
+    Integrate(VState.vInertialVelocity, vUVWidot,          VState.dqUVWidot,          dt, integrator_translational_rate);
+    Integrate(VState.qAttitudeECI,      vQtrndot,          VState.dqQtrndot,          dt, integrator_rotational_position);
+    Integrate(VState.vInertialPosition, VState.vInertialVelocity, VState.dqInertialVelocity, dt, integrator_translational_position);
+  } else {
+    // Keep the past values up to date, should the multistep integrators be
+    // selected again.
+    VState.dqPQRdot.Push(vPQRdot);
+    VState.dqUVWidot.Push(vUVWidot);
+    VState.dqQtrndot.Push(vQtrndot);
+    VState.dqInertialVelocity.Push(VState.vInertialVelocity);
+
+    // The accelerations that do not depend on the integrated state are held
+    // over the time step: the forces (friction included) as seen from the
+    // body and the moments.
+    const FGMatrix33& J = MassBalance->GetJ();
+    const FGMatrix33& Jinv = MassBalance->GetJinv();
+    vBodySpecificForce = Ti2b * vUVWidot - vGravAccel;
+    vPQRdotExternal = vPQRdot + Jinv*(VState.vPQRi*(J*VState.vPQRi));
+
+    if (dt > 0.0) {
+      if (integration_method == imRungeKutta4) IntegrateRK4(dt);
+      else IntegrateRK45(dt);
+    }
+  }
 
   // CAUTION : the order of the operations below is very important to get transformation
   // matrices that are consistent with the new state of the vehicle
@@ -400,12 +436,11 @@ void FGPropagate::CalculateUVW(void)
 
 void FGPropagate::Integrate( FGColumnVector3& Integrand,
                              FGColumnVector3& Val,
-                             deque <FGColumnVector3>& ValDot,
+                             FGStateHistory <FGColumnVector3, 4>& ValDot,
                              double dt,
                              eIntegrateType integration_type)
 {
-  ValDot.push_front(Val);
-  ValDot.pop_back();
+  ValDot.Push(Val);
 
   switch(integration_type) {
   case eRectEuler:       Integrand += dt*ValDot[0];
@@ -427,12 +462,11 @@ void FGPropagate::Integrate( FGColumnVector3& Integrand,
 
 void FGPropagate::Integrate( FGQuaternion& Integrand,
                              FGQuaternion& Val,
-                             deque <FGQuaternion>& ValDot,
+                             FGStateHistory <FGQuaternion, 4>& ValDot,
                              double dt,
                              eIntegrateType integration_type)
 {
-  ValDot.push_front(Val);
-  ValDot.pop_back();
+  ValDot.Push(Val);
 
   switch(integration_type) {
   case eRectEuler:       Integrand += dt*ValDot[0];
@@ -450,6 +484,200 @@ void FGPropagate::Integrate( FGQuaternion& Integrand,
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Gravitational acceleration at an inertial position, expressed in the inertial
+// frame, for the given Earth position angle.
+
+FGColumnVector3 FGPropagate::GetInertialGravity(const FGColumnVector3& position,
+                                                double epa)
+{
+  double r = position.Magnitude();
+
+  switch (gravType) {
+  case gtWGS84:
+    {
+      FGLocation location(VState.vLocation);
+      location.SetEarthPositionAngle(epa);
+      const FGMatrix33& Ti2ec_epa = location.GetTi2ec();
+      return location.GetTec2i() * Inertial->GetGravityJ2(Ti2ec_epa * position);
+    }
+  case gtStandard:
+  default:
+    // The local vertical points toward the center of the Earth.
+    return (-Inertial->GetGAccel(r)/r) * position;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Computes the derivative of the state integrated by the Runge-Kutta methods,
+// using the body specific force and the external angular acceleration that are
+// held over the time step.
+
+void FGPropagate::CalculateRKDerivative(const RKState& state, double epa, RKState& deriv)
+{
+  const FGMatrix33& J = MassBalance->GetJ();
+  const FGMatrix33& Jinv = MassBalance->GetJinv();
+  FGQuaternion attitude = state.qAttitudeECI;
+
+  deriv.vInertialPosition = state.vInertialVelocity;
+  deriv.vInertialVelocity = attitude.GetTInv() * vBodySpecificForce
+                          + GetInertialGravity(state.vInertialPosition, epa);
+  deriv.qAttitudeECI = attitude.GetQDot(state.vPQRi);
+  deriv.vPQRi = vPQRdotExternal - Jinv*(state.vPQRi*(J*state.vPQRi));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Sets out = y + h*(c[0]*k[0] + ... + c[n-1]*k[n-1])
+
+void FGPropagate::RKCombine(RKState& out, const RKState& y, double h,
+                            const double* c, const RKState* k, int n)
+{
+  out = y;
+  for (int i=0; i<n; i++) {
+    if (c[i] == 0.0) continue;
+    double hc = h*c[i];
+    out.vInertialPosition += hc*k[i].vInertialPosition;
+    out.vInertialVelocity += hc*k[i].vInertialVelocity;
+    out.qAttitudeECI += hc*k[i].qAttitudeECI;
+    out.vPQRi += hc*k[i].vPQRi;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Classical fourth order Runge-Kutta method, over one time step.
+
+void FGPropagate::IntegrateRK4(double dt)
+{
+  // The Earth position angle at the end of the time step (FGInertial is run
+  // before FGPropagate) and at its beginning.
+  double epa1 = Inertial->GetEarthPositionAngle();
+  double epa0 = epa1 - Inertial->omega()*dt;
+
+  static const double c1[] = {0.5};
+  static const double c2[] = {0.0, 0.5};
+  static const double c3[] = {0.0, 0.0, 1.0};
+  static const double c4[] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
+
+  RKState y, tmp, k[4];
+  y.vInertialPosition = VState.vInertialPosition;
+  y.vInertialVelocity = VState.vInertialVelocity;
+  y.qAttitudeECI = VState.qAttitudeECI;
+  y.vPQRi = VState.vPQRi;
+
+  CalculateRKDerivative(y, epa0, k[0]);
+  RKCombine(tmp, y, dt, c1, k, 1);
+  CalculateRKDerivative(tmp, 0.5*(epa0+epa1), k[1]);
+  RKCombine(tmp, y, dt, c2, k, 2);
+  CalculateRKDerivative(tmp, 0.5*(epa0+epa1), k[2]);
+  RKCombine(tmp, y, dt, c3, k, 3);
+  CalculateRKDerivative(tmp, epa1, k[3]);
+  RKCombine(tmp, y, dt, c4, k, 4);
+
+  VState.vInertialPosition = tmp.vInertialPosition;
+  VState.vInertialVelocity = tmp.vInertialVelocity;
+  VState.qAttitudeECI = tmp.qAttitudeECI;
+  VState.vPQRi = tmp.vPQRi;
+  RKSteps = 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Dormand-Prince 4(5) embedded Runge-Kutta method. The time step is covered by
+// as many sub-steps as are needed to keep the estimated local error of each
+// below the tolerance; the size of the last sub-step is used as the first
+// guess for the next time step.
+// Reference: Hairer, Norsett and Wanner, "Solving Ordinary Differential
+//            Equations I", Second edition (1993), section II.5
+
+// Scaled error of a component of the state: the error is measured relative
+// to the magnitude of the component, or absolutely when it is less than 1.
+static inline double RKError(double err, double y0, double y1, double tol)
+{
+  double scale = tol*(1.0 + std::max(fabs(y0), fabs(y1)));
+  return fabs(err)/scale;
+}
+
+void FGPropagate::IntegrateRK45(double dt)
+{
+  static const double c[] = {0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0};
+  static const double a1[] = {1.0/5.0};
+  static const double a2[] = {3.0/40.0, 9.0/40.0};
+  static const double a3[] = {44.0/45.0, -56.0/15.0, 32.0/9.0};
+  static const double a4[] = {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0};
+  static const double a5[] = {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0};
+  static const double a6[] = {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0};
+  static const double* a[] = {0, a1, a2, a3, a4, a5, a6};
+  // Difference between the 5th order solution (a6) and the embedded 4th order one.
+  static const double e[] = {71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0,
+                             -17253.0/339200.0, 22.0/525.0, -1.0/40.0};
+
+  double omega = Inertial->omega();
+  double epa1 = Inertial->GetEarthPositionAngle();
+  double epa0 = epa1 - omega*dt;
+
+  RKState y, ynew, err, zero, k[7];
+  zero.qAttitudeECI -= zero.qAttitudeECI; // FGQuaternion() is the identity
+  y.vInertialPosition = VState.vInertialPosition;
+  y.vInertialVelocity = VState.vInertialVelocity;
+  y.qAttitudeECI = VState.qAttitudeECI;
+  y.vPQRi = VState.vPQRi;
+
+  double t = 0.0;
+  double h = (RKStepSize > 0.0) ? RKStepSize : dt;
+  double hmin = 1e-6*dt;
+  RKSteps = 0;
+
+  CalculateRKDerivative(y, epa0, k[0]);
+
+  while (t < dt) {
+    bool last = (h >= dt - t);
+    double hstep = last ? dt - t : h;
+
+    for (int s=1; s<7; s++) {
+      RKCombine(ynew, y, hstep, a[s], k, s);
+      CalculateRKDerivative(ynew, epa0 + omega*(t + c[s]*hstep), k[s]);
+    }
+    // ynew is now the 5th order solution and k[6] its derivative (FSAL).
+
+    RKCombine(err, zero, hstep, e, k, 7);
+    double errmax = 0.0;
+    for (int i=1; i<=3; i++) {
+      errmax = std::max(errmax, RKError(err.vInertialPosition(i), y.vInertialPosition(i),
+                                        ynew.vInertialPosition(i), RKTolerance));
+      errmax = std::max(errmax, RKError(err.vInertialVelocity(i), y.vInertialVelocity(i),
+                                        ynew.vInertialVelocity(i), RKTolerance));
+      errmax = std::max(errmax, RKError(err.vPQRi(i), y.vPQRi(i), ynew.vPQRi(i), RKTolerance));
+    }
+    for (int i=1; i<=4; i++)
+      errmax = std::max(errmax, RKError(err.qAttitudeECI(i), y.qAttitudeECI(i),
+                                        ynew.qAttitudeECI(i), RKTolerance));
+
+    // Step size control: aim at an error of 0.9 of the tolerance, and do not
+    // change the step size by more than a factor of 5 at once.
+    double factor = (errmax > 0.0) ? 0.9*pow(errmax, -0.2) : 5.0;
+    factor = std::min(5.0, std::max(0.2, factor));
+
+    if (errmax <= 1.0 || hstep <= hmin) {
+      t = last ? dt : t + hstep;
+      y = ynew;
+      k[0] = k[6];
+      RKSteps++;
+      // A sub-step shortened to end the time step says nothing about the
+      // step size that the error allows.
+      if (!last || hstep >= h) h = hstep*factor;
+    } else {
+      h = std::max(hmin, hstep*factor);
+    }
+  }
+
+  RKStepSize = h;
+
+  VState.vInertialPosition = y.vInertialPosition;
+  VState.vInertialVelocity = y.vInertialVelocity;
+  VState.qAttitudeECI = y.qAttitudeECI;
+  VState.vPQRi = y.vPQRi;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 // Resolves the contact forces just before integrating the EOM.
 // This routine is using Lagrange multipliers and the projected Gauss-Seidel
@@ -467,12 +695,13 @@ void FGPropagate::ResolveFrictionForces(double dt)
 {
   const double invMass = 1.0 / MassBalance->GetMass();
   const FGMatrix33& Jinv = MassBalance->GetJinv();
-  vector <FGColumnVector3> JacF, JacM;
   FGColumnVector3 vdot, wdot;
   FGColumnVector3 Fc, Mc;
   int n = 0, i;
 
   // Compiles data from the ground reactions to build up the jacobian matrix
+  JacF.clear();
+  JacM.clear();
   for (MultiplierIterator it=MultiplierIterator(GroundReactions); *it; ++it, n++) {
     JacF.push_back((*it)->ForceJacobian);
     JacM.push_back((*it)->MomentJacobian);
@@ -481,11 +710,17 @@ void FGPropagate::ResolveFrictionForces(double dt)
   // If no gears are in contact with the ground then return
   if (!n) return;
 
-  vector<double> a(n*n); // Will contain J*M^-1*J^T
-  vector<double> eta(n);
-  vector<double> lambda(n);
-  vector<double> lambdaMin(n);
-  vector<double> lambdaMax(n);
+  LagrangeA.resize(n*n);
+  LagrangeEta.resize(n);
+  Lambda.resize(n);
+  LambdaMin.resize(n);
+  LambdaMax.resize(n);
+
+  vector<double>& a = LagrangeA; // Will contain J*M^-1*J^T
+  vector<double>& eta = LagrangeEta;
+  vector<double>& lambda = Lambda;
+  vector<double>& lambdaMin = LambdaMin;
+  vector<double>& lambdaMax = LambdaMax;
 
   // Initializes the Lagrange multipliers
   i = 0;
@@ -624,17 +859,11 @@ void FGPropagate::InitializeDerivatives(void)
   CalculateQuatdot();          // Angular orientation derivative
   CalculateInertialVelocity(); // Translational position derivative
 
-  // Initialize past values deques
-  VState.dqPQRdot.clear();
-  VState.dqUVWidot.clear();
-  VState.dqInertialVelocity.clear();
-  VState.dqQtrndot.clear();
-  for (int i=0; i<4; i++) {
-    VState.dqPQRdot.push_front(vPQRdot);
-    VState.dqUVWidot.push_front(vUVWdot);
-    VState.dqInertialVelocity.push_front(VState.vInertialVelocity);
-    VState.dqQtrndot.push_front(vQtrndot);
-  }
+  // Initialize past values
+  VState.dqPQRdot.Fill(vPQRdot);
+  VState.dqUVWidot.Fill(vUVWdot);
+  VState.dqInertialVelocity.Fill(VState.vInertialVelocity);
+  VState.dqQtrndot.Fill(vQtrndot);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -649,6 +878,9 @@ void FGPropagate::RecomputeLocalTerrainRadius(void)
   FDMExec->GetGroundCallback()->GetAGLevel(t, VState.vLocation, contactloc, dv,
                                            LocalTerrainVelocity);
   LocalTerrainRadius = contactloc.GetRadius(); 
+
+  // And the sea level below the vehicle, if the ground knows it
+  FDMExec->GetGroundCallback()->GetSeaLevelRadius(VState.vLocation, SeaLevelRadius);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -663,7 +895,7 @@ void FGPropagate::SetTerrainElevation(double terrainElev)
 
 double FGPropagate::GetTerrainElevation(void) const
 {
-  return FDMExec->GetGroundCallback()->GetTerrainGeoCentRadius()-SeaLevelRadius;
+  return LocalTerrainRadius - SeaLevelRadius;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -773,6 +1005,9 @@ void FGPropagate::bind(void)
   PropertyManager->Tie("simulation/integrator/rate/translational", (int*)&integrator_translational_rate);
   PropertyManager->Tie("simulation/integrator/position/rotational", (int*)&integrator_rotational_position);
   PropertyManager->Tie("simulation/integrator/position/translational", (int*)&integrator_translational_position);
+  PropertyManager->Tie("simulation/integrator/method", (int*)&integration_method);
+  PropertyManager->Tie("simulation/integrator/tolerance", &RKTolerance);
+  PropertyManager->Tie("simulation/integrator/steps", &RKSteps);
   PropertyManager->Tie("simulation/gravity-model", &gravType);
 }
 
@@ -43,7 +43,7 @@ INCLUDES
 #include "math/FGLocation.h"
 #include "math/FGQuaternion.h"
 #include "math/FGMatrix33.h"
-#include <deque>
+#include "math/FGStateHistory.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -57,7 +57,6 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
-using std::deque;
 class FGInitialCondition;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -101,6 +100,32 @@ CLASS DOCUMENTATION
     5: Adams Bashforth 4
     @endcode
 
+    Alternatively the whole state can be integrated at once by a Runge-Kutta
+    method, selected by the property simulation/integrator/method:
+
+    @code
+    0: The integrators selected above (default)
+    1: Runge-Kutta 4
+    2: Runge-Kutta 4(5) (Dormand-Prince) with adaptive step size
+    @endcode
+
+    The Runge-Kutta methods re-evaluate, at each of their stages, the
+    accelerations that depend on the state being integrated: gravitation at
+    the stage position, the gyroscopic moments at the stage angular rates and
+    the attitude kinematics. The forces and moments computed by the other
+    models (aerodynamics, propulsion, ground reactions, ...) are held constant
+    in the body frame over the time step, as they are only computed once per
+    frame. This makes the Runge-Kutta methods most useful for orbital and
+    ballistic flight, where gravitation dominates.
+
+    The adaptive method integrates each time step in as many sub-steps as
+    are needed to keep the local error within the relative tolerance set by
+    simulation/integrator/tolerance (1e-9 by default). The sub-step size is
+    carried from one time step to the next, so a coast phase can be run at a
+    large time step (see FGFDMExec::Setdt()) without loss of accuracy. The
+    number of sub-steps of the last time step is available through
+    simulation/integrator/steps.
+
     @author Jon S. Berndt, Mathias Froehlich
     @version $Id: FGPropagate.h,v 1.48 2010/09/18 22:48:12 jberndt Exp $
   */
@@ -147,10 +172,12 @@ public:
 
     FGColumnVector3 vInertialPosition;
 
-    deque <FGColumnVector3> dqPQRdot;
-    deque <FGColumnVector3> dqUVWidot;
-    deque <FGColumnVector3> dqInertialVelocity;
-    deque <FGQuaternion>    dqQtrndot;
+    /** The past values of the derivatives, as used by the multistep
+        integrators (up to Adams Bashforth 4, hence the 4 values kept). */
+    FGStateHistory <FGColumnVector3, 4> dqPQRdot;
+    FGStateHistory <FGColumnVector3, 4> dqUVWidot;
+    FGStateHistory <FGColumnVector3, 4> dqInertialVelocity;
+    FGStateHistory <FGQuaternion, 4>    dqQtrndot;
   };
 
   /** Constructor.
@@ -169,6 +196,9 @@ public:
   /// These define the indices use to select the various integrators.
   enum eIntegrateType {eNone = 0, eRectEuler, eTrapezoidal, eAdamsBashforth2, eAdamsBashforth3, eAdamsBashforth4};
 
+  /// These define the indices use to select the whole state integration method.
+  enum eIntegrationMethod {imMultistep = 0, imRungeKutta4, imRungeKutta45};
+
   /// These define the indices use to select the gravitation models.
   enum eGravType {gtStandard, gtWGS84}; 
 
@@ -334,7 +364,9 @@ public:
   const FGColumnVector3& GetInertialPosition(void) const { return VState.vInertialPosition; }
 
   /** Returns the current altitude above sea level.
-      This function returns the altitude above sea level.
+      This function returns the altitude above sea level. The sea level is the
+      sphere of the sea level radius, or the sea level below the vehicle when
+      the ground callback knows it (see FGGroundCallback::GetSeaLevelRadius()).
       units ft
       @return The current altitude above sea level in feet.
   */
@@ -638,8 +670,32 @@ private:
   eIntegrateType integrator_translational_rate;
   eIntegrateType integrator_rotational_position;
   eIntegrateType integrator_translational_position;
+  eIntegrationMethod integration_method;
   int gravType;
 
+  /// The part of the state that is integrated by the Runge-Kutta methods,
+  /// also used to hold its derivative.
+  struct RKState {
+    FGColumnVector3 vInertialPosition;
+    FGColumnVector3 vInertialVelocity;
+    FGQuaternion qAttitudeECI;
+    FGColumnVector3 vPQRi;
+  };
+
+  // Held over a time step by the Runge-Kutta methods: the non gravitational
+  // acceleration in the body frame and the angular acceleration due to the
+  // external moments.
+  FGColumnVector3 vBodySpecificForce;
+  FGColumnVector3 vPQRdotExternal;
+  double RKTolerance;
+  double RKStepSize;
+  int RKSteps;
+
+  // Work space of ResolveFrictionForces(), kept between frames so that
+  // solving the contact forces does not allocate memory.
+  std::vector <FGColumnVector3> JacF, JacM;
+  std::vector <double> LagrangeA, LagrangeEta, Lambda, LambdaMin, LambdaMax;
+
   void CalculatePQRdot(void);
   void CalculateQuatdot(void);
   void CalculateInertialVelocity(void);
@@ -648,18 +704,25 @@ private:
 
   void Integrate( FGColumnVector3& Integrand,
                   FGColumnVector3& Val,
-                  deque <FGColumnVector3>& ValDot,
+                  FGStateHistory <FGColumnVector3, 4>& ValDot,
                   double dt,
                   eIntegrateType integration_type);
 
   void Integrate( FGQuaternion& Integrand,
                   FGQuaternion& Val,
-                  deque <FGQuaternion>& ValDot,
+                  FGStateHistory <FGQuaternion, 4>& ValDot,
                   double dt,
                   eIntegrateType integration_type);
 
   void ResolveFrictionForces(double dt);
 
+  void CalculateRKDerivative(const RKState& state, double epa, RKState& deriv);
+  static void RKCombine(RKState& out, const RKState& y, double h,
+                        const double* c, const RKState* k, int n);
+  FGColumnVector3 GetInertialGravity(const FGColumnVector3& position, double epa);
+  void IntegrateRK4(double dt);
+  void IntegrateRK45(double dt);
+
   void UpdateLocationMatrices(void);
   void UpdateBodyMatrices(void);
 
@@ -56,6 +56,7 @@ INCLUDES
 #include "models/propulsion/FGTank.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLParse.h"
+#include "input_output/FGOutputRecord.h"
 #include "math/FGColumnVector3.h"
 #include <iostream>
 #include <sstream>
@@ -258,6 +259,15 @@ void FGPropulsion::InitRunning(int n)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGPropulsion::GetFunctions(vector <FGFunction*>& functions) const
+{
+  FGModel::GetFunctions(functions);
+
+  for (unsigned int i=0; i<Engines.size(); i++) Engines[i]->GetFunctions(functions);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 bool FGPropulsion::Load(Element* el)
 {
   string type, engine_filename;
@@ -422,24 +432,20 @@ string FGPropulsion::GetPropulsionStrings(const string& delimiter)
 
 string FGPropulsion::GetPropulsionValues(const string& delimiter)
 {
-  unsigned int i;
+  FGOutputRecord record;
 
-  string PropulsionValues = "";
-  bool firstime = true;
-  stringstream buf;
+  GetPropulsionValues(record);
 
-  for (i=0; i<Engines.size(); i++) {
-    if (firstime)  firstime = false;
-    else           PropulsionValues += delimiter;
+  return record.Print(delimiter);
+}
 
-    PropulsionValues += Engines[i]->GetEngineValues(delimiter);
-  }
-  for (i=0; i<Tanks.size(); i++) {
-    buf << delimiter;
-    buf << Tanks[i]->GetContents();
-  }
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The tank contents are left out, as GetPropulsionStrings() leaves out their
+// labels.
 
-  return PropulsionValues;
+void FGPropulsion::GetPropulsionValues(FGOutputRecord& record)
+{
+  for (unsigned int i=0; i<Engines.size(); i++) Engines[i]->GetEngineValues(record);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
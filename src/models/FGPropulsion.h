@@ -59,6 +59,7 @@ namespace JSBSim {
 
 class FGTank;
 class FGEngine;
+class FGOutputRecord;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -124,6 +125,9 @@ public:
       @return true if successfully loaded, otherwise false */
   bool Load(Element* el);
 
+  /// Appends the functions of the propulsion model and of its engines to a list.
+  void GetFunctions(std::vector <FGFunction*>& functions) const;
+
   /// Retrieves the number of engines defined for the aircraft.
   inline unsigned int GetNumEngines(void) const {return (unsigned int)Engines.size();}
 
@@ -160,6 +164,7 @@ public:
 
   std::string GetPropulsionStrings(const std::string& delimiter);
   std::string GetPropulsionValues(const std::string& delimiter);
+  void GetPropulsionValues(FGOutputRecord& record);
 
   inline FGColumnVector3& GetForces(void)  {return vForces; }
   inline double GetForces(int n) const { return vForces(n);}
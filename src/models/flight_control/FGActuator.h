@@ -130,6 +130,7 @@ public:
       It calls private functions if needed to perform the hysteresis, lag,
       limiting, etc. functions. */
   bool Run (void);
+  void SetDt(double _dt);
 
   // these may need to have the bool argument replaced with a double
   /** This function fails the actuator to zero. The motion to zero
@@ -60,6 +60,7 @@ FGFCSComponent::FGFCSComponent(FGFCS* _fcs, Element* element) : fcs(_fcs)
   Input = Output = clipmin = clipmax = 0.0;
   treenode = 0;
   delay = index = 0;
+  delay_time = 0.0;
   ClipMinPropertyNode = ClipMaxPropertyNode = 0;
   clipMinSign = clipMaxSign = 1.0;
   IsOutput   = clip = false;
@@ -154,6 +155,7 @@ FGFCSComponent::FGFCSComponent(FGFCS* _fcs, Element* element) : fcs(_fcs)
     string delayType = delay_elem->GetAttributeValue("type");
     if (delayType.length() > 0) {
       if (delayType == "time") {
+        delay_time = delay;
         delay = (int)(delay / dt);
       } else if (delayType == "frames") {
         // no op. the delay type of "frames" is assumed and is the default.
@@ -161,6 +163,7 @@ FGFCSComponent::FGFCSComponent(FGFCS* _fcs, Element* element) : fcs(_fcs)
         cerr << "Unallowed delay type" << endl;
       }
     } else {
+      delay_time = delay;
       delay = (int)(delay / dt);
     }
     output_array.resize(delay);
@@ -216,6 +219,24 @@ bool FGFCSComponent::Run(void)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A delay given as a time spans another number of frames at the new time step:
+// the delayed outputs then start again from zero.
+
+void FGFCSComponent::SetDt(double _dt)
+{
+  dt = _dt;
+
+  if (delay_time > 0.0) {
+    int frames = (int)(delay_time / dt);
+    if (frames != delay) {
+      delay = frames;
+      index = 0;
+      output_array.assign(delay, 0.0);
+    }
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGFCSComponent::Delay(void)
@@ -38,6 +38,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include "FGJSBBase.h"
+#include "math/FGTimingStats.h"
 #include <string>
 #include <vector>
 
@@ -98,11 +99,19 @@ public:
 
   virtual bool Run(void);
   virtual void SetOutput(void);
+  /** Sets the time step the component runs at. It is called by the FCS when
+      its rate, or the time step of the executive, changes. Components that
+      derive coefficients from the time step compute them again. */
+  virtual void SetDt(double _dt);
   void LateBind(void);
   double GetOutput (void) const {return Output;}
   std::string GetName(void) const {return Name;}
   std::string GetType(void) const { return Type; }
   virtual double GetOutputPct(void) const { return 0; }
+  /** Returns the statistics of the wall clock times of the runs of the
+      component. They are only collected when the FCS times its components
+      (see FGFCS). */
+  FGTimingStats& GetExecStats(void) {return ExecStats;}
 
 protected:
   FGFCS* fcs;
@@ -124,8 +133,10 @@ protected:
   int index;
   float clipMinSign, clipMaxSign;
   double dt;
+  double delay_time;
   bool IsOutput;
   bool clip;
+  FGTimingStats ExecStats;
 
   void Delay(void);
   void Clip(void);
@@ -120,6 +120,8 @@ public:
 
   bool Run(void);
 
+  FGFunction* GetFunction(void) const {return function;}
+
 private:
   FGFunction* function;
 
@@ -177,6 +177,14 @@ void FGFilter::CalculateDynamicFilters(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFilter::SetDt(double _dt)
+{
+  FGFCSComponent::SetDt(_dt);
+  if (FilterType != eUnknown) CalculateDynamicFilters();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 bool FGFilter::Run(void)
 {
   double test = 0.0;
@@ -243,6 +243,7 @@ public:
   ~FGFilter();
 
   bool Run (void);
+  void SetDt(double _dt);
 
   /** When true, causes previous values to be set to current values. This
       is particularly useful for first pass. */
@@ -130,6 +130,7 @@ public:
   int    GetQuantized(void) const {return quantized;}
 
   virtual bool Run (void);
+  void SetDt(double _dt);
 
 protected:
   enum eNoiseType {ePercent=0, eAbsolute} NoiseType;
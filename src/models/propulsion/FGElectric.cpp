@@ -42,6 +42,7 @@ INCLUDES
 #include "FGElectric.h"
 #include "models/FGPropulsion.h"
 #include "models/propulsion/FGThruster.h"
+#include "input_output/FGOutputRecord.h"
 
 #include <iostream>
 #include <sstream>
@@ -66,7 +67,7 @@ FGElectric::FGElectric(FGFDMExec* exec, Element *el, int engine_number)
   PowerWatts = 745.7;
   hptowatts = 745.7;
 
-  dt = FDMExec->GetDeltaT();
+  dt = FDMExec->GetDeltaT() * Propulsion->GetRate();
 
   if (el->FindElement("power"))
     PowerWatts = el->FindElementValueAsNumberConvertTo("power","WATTS");
@@ -87,6 +88,8 @@ void FGElectric::Calculate(void)
 {
   RunPreFunctions();
 
+  dt = FDMExec->GetDeltaT() * Propulsion->GetRate();
+
   Throttle = FCS->GetThrottlePos(EngineNumber);
 
   RPM = Thruster->GetRPM() * Thruster->GetGearRatio();
@@ -114,14 +117,10 @@ string FGElectric::GetEngineLabels(const string& delimiter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGElectric::GetEngineValues(const string& delimiter)
+void FGElectric::GetEngineValues(FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << HP << delimiter
-     << Thruster->GetThrusterValues(EngineNumber, delimiter);
-
-  return buf.str();
+  record.Push(HP);
+  Thruster->GetThrusterValues(EngineNumber, record);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -84,7 +84,7 @@ public:
   double GetPowerAvailable(void) {return PowerAvailable;}
   double getRPM(void) {return RPM;}
   std::string GetEngineLabels(const std::string& delimiter);
-  std::string GetEngineValues(const std::string& delimiter);
+  void GetEngineValues(FGOutputRecord& record);
 
 private:
 
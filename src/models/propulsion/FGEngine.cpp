@@ -44,6 +44,7 @@ INCLUDES
 #include "FGRotor.h"
 #include "models/FGPropulsion.h"
 #include "input_output/FGXMLParse.h"
+#include "input_output/FGOutputRecord.h"
 #include "math/FGColumnVector3.h"
 
 #include <iostream>
@@ -199,7 +200,6 @@ void FGEngine::ConsumeFuel(void)
   Fshortage = FuelNeeded = 0.0;
   double FuelToBurn;
   unsigned int CurrentPriority = 1;
-  vector <int> FeedList;
   Starved = false;
 
   FuelToBurn = CalcFuelNeed();
@@ -207,6 +207,7 @@ void FGEngine::ConsumeFuel(void)
 
   // Count how many fuel tanks with the current priority level have fuel.
   // If none, then try next lower priority.  Build the feed list.
+  FeedList.clear();
   while ((TanksWithFuel == 0) && (CurrentPriority <= Propulsion->GetNumTanks())) {
     for (i=0; i<Propulsion->GetNumTanks(); i++) {
       if (SourceTanks[i] != 0) {
@@ -338,6 +339,17 @@ bool FGEngine::LoadThruster(Element *thruster_element)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGEngine::GetEngineValues(const string& delimiter)
+{
+  FGOutputRecord record;
+
+  GetEngineValues(record);
+
+  return record.Print(delimiter);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
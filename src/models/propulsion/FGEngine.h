@@ -72,6 +72,7 @@ class FGAuxiliary;
 class FGThruster;
 class Element;
 class FGPropertyManager;
+class FGOutputRecord;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -183,7 +184,10 @@ public:
   FGThruster* GetThruster(void) {return Thruster;}
 
   virtual std::string GetEngineLabels(const std::string& delimiter) = 0;
-  virtual std::string GetEngineValues(const std::string& delimiter) = 0;
+  std::string GetEngineValues(const std::string& delimiter);
+  /** Appends the values of the engine and of its thruster to an output record.
+      The labels of the values are given by GetEngineLabels(). */
+  virtual void GetEngineValues(FGOutputRecord& record) = 0;
 
 protected:
   /** Reduces the fuel in the active tanks by the amount required.
@@ -236,6 +240,7 @@ protected:
   FGThruster*     Thruster;
 
   std::vector <int> SourceTanks;
+  std::vector <int> FeedList; // kept between frames by ConsumeFuel() to avoid allocations
 
   void Debug(int from);
 };
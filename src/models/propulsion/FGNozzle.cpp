@@ -42,6 +42,7 @@ INCLUDES
 #include "FGNozzle.h"
 #include "models/FGAtmosphere.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -110,13 +111,9 @@ string FGNozzle::GetThrusterLabels(int id, string delimeter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGNozzle::GetThrusterValues(int id, string delimeter)
+void FGNozzle::GetThrusterValues(int id, FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << Thrust;
-
-  return buf.str();
+  record.Push(Thrust);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -92,7 +92,7 @@ public:
 
   double Calculate(double vacThrust);
   string GetThrusterLabels(int id, string delimeter);
-  string GetThrusterValues(int id, string delimeter);
+  void GetThrusterValues(int id, FGOutputRecord& record);
 
 private:
 //  double PE;
@@ -47,6 +47,7 @@ INCLUDES
 #include "models/FGAuxiliary.h"
 #include "models/FGPropulsion.h"
 #include "FGPropeller.h"
+#include "input_output/FGOutputRecord.h"
 #include <iostream>
 
 using namespace std;
@@ -74,7 +75,7 @@ FGPiston::FGPiston(FGFDMExec* exec, Element* el, int engine_number)
   // Defaults and initializations
 
   Type = etPiston;
-  dt = FDMExec->GetDeltaT();
+  dt = FDMExec->GetDeltaT() * Propulsion->GetRate();
 
   // These items are read from the configuration file
   // Defaults are from a Lycoming O-360, more or less
@@ -389,6 +390,9 @@ void FGPiston::Calculate(void)
 {
   RunPreFunctions();
 
+  // The engine runs at the rate of the propulsion model, which may change
+  dt = FDMExec->GetDeltaT() * Propulsion->GetRate();
+
   if (FuelFlow_gph > 0.0) ConsumeFuel();
 
   Throttle = FCS->GetThrottlePos(EngineNumber);
@@ -874,15 +878,13 @@ string FGPiston::GetEngineLabels(const string& delimiter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGPiston::GetEngineValues(const string& delimiter)
+void FGPiston::GetEngineValues(FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << PowerAvailable << delimiter << HP << delimiter
-      << equivalence_ratio << delimiter << ManifoldPressure_inHg << delimiter
-      << Thruster->GetThrusterValues(EngineNumber, delimiter);
-
-  return buf.str();
+  record.Push(PowerAvailable);
+  record.Push(HP);
+  record.Push(equivalence_ratio);
+  record.Push(ManifoldPressure_inHg);
+  Thruster->GetThrusterValues(EngineNumber, record);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
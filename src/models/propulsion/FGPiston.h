@@ -197,7 +197,7 @@ public:
   ~FGPiston();
 
   std::string GetEngineLabels(const std::string& delimiter);
-  std::string GetEngineValues(const std::string& delimiter);
+  void GetEngineValues(FGOutputRecord& record);
 
   void Calculate(void);
   double GetPowerAvailable(void) {return PowerAvailable;}
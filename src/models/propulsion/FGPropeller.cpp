@@ -43,6 +43,7 @@ INCLUDES
 #include "models/FGAtmosphere.h"
 #include "models/FGAuxiliary.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -371,20 +372,15 @@ string FGPropeller::GetThrusterLabels(int id, string delimeter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGPropeller::GetThrusterValues(int id, string delimeter)
+void FGPropeller::GetThrusterValues(int id, FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
   FGColumnVector3 vPFactor = GetPFactor();
-  buf << vTorque(eX) << delimeter
-      << vPFactor(ePitch) << delimeter
-      << vPFactor(eYaw) << delimeter
-      << Thrust << delimeter;
-  if (IsVPitch())
-    buf << Pitch << delimeter;
-  buf << RPM;
-
-  return buf.str();
+  record.Push(vTorque(eX));
+  record.Push(vPFactor(ePitch));
+  record.Push(vPFactor(eYaw));
+  record.Push(Thrust);
+  if (IsVPitch()) record.Push(Pitch);
+  record.Push(RPM);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
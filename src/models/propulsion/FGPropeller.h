@@ -250,7 +250,7 @@ public:
   double Calculate(double PowerAvailable);
   FGColumnVector3 GetPFactor(void);
   string GetThrusterLabels(int id, string delimeter);
-  string GetThrusterValues(int id, string delimeter);
+  void GetThrusterValues(int id, FGOutputRecord& record);
 
   void   SetReverseCoef (double c) { Reverse_coef = c; }
   double GetReverseCoef (void) { return Reverse_coef; }
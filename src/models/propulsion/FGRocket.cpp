@@ -44,6 +44,7 @@ INCLUDES
 #include "models/FGPropulsion.h"
 #include "FGThruster.h"
 #include "FGTank.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -155,7 +156,7 @@ void FGRocket::Calculate(void)
         VacThrust *= sin((BurnTime/BuildupTime)*M_PI/2.0);
         // VacThrust *= (1-cos((BurnTime/BuildupTime)*M_PI))/2.0; // 1 - cos approach
       }
-      BurnTime += FDMExec->GetDeltaT(); // Increment burn time
+      BurnTime += FDMExec->GetDeltaT()*Propulsion->GetRate(); // Increment burn time
     } else {
       VacThrust = 0.0;
     }
@@ -302,13 +303,10 @@ string FGRocket::GetEngineLabels(const string& delimiter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGRocket::GetEngineValues(const string& delimiter)
+void FGRocket::GetEngineValues(FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << It << delimiter << Thruster->GetThrusterValues(EngineNumber, delimiter);
-
-  return buf.str();
+  record.Push(It);
+  Thruster->GetThrusterValues(EngineNumber, record);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -159,7 +159,7 @@ public:
   double GetOxiFlowRate(void) const {return OxidizerFlowRate;}
 
   std::string GetEngineLabels(const std::string& delimiter);
-  std::string GetEngineValues(const std::string& delimiter);
+  void GetEngineValues(FGOutputRecord& record);
 
   /** Sets the thrust variation for a solid rocket engine. 
       Solid propellant rocket motor thrust characteristics are typically
@@ -45,8 +45,10 @@ INCLUDES
 #include "models/FGAtmosphere.h"
 #include "models/FGAuxiliary.h"
 #include "models/FGMassBalance.h"
+#include "models/FGPropulsion.h"
 
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGOutputRecord.h"
 
 #include "math/FGRungeKutta.h"
 
@@ -84,6 +86,7 @@ void FGRotor::rotor::zero() {
   parent              = NULL  ;
 
   reports             = 0;
+  InflowSolver        = eInflowImplicit;
 
   // configuration
   Radius              = 0.0 ;
@@ -349,6 +352,38 @@ FGColumnVector3 FGRotor::rotor::fus_angvel_body2ca( const FGColumnVector3 &pqr)
     return  d_nu; 
   }; 
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+  // derivative of the problem function with respect to nu
+  double FGRotor::rotor::dnuFunction::pDeriv(double nu) {
+    double l  = k_wor - nu;
+    double s2 = mu2 + sqr(l);
+    return -k_flowscale * k_sat * (ct_lambda * s2 - (ct_lambda * l + k_theta) * l) /
+                                  (2.0 * s2 * sqrt(s2)) - 1.0;
+  };
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+  // One step of the trapezoidal rule, which is implicit in nu_1: Newton
+  // iterations, starting from the explicit Euler step. At the frame rate the
+  // step is much shorter than the time constant of the equation, so a few
+  // rounds are enough; false if they did not converge.
+  bool FGRotor::rotor::dnuFunction::trapezoidal_step(double nu_0, double dt, double& nu_1) {
+    double f_0 = pFunc(0.0, nu_0);
+    double nu  = nu_0 + dt * f_0;
+    for (int i=0; i<8; i++) {
+      double delta = (nu - nu_0 - 0.5 * dt * (f_0 + pFunc(0.0, nu))) /
+                     (1.0 - 0.5 * dt * pDeriv(nu));
+      nu -= delta;
+      if (!(fabs(nu) < 1e3)) return false; // diverged, or not a number
+      if (fabs(delta) <= 1e-12 * (1.0 + fabs(nu))) {
+        nu_1 = nu;
+        return true;
+      }
+    }
+    return false;
+  };
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
   // merge params to keep the equation short
@@ -372,7 +407,8 @@ FGColumnVector3 FGRotor::rotor::fus_angvel_body2ca( const FGColumnVector3 &pqr)
 // Propper calculation of the inflow-ratio (lambda) is vital for the
 // following calculations. Simple implementations (i.e. Newton-Raphson w/o
 // checking) tend to oscillate or overshoot in the low speed region,
-// therefore a more expensive solver is used.
+// therefore the implicit step is checked, and the more expensive rk solver
+// is used if it fails (or always, see eInflowSolver).
 //
 // The flow_scale parameter is used to approximate a reduction of inflow
 // if the helicopter is close to the ground, yielding to higher thrust,
@@ -396,21 +432,24 @@ void FGRotor::rotor::calc_flow_and_thrust(
   // merge params together
   flowEquation.update_params(this, ct_t0+ct_t1, flow_scale, Ww);
   
-  nu_ret = rk.evolve(nu, &flowEquation);
+  if (InflowSolver == eInflowRKFehlberg || !flowEquation.trapezoidal_step(nu, dt, nu_ret)) {
 
-  if (rk.getStatus() != FGRungeKutta::eNoError) { // never observed so far
-    cerr << "# IEHHHH [" << flags << "]: Solver Error - resetting!" << endl;
-    rk.clearStatus();
-    nu_ret = nu; // use old value and keep fingers crossed.
-  }
+    nu_ret = rk.evolve(nu, &flowEquation);
 
-  // keep an eye on the solver, but be quiet after a hundred messages
-  if (reports < 100 && rk.getIterations()>6) {
-    cerr << "# LOOK [" << flags << "]: Solver took " 
-         << rk.getIterations() << " rounds." << endl;
-    reports++;
-    if (reports==100) {
-      cerr << "# stopped babbling after 100 notifications." << endl;
+    if (rk.getStatus() != FGRungeKutta::eNoError) { // never observed so far
+      cerr << "# IEHHHH [" << flags << "]: Solver Error - resetting!" << endl;
+      rk.clearStatus();
+      nu_ret = nu; // use old value and keep fingers crossed.
+    }
+
+    // keep an eye on the solver, but be quiet after a hundred messages
+    if (reports < 100 && rk.getIterations()>6) {
+      cerr << "# LOOK [" << flags << "]: Solver took " 
+           << rk.getIterations() << " rounds." << endl;
+      reports++;
+      if (reports==100) {
+        cerr << "# stopped babbling after 100 notifications." << endl;
+      }
     }
   }
 
@@ -622,7 +661,7 @@ FGRotor::FGRotor(FGFDMExec *exec, Element* rotor_element, int num)
   Element *thruster_element;
 
   PropertyManager = fdmex->GetPropertyManager();
-  dt = fdmex->GetDeltaT();
+  dt = fdmex->GetDeltaT()*fdmex->GetPropulsion()->GetRate();
 
   /* apply defaults */
 
@@ -793,7 +832,16 @@ double FGRotor::Calculate(double PowerAvailable)
   /* total vehicle velocity including wind effects in feet per second. */
   Vt = fdmex->GetAuxiliary()->GetVt();
 
-  dt = fdmex->GetDeltaT(); // might be variable ?
+  // The rotor runs at the rate of the propulsion model, which may change: the
+  // inflow solvers then restart with the new step, and the height filter
+  // is given it.
+  double new_dt = fdmex->GetDeltaT()*fdmex->GetPropulsion()->GetRate();
+  if (new_dt != dt) {
+    dt = new_dt;
+    mr.rk.init(0,dt,6);
+    if (tailRotorPresent) tr.rk.init(0,dt,6);
+    damp_hagl.SetCoefficients(1.0,dt);
+  }
 
   dump_req = prop_DumpFlag;
   prop_DumpFlag = 0;
@@ -1028,6 +1076,9 @@ bool FGRotor::bind(void) {
   prop_rotorbrake =   PropertyManager->GetNode(base_property_name + "/rotorbrake-hp", true);
   prop_freewheel_factor =   PropertyManager->GetNode(base_property_name + "/freewheel-factor", true);
 
+  PropertyManager->Tie( base_property_name + "/inflow-solver", this,
+                        &FGRotor::GetInflowSolver, &FGRotor::SetInflowSolver );
+
   PropertyManager->Tie( base_property_name + "/dump-flag", &prop_DumpFlag );
 
   return true;
@@ -1048,13 +1099,9 @@ string FGRotor::GetThrusterLabels(int id, string delimeter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGRotor::GetThrusterValues(int id, string delimeter)
+void FGRotor::GetThrusterValues(int id, FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << RPM;
-
-  return buf.str();
+  record.Push(RPM);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
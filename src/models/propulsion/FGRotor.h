@@ -180,6 +180,13 @@ CLASS DOCUMENTATION
    Concerning coaxial designs: By providing the 'variant' attribute with value 'coaxial'
    a Kamov-style rotor is modeled - i.e. the rotor produces no torque.
 
+   The induced inflow follows a first order differential equation, which is
+   advanced by one step of the implicit trapezoidal rule per frame, solved by
+   Newton iterations from the previous inflow. Should the iterations fail the
+   adaptive Runge-Kutta-Fehlberg solver takes over for the frame. Setting
+   <tt>propulsion/engine[x]/inflow-solver</tt> to 1 uses that solver all the
+   time, as a reference (0 selects the default).
+
 
 <h3>References:</h3>  
 
@@ -240,6 +247,7 @@ class FGRotor : public FGThruster {
      // FGRK4 rk                  ;  // use this after checking
      FGRKFehlberg rk            ;
      int          reports       ;
+     int          InflowSolver  ; // see eInflowSolver
 
      // configuration parameters
      double Radius              ;
@@ -301,8 +309,10 @@ class FGRotor : public FGThruster {
      class dnuFunction : public FGRungeKuttaProblem {
        public:
          void update_params(rotor *r, double ct_t01, double fs, double w);
+         bool trapezoidal_step(double nu_0, double dt, double& nu_1);
        private:
          double pFunc(double x, double y);
+         double pDeriv(double nu);
          // some shortcuts
          double k_sat, ct_lambda, k_wor, k_theta, mu2, k_flowscale;
      } flowEquation;
@@ -312,6 +322,9 @@ class FGRotor : public FGThruster {
 
 
 public:
+  /// Inflow solvers
+  enum eInflowSolver {eInflowImplicit=0, eInflowRKFehlberg=1};
+
   /** Constructor
       @param exec pointer to executive structure
       @param rotor_element pointer to XML element in the config file
@@ -332,6 +345,8 @@ public:
   double Calculate(double);
 
   double GetRPM(void)     const { return RPM;           }
+  int GetInflowSolver(void) const { return mr.InflowSolver; }
+  void SetInflowSolver(int solver) { mr.InflowSolver = tr.InflowSolver = solver; }
   double GetDiameter(void)      { return mr.Radius*2.0; }
 
   // Stubs. Right now this rotor-to-engine interface is just a hack.
@@ -340,7 +355,7 @@ public:
 
   // Stubs. Only main rotor RPM is returned
   string GetThrusterLabels(int id, string delimeter);
-  string GetThrusterValues(int id, string delimeter);
+  void GetThrusterValues(int id, FGOutputRecord& record);
 
 private:
 
@@ -40,6 +40,7 @@ INCLUDES
 
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -123,11 +124,18 @@ string FGThruster::GetThrusterLabels(int id, string delimeter)
 
 string FGThruster::GetThrusterValues(int id, string delimeter)
 {
-  std::ostringstream buf;
+  FGOutputRecord record;
 
-  buf << Thrust;
+  GetThrusterValues(id, record);
 
-  return buf.str();
+  return record.Print(delimeter);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGThruster::GetThrusterValues(int id, FGOutputRecord& record)
+{
+  record.Push(Thrust);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -56,6 +56,7 @@ namespace JSBSim {
 
 class Element;
 class FGPropertyManager;
+class FGOutputRecord;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -108,7 +109,8 @@ public:
   virtual double GetRPM(void) const { return 0.0; };
   double GetGearRatio(void) {return GearRatio; }
   virtual string GetThrusterLabels(int id, string delimeter);
-  virtual string GetThrusterValues(int id, string delimeter);
+  string GetThrusterValues(int id, string delimeter);
+  virtual void GetThrusterValues(int id, FGOutputRecord& record);
 
 protected:
   eType Type;
@@ -46,6 +46,7 @@ INCLUDES
 #include "models/FGPropulsion.h"
 #include "models/FGAuxiliary.h"
 #include "models/FGAtmosphere.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -408,6 +409,18 @@ double FGTurbine::GetPowerAvailable(void) {
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGTurbine::GetFunctions(vector <FGFunction*>& functions) const
+{
+  FGEngine::GetFunctions(functions);
+
+  if (IdleThrustLookup) functions.push_back(IdleThrustLookup);
+  if (MilThrustLookup) functions.push_back(MilThrustLookup);
+  if (MaxThrustLookup) functions.push_back(MaxThrustLookup);
+  if (InjectionLookup) functions.push_back(InjectionLookup);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 double FGTurbine::Seek(double *var, double target, double accel, double decel) {
   double v = *var;
   if (v > target) {
@@ -506,15 +519,11 @@ string FGTurbine::GetEngineLabels(const string& delimiter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGTurbine::GetEngineValues(const string& delimiter)
+void FGTurbine::GetEngineValues(FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << N1 << delimiter
-      << N2 << delimiter
-      << Thruster->GetThrusterValues(EngineNumber, delimiter);
-
-  return buf.str();
+  record.Push(N1);
+  record.Push(N2);
+  Thruster->GetThrusterValues(EngineNumber, record);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
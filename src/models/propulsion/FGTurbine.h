@@ -167,6 +167,7 @@ public:
   enum phaseType { tpOff, tpRun, tpSpinUp, tpStart, tpStall, tpSeize, tpTrim };
 
   void Calculate(void);
+  void GetFunctions(std::vector <FGFunction*>& functions) const;
   double CalcFuelNeed(void);
   double GetPowerAvailable(void);
   /** A lag filter.
@@ -210,7 +211,7 @@ public:
   void ResetToIC(void);
 
   std::string GetEngineLabels(const std::string& delimiter);
-  std::string GetEngineValues(const std::string& delimiter);
+  void GetEngineValues(FGOutputRecord& record);
 
 private:
 
@@ -47,6 +47,7 @@ INCLUDES
 #include "FGPropeller.h"
 #include "models/FGPropulsion.h"
 #include "models/FGAuxiliary.h"
+#include "input_output/FGOutputRecord.h"
 
 using namespace std;
 
@@ -491,16 +492,12 @@ string FGTurboProp::GetEngineLabels(const string& delimiter)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-string FGTurboProp::GetEngineValues(const string& delimiter)
+void FGTurboProp::GetEngineValues(FGOutputRecord& record)
 {
-  std::ostringstream buf;
-
-  buf << PowerAvailable << delimiter
-      << N1 << delimiter
-      << N2 << delimiter
-      << Thruster->GetThrusterValues(EngineNumber,delimiter);
-
-  return buf.str();
+  record.Push(PowerAvailable);
+  record.Push(N1);
+  record.Push(N2);
+  Thruster->GetThrusterValues(EngineNumber, record);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -148,7 +148,7 @@ public:
   inline void SetCondition(bool c) { Condition=c; }
   int InitRunning(void);
   std::string GetEngineLabels(const std::string& delimiter);
-  std::string GetEngineValues(const std::string& delimiter);
+  void GetEngineValues(FGOutputRecord& record);
 
 private:
 
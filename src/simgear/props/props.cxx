@@ -252,7 +252,7 @@ compare_strings (const char * s1, const char * s2)
  * Locate a child node by name and index.
  */
 static int
-find_child (const char * name, int index, vector<SGPropertyNode_ptr> nodes)
+find_child (const char * name, int index, const vector<SGPropertyNode_ptr>& nodes)
 {
   int nNodes = nodes.size();
   for (int i = 0; i < nNodes; i++) {
@@ -918,8 +918,12 @@ SGPropertyNode::removeChild (int pos, bool keep)
   if (keep) {
     _removedChildren.push_back(node);
   }
-  if (_path_cache)
-     _path_cache->erase(node->getName()); // EMH - TODO: Take "index" into account!
+  // Paths cached here or in any ancestor may lead into the removed subtree:
+  // drop them, so that they neither return removed nodes nor keep them alive.
+  for (SGPropertyNode * ancestor = this; ancestor != 0; ancestor = ancestor->_parent) {
+    delete ancestor->_path_cache;
+    ancestor->_path_cache = 0;
+  }
   node->setAttribute(REMOVED, true);
   node->clearValue();
   fireChildRemoved(node);
@@ -0,0 +1,187 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       alloc_count.cpp
+ Purpose:      Counts the heap allocations made while running a script
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+alloc_count replaces the global operator new and delete by counting versions,
+loads a script, runs it for a number of warm up frames and then counts the heap
+allocations made by each call to FGFDMExec::Run() for a number of frames. As
+every model is run within FGFDMExec::Run(), an allocation introduced anywhere
+in the frame loop shows up in the count.
+
+The number of frames that allocated, the total and the largest count per frame
+are reported, along with the simulation time of the first frames that did. The
+program exits with a non zero status when the allocations of a frame exceed
+the given limit (0 by default), so that it can be used as a regression check.
+
+The output defined by the script (or the aircraft) is disabled, unless the
+--output option is given. Note that the events of a script (and the
+notifications they print) are run within FGFDMExec::Run() as well, so the
+frames at which they trigger may legitimately allocate; the warm up and limit
+arguments allow for that.
+
+Usage (from the JSBSim root directory):
+
+  alloc_count [--output] <script file> [warm up frames] [frames] [limit]
+
+For example:
+
+  alloc_count scripts/c172_cruise_8K.xml 100 10000
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+
+#include <iostream>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+GLOBAL DATA
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static unsigned long allocations = 0;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#if __cplusplus >= 201103L
+#  define THROW_BAD_ALLOC
+#else
+#  define THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+void* operator new(size_t size) THROW_BAD_ALLOC
+{
+  allocations++;
+  void* p = malloc(size > 0 ? size : 1);
+  if (p == 0) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) THROW_BAD_ALLOC
+{
+  allocations++;
+  void* p = malloc(size > 0 ? size : 1);
+  if (p == 0) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) throw()
+{
+  free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+  free(p);
+}
+
+// The sized versions, that C++14 compilers call when the size is known, must
+// go to free() as well: the library ones would not match the malloc() above.
+void operator delete(void* p, size_t) throw()
+{
+  free(p);
+}
+
+void operator delete[](void* p, size_t) throw()
+{
+  free(p);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  bool output = (argc > 1 && string(argv[1]) == "--output");
+  if (output) {
+    argc--;
+    argv++;
+  }
+
+  if (argc < 2) {
+    cerr << "Usage: alloc_count [--output] <script file> [warm up frames] [frames] [limit]" << endl;
+    return -1;
+  }
+
+  string script = argv[1];
+  int warmup = argc > 2 ? atoi(argv[2]) : 100;
+  int frames = argc > 3 ? atoi(argv[3]) : 10000;
+  unsigned long limit = argc > 4 ? strtoul(argv[4], 0, 10) : 0;
+
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+  FDMExec->SetAircraftPath("aircraft");
+  FDMExec->SetEnginePath("engine");
+  FDMExec->SetSystemsPath("systems");
+
+  if (!FDMExec->LoadScript(script, 0.0)) {
+    cerr << "Script file " << script << " was not successfully loaded" << endl;
+    delete FDMExec;
+    return -1;
+  }
+  if (!output) FDMExec->DisableOutput();
+
+  bool running = true;
+  for (int i=0; i<warmup && running; i++) running = FDMExec->Run();
+
+  const int nReported = 10;
+  int nAllocating = 0, nRun = 0;
+  unsigned long total = 0, largest = 0;
+
+  for (int i=0; i<frames && running; i++) {
+    double time = FDMExec->GetSimTime();
+    unsigned long before = allocations;
+    running = FDMExec->Run();
+    unsigned long count = allocations - before;
+    nRun++;
+
+    if (count > 0) {
+      if (nAllocating < nReported)
+        cout << "  " << count << " allocation(s) in the frame at t = " << time << " s" << endl;
+      nAllocating++;
+      total += count;
+      if (count > largest) largest = count;
+    }
+  }
+
+  cout << "Aircraft:              " << FDMExec->GetModelName() << endl;
+  cout << "Frames:                " << nRun << " (after " << warmup << " warm up frames)" << endl;
+  cout << "Allocating frames:     " << nAllocating << endl;
+  cout << "Allocations:           " << total << " total, " << largest << " at most per frame" << endl;
+
+  delete FDMExec;
+
+  if (largest > limit) {
+    cerr << "More than " << limit << " allocation(s) in a frame" << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       bench_function.cpp
+ Purpose:      Benchmark of compiled versus tree-walked function evaluation
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+bench_function loads a script, runs it for a number of frames so that the
+aircraft is in a representative state, and then evaluates the complete set of
+aerodynamic coefficient functions of the aircraft repeatedly, first by walking
+the parameter trees (FGFunction::GetTreeValue) and then through the compiled
+programs (FGFunction::GetValue). The time per function evaluation is reported
+for both, along with the largest difference between the two results.
+
+Finally the script is run for the same number of frames again with function
+dirty tracking enabled, and the number of function evaluations computed and
+skipped per frame is reported.
+
+Usage (from the JSBSim root directory):
+
+  bench_function <script file> [frames] [iterations]
+
+For example:
+
+  bench_function scripts/737_cruise.xml 1000 2000
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "models/FGAerodynamics.h"
+#include "math/FGFunction.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+double getcurrentseconds(void)
+{
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+#else
+double getcurrentseconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: bench_function <script file> [frames] [iterations]" << endl;
+    return -1;
+  }
+
+  string script = argv[1];
+  int frames = argc > 2 ? atoi(argv[2]) : 1000;
+  int iterations = argc > 3 ? atoi(argv[3]) : 1000;
+
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+  FDMExec->SetAircraftPath("aircraft");
+  FDMExec->SetEnginePath("engine");
+  FDMExec->SetSystemsPath("systems");
+
+  if (!FDMExec->LoadScript(script, 0.0)) {
+    cerr << "Script file " << script << " was not successfully loaded" << endl;
+    delete FDMExec;
+    return -1;
+  }
+
+  for (int i=0; i<frames; i++) FDMExec->Run();
+
+  vector <FGFunction*> functions;
+  vector <FGFunction*>* Coeff = FDMExec->GetAerodynamics()->GetCoeff();
+  for (unsigned int axis=0; axis<6; axis++) {
+    for (unsigned int i=0; i<Coeff[axis].size(); i++) functions.push_back(Coeff[axis][i]);
+  }
+
+  unsigned int nCompiled = 0;
+  for (unsigned int i=0; i<functions.size(); i++) {
+    if (functions[i]->Compile()) nCompiled++;
+  }
+
+  double maxDiff = 0.0;
+  for (unsigned int i=0; i<functions.size(); i++) {
+    double diff = fabs(functions[i]->GetValue() - functions[i]->GetTreeValue());
+    if (diff > maxDiff) maxDiff = diff;
+  }
+
+  double sum_tree = 0.0, sum_compiled = 0.0;
+  double start = getcurrentseconds();
+  for (int n=0; n<iterations; n++) {
+    for (unsigned int i=0; i<functions.size(); i++) sum_tree += functions[i]->GetTreeValue();
+  }
+  double tree_time = getcurrentseconds() - start;
+
+  start = getcurrentseconds();
+  for (int n=0; n<iterations; n++) {
+    for (unsigned int i=0; i<functions.size(); i++) sum_compiled += functions[i]->GetValue();
+  }
+  double compiled_time = getcurrentseconds() - start;
+
+  double evaluations = (double)iterations * functions.size();
+
+  cout << "Aircraft:              " << FDMExec->GetModelName() << endl;
+  cout << "Functions:             " << functions.size() << " (" << nCompiled << " compiled)" << endl;
+  cout << "Iterations:            " << iterations << endl;
+  cout << fixed << setprecision(2);
+  cout << "Tree walk:             " << tree_time*1e9/evaluations << " ns/evaluation, "
+       << tree_time*1e9/iterations << " ns/set" << endl;
+  cout << "Compiled:              " << compiled_time*1e9/evaluations << " ns/evaluation, "
+       << compiled_time*1e9/iterations << " ns/set" << endl;
+  cout << "Speedup:               " << tree_time/compiled_time << endl;
+  cout << scientific << setprecision(3);
+  cout << "Max difference:        " << maxDiff << endl;
+  cout << "Checksum difference:   " << fabs(sum_tree - sum_compiled) << endl;
+
+  FDMExec->SetFunctionDirtyTracking(1);
+  double computed = 0.0, skipped = 0.0;
+  start = getcurrentseconds();
+  for (int i=0; i<frames; i++) {
+    FDMExec->Run();
+    computed += FDMExec->GetFunctionsEvaluated();
+    skipped += FDMExec->GetFunctionsSkipped();
+  }
+  double tracked_time = getcurrentseconds() - start;
+
+  cout << fixed << setprecision(1);
+  cout << "Dirty tracking:        " << computed/frames << " computed, "
+       << skipped/frames << " skipped per frame ("
+       << tracked_time*1e6/frames << " us/frame)" << endl;
+
+  delete FDMExec;
+
+  return 0;
+}
@@ -0,0 +1,206 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       bench_orbit.cpp
+ Purpose:      Benchmark of the integrators of FGPropagate on the orbit case
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+bench_orbit flies the ball of the orbit check case (aircraft ball, initial
+conditions reset00: a circular orbit at 800 kft) for a given time with several
+integration methods and time steps:
+
+- the multistep integrators as set by scripts/ball_orbit.xml (trapezoidal and
+  Adams Bashforth 2/3),
+- the Runge-Kutta 4 method,
+- the adaptive Runge-Kutta 4(5) method.
+
+A reference trajectory is computed first with the adaptive method at a very
+tight tolerance. For each case, the wall clock time and the distance between
+the final inertial position and that of the reference are reported.
+
+Usage (from the JSBSim root directory):
+
+  bench_orbit [simulation time (s)] [tolerance]
+
+For example:
+
+  bench_orbit 5400 1e-9
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "models/FGPropagate.h"
+#include "initialization/FGInitialCondition.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+double getcurrentseconds(void)
+{
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+#else
+double getcurrentseconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct OrbitCase {
+  const char* Name;
+  int Method;
+  double dt;
+};
+
+struct OrbitResult {
+  bool Success;
+  FGColumnVector3 Position;
+  double WallTime;
+  unsigned long Frames;
+  unsigned long Steps;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+OrbitResult FlyOrbit(int method, double dt, double tolerance, double duration)
+{
+  OrbitResult result;
+  result.Success = false;
+  result.WallTime = 0.0;
+  result.Frames = result.Steps = 0;
+
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+
+  if (!FDMExec->LoadModel("aircraft", "engine", "systems", "ball")) {
+    cerr << "The ball aircraft was not successfully loaded" << endl;
+    delete FDMExec;
+    return result;
+  }
+  if (!FDMExec->GetIC()->Load("reset00")) {
+    cerr << "The reset00 initial conditions were not successfully loaded" << endl;
+    delete FDMExec;
+    return result;
+  }
+
+  FDMExec->Setdt(dt);
+  FDMExec->RunIC();
+
+  // The integrators of scripts/ball_orbit.xml
+  FDMExec->SetPropertyValue("simulation/integrator/rate/rotational", 2);
+  FDMExec->SetPropertyValue("simulation/integrator/rate/translational", 3);
+  FDMExec->SetPropertyValue("simulation/integrator/position/rotational", 3);
+  FDMExec->SetPropertyValue("simulation/integrator/position/translational", 4);
+  FDMExec->SetPropertyValue("simulation/integrator/method", method);
+  FDMExec->SetPropertyValue("simulation/integrator/tolerance", tolerance);
+
+  unsigned long frames = (unsigned long)(duration/dt + 0.5);
+
+  double start = getcurrentseconds();
+  for (unsigned long i=0; i<frames; i++) {
+    FDMExec->Run();
+    result.Steps += (unsigned long)FDMExec->GetPropertyValue("simulation/integrator/steps");
+  }
+  result.WallTime = getcurrentseconds() - start;
+
+  result.Frames = frames;
+  result.Position = FDMExec->GetPropagate()->GetInertialPosition();
+  result.Success = true;
+
+  delete FDMExec;
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  double duration = argc > 1 ? atof(argv[1]) : 5400.0;
+  double tolerance = argc > 2 ? atof(argv[2]) : 1e-9;
+
+  const int MS = FGPropagate::imMultistep;
+  const int RK4 = FGPropagate::imRungeKutta4;
+  const int RK45 = FGPropagate::imRungeKutta45;
+
+  OrbitCase cases[] = {
+    {"Multistep", MS, 1.0/480.0},
+    {"Multistep", MS, 1.0/120.0},
+    {"Multistep", MS, 0.1},
+    {"Multistep", MS, 1.0},
+    {"RK4", RK4, 1.0/120.0},
+    {"RK4", RK4, 0.1},
+    {"RK4", RK4, 1.0},
+    {"RK4", RK4, 10.0},
+    {"RK45", RK45, 1.0/120.0},
+    {"RK45", RK45, 1.0},
+    {"RK45", RK45, 10.0},
+    {"RK45", RK45, 60.0}
+  };
+  const int nCases = sizeof(cases)/sizeof(cases[0]);
+
+  cout << "Orbit of the ball (reset00) for " << duration << " s" << endl;
+  cout << "Computing the reference trajectory (RK45, dt = 1 s, tolerance 1e-13)" << endl;
+  OrbitResult reference = FlyOrbit(RK45, 1.0, 1e-13, duration);
+  if (!reference.Success) return -1;
+
+  cout << endl;
+  cout << "  Method        dt (s)   Steps/frame   Wall time (s)   Position error (ft)" << endl;
+
+  for (int i=0; i<nCases; i++) {
+    OrbitResult result = FlyOrbit(cases[i].Method, cases[i].dt, tolerance, duration);
+    if (!result.Success) return -1;
+
+    double error = (result.Position - reference.Position).Magnitude();
+    cout << "  " << left << setw(10) << cases[i].Name << right
+         << fixed << setprecision(4) << setw(10) << cases[i].dt
+         << setprecision(2) << setw(14) << (double)result.Steps/result.Frames
+         << setprecision(3) << setw(16) << result.WallTime
+         << scientific << setprecision(3) << setw(22) << error << endl;
+  }
+
+  return 0;
+}
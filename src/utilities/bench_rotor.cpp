@@ -0,0 +1,187 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       bench_rotor.cpp
+ Purpose:      Benchmark of the rotor inflow solvers
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+bench_rotor flies the ah1s helicopter (initial conditions reset00) with each
+inflow solver of FGRotor: the adaptive Runge-Kutta-Fehlberg solver, which is
+the reference, and the implicit trapezoidal step. The engine is started with
+the rpm governor on; the collective is raised from 5 s to take off, and lowered
+from 15 s to climb slowly.
+
+For each solver, the mean and maximum execution times of the propulsion model
+(which runs the rotor) and the mean frame time are reported, together with the
+largest differences of the induced inflow ratio and of the main rotor thrust
+from those of the reference along the flight, and the distance between the
+final positions.
+
+Usage (from the JSBSim root directory):
+
+  bench_rotor [simulation time (s)]
+
+For example:
+
+  bench_rotor 30
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "models/FGPropagate.h"
+#include "models/propulsion/FGRotor.h"
+#include "initialization/FGInitialCondition.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct RotorResult {
+  bool Success;
+  vector <double> Inflow;
+  vector <double> Thrust;
+  FGColumnVector3 Position;
+  double PropulsionMean;
+  double PropulsionMax;
+  double FrameMean;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The collective (fcs/mixture-cmd-norm for this model) along the flight
+double Collective(double t)
+{
+  if (t < 5.0) return 0.0;
+  if (t < 10.0) return 0.7*(t - 5.0)/5.0;
+  if (t < 15.0) return 0.7;
+  if (t < 18.0) return 0.7 - 0.15*(t - 15.0)/3.0;
+  return 0.55;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+RotorResult Fly(int solver, double duration)
+{
+  RotorResult result;
+  result.Success = false;
+  result.PropulsionMean = result.PropulsionMax = result.FrameMean = 0.0;
+
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+
+  if (!FDMExec->LoadModel("aircraft", "engine", "systems", "ah1s")) {
+    cerr << "The ah1s aircraft was not successfully loaded" << endl;
+    delete FDMExec;
+    return result;
+  }
+  if (!FDMExec->GetIC()->Load("reset00")) {
+    cerr << "The reset00 initial conditions were not successfully loaded" << endl;
+    delete FDMExec;
+    return result;
+  }
+
+  FDMExec->DisableOutput();
+  FDMExec->Setdt(1.0/120.0);
+  FDMExec->RunIC();
+
+  FDMExec->SetPropertyValue("propulsion/set-running", -1);
+  FDMExec->SetPropertyValue("fcs/rpm-governor-active-norm", 1);
+  FDMExec->SetPropertyValue("/controls/engines/engine/throttle", 1);
+  FDMExec->SetPropertyValue("propulsion/engine/inflow-solver", solver);
+  FDMExec->SetPropertyValue("simulation/perf/reset", 1);
+
+  unsigned long frames = (unsigned long)(duration*120.0 + 0.5);
+  result.Inflow.reserve(frames);
+  result.Thrust.reserve(frames);
+
+  for (unsigned long i=0; i<frames; i++) {
+    FDMExec->SetPropertyValue("fcs/mixture-cmd-norm", Collective(FDMExec->GetSimTime()));
+    FDMExec->Run();
+    result.Inflow.push_back(FDMExec->GetPropertyValue("propulsion/engine/induced-inflow-ratio"));
+    result.Thrust.push_back(FDMExec->GetPropertyValue("propulsion/engine/thrust-mr-lbs"));
+  }
+
+  result.PropulsionMean = FDMExec->GetPropertyValue("simulation/perf/propulsion/mean-sec");
+  result.PropulsionMax = FDMExec->GetPropertyValue("simulation/perf/propulsion/max-sec");
+  result.FrameMean = FDMExec->GetPropertyValue("simulation/perf/frame/mean-sec");
+  result.Position = FDMExec->GetPropagate()->GetInertialPosition();
+  result.Success = true;
+
+  delete FDMExec;
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  double duration = argc > 1 ? atof(argv[1]) : 30.0;
+
+  struct {
+    const char* Name;
+    int Solver;
+  } cases[] = {
+    {"RKF", FGRotor::eInflowRKFehlberg},
+    {"Implicit", FGRotor::eInflowImplicit}
+  };
+  const int nCases = sizeof(cases)/sizeof(cases[0]);
+
+  cout << "Flight of the ah1s (reset00) for " << duration << " s" << endl;
+  RotorResult reference = Fly(FGRotor::eInflowRKFehlberg, duration);
+  if (!reference.Success) return -1;
+
+  cout << endl;
+  cout << "  Solver    Propulsion mean/max (us)   Frame mean (us)"
+          "   Max inflow error   Max thrust error (lbs)   Position error (ft)" << endl;
+
+  for (int i=0; i<nCases; i++) {
+    RotorResult result = Fly(cases[i].Solver, duration);
+    if (!result.Success) return -1;
+
+    double inflowError = 0.0, thrustError = 0.0;
+    for (unsigned int j=0; j<result.Inflow.size(); j++) {
+      inflowError = max(inflowError, fabs(result.Inflow[j] - reference.Inflow[j]));
+      thrustError = max(thrustError, fabs(result.Thrust[j] - reference.Thrust[j]));
+    }
+    double error = (result.Position - reference.Position).Magnitude();
+
+    cout << "  " << left << setw(10) << cases[i].Name << right
+         << fixed << setprecision(2) << setw(12) << 1e6*result.PropulsionMean
+         << " /" << setw(9) << 1e6*result.PropulsionMax
+         << setw(18) << 1e6*result.FrameMean
+         << scientific << setprecision(3) << setw(19) << inflowError
+         << setw(25) << thrustError
+         << setw(22) << error << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,198 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       bench_schedule.cpp
+ Purpose:      Reports the execution times of the models for a given schedule
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+bench_schedule runs a script twice for a number of frames: once with the default
+schedule (every model run at each frame) and once with the given model rates,
+the phases of which are chosen by FGFDMExec::BalanceSchedule() from the times
+measured during a number of warm up frames. For each run, the rate, phase, mean,
+99th percentile and maximum execution times of each model (read from the
+properties under simulation/perf, reset after the warm up) are reported, along with the mean and
+maximum frame times, the worst case frame time computed by the executive and,
+for the second run, the distance between the final positions of both runs.
+
+The rates are given as model=rate arguments, where model is the name of the
+model under simulation/schedule (atmosphere, massbalance, aerodynamics, ...).
+The default rates are atmosphere=4 and massbalance=8. The outputs of the script
+(or of the aircraft) are disabled.
+
+Usage (from the JSBSim root directory):
+
+  bench_schedule <script file> [frames] [model=rate ...]
+
+For example:
+
+  bench_schedule scripts/c172_cruise_8K.xml 6000 atmosphere=4 massbalance=8
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "models/FGPropagate.h"
+#include "input_output/FGPropertyManager.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct ScheduleRun {
+  bool Success;
+  FGColumnVector3 Position;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the names of the scheduled models, as found under simulation/schedule
+
+vector <string> GetModelNames(FGFDMExec* FDMExec)
+{
+  vector <string> names;
+  FGPropertyManager* schedule = FDMExec->GetPropertyManager()->GetNode("simulation/schedule");
+
+  for (int i=0; i<schedule->nChildren(); i++) {
+    SGPropertyNode* node = schedule->getChild(i);
+    if (node->nChildren() == 0) continue; // Not a model
+    ostringstream name;
+    name << node->getName();
+    if (node->getIndex() > 0) name << '[' << node->getIndex() << ']';
+    names.push_back(name.str());
+  }
+
+  return names;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ScheduleRun RunSchedule(const string& script, int frames, const vector <string>& rates)
+{
+  ScheduleRun result;
+  result.Success = false;
+
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+  FDMExec->SetAircraftPath("aircraft");
+  FDMExec->SetEnginePath("engine");
+  FDMExec->SetSystemsPath("systems");
+
+  if (!FDMExec->LoadScript(script, 0.0)) {
+    cerr << "Script file " << script << " was not successfully loaded" << endl;
+    delete FDMExec;
+    return result;
+  }
+  FDMExec->DisableOutput();
+
+  for (unsigned int i=0; i<rates.size(); i++) {
+    string::size_type eq = rates[i].find('=');
+    string name = "simulation/schedule/" + rates[i].substr(0, eq) + "/rate";
+    if (eq == string::npos || !FDMExec->GetPropertyManager()->HasNode(name)) {
+      cerr << "Unknown model rate " << rates[i] << endl;
+      delete FDMExec;
+      return result;
+    }
+    FDMExec->SetPropertyValue(name, atoi(rates[i].substr(eq+1).c_str()));
+  }
+
+  // Warm up, then choose the phases from the measured times.
+  bool running = true;
+  int warmup = frames/10;
+  for (int i=0; i<warmup && running; i++) running = FDMExec->Run();
+  if (!rates.empty()) FDMExec->BalanceSchedule();
+  FDMExec->ResetPerformanceStats();
+
+  double mean_frame = 0.0, max_frame = 0.0;
+  int nRun = 0;
+  for (int i=0; i<frames && running; i++) {
+    running = FDMExec->Run();
+    double frame_time = FDMExec->GetFrameTime();
+    mean_frame += frame_time;
+    if (frame_time > max_frame) max_frame = frame_time;
+    nRun++;
+  }
+  if (nRun > 0) mean_frame /= nRun;
+
+  vector <string> names = GetModelNames(FDMExec);
+
+  cout << "  Model              Rate  Phase   Mean (us)    p99 (us)    Max (us)" << endl;
+  for (unsigned int i=0; i<names.size(); i++) {
+    string base = "simulation/schedule/" + names[i];
+    string perf = "simulation/perf/" + names[i];
+    cout << "  " << left << setw(18) << names[i] << right
+         << setw(5) << (int)FDMExec->GetPropertyValue(base + "/rate")
+         << setw(7) << (int)FDMExec->GetPropertyValue(base + "/phase")
+         << fixed << setprecision(2)
+         << setw(12) << 1e6*FDMExec->GetPropertyValue(perf + "/mean-sec")
+         << setw(12) << 1e6*FDMExec->GetPropertyValue(perf + "/p99-sec")
+         << setw(12) << 1e6*FDMExec->GetPropertyValue(perf + "/max-sec") << endl;
+  }
+  cout << "  Frames:                  " << nRun << " (after " << warmup << " warm up frames)" << endl;
+  cout << "  Frame time (us):         " << 1e6*mean_frame << " mean, " << 1e6*max_frame << " max" << endl;
+  cout << "  Worst case frame (us):   " << 1e6*FDMExec->GetWorstFrameTime() << endl;
+
+  result.Position = FDMExec->GetPropagate()->GetInertialPosition();
+  result.Success = true;
+
+  delete FDMExec;
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: bench_schedule <script file> [frames] [model=rate ...]" << endl;
+    return -1;
+  }
+
+  string script = argv[1];
+  int frames = argc > 2 ? atoi(argv[2]) : 6000;
+  vector <string> rates;
+  for (int i=3; i<argc; i++) rates.push_back(argv[i]);
+  if (rates.empty()) {
+    rates.push_back("atmosphere=4");
+    rates.push_back("massbalance=8");
+  }
+
+  cout << "Default schedule" << endl;
+  ScheduleRun reference = RunSchedule(script, frames, vector <string>());
+  if (!reference.Success) return -1;
+
+  cout << endl << "Multi-rate schedule" << endl;
+  ScheduleRun multirate = RunSchedule(script, frames, rates);
+  if (!multirate.Success) return -1;
+
+  cout << "  Position difference (ft): "
+       << (multirate.Position - reference.Position).Magnitude() << endl;
+
+  return 0;
+}
@@ -0,0 +1,268 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       bench_table.cpp
+ Purpose:      Benchmark of the FGTable lookups
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+bench_table builds a 1D, a 2D and a 3D table and looks each of them up for a
+set of keys in three ways: with the reference lookups on the unpacked data
+(FGTable::GetReferenceValue), with the scalar lookups on the packed data
+(FGTable::GetValue) and with the batched lookups (FGTable::GetValues). The keys
+are looked up once in a slow sweep across the table, as during a simulation,
+and once in random order, as in a Monte Carlo run. The time per lookup is
+reported, along with the largest difference to the reference results.
+
+Usage:
+
+  bench_table [breakpoints] [keys] [iterations]
+
+where breakpoints is the number of rows of the tables (the tables have half as
+many columns and a quarter as many sub-tables).
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "math/FGTable.h"
+#include "input_output/FGXMLParse.h"
+#include "input_output/FGPropertyManager.h"
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+double getcurrentseconds(void)
+{
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+#else
+double getcurrentseconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+#endif
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Writes the <tableData> of a 2D table with breakpoints 0, 1, 2, ... and
+// values that vary non-linearly across the table.
+
+void WriteTableData(ostream& xml, int rows, int cols, double offset)
+{
+  xml << "        ";
+  for (int c=0; c<cols; c++) xml << " " << c;
+  xml << endl;
+  for (int r=0; r<rows; r++) {
+    xml << "    " << r;
+    for (int c=0; c<cols; c++) xml << " " << sin(0.3*r + 0.1*c*c + offset);
+    xml << endl;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGTable* BuildTable(FGPropertyManager* pm, int dimension, int rows)
+{
+  int cols = rows/2 > 2 ? rows/2 : 2;
+  int tables = rows/4 > 2 ? rows/4 : 2;
+  ostringstream xml;
+
+  xml << "<table>" << endl;
+  xml << "  <independentVar lookup=\"row\">bench/row</independentVar>" << endl;
+  if (dimension > 1)
+    xml << "  <independentVar lookup=\"column\">bench/column</independentVar>" << endl;
+  if (dimension > 2)
+    xml << "  <independentVar lookup=\"table\">bench/table</independentVar>" << endl;
+
+  switch (dimension) {
+  case 1:
+    xml << "  <tableData>" << endl;
+    for (int r=0; r<rows; r++) xml << "    " << r << " " << sin(0.3*r) << endl;
+    xml << "  </tableData>" << endl;
+    break;
+  case 2:
+    xml << "  <tableData>" << endl;
+    WriteTableData(xml, rows, cols, 0.0);
+    xml << "  </tableData>" << endl;
+    break;
+  case 3:
+    for (int t=0; t<tables; t++) {
+      xml << "  <tableData breakPoint=\"" << t << "\">" << endl;
+      WriteTableData(xml, rows, cols, 0.5*t);
+      xml << "  </tableData>" << endl;
+    }
+    break;
+  }
+  xml << "</table>" << endl;
+
+  istringstream input(xml.str());
+  FGXMLParse parser;
+  readXML(input, parser);
+
+  return new FGTable(pm, parser.GetDocument());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double Reference(const FGTable* table, int dimension, double r, double c, double t)
+{
+  switch (dimension) {
+  case 1: return table->GetReferenceValue(r);
+  case 2: return table->GetReferenceValue(r, c);
+  default: return table->GetReferenceValue(r, c, t);
+  }
+}
+
+double Packed(const FGTable* table, int dimension, double r, double c, double t)
+{
+  switch (dimension) {
+  case 1: return table->GetValue(r);
+  case 2: return table->GetValue(r, c);
+  default: return table->GetValue(r, c, t);
+  }
+}
+
+void Batched(const FGTable* table, int dimension, unsigned int n, const double* r,
+             const double* c, const double* t, double* values)
+{
+  switch (dimension) {
+  case 1: table->GetValues(n, r, values); break;
+  case 2: table->GetValues(n, r, c, values); break;
+  default: table->GetValues(n, r, c, t, values); break;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Benchmark(FGTable* table, int dimension, int rows, int nKeys, int iterations,
+               bool sweep)
+{
+  int cols = rows/2 > 2 ? rows/2 : 2;
+  int tables = rows/4 > 2 ? rows/4 : 2;
+  vector <double> r(nKeys), c(nKeys), t(nKeys);
+  vector <double> ref(nKeys), packed(nKeys), batched(nKeys);
+
+  // The keys slightly overshoot the table to exercise the end points.
+  for (int i=0; i<nKeys; i++) {
+    if (sweep) {
+      double x = (double)i/nKeys;
+      r[i] = (rows + 1)*x - 1.0;
+      c[i] = (cols + 1)*(0.5 - 0.5*cos(6.0*x)) - 1.0;
+      t[i] = (tables + 1)*(0.5 - 0.5*cos(3.0*x)) - 1.0;
+    } else {
+      r[i] = (rows + 1)*(rand()/(double)RAND_MAX) - 1.0;
+      c[i] = (cols + 1)*(rand()/(double)RAND_MAX) - 1.0;
+      t[i] = (tables + 1)*(rand()/(double)RAND_MAX) - 1.0;
+    }
+  }
+
+  double start = getcurrentseconds();
+  for (int n=0; n<iterations; n++) {
+    for (int i=0; i<nKeys; i++) ref[i] = Reference(table, dimension, r[i], c[i], t[i]);
+  }
+  double ref_time = getcurrentseconds() - start;
+
+  start = getcurrentseconds();
+  for (int n=0; n<iterations; n++) {
+    for (int i=0; i<nKeys; i++) packed[i] = Packed(table, dimension, r[i], c[i], t[i]);
+  }
+  double packed_time = getcurrentseconds() - start;
+
+  start = getcurrentseconds();
+  for (int n=0; n<iterations; n++) {
+    Batched(table, dimension, nKeys, &r[0], &c[0], &t[0], &batched[0]);
+  }
+  double batched_time = getcurrentseconds() - start;
+
+  double packed_diff = 0.0, batched_diff = 0.0;
+  for (int i=0; i<nKeys; i++) {
+    packed_diff = max(packed_diff, fabs(packed[i] - ref[i]));
+    batched_diff = max(batched_diff, fabs(batched[i] - ref[i]));
+  }
+
+  double lookups = (double)iterations * nKeys;
+
+  cout << dimension << "D " << (sweep ? "sweep " : "random") << fixed << setprecision(2)
+       << "  reference " << setw(7) << ref_time*1e9/lookups << " ns"
+       << "  packed " << setw(7) << packed_time*1e9/lookups << " ns"
+       << "  batched " << setw(7) << batched_time*1e9/lookups << " ns"
+       << scientific << setprecision(1)
+       << "  max diff packed " << packed_diff << " batched " << batched_diff << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  int rows = argc > 1 ? atoi(argv[1]) : 20;
+  int nKeys = argc > 2 ? atoi(argv[2]) : 1024;
+  int iterations = argc > 3 ? atoi(argv[3]) : 1000;
+
+  if (rows < 2 || nKeys < 1 || iterations < 1) {
+    cerr << "Usage: bench_table [breakpoints] [keys] [iterations]" << endl;
+    return -1;
+  }
+
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+  FGPropertyManager* pm = FDMExec->GetPropertyManager();
+  pm->GetNode("bench/row", true);
+  pm->GetNode("bench/column", true);
+  pm->GetNode("bench/table", true);
+
+  cout << "Breakpoints: " << rows << ", keys: " << nKeys
+       << ", iterations: " << iterations << endl;
+
+  for (int dimension=1; dimension<=3; dimension++) {
+    FGTable* table = BuildTable(pm, dimension, rows);
+    Benchmark(table, dimension, rows, nKeys, iterations, true);
+    Benchmark(table, dimension, rows, nKeys, iterations, false);
+    delete table;
+  }
+
+  delete FDMExec;
+
+  return 0;
+}
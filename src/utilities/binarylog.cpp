@@ -0,0 +1,124 @@
+/***************************************************************************
+                          binarylog.cpp  -  description
+                             -------------------
+    begin                : Fri Oct 16 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "binarylog.h"
+#include <cstring>
+
+using namespace std;
+
+static const char magic[] = "JSBSBLOG";
+static const unsigned int header_prefix = 24;
+
+static const int endianTest = 1;
+#define isLittleEndian (*((char *) &endianTest ) != 0)
+
+static unsigned int GetLE32(const char* bytes)
+{
+  const unsigned char* b = (const unsigned char*)bytes;
+  return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int)b[3] << 24);
+}
+
+
+BinaryLog::BinaryLog() : header_size(0) {
+}
+
+
+BinaryLog::~BinaryLog() {
+  Close();
+}
+
+
+bool BinaryLog::IsBinaryLog(const string& fname) {
+  ifstream file(fname.c_str(), ios::in | ios::binary);
+  char prefix[8];
+
+  if (!file.read(prefix, sizeof(prefix))) return false;
+  return memcmp(prefix, magic, sizeof(prefix)) == 0;
+}
+
+
+bool BinaryLog::Open(const string& fname) {
+  char prefix[header_prefix];
+
+  Close();
+  f.open(fname.c_str(), ios::in | ios::binary);
+  if (!f.read(prefix, sizeof(prefix)) || memcmp(prefix, magic, 8) != 0) {
+    Close();
+    return false;
+  }
+
+  unsigned int count = GetLE32(prefix+12);
+  header_size = GetLE32(prefix+16);
+  if (header_size < header_prefix) {
+    Close();
+    return false;
+  }
+
+  vector <char> text(header_size - header_prefix + 1, '\0');
+  if (!f.read(&text[0], header_size - header_prefix)) {
+    Close();
+    return false;
+  }
+
+  // The names and the units alternate, each one terminated by a null character
+  const char* p = &text[0];
+  const char* end = p + text.size() - 1;
+  for (unsigned int i=0; i<count && p<end; i++) {
+    names.push_back(p);
+    p += names.back().size() + 1;
+    units.push_back(p < end ? p : "");
+    p += units.back().size() + 1;
+  }
+  if (names.size() != count) {
+    Close();
+    return false;
+  }
+
+  buffer.resize(count*sizeof(double));
+  return true;
+}
+
+
+void BinaryLog::Close(void) {
+  if (f.is_open()) f.close();
+  f.clear();
+  names.clear();
+  units.clear();
+  header_size = 0;
+}
+
+
+bool BinaryLog::ReadRecord(vector <double>& record) {
+  if (names.empty() || !f.read(&buffer[0], buffer.size())) return false;
+
+  record.resize(names.size());
+  if (isLittleEndian) {
+    memcpy(&record[0], &buffer[0], buffer.size());
+  } else {
+    for (unsigned int i=0; i<record.size(); i++) {
+      char* value = (char*)&record[i];
+      for (unsigned int j=0; j<sizeof(double); j++)
+        value[j] = buffer[(i+1)*sizeof(double)-1-j];
+    }
+  }
+  return true;
+}
+
+
+void BinaryLog::Rewind(void) {
+  f.clear();
+  f.seekg(header_size, ios::beg);
+}
+
@@ -0,0 +1,63 @@
+/***************************************************************************
+                          binarylog.h  -  description
+                             -------------------
+    begin                : Fri Oct 16 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BINARYLOG_H
+#define BINARYLOG_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** Reads the files written by the BINARY output type of JSBSim, one record at
+  * a time. The header gives the names and the units of the columns; each
+  * record is made of one little endian double per column. See FGOutput for
+  * the layout of the header.
+  */
+
+class BinaryLog {
+public:
+  BinaryLog();
+  ~BinaryLog();
+
+  /** Opens a file and reads its header.
+    * @return false if the file cannot be opened or is not a binary log */
+  bool Open(const std::string& fname);
+  void Close(void);
+
+  /** Reads the next record.
+    * @param record receives one value per column
+    * @return false at the end of the file */
+  bool ReadRecord(std::vector <double>& record);
+  /// Goes back to the first record.
+  void Rewind(void);
+
+  unsigned int GetNumColumns(void) const {return names.size();}
+  const std::vector <std::string>& GetNames(void) const {return names;}
+  const std::vector <std::string>& GetUnits(void) const {return units;}
+  /// The offset of the first record in the file, in bytes.
+  unsigned int GetHeaderSize(void) const {return header_size;}
+
+  /// Returns true if a file begins like a binary log.
+  static bool IsBinaryLog(const std::string& fname);
+
+private:
+  std::ifstream f;
+  std::vector <std::string> names;
+  std::vector <std::string> units;
+  std::vector <char> buffer;
+  unsigned int header_size;
+};
+#endif
+
@@ -0,0 +1,142 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       binlog2csv.cpp
+ Purpose:      Converts a binary log written by JSBSim to CSV
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+binlog2csv reads a file written by an output of type BINARY and writes the same
+columns as a CSV file: a header line with the names of the columns followed by
+one line per record. The values are written with 17 significant digits by
+default, which is enough to read them back exactly.
+
+Usage:
+
+  binlog2csv <binary log> [output.csv] [--precision=<digits>] [--units]
+
+The CSV goes to the standard output when no output file is given. With --units,
+a second header line gives the unit of each column.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "binarylog.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  #define snprintf _snprintf
+#endif
+
+using namespace std;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+int main(int argc, char **argv)
+{
+  string input, output;
+  int precision = 17;
+  bool with_units = false;
+
+  for (int i=1; i<argc; i++) {
+    string arg(argv[i]);
+    if (arg.substr(0,12) == "--precision=") {
+      precision = atoi(arg.substr(12).c_str());
+    } else if (arg == "--units") {
+      with_units = true;
+    } else if (input.empty()) {
+      input = arg;
+    } else if (output.empty()) {
+      output = arg;
+    } else {
+      cerr << "Unknown argument " << arg << endl;
+      exit(-1);
+    }
+  }
+
+  if (input.empty()) {
+    cerr << "Usage: binlog2csv <binary log> [output.csv] [--precision=<digits>] [--units]" << endl;
+    exit(-1);
+  }
+  if (precision < 1 || precision > 17) precision = 17;
+
+  BinaryLog log;
+  if (!log.Open(input)) {
+    cerr << "Could not read the binary log " << input << endl;
+    exit(-1);
+  }
+
+  ofstream outfile;
+  if (!output.empty()) {
+    outfile.open(output.c_str());
+    if (!outfile) {
+      cerr << "Could not create file: " << output << endl;
+      exit(-1);
+    }
+  }
+  ostream& out = output.empty() ? cout : outfile;
+
+  const vector <string>& names = log.GetNames();
+  for (unsigned int i=0; i<names.size(); i++) {
+    if (i > 0) out << ", ";
+    out << names[i];
+  }
+  out << '\n';
+
+  if (with_units) {
+    const vector <string>& units = log.GetUnits();
+    for (unsigned int i=0; i<units.size(); i++) {
+      if (i > 0) out << ", ";
+      out << units[i];
+    }
+    out << '\n';
+  }
+
+  vector <double> record;
+  string line;
+  char buf[32];
+  unsigned long count = 0;
+
+  while (log.ReadRecord(record)) {
+    line.clear();
+    for (unsigned int i=0; i<record.size(); i++) {
+      if (i > 0) line += ", ";
+      int n = snprintf(buf, sizeof(buf), "%.*g", precision, record[i]);
+      if (n < 0 || n > (int)sizeof(buf)-1) n = sizeof(buf)-1;
+      line.append(buf, n);
+    }
+    line += '\n';
+    out.write(line.data(), line.size());
+    count++;
+  }
+
+  cerr << count << " records of " << names.size() << " columns converted" << endl;
+
+  return 0;
+}
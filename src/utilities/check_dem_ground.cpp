@@ -0,0 +1,211 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       check_dem_ground.cpp
+ Purpose:      Checks the ground of FGDEMGroundCallback where a tile is missing
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+check_dem_ground writes, in a temporary directory, the tile N37W122 of a flat
+terrain 100 m above the geoid, and a geoid.txt that gives it an undulation of
+-32.5 m, the other tiles -30 m. The tile N37W121, east of it, is missing, as a
+coast is in SRTM. It checks that:
+
+- the ground of the tile is 67.5 m above the ellipsoid, and the ground east of
+  the edge is the geoid of the missing tile, 30 m below the ellipsoid: there
+  is no step larger than the terrain itself at the edge;
+- the sea level of the missing tile is the ellipsoid lowered by 30 m;
+- the c172x, given an altitude of 1000 ft above sea level on either side of
+  the edge, starts 1000 ft above the geoid, over the terrain that is there.
+
+The program exits with a non zero status if a check fails.
+
+Usage (from the JSBSim root directory):
+
+  check_dem_ground
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "models/FGInertial.h"
+#include "models/FGPropagate.h"
+#include "input_output/FGDEMGroundCallback.h"
+#include "initialization/FGInitialCondition.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+const double FtToM = 0.3048;
+const double DegToRad = M_PI/180.0;
+const double Terrain = 100.0;          // m above the geoid, in N37W122
+const double TileUndulation = -32.5;   // m, of N37W122
+const double DefaultUndulation = -30.0; // m, of the other tiles
+const double Latitude = 37.5;
+const unsigned int Samples = 11;
+
+int failures = 0;
+
+void Check(const string& what, double value, double expected, double tolerance)
+{
+  cout << what << ": " << value << " (expected " << expected << ")" << endl;
+  if (fabs(value - expected) > tolerance) {
+    cerr << "  Off by more than " << tolerance << endl;
+    failures++;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool WriteTiles(const string& directory)
+{
+  ofstream tile((directory + "/N37W122.hgt").c_str(), ios::binary);
+  for (unsigned int i=0; i<Samples*Samples; i++) {
+    int sample = (int)Terrain;
+    tile.put((char)((sample >> 8) & 0xff));
+    tile.put((char)(sample & 0xff));
+  }
+  ofstream geoid((directory + "/geoid.txt").c_str());
+  geoid << "default " << DefaultUndulation << endl
+        << "N37W122 " << TileUndulation << endl;
+  return tile.good() && geoid.good();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Checks the callback alone, 1000 ft above the ellipsoid on both sides of the
+// edge between the tile and the missing one.
+void CheckEdge(const FGDEMGroundCallback& ground, double a, double b)
+{
+  FGLocation loc, contact;
+  FGColumnVector3 normal, vel;
+  loc.SetEllipse(a, b);
+
+  loc.SetPositionGeodetic(-121.0001*DegToRad, Latitude*DegToRad, 1000.0);
+  double west = ground.GetAGLevel(0.0, loc, contact, normal, vel);
+  Check("Height above the tile (ft)", west,
+        1000.0 - (Terrain + TileUndulation)/FtToM, 0.1);
+  double westRadius = contact.GetRadius();
+
+  loc.SetPositionGeodetic(-120.9999*DegToRad, Latitude*DegToRad, 1000.0);
+  double east = ground.GetAGLevel(0.0, loc, contact, normal, vel);
+  Check("Height above the missing tile (ft)", east,
+        1000.0 - DefaultUndulation/FtToM, 0.1);
+  Check("Step of the ground at the edge (ft)", westRadius - contact.GetRadius(),
+        (Terrain + TileUndulation - DefaultUndulation)/FtToM, 1.0);
+
+  FGLocation geoid;
+  geoid.SetEllipse(a, b);
+  geoid.SetPositionGeodetic(-120.5*DegToRad, Latitude*DegToRad, DefaultUndulation/FtToM);
+  double radius = 0.0;
+  if (!ground.GetSeaLevelRadius(geoid, radius)) {
+    cerr << "The terrain does not know its sea level" << endl;
+    failures++;
+  }
+  Check("Sea level radius of the missing tile (ft)", radius, geoid.GetRadius(), 0.01);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Starts the c172x 1000 ft above sea level at a longitude, and checks its
+// height above the ground there.
+bool CheckStart(const string& directory, double longitude, double undulation,
+                double terrain)
+{
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+
+  if (!FDMExec->LoadModel("aircraft", "engine", "systems", "c172x")) {
+    cerr << "The c172x aircraft was not successfully loaded" << endl;
+    delete FDMExec;
+    return false;
+  }
+
+  FGInertial* Inertial = FDMExec->GetInertial();
+  FDMExec->SetGroundCallback(new FGDEMGroundCallback(directory,
+                               Inertial->GetRefRadius(), Inertial->GetSemimajor(),
+                               Inertial->GetSemiminor()));
+
+  FGInitialCondition* IC = FDMExec->GetIC();
+  IC->SetLatitudeDegIC(Latitude);
+  IC->SetLongitudeDegIC(longitude);
+  IC->SetAltitudeASLFtIC(1000.0);
+  IC->SetVtrueKtsIC(0.0);
+
+  FDMExec->DisableOutput();
+  FDMExec->RunIC();
+
+  FGPropagate* Propagate = FDMExec->GetPropagate();
+  Check("  Altitude above sea level (ft)", Propagate->GetAltitudeASL(), 1000.0, 0.1);
+  Check("  Altitude above the ellipsoid (ft)",
+        Propagate->GetLocation().GetGeodAltitude(), 1000.0 + undulation/FtToM, 1.0);
+  Check("  Altitude above ground (ft)", Propagate->GetDistanceAGL(),
+        1000.0 - terrain/FtToM, 1.0);
+
+  delete FDMExec;
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main()
+{
+  char name[] = "/tmp/check_dem_ground.XXXXXX";
+  if (mkdtemp(name) == 0) {
+    cerr << "Could not create a directory for the terrain tiles" << endl;
+    return -1;
+  }
+  string directory = name;
+
+  bool ok = WriteTiles(directory);
+  if (!ok) cerr << "Could not write the terrain tiles in " << directory << endl;
+
+  if (ok) {
+    // WGS84, in feet
+    double a = 20925646.3255, b = 20855486.5951;
+    FGDEMGroundCallback ground(directory, 20925650.0, a, b);
+    CheckEdge(ground, a, b);
+
+    cout << "The c172x over the tile:" << endl;
+    ok = CheckStart(directory, -121.5, TileUndulation, Terrain);
+    cout << "The c172x over the missing tile:" << endl;
+    ok = ok && CheckStart(directory, -120.5, DefaultUndulation, 0.0);
+  }
+
+  remove((directory + "/N37W122.hgt").c_str());
+  remove((directory + "/geoid.txt").c_str());
+  rmdir(directory.c_str());
+
+  if (!ok) return -1;
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       check_ground_cull.cpp
+ Purpose:      Checks the culling of the airborne gear units
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+check_ground_cull sets the c172x on a high plateau (13000 ft, at the equator)
+modeled by a ground callback derived from FGGroundCallback, and checks how
+FGGroundReactions culls the gear units that are above any ground:
+
+- the callback overrides GetAGLevel() only, so it gives no bound of the
+  ground: the aircraft must rest on the plateau, its gear being queried;
+- the callback also overrides GetMaxTerrainGeoCentRadius(), with the radius of
+  the plateau: the aircraft flying 3000 ft above it must not query the ground
+  for its gear, and must still rest on the plateau when released on it.
+
+The program exits with a non zero status if a check fails.
+
+Usage (from the JSBSim root directory):
+
+  check_ground_cull
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "models/FGInertial.h"
+#include "models/FGPropagate.h"
+#include "input_output/FGGroundCallback.h"
+#include "initialization/FGInitialCondition.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+const double Elevation = 13000.0;
+
+// A ball higher than the sea level by Elevation, that counts the gear queries
+class PlateauGroundCallback : public FGGroundCallback
+{
+public:
+  PlateauGroundCallback(double ReferenceRadius)
+    : FGGroundCallback(ReferenceRadius), Queries(0) {}
+
+  double GetAGLevel(double /*t*/, const FGLocation& l, FGLocation& cont,
+                    FGColumnVector3& n, FGColumnVector3& v) const {
+    double radius = GetTerrainGeoCentRadius() + Elevation;
+    v = FGColumnVector3(0.0, 0.0, 0.0);
+    n = FGColumnVector3(l).Normalize();
+    cont = (radius/l.GetRadius())*FGColumnVector3(l);
+    return l.GetRadius() - radius;
+  }
+
+  void GetAGLevels(double t, unsigned int count, const FGLocation* l,
+                   double* agl, FGLocation* cont, FGColumnVector3* n,
+                   FGColumnVector3* v) const {
+    Queries += count;
+    FGGroundCallback::GetAGLevels(t, count, l, agl, cont, n, v);
+  }
+
+  mutable unsigned long Queries;
+};
+
+// The same ground, which also bounds itself
+class BoundedPlateauGroundCallback : public PlateauGroundCallback
+{
+public:
+  BoundedPlateauGroundCallback(double ReferenceRadius)
+    : PlateauGroundCallback(ReferenceRadius) {}
+
+  double GetMaxTerrainGeoCentRadius(const FGLocation& /*l*/, double /*distance*/) const {
+    return GetTerrainGeoCentRadius() + Elevation;
+  }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Runs the c172x from a height above the plateau for a duration; returns the
+// number of gear queries and the final height.
+bool Fly(bool bounded, double height, double duration, unsigned long& queries,
+         double& final)
+{
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+
+  if (!FDMExec->LoadModel("aircraft", "engine", "systems", "c172x")) {
+    cerr << "The c172x aircraft was not successfully loaded" << endl;
+    delete FDMExec;
+    return false;
+  }
+
+  double radius = FDMExec->GetInertial()->GetRefRadius();
+  PlateauGroundCallback* ground = bounded ? new BoundedPlateauGroundCallback(radius)
+                                          : new PlateauGroundCallback(radius);
+  FDMExec->SetGroundCallback(ground);
+
+  FGInitialCondition* IC = FDMExec->GetIC();
+  IC->SetLatitudeDegIC(0.0);
+  IC->SetLongitudeDegIC(-78.0);
+  IC->SetAltitudeASLFtIC(Elevation + height);
+  IC->SetVtrueKtsIC(0.0);
+
+  FDMExec->DisableOutput();
+  FDMExec->RunIC();
+
+  ground->Queries = 0;
+  while (FDMExec->GetSimTime() < duration) FDMExec->Run();
+
+  queries = ground->Queries;
+  final = FDMExec->GetPropagate()->GetAltitudeASL() - Elevation;
+
+  delete FDMExec;
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main()
+{
+  int failures = 0;
+  unsigned long queries;
+  double height;
+
+  // No bound: the plateau is queried and holds the aircraft
+  if (!Fly(false, 5.0, 5.0, queries, height)) return -1;
+  cout << "Unbounded ground, on the plateau: " << queries << " queries, height "
+       << height << " ft" << endl;
+  if (queries == 0 || height < 0.0) {
+    cerr << "  The aircraft fell through the ground" << endl;
+    failures++;
+  }
+
+  // Bound: no query 3000 ft above the plateau ...
+  if (!Fly(true, 3000.0, 1.0, queries, height)) return -1;
+  cout << "Bounded ground, 3000 ft above the plateau: " << queries << " queries" << endl;
+  if (queries != 0) {
+    cerr << "  The gear units were not culled" << endl;
+    failures++;
+  }
+
+  // ... and the plateau still holds the aircraft
+  if (!Fly(true, 5.0, 5.0, queries, height)) return -1;
+  cout << "Bounded ground, on the plateau: " << queries << " queries, height "
+       << height << " ft" << endl;
+  if (queries == 0 || height < 0.0) {
+    cerr << "  The aircraft fell through the ground" << endl;
+    failures++;
+  }
+
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       check_random.cpp
+ Purpose:      Checks FGRandom and the reproducibility of the turbulence
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+check_random checks that:
+
+- FGRandom::Block() gives the known answers of Philox4x32-10 published with
+  the Random123 library (kat_vectors);
+- the Milspec turbulence of the c172x depends on its seed and stream only:
+  two instances with the same seed and stream, run frame by frame in turn,
+  both give the turbulence of an instance run alone.
+
+The program exits with a non zero status if a check fails.
+
+Usage (from the JSBSim root directory):
+
+  check_random
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "math/FGRandom.h"
+#include "initialization/FGInitialCondition.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Random123 kat_vectors, philox4x32 10: counter, key, expected output
+struct KnownAnswer {
+  unsigned int counter[4];
+  unsigned int key[2];
+  unsigned int out[4];
+};
+
+const KnownAnswer Philox[] = {
+  {{0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U},
+   {0x00000000U, 0x00000000U},
+   {0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}},
+  {{0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU},
+   {0xffffffffU, 0xffffffffU},
+   {0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}},
+  {{0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U},
+   {0xa4093822U, 0x299f31d0U},
+   {0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U}}
+};
+
+const int Frames = 600;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int CheckPhilox(void)
+{
+  int failures = 0;
+
+  for (unsigned int i=0; i<sizeof(Philox)/sizeof(Philox[0]); i++) {
+    unsigned int out[4];
+    FGRandom::Block(Philox[i].counter, Philox[i].key, out);
+    cout << "Philox4x32-10 vector " << i << ":" << hex << setfill('0');
+    bool ok = true;
+    for (int j=0; j<4; j++) {
+      cout << " " << setw(8) << out[j];
+      if (out[j] != Philox[i].out[j]) ok = false;
+    }
+    cout << dec << setfill(' ') << endl;
+    if (!ok) {
+      cerr << "  Not the known answer" << endl;
+      failures++;
+    }
+  }
+
+  return failures;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The c172x cruising in moderate Milspec turbulence
+FGFDMExec* Cruise(unsigned long seed, unsigned int stream)
+{
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+
+  if (!FDMExec->LoadModel("aircraft", "engine", "systems", "c172x")) {
+    cerr << "The c172x aircraft was not successfully loaded" << endl;
+    delete FDMExec;
+    return 0;
+  }
+
+  FDMExec->SetRandomSeed(seed, stream);
+  FDMExec->SetPropertyValue("atmosphere/turb-type", 4); // ttMilspec
+  FDMExec->SetPropertyValue("atmosphere/turbulence/milspec/severity", 4);
+  FDMExec->SetPropertyValue("atmosphere/turbulence/milspec/windspeed_at_20ft_AGL-fps", 30.0);
+
+  FGInitialCondition* IC = FDMExec->GetIC();
+  IC->SetAltitudeASLFtIC(3000.0);
+  IC->SetVtrueKtsIC(100.0);
+
+  FDMExec->DisableOutput();
+  FDMExec->RunIC();
+  return FDMExec;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double Turbulence(FGFDMExec* FDMExec)
+{
+  return FDMExec->GetPropertyValue("atmosphere/turb-north-fps")
+       + FDMExec->GetPropertyValue("atmosphere/turb-east-fps")
+       + FDMExec->GetPropertyValue("atmosphere/turb-down-fps");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int CheckTurbulence(void)
+{
+  vector <double> alone(Frames);
+  FGFDMExec* single = Cruise(7, 3);
+  if (single == 0) return 1;
+  for (int i=0; i<Frames; i++) {
+    single->Run();
+    alone[i] = Turbulence(single);
+  }
+  delete single;
+
+  FGFDMExec* first = Cruise(7, 3);
+  FGFDMExec* second = Cruise(7, 3);
+  if (first == 0 || second == 0) return 1;
+
+  int mismatches = 0;
+  bool moving = false;
+  for (int i=0; i<Frames; i++) {
+    first->Run();
+    second->Run();
+    if (Turbulence(first) != alone[i] || Turbulence(second) != alone[i]) mismatches++;
+    if (alone[i] != 0.0) moving = true;
+  }
+  delete first;
+  delete second;
+
+  cout << "Turbulence of two instances run in turn: " << mismatches
+       << " frames of " << Frames << " differ from an instance run alone" << endl;
+  if (!moving) {
+    cerr << "  There was no turbulence" << endl;
+    return 1;
+  }
+  if (mismatches > 0) {
+    cerr << "  The turbulence depends on the other instance" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main()
+{
+  int failures = CheckPhilox();
+  failures += CheckTurbulence();
+
+  return failures > 0 ? 1 : 0;
+}
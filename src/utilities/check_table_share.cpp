@@ -0,0 +1,199 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       check_table_share.cpp
+ Purpose:      Checks the copies of a table bound to other instances
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+check_table_share reads a named 2D table once, in the property tree of a first
+FGFDMExec, and copies it for two other instances, as a batch run would share
+the tables of an aircraft between its runs. It checks that:
+
+- a copy looks up the properties of its own instance, and is tied in its tree;
+- the copies, looked up at the same time from two threads with different
+  keys, give the values of the original for these keys.
+
+The program exits with a non zero status if a check fails.
+
+Usage:
+
+  check_table_share
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "math/FGTable.h"
+#include "input_output/FGXMLParse.h"
+#include "input_output/FGPropertyManager.h"
+
+#include <pthread.h>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+const int Rows = 20;
+const int Columns = 10;
+const int Keys = 20000;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGTable* ReadTable(FGPropertyManager* pm)
+{
+  ostringstream xml;
+
+  xml << "<table name=\"check/table\">" << endl;
+  xml << "  <independentVar lookup=\"row\">check/row</independentVar>" << endl;
+  xml << "  <independentVar lookup=\"column\">check/column</independentVar>" << endl;
+  xml << "  <tableData>" << endl;
+  xml << "        ";
+  for (int c=0; c<Columns; c++) xml << " " << c;
+  xml << endl;
+  for (int r=0; r<Rows; r++) {
+    xml << "    " << r;
+    for (int c=0; c<Columns; c++) xml << " " << sin(0.3*r + 0.1*c*c);
+    xml << endl;
+  }
+  xml << "  </tableData>" << endl;
+  xml << "</table>" << endl;
+
+  istringstream input(xml.str());
+  FGXMLParse parser;
+  readXML(input, parser);
+
+  return new FGTable(pm, parser.GetDocument());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CreateKeys(FGPropertyManager* pm)
+{
+  pm->GetNode("check/row", true)->setDoubleValue(0.0);
+  pm->GetNode("check/column", true)->setDoubleValue(0.0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The work of a thread: sweeps the keys of an instance across the table, in
+// its own direction, and counts the values that differ from the original.
+struct Sweep {
+  FGPropertyManager* pm;
+  const FGTable* table;
+  const FGTable* original;
+  bool forward;
+  int mismatches;
+};
+
+void* SweepTable(void* arg)
+{
+  Sweep* sweep = (Sweep*)arg;
+  FGPropertyManager* row = sweep->pm->GetNode("check/row");
+  FGPropertyManager* column = sweep->pm->GetNode("check/column");
+  FGTable::Cursor cursor;
+
+  for (int i=0; i<Keys; i++) {
+    double x = (double)(sweep->forward ? i : Keys - i)/Keys;
+    double r = (Rows + 1)*x - 1.0;
+    double c = (Columns + 1)*(0.5 - 0.5*cos(6.0*x)) - 1.0;
+    row->setDoubleValue(r);
+    column->setDoubleValue(c);
+    if (sweep->table->GetValue() != sweep->original->GetValue(cursor, r, c))
+      sweep->mismatches++;
+  }
+  return 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main()
+{
+  int failures = 0;
+  vector <FGFDMExec*> FDMExec(3);
+
+  for (unsigned int i=0; i<FDMExec.size(); i++) {
+    FDMExec[i] = new FGFDMExec();
+    FDMExec[i]->SetDebugLevel(0);
+    CreateKeys(FDMExec[i]->GetPropertyManager());
+  }
+
+  FGTable* original = ReadTable(FDMExec[0]->GetPropertyManager());
+  vector <FGTable*> copies;
+  for (unsigned int i=1; i<FDMExec.size(); i++)
+    copies.push_back(new FGTable(*original, FDMExec[i]->GetPropertyManager()));
+
+  // A copy follows the keys of its own instance.
+  FDMExec[0]->SetPropertyValue("check/row", 3.0);
+  FDMExec[0]->SetPropertyValue("check/column", 2.0);
+  FDMExec[1]->SetPropertyValue("check/row", 11.5);
+  FDMExec[1]->SetPropertyValue("check/column", 7.25);
+  double expected = original->GetValue(11.5, 7.25);
+  cout << "Copy for the second instance: " << copies[0]->GetValue()
+       << " (expected " << expected << ")" << endl;
+  if (copies[0]->GetValue() != expected) {
+    cerr << "  The copy does not look up the properties of its instance" << endl;
+    failures++;
+  }
+  cout << "Property check/table of the second instance: "
+       << FDMExec[1]->GetPropertyValue("check/table") << endl;
+  if (FDMExec[1]->GetPropertyValue("check/table") != expected) {
+    cerr << "  The copy is not tied in the tree of its instance" << endl;
+    failures++;
+  }
+  if (original->GetValue() != original->GetValue(3.0, 2.0)) {
+    cerr << "  The original does not look up its own properties anymore" << endl;
+    failures++;
+  }
+
+  // Both copies at the same time, with different keys.
+  vector <Sweep> sweeps(copies.size());
+  vector <pthread_t> threads(copies.size());
+  for (unsigned int i=0; i<copies.size(); i++) {
+    sweeps[i].pm = FDMExec[i+1]->GetPropertyManager();
+    sweeps[i].table = copies[i];
+    sweeps[i].original = original;
+    sweeps[i].forward = (i % 2 == 0);
+    sweeps[i].mismatches = 0;
+    pthread_create(&threads[i], 0, SweepTable, &sweeps[i]);
+  }
+  for (unsigned int i=0; i<copies.size(); i++) {
+    pthread_join(threads[i], 0);
+    cout << "Copy " << i << " looked up concurrently: " << sweeps[i].mismatches
+         << " values of " << Keys << " differ from the original" << endl;
+    if (sweeps[i].mismatches > 0) failures++;
+  }
+
+  // The instances untie the tables, so they go first.
+  for (unsigned int i=0; i<FDMExec.size(); i++) delete FDMExec[i];
+  for (unsigned int i=0; i<copies.size(); i++) delete copies[i];
+  delete original;
+
+  return failures > 0 ? 1 : 0;
+}
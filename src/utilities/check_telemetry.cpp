@@ -0,0 +1,210 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       check_telemetry.cpp
+ Purpose:      Checks the subscription handshake of the telemetry output
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+check_telemetry serves a property with FGfdmTelemetry on the loopback
+interface, at an output rate of 60 Hz, and subscribes to it from a client on
+the same machine. It checks that:
+
+- a SUBSCRIBE without the cookie of the client (or with a wrong one) is only
+  answered by a CHALLENGE, not larger than the SUBSCRIBE, and creates no
+  subscription;
+- the same SUBSCRIBE with the cookie of the CHALLENGE is served: the client
+  gets a SUBSCRIBED, with the rate of 1000 Hz it asked for capped at 60 Hz,
+  then an UPDATE at every frame of the output.
+
+The program exits with a non zero status if a check fails.
+
+Usage:
+
+  check_telemetry
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGFDMExec.h"
+#include "input_output/FGfdmTelemetry.h"
+#include "input_output/FGPropertyManager.h"
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <iostream>
+#include <string>
+#include <cstring>
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+const int FirstPort = 15700;
+const double OutputRate = 60.0;
+const unsigned int Id = 42;
+
+enum {msgSubscribe=1, msgSubscribed, msgUnsubscribe, msgKeyframe, msgUpdate, msgError,
+      msgChallenge};
+
+int failures = 0;
+
+void Check(const string& what, bool ok)
+{
+  cout << what << ": " << (ok ? "yes" : "no") << endl;
+  if (!ok) failures++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The messages are little endian: so is the machine the test runs on.
+
+void Append32(string& buf, unsigned int value)
+{
+  buf.append((const char*)&value, 4);
+}
+
+unsigned int Get32(const string& buf, size_t offset)
+{
+  unsigned int value = 0;
+  if (buf.size() >= offset + 4) memcpy(&value, buf.data() + offset, 4);
+  return value;
+}
+
+string Subscription(unsigned int cookie)
+{
+  string msg;
+  double deadband = 0.0;
+
+  Append32(msg, 0);
+  Append32(msg, msgSubscribe);
+  Append32(msg, Id);
+  Append32(msg, cookie);
+  Append32(msg, 1000); // Hz
+  Append32(msg, 0);
+  Append32(msg, 1);
+  msg.append((const char*)&deadband, 8);
+  msg.append("check/value", 12);
+  unsigned int size = (unsigned int)msg.size();
+  memcpy(&msg[0], &size, 4);
+  return msg;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The telemetry sends from within Run(), so its datagrams are already queued
+// on the loopback interface when this is called.
+
+string Receive(int sckt)
+{
+  char buf[2048];
+  ssize_t size = recv(sckt, buf, sizeof(buf), MSG_DONTWAIT);
+  return size > 0 ? string(buf, size) : string();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main()
+{
+  FGFDMExec* FDMExec = new FGFDMExec();
+  FDMExec->SetDebugLevel(0);
+  FGPropertyManager* pm = FDMExec->GetPropertyManager();
+  pm->GetNode("check/value", true)->setDoubleValue(0.0);
+
+  FGfdmTelemetry* telemetry = 0;
+  int port = FirstPort;
+  for (; port < FirstPort + 20; port++) {
+    telemetry = new FGfdmTelemetry(pm, "", port);
+    if (telemetry->IsListening()) break;
+    delete telemetry;
+    telemetry = 0;
+  }
+  int client = socket(AF_INET, SOCK_DGRAM, 0);
+  if (telemetry == 0 || client < 0) {
+    cerr << "Could not open the sockets" << endl;
+    delete FDMExec;
+    return -1;
+  }
+
+  struct sockaddr_in server;
+  memset(&server, 0, sizeof(server));
+  server.sin_family = AF_INET;
+  server.sin_port = htons(port);
+  server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  connect(client, (struct sockaddr*)&server, sizeof(server));
+
+  double time = 0.0, dt = 1.0/OutputRate;
+
+  // Without the cookie
+  string request = Subscription(0);
+  send(client, request.data(), request.size(), 0);
+  telemetry->Run(time, OutputRate);
+  string reply = Receive(client);
+  unsigned int cookie = Get32(reply, 12);
+  Check("A SUBSCRIBE without cookie is challenged", Get32(reply, 4) == msgChallenge
+        && Get32(reply, 8) == Id && cookie != 0);
+  Check("The CHALLENGE is not larger than the SUBSCRIBE", reply.size() <= request.size());
+  Check("No subscription is made without cookie", telemetry->GetNumSubscriptions() == 0);
+  Check("Nothing else is sent", Receive(client).empty());
+
+  // With a wrong cookie
+  request = Subscription(cookie + 1);
+  send(client, request.data(), request.size(), 0);
+  time += dt;
+  telemetry->Run(time, OutputRate);
+  reply = Receive(client);
+  Check("A SUBSCRIBE with a wrong cookie is challenged", Get32(reply, 4) == msgChallenge
+        && Get32(reply, 12) == cookie);
+  Check("No subscription is made with a wrong cookie", telemetry->GetNumSubscriptions() == 0);
+
+  // With the cookie
+  request = Subscription(cookie);
+  send(client, request.data(), request.size(), 0);
+  time += dt;
+  telemetry->Run(time, OutputRate);
+  reply = Receive(client);
+  double rate = 0.0;
+  if (reply.size() >= 24) memcpy(&rate, reply.data() + 16, 8);
+  Check("A SUBSCRIBE with the cookie is served", Get32(reply, 4) == msgSubscribed
+        && telemetry->GetNumSubscriptions() == 1);
+  cout << "Rate served: " << rate << " Hz (1000 Hz asked)" << endl;
+  Check("The rate is capped at the rate of the output", rate == OutputRate);
+
+  int updates = Get32(Receive(client), 4) == msgUpdate ? 1 : 0;
+  for (int i=0; i<10; i++) {
+    time += dt;
+    pm->GetNode("check/value")->setDoubleValue(i + 1.0);
+    telemetry->Run(time, OutputRate);
+    if (Get32(Receive(client), 4) == msgUpdate) updates++;
+  }
+  cout << "Updates: " << updates << " in 11 frames of the output" << endl;
+  Check("An UPDATE is sent at every frame", updates == 11);
+
+  close(client);
+  delete telemetry;
+  delete FDMExec;
+
+  return failures > 0 ? 1 : 0;
+}
@@ -16,110 +16,302 @@
  ***************************************************************************/
 
 #include "datafile.h"
+#include "binarylog.h"
+#include <cstring>
+#include <cstdlib>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+static const int endianTest = 1;
+#define isLittleEndian (*((char *) &endianTest ) != 0)
+
+/** Finds the minimum and the maximum of n values in a single pass. The four
+    independent accumulators let the compiler keep the loop in vector
+    registers instead of waiting on one comparison after the other. */
+
+static void MinMax(const double* v, size_t n, double& min, double& max)
+{
+  if (n == 0) {
+    min = max = 0.0;
+    return;
+  }
 
-DataFile::DataFile() {
+  double mn0 = v[0], mn1 = v[0], mn2 = v[0], mn3 = v[0];
+  double mx0 = v[0], mx1 = v[0], mx2 = v[0], mx3 = v[0];
+  size_t i = 0;
+
+  for (; i+4 <= n; i+=4) {
+    mn0 = v[i]   < mn0 ? v[i]   : mn0;
+    mn1 = v[i+1] < mn1 ? v[i+1] : mn1;
+    mn2 = v[i+2] < mn2 ? v[i+2] : mn2;
+    mn3 = v[i+3] < mn3 ? v[i+3] : mn3;
+    mx0 = v[i]   > mx0 ? v[i]   : mx0;
+    mx1 = v[i+1] > mx1 ? v[i+1] : mx1;
+    mx2 = v[i+2] > mx2 ? v[i+2] : mx2;
+    mx3 = v[i+3] > mx3 ? v[i+3] : mx3;
+  }
+  for (; i < n; i++) {
+    mn0 = v[i] < mn0 ? v[i] : mn0;
+    mx0 = v[i] > mx0 ? v[i] : mx0;
+  }
 
+  mn0 = mn1 < mn0 ? mn1 : mn0;
+  mn2 = mn3 < mn2 ? mn3 : mn2;
+  mx0 = mx1 > mx0 ? mx1 : mx0;
+  mx2 = mx3 > mx2 ? mx3 : mx2;
+  min = mn2 < mn0 ? mn2 : mn0;
+  max = mx2 > mx0 ? mx2 : mx0;
+}
+
+
+DataFile::DataFile() : base(0), length(0), data_start(0), binary(false),
+                       indexed(false), StartIdx(0), EndIdx(-1) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  file_handle = mapping_handle = 0;
+#endif
 }
 
 
 DataFile::~DataFile() {
-  f.close();
+  Unmap();
+}
+
+
+/** This overloaded constructor opens the requested file, either a CSV file or
+    a binary log. Only the names of the columns are read here. */
+
+DataFile::DataFile(string fname) : base(0), length(0), data_start(0), binary(false),
+                                   indexed(false), StartIdx(0), EndIdx(-1) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  file_handle = mapping_handle = 0;
+#endif
+
+  Map(fname);
+  cout << "File " << fname << " successfully opened." << endl;
+
+  BinaryLog log;
+  if (length >= 8 && log.Open(fname)) {
+    binary = true;
+    names = log.GetNames();
+    data_start = log.GetHeaderSize();
+    log.Close();
+  } else {
+    const char* eol = (const char*)memchr(base, '\n', length);
+    data_start = eol ? eol - base + 1 : length;
+    data_str.assign(base ? base : "", eol ? eol - base : length);
+
+    size_t start, end = 0;
+    while (1) {
+      start = end;
+      while (start < data_str.size() && data_str[start] == ' ') start++;
+      end = data_str.find(",", start);
+      if (end == string::npos) {
+        end = data_str.size();
+        if (end > start && data_str[end-1] == '\r') end--;
+        names.push_back(data_str.substr(start, end-start));
+        break;
+      } else {
+        names.push_back(data_str.substr(start, end-start));
+        end++;
+      }
+    }
+  }
+
+  Columns.resize(names.size());
+  Max.resize(names.size(), 0.0);
+  Min.resize(names.size(), 0.0);
+
+  cout << "Done parsing names." << endl;
 }
 
 
-/** This overloaded constructor opens the requested file. */
+void DataFile::Map(const string& fname) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  HANDLE file = CreateFileA(fname.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+  if (file == INVALID_HANDLE_VALUE) {
+    cout << "fileopen failed for file " << fname << endl << endl;
+    exit(-1);
+  }
+  file_handle = file;
 
-DataFile::DataFile(string fname) {
-  int count=0;
-  unsigned short start, end;
-  string var;
+  LARGE_INTEGER size;
+  GetFileSizeEx(file, &size);
+  length = (size_t)size.QuadPart;
+  if (length == 0) return;
 
-  f.open(fname.c_str());
-  f.setf(ios::skipws);
-  if ( !f ) {
+  HANDLE mapping = CreateFileMapping(file, 0, PAGE_READONLY, 0, 0, 0);
+  if (mapping) {
+    mapping_handle = mapping;
+    base = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  }
+#else
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
     cout << "fileopen failed for file " << fname << endl << endl;
     exit(-1);
-  } else {
-    cout << "File " << fname << " successfully opened." << endl;
   }
 
-  getline(f, data_str);
-  end = 0;
-
-  while (1) {
-    start = end;
-    while (data_str[start] == ' ') start++;
-    end = data_str.find(",", start);
-    count++;
-    if (end >= 65535) {
-      end = data_str.size();
-      var = data_str.substr(start, end-start);
-      names.push_back(var);
-      break;
-    } else {
-      var = data_str.substr(start, end-start);
-      names.push_back(var);
-      end++;
+  struct stat st;
+  if (fstat(fd, &st) == 0) length = st.st_size;
+  if (length > 0) {
+    void* p = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      base = (const char*)p;
+#if defined(MADV_SEQUENTIAL)
+      madvise(p, length, MADV_SEQUENTIAL);
+#endif
     }
   }
+  close(fd);
+#endif
+
+  if (length > 0 && base == 0) {
+    cout << "Could not map file " << fname << " in memory" << endl << endl;
+    exit(-1);
+  }
+}
 
-  cout << "Done parsing names. Reading data ..." << endl;
 
-  int row=0, column=0;
-  char scratch[10];
+void DataFile::Unmap(void) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  if (base) UnmapViewOfFile(base);
+  if (mapping_handle) CloseHandle((HANDLE)mapping_handle);
+  if (file_handle) CloseHandle((HANDLE)file_handle);
+  file_handle = mapping_handle = 0;
+#else
+  if (base) munmap((void*)base, length);
+#endif
+  base = 0;
+  length = 0;
+}
 
-  while (1) {
-    column = 0;
-    Data.push_back(*(new Row()));
-    while (1) {
-      Data[row].push_back(0.0);
-      f >> Data[row][column];
-      if (f.eof()) {
-        Data.pop_back();
-        break;
-      }
-      if (++column == count) break;
-      else f >> scratch;
-    }
-    row++;
-    if (f.eof()) break;
+
+/** Finds the start of each line of data of a CSV file, in one pass over the
+    file. Blank lines are skipped. */
+
+void DataFile::IndexLines(void) {
+  if (indexed) return;
+  indexed = true;
+  if (binary || base == 0) return;
+
+  const char* p = base + data_start;
+  const char* end = base + length;
+
+  while (p < end) {
+    const char* eol = (const char*)memchr(p, '\n', end - p);
+    if (eol == 0) eol = end;
+    const char* q = p;
+    while (q < eol && (*q == ' ' || *q == '\r' || *q == '\t')) q++;
+    if (q < eol) lines.push_back(p - base);
+    p = eol + 1;
   }
+}
+
 
-  for (int i=0;i<GetNumFields();i++) {
-    Max.push_back(0.0);
-    Min.push_back(0.0);
+int DataFile::GetNumRecords(void) {
+  if (binary) {
+    if (names.empty() || length < data_start) return 0;
+    return (length - data_start) / (names.size()*sizeof(double));
   }
+  IndexLines();
+  return lines.size();
+}
+
+
+const double* DataFile::GetColumn(int column) {
+  LoadColumn(column);
+  return Columns[column].empty() ? 0 : &Columns[column][0];
+}
 
-  for (int fld=0; fld<GetNumFields(); fld++) {
-    Max[fld] = Data[0][fld];
-    Min[fld] = Data[0][fld];
-    for (int rec=1;rec<GetNumRecords();rec++) {
-      if (Data[rec][fld] > Max[fld]) Max[fld] = Data[rec][fld];
-      else if (Data[rec][fld] < Min[fld]) Min[fld] = Data[rec][fld];
+
+/** Converts a column to numbers and finds its extrema. For a CSV file, only
+    the field of the column is parsed in each line; the fields before it are
+    skipped over. */
+
+void DataFile::LoadColumn(int column) {
+  int records = GetNumRecords();
+  vector <double>& values = Columns[column];
+
+  if ((int)values.size() == records) return;
+  values.resize(records);
+
+  if (binary) {
+    size_t stride = names.size()*sizeof(double);
+    const char* p = base + data_start + column*sizeof(double);
+    for (int rec=0; rec<records; rec++, p+=stride) {
+      if (isLittleEndian) {
+        memcpy(&values[rec], p, sizeof(double));
+      } else {
+        char* value = (char*)&values[rec];
+        for (unsigned int j=0; j<sizeof(double); j++) value[j] = p[sizeof(double)-1-j];
+      }
+    }
+  } else {
+    const char* end = base + length;
+    char field[64];
+
+    for (int rec=0; rec<records; rec++) {
+      const char* p = base + lines[rec];
+      const char* eol = (const char*)memchr(p, '\n', end - p);
+      if (eol == 0) eol = end;
+
+      for (int i=0; i<column && p; i++) {
+        p = (const char*)memchr(p, ',', eol - p);
+        if (p) p++;
+      }
+      if (p == 0) {
+        values[rec] = 0.0;
+        continue;
+      }
+
+      // The field is copied so that strtod() cannot read past the mapping
+      size_t n = 0;
+      while (p < eol && *p != ',' && n < sizeof(field)-1) field[n++] = *p++;
+      field[n] = '\0';
+      values[rec] = strtod(field, 0);
     }
   }
 
-  StartIdx = 0;
-  EndIdx = GetNumRecords()-1;
+  MinMax(values.empty() ? 0 : &values[0], values.size(), Min[column], Max[column]);
+}
+
 
-  cout << endl << "Done Reading data ..." << endl;
+/** Returns the extrema of a column between the start and the end indices. */
 
+void DataFile::GetRangeMinMax(int column, double& min, double& max) {
+  const double* values = GetColumn(column);
+  int records = GetNumRecords();
+  int start = StartIdx > 0 ? StartIdx : 0;
+  int end = (EndIdx >= 0 && EndIdx < records) ? EndIdx : records-1;
+
+  if (start == 0 && end == records-1) {
+    min = Min[column];
+    max = Max[column];
+  } else if (end >= start) {
+    MinMax(values + start, end - start + 1, min, max);
+  } else {
+    min = max = 0.0;
+  }
 }
 
 
 float DataFile::GetAutoAxisMax(int item) {
   double Mx, order, magnitude;
-  float max = Max[item];
-  float min = Min[item];
+  double min, max;
 
-  if (max == 0.0 && min == 0.0) return(1.0);
+  GetRangeMinMax(item, min, max);
 
-  if (StartIdx != 0 || EndIdx != (GetNumRecords()-1)) {
-    Mx = Data[StartIdx][item];
-    for (int rec=StartIdx+1; rec<=EndIdx; rec++) {
-      if (Data[rec][item] > Mx) Mx = Data[rec][item];
-    }
-  }
+  if (max == 0.0 && min == 0.0) return(1.0);
+  if (max == 0.0) return(0.0);
 
   order = (int)(log10(fabs(max)));
   magnitude = pow((double)10.0, (double)order);
@@ -132,18 +324,13 @@ float DataFile::GetAutoAxisMax(int item) {
 
 
 float DataFile::GetAutoAxisMin(int item) {
-  float Mn, order, magnitude;
-  float min = Min[item];
-  float max = Max[item];
+  double Mn, order, magnitude;
+  double min, max;
 
-  if (max == 0.0 && min == 0.0) return(0.0);
+  GetRangeMinMax(item, min, max);
 
-  if (StartIdx != 0 || (EndIdx != GetNumRecords()-1)) {
-    min = Data[StartIdx][item];
-    for (int rec=StartIdx+1; rec<=EndIdx; rec++) {
-      if (Data[rec][item] < min) min = Data[rec][item];
-    }
-  }
+  if (max == 0.0 && min == 0.0) return(0.0);
+  if (min == 0.0) return(0.0);
 
   order = (int)(log10(fabs(min)));
   magnitude = pow((double)10.0, (double)order);
@@ -154,4 +341,3 @@ float DataFile::GetAutoAxisMin(int item) {
   return Mn;
 }
 
-
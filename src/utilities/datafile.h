@@ -28,6 +28,13 @@
 using namespace std;
 
 /**This class handles reading a data file and placing user-requested data into arrays for plotting.
+  *
+  * The file (a CSV file or a binary log) is mapped in memory rather than read.
+  * Nothing but the names of the columns is parsed when the file is opened: the
+  * start of each line of a CSV file is found the first time the data is needed,
+  * and a column is only converted to numbers, along with its minimum and
+  * maximum, the first time it is requested. A plot of a few variables out of a
+  * long log thus touches the file once and keeps only those columns in memory.
   *@author Jon S. Berndt
   */
 
@@ -39,30 +46,45 @@ public:
 
   std::vector <string> names;
   string data_str;
-  typedef std::vector <float> Row;
-  typedef std::vector <Row> DataType;
-  DataType Data;
 
-  int GetNumFields(void) {if (Data.size() > 0) return(Data[0].size()); else return(0);}
-  int GetNumRecords(void) {return(Data.size());}
-  float GetStartTime(void) {if (Data.size() >= 2) return(Data[0][0]); else return(0);}
-  float GetEndTime(void) {if (Data.size() >= 2) return(Data[Data.size()-1][0]); else return(0);}
-  float GetMax(int column) {return(Max[column]);}
-  float GetMin(int column) {return(Min[column]);}
+  int GetNumFields(void) {return names.size();}
+  int GetNumRecords(void);
+  /// Returns the values of a column, one per record.
+  const double* GetColumn(int column);
+  double GetValue(int record, int column) {return GetColumn(column)[record];}
+  float GetStartTime(void) {if (GetNumRecords() >= 2) return(GetValue(0, 0)); else return(0);}
+  float GetEndTime(void) {if (GetNumRecords() >= 2) return(GetValue(GetNumRecords()-1, 0)); else return(0);}
+  float GetMax(int column) {GetColumn(column); return(Max[column]);}
+  float GetMin(int column) {GetColumn(column); return(Min[column]);}
   float GetRange(int field) {return (GetMax(field) - GetMin(field));}
   float GetAutoAxisMax(int item);
   float GetAutoAxisMin(int item);
   void SetStartIdx(int sidx) {StartIdx = sidx;}
   void SetEndIdx(int eidx)   {EndIdx = eidx;}
   int GetStartIdx(void)       {return StartIdx;}
-  int GetEndIdx(void)         {return EndIdx;}
+  int GetEndIdx(void)         {return EndIdx >= 0 ? EndIdx : GetNumRecords()-1;}
 
 private: // Private attributes
-  string buff_str;
-  ifstream f;
-  Row Max;
-  Row Min;
+  const char* base;          // The mapped file
+  size_t length;             // Its size in bytes
+  size_t data_start;         // The offset of the first record
+  bool binary;
+  bool indexed;
+  std::vector <size_t> lines;   // CSV: the offset of each line of data
+  std::vector < std::vector <double> > Columns;
+  std::vector <double> Max;
+  std::vector <double> Min;
   int StartIdx, EndIdx;
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  void* file_handle;
+  void* mapping_handle;
+#endif
+
+  void Map(const string& fname);
+  void Unmap(void);
+  void IndexLines(void);
+  void LoadColumn(int column);
+  void GetRangeMinMax(int column, double& min, double& max);
 };
 #endif
 
@@ -0,0 +1,241 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       input_load.cpp
+ Purpose:      Drives the input port of a running JSBSim with get/set commands
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+input_load opens a number of connections to the input port of a JSBSim instance
+(the <input port="..."/> of an aircraft) and sends get and set commands on each
+of them, in turn, for a number of seconds. Each connection keeps a number of
+commands on their way; a command is answered when its prompt comes back. At the
+end, the number of commands answered per second, the mean and maximum times of
+the answers and the number of connections lost are reported.
+
+The simulation should run in real time (or "nice") so that the frames, during
+which the commands are answered, keep coming:
+
+  JSBSim --script=scripts/c1722.xml --realtime &
+  input_load --port=1137 --clients=50 --seconds=10
+
+Usage:
+
+  input_load [--host=<address>] [--port=<port>] [--clients=<number>]
+             [--seconds=<duration>] [--pipeline=<commands>]
+             [--property=<property name>]
+
+The defaults are 127.0.0.1, port 1137, 10 clients, 10 seconds, 16 commands per
+connection and the property fcs/elevator-cmd-norm, which is set to 0.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0
+#endif
+
+using namespace std;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static const char prompt[] = "JSBSim> ";
+
+struct Connection {
+  int fd;
+  bool greeted;            // The prompt of the greeting has been received
+  unsigned int matched;    // The characters of a prompt matched so far
+  unsigned long sent;      // The commands sent
+  string out;              // The bytes not sent yet
+  deque <double> times;    // The times the commands waiting were sent
+};
+
+static double Now(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+static bool Option(const string& arg, const string& name, string& value)
+{
+  string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  string host = "127.0.0.1", property = "fcs/elevator-cmd-norm";
+  int port = 1137, clients = 10, pipeline = 16;
+  double seconds = 10.0;
+
+  for (int i=1; i<argc; i++) {
+    string arg(argv[i]), value;
+    if (Option(arg, "host", value)) {
+      host = value;
+    } else if (Option(arg, "port", value)) {
+      port = atoi(value.c_str());
+    } else if (Option(arg, "clients", value)) {
+      clients = atoi(value.c_str());
+    } else if (Option(arg, "seconds", value)) {
+      seconds = atof(value.c_str());
+    } else if (Option(arg, "pipeline", value)) {
+      pipeline = atoi(value.c_str());
+    } else if (Option(arg, "property", value)) {
+      property = value;
+    } else {
+      cerr << "Usage: input_load [--host=<address>] [--port=<port>] [--clients=<number>]" << endl
+           << "                  [--seconds=<duration>] [--pipeline=<commands>]" << endl
+           << "                  [--property=<property name>]" << endl;
+      exit(-1);
+    }
+  }
+  if (clients < 1) clients = 1;
+  if (pipeline < 1) pipeline = 1;
+
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+    cerr << "Not an IPv4 address: " << host << endl;
+    exit(-1);
+  }
+
+  const string get = "get " + property + "\n";
+  const string set = "set " + property + " 0\n";
+
+  vector <Connection> connections(clients);
+  for (int i=0; i<clients; i++) {
+    Connection& c = connections[i];
+    c.fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (c.fd < 0 || connect(c.fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+      cerr << "Could not connect to " << host << ":" << port << " (" << strerror(errno) << ")" << endl;
+      exit(-1);
+    }
+    int one = 1;
+    setsockopt(c.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(c.fd, F_SETFL, fcntl(c.fd, F_GETFL, 0) | O_NONBLOCK);
+    c.greeted = false;
+    c.matched = 0;
+    c.sent = 0;
+  }
+
+  vector <struct pollfd> fds(clients);
+  unsigned long answered = 0, lost = 0;
+  double total_latency = 0.0, max_latency = 0.0;
+  double start = Now(), end = start + seconds;
+  char buf[65536];
+
+  while (Now() < end) {
+    for (int i=0; i<clients; i++) {
+      Connection& c = connections[i];
+      fds[i].fd = c.fd;
+      fds[i].events = 0;
+      fds[i].revents = 0;
+      if (c.fd < 0) continue;
+
+      // Keep the pipeline full, alternating gets and sets
+      if (c.greeted) {
+        double now = Now();
+        while ((int)c.times.size() < pipeline) {
+          c.out += (c.sent++ % 2) ? set : get;
+          c.times.push_back(now);
+        }
+      }
+      fds[i].events = POLLIN | (c.out.empty() ? 0 : POLLOUT);
+    }
+
+    if (poll(&fds[0], clients, 100) <= 0) continue;
+
+    for (int i=0; i<clients; i++) {
+      Connection& c = connections[i];
+      if (c.fd < 0) continue;
+
+      if (fds[i].revents & POLLOUT) {
+        ssize_t n = send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+        if (n > 0) c.out.erase(0, n);
+      }
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+        ssize_t n = recv(c.fd, buf, sizeof(buf), 0);
+        if (n <= 0 && !(n < 0 && (errno == EAGAIN || errno == EINTR))) {
+          close(c.fd);
+          c.fd = -1;
+          lost++;
+          continue;
+        }
+        double now = Now();
+        for (ssize_t k=0; k<n; k++) {
+          if (buf[k] == prompt[c.matched]) c.matched++;
+          else c.matched = (buf[k] == prompt[0]) ? 1 : 0;
+          if (c.matched < sizeof(prompt)-1) continue;
+
+          c.matched = 0;
+          if (!c.greeted) {
+            c.greeted = true;
+          } else if (!c.times.empty()) {
+            double latency = now - c.times.front();
+            c.times.pop_front();
+            total_latency += latency;
+            if (latency > max_latency) max_latency = latency;
+            answered++;
+          }
+        }
+      }
+    }
+  }
+
+  double elapsed = Now() - start;
+  for (int i=0; i<clients; i++)
+    if (connections[i].fd >= 0) close(connections[i].fd);
+
+  cout << clients << " clients, " << pipeline << " commands on their way per client" << endl;
+  cout << answered << " commands answered in " << elapsed << " s: "
+       << answered/elapsed << " commands/s" << endl;
+  if (answered > 0) {
+    cout << "Time to answer: mean " << 1000.0*total_latency/answered << " ms, max "
+         << 1000.0*max_latency << " ms" << endl;
+  }
+  cout << lost << " connections lost" << endl;
+
+  return lost > 0 ? 1 : 0;
+}
@@ -36,6 +36,10 @@ A data file in comma-separated value (CSV) format, with time in the first
 column. The data file is expected to be all numeric. That is, NaN will
 mess it up, I think.
 
+A binary log (written by an output of type BINARY) can be given instead of a
+CSV file. The names of the columns are then read from its header and gnuplot
+is told to read the records as binary data.
+
 Multiple files (currently up to 10) can be input to prep_plot provided
 the names of the files are all the same except for a digit. The digit
 is substituted for on the command line to prep_plot using the "#" character.
@@ -97,6 +101,7 @@ INCLUDES
 #include <sstream>
 #include "string_utilities.h"
 #include "plotXMLVisitor.h"
+#include "binarylog.h"
 
 #define DEFAULT_FONT "Helvetica,10"
 #define TITLE_FONT "Helvetica,14"
@@ -111,6 +116,7 @@ string plot_range;
 
 string HaveTerm(vector <string>&, string); 
 int GetTermIndex(vector <string>&, string);
+string DataSource(const string&);
 void EmitComparisonPlot(vector <string>&, int, string);
 void EmitSinglePlot(string, int, string);
 bool MakeArbitraryPlot(
@@ -157,13 +163,19 @@ int main(int argc, char **argv)
     files.push_back(filename);
   }
   
-  ifstream infile(files[0].c_str());
-  if (!infile.is_open()) {
-    cerr << "Could not open file: " << files[0] << endl;
-    exit(-1);
+  BinaryLog log;
+  if (log.Open(files[0])) {
+    names = log.GetNames();
+    log.Close();
+  } else {
+    ifstream infile(files[0].c_str());
+    if (!infile.is_open()) {
+      cerr << "Could not open file: " << files[0] << endl;
+      exit(-1);
+    }
+    getline(infile, in_string, '\n');
+    names = split(in_string, ',');
   }
-  getline(infile, in_string, '\n');
-  names = split(in_string, ',');
   unsigned int num_names=names.size();
   
   // Read command line args
@@ -464,28 +476,28 @@ bool MakeArbitraryPlot(
         newPlot << "set y2tics font \""TICS_FONT"\"" << endl;
       }
 
-      newPlot << "plot " << time_range << " \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+      newPlot << "plot " << time_range << " " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
            << ":" << GetTermIndex(names, LeftYAxisNames[0]) << " with lines title \""
            << LeftYAxisNames[0] << "\"";
       if (numLeftYAxisNames > 1) {
         newPlot << ", \\" << endl;
         for (i=1; i<numLeftYAxisNames-1; i++) {
-          newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+          newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
                << ":" << GetTermIndex(names, LeftYAxisNames[i]) << " with lines title \"" 
                << LeftYAxisNames[i] << "\", \\" << endl;
         }
-        newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)<< ":" 
+        newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)<< ":" 
              << GetTermIndex(names, LeftYAxisNames[numLeftYAxisNames-1]) << " with lines title \"" 
              << LeftYAxisNames[numLeftYAxisNames-1] << "\"";
       }
       if (numRightYAxisNames > 0) {
         newPlot << ", \\" << endl;
         for (i=0; i<numRightYAxisNames-1; i++) {
-          newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+          newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
                << ":" << GetTermIndex(names, RightYAxisNames[i]) << " with lines axes x1y2 title \""
                << RightYAxisNames[i] << "\", \\" << endl;
         }
-        newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+        newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
              << ":" << GetTermIndex(names, RightYAxisNames[numRightYAxisNames-1]) << " with lines axes x1y2 title \""
              << RightYAxisNames[numRightYAxisNames-1] << "\"";
       }
@@ -511,28 +523,28 @@ bool MakeArbitraryPlot(
           newPlot << "     ";
         }
 
-        newPlot << "\"" << files[f] << "\" using " << GetTermIndex(names, XAxisName)
+        newPlot << DataSource(files[f]) << " using " << GetTermIndex(names, XAxisName)
              << ":" << GetTermIndex(names, LeftYAxisNames[0]) << " with lines title \""
              << LeftYAxisNames[0] << ": " << f << "\"";
         if (numLeftYAxisNames > 1) {
           newPlot << ", \\" << endl;
           for (i=1; i<numLeftYAxisNames-1; i++) {
-            newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(names, XAxisName)
+            newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(names, XAxisName)
                  << ":" << GetTermIndex(names, LeftYAxisNames[i]) << " with lines title \"" 
                  << LeftYAxisNames[i] << ": " << f << "\", \\" << endl;
           }
-          newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(names, XAxisName)<< ":" 
+          newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(names, XAxisName)<< ":" 
                << GetTermIndex(names, LeftYAxisNames[numLeftYAxisNames-1]) << " with lines title \"" 
                << LeftYAxisNames[numLeftYAxisNames-1] << ": " << f << "\"";
         }
         if (numRightYAxisNames > 0) {
           newPlot << ", \\" << endl;
           for (i=0; i<numRightYAxisNames-2; i++) {
-            newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(names, XAxisName)
+            newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(names, XAxisName)
                  << ":" << GetTermIndex(names, RightYAxisNames[i]) << " with lines axes x1y2 title \""
                  << RightYAxisNames[i] << ": " << f << "\", \\" << endl;
           }
-          newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(names, XAxisName)
+          newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(names, XAxisName)
                << ":" << GetTermIndex(names, RightYAxisNames[numRightYAxisNames-1]) << " with lines axes x1y2 title \""
                << RightYAxisNames[numRightYAxisNames-1] << ": " << f << "\"";
         }
@@ -548,20 +560,36 @@ bool MakeArbitraryPlot(
   return have_all_terms;
 }
 
+// ############################################################################
+// Returns the data file as given to the gnuplot plot command. For a binary log,
+// gnuplot is told to skip the header and to read one double per column.
+
+string DataSource(const string& filename)
+{
+  BinaryLog log;
+  if (!log.Open(filename)) return "\"" + filename + "\"";
+
+  stringstream source;
+  source << "\"" << filename << "\" binary skip=" << log.GetHeaderSize() << " format=\"";
+  for (unsigned int i=0; i<log.GetNumColumns(); i++) source << "%float64";
+  source << "\" endian=little";
+  return source.str();
+}
+
 // ############################################################################
 
 void EmitSinglePlot(string filename, int index, string linetitle )
 {
-  cout << "plot " << plot_range << " \"" << filename << "\" using 1:" << index << " with lines title \"" << linetitle << "\"" << endl;
+  cout << "plot " << plot_range << " " << DataSource(filename) << " using 1:" << index << " with lines title \"" << linetitle << "\"" << endl;
 }
 
 // ############################################################################
 
 void EmitComparisonPlot(vector <string>& filenames, int index, string linetitle)
 {
-  cout << "plot " << plot_range <<  " \"" << filenames[0] << "\" using 1:" << index << " with lines title \"" << linetitle << ": 1" << "\", \\" << endl;
+  cout << "plot " << plot_range <<  " " << DataSource(filenames[0]) << " using 1:" << index << " with lines title \"" << linetitle << ": 1" << "\", \\" << endl;
   for (unsigned int f=1;f<filenames.size()-1;f++){
-    cout << "\"" << filenames[f] << "\" using 1:" << index << " with lines title \"" << linetitle << ": " << f+1 << "\", \\" << endl;
+    cout << DataSource(filenames[f]) << " using 1:" << index << " with lines title \"" << linetitle << ": " << f+1 << "\", \\" << endl;
   }
-  cout << "\"" << filenames[filenames.size()-1] << "\" using 1:" << index << " with lines title \"" << linetitle << ": " << filenames.size() << "\"" << endl;
+  cout << DataSource(filenames[filenames.size()-1]) << " using 1:" << index << " with lines title \"" << linetitle << ": " << filenames.size() << "\"" << endl;
 }
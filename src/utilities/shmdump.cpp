@@ -0,0 +1,206 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       shmdump.cpp
+ Purpose:      Prints the state JSBSim publishes in shared memory
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+shmdump maps the segment of an output of type SHARED_MEMORY and prints, as CSV,
+the names of its columns followed by a number of snapshots of the values, taken
+at regular intervals. It reads the segment the way a visual system would: a
+snapshot is copied between two reads of the sequence number and copied again
+if the simulation was writing meanwhile. It is an example of such a reader as
+much as a tool. The number of snapshots that had to be copied again is reported
+at the end.
+
+Usage:
+
+  shmdump <segment name> [--count=<snapshots>] [--interval=<milliseconds>]
+
+The defaults are 1 snapshot and 100 milliseconds between them. A snapshot is
+printed only if the values changed since the previous one.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+using namespace std;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static const char magic[8] = {'J','S','B','S','S','H','M','\0'};
+static const char log_magic[8] = {'J','S','B','S','B','L','O','G'};
+
+// The integers of the header are in the byte order of the machine
+static unsigned int GetU32(const char* bytes)
+{
+  unsigned int value;
+  memcpy(&value, bytes, sizeof(value));
+  return value;
+}
+
+// Copies a consistent set of values: the sequence number is the same, and
+// even, before and after the copy. Returns the number of copies that failed.
+static unsigned long Snapshot(const char* base, size_t data_offset,
+                              vector <double>& values, unsigned int& seq)
+{
+  volatile const unsigned int* sequence = (volatile const unsigned int*)(base + 20);
+  unsigned long retries = 0;
+
+  for (;;) {
+    unsigned int s1 = *sequence;
+    __sync_synchronize();
+    if ((s1 & 1) == 0) {
+      memcpy(&values[0], base + data_offset, values.size()*sizeof(double));
+      __sync_synchronize();
+      if (*sequence == s1) {
+        seq = s1;
+        return retries;
+      }
+    }
+    retries++;
+    if (retries % 1000 == 0) usleep(0);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char **argv)
+{
+  string name;
+  int count = 1;
+  int interval = 100;
+
+  for (int i=1; i<argc; i++) {
+    string arg(argv[i]);
+    if (arg.substr(0,8) == "--count=") {
+      count = atoi(arg.substr(8).c_str());
+    } else if (arg.substr(0,11) == "--interval=") {
+      interval = atoi(arg.substr(11).c_str());
+    } else if (name.empty()) {
+      name = arg;
+    } else {
+      cerr << "Unknown argument " << arg << endl;
+      exit(-1);
+    }
+  }
+
+  if (name.empty()) {
+    cerr << "Usage: shmdump <segment name> [--count=<snapshots>] [--interval=<milliseconds>]" << endl;
+    exit(-1);
+  }
+  if (name[0] != '/') name = "/" + name;
+  if (count < 1) count = 1;
+  if (interval < 0) interval = 0;
+
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    cerr << "Could not open the shared memory segment " << name << endl;
+    exit(-1);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 64) {
+    cerr << "The segment " << name << " is too small" << endl;
+    exit(-1);
+  }
+  size_t size = st.st_size;
+  void* mapping = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    cerr << "Could not map the segment " << name << endl;
+    exit(-1);
+  }
+  const char* base = (const char*)mapping;
+
+  // The header is checked once the writer has finished it
+  while (*(volatile const unsigned int*)(base + 20) & 1) usleep(1000);
+  __sync_synchronize();
+
+  if (memcmp(base, magic, 8) != 0 || GetU32(base + 8) != 1) {
+    cerr << "The segment " << name << " was not written by JSBSim" << endl;
+    exit(-1);
+  }
+  unsigned int columns = GetU32(base + 12);
+  size_t data_offset = GetU32(base + 16);
+  if (data_offset < 64 + 24 || data_offset + columns*sizeof(double) > size
+      || memcmp(base + 64, log_magic, 8) != 0) {
+    cerr << "The header of the segment " << name << " is not valid" << endl;
+    exit(-1);
+  }
+
+  // The names and units follow the header of a binary log, at offset 64
+  const char* p = base + 64 + 24;
+  const char* end = base + data_offset;
+  for (unsigned int i=0; i<columns; i++) {
+    const char* unit = (const char*)memchr(p, '\0', end - p);
+    if (unit == 0) break;
+    unit++;
+    const char* next = (const char*)memchr(unit, '\0', end - unit);
+    if (next == 0) break;
+    if (i > 0) cout << ", ";
+    cout << p;
+    p = next + 1;
+  }
+  cout << '\n';
+
+  vector <double> values(columns);
+  unsigned int seq, last_seq = 0;
+  unsigned long retries = 0;
+  string line;
+  char buf[32];
+
+  for (int n=0; n<count; n++) {
+    if (n > 0) usleep(interval*1000);
+    retries += Snapshot(base, data_offset, values, seq);
+    if (seq == last_seq) continue;
+    last_seq = seq;
+    line.clear();
+    for (unsigned int i=0; i<columns; i++) {
+      if (i > 0) line += ", ";
+      int len = snprintf(buf, sizeof(buf), "%.17g", values[i]);
+      if (len < 0 || len > (int)sizeof(buf)-1) len = sizeof(buf)-1;
+      line.append(buf, len);
+    }
+    line += '\n';
+    cout.write(line.data(), line.size());
+    cout.flush();
+  }
+
+  cerr << "Copies retried: " << retries << endl;
+
+  munmap(mapping, size);
+  return 0;
+}